@@ -0,0 +1,108 @@
+#include "form/RefElement.h"
+#include "form/SumFactorization.h"
+#include "quadrules/AutoRule.h"
+#include "tensor/EigenMap.h"
+#include "tensor/Managed.h"
+#include "tensor/Tensor.h"
+
+#include <Eigen/Core>
+#include <argparse.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using tndm::ModalRefElement;
+using tndm::SumFactorization;
+
+/**
+ * Compares the dense reference-matrix volume operator (as in the generated kernels) with the
+ * sum-factorised one. Both compute y = D^T D u per element, where D is the matrix of reference
+ * gradients at the quadrature points.
+ */
+template <std::size_t D> void bench(unsigned maxDegree, std::size_t numElements) {
+    using clock = std::chrono::steady_clock;
+    std::cout << std::setw(6) << "degree" << std::setw(8) << "Nbf" << std::setw(10) << "Nq dense"
+              << std::setw(10) << "Nq sf" << std::setw(14) << "dense [us]" << std::setw(14)
+              << "sf [us]" << std::setw(10) << "speed-up" << std::endl;
+    for (unsigned N = 1; N <= maxDegree; ++N) {
+        unsigned minQuadOrder = 2 * N + 1;
+        auto refElement = ModalRefElement<D>(N);
+        std::size_t Nbf = refElement.numBasisFunctions();
+
+        auto denseRule = tndm::simplexQuadratureRule<D>(minQuadOrder);
+        auto Dxi = refElement.evaluateGradientAt(denseRule.points(), {1, 2, 0});
+        auto DxiMap = Eigen::Map<Eigen::MatrixXd>(Dxi.data(), D * denseRule.size(), Nbf);
+        Eigen::MatrixXd DxiT = DxiMap.transpose();
+
+        auto sf = SumFactorization<D>(N, minQuadOrder);
+        std::vector<double> scratch(sf.scratch_size());
+        std::vector<double> grad(D * sf.numQuadPoints());
+
+        Eigen::MatrixXd U = Eigen::MatrixXd::Random(Nbf, numElements);
+        Eigen::MatrixXd Y(Nbf, numElements);
+        Eigen::VectorXd G(D * denseRule.size());
+
+        auto start = clock::now();
+        for (std::size_t elNo = 0; elNo < numElements; ++elNo) {
+            G.noalias() = DxiMap * U.col(elNo);
+            Y.col(elNo).noalias() = DxiT * G;
+        }
+        double dense = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+        start = clock::now();
+        for (std::size_t elNo = 0; elNo < numElements; ++elNo) {
+            sf.evaluate_gradient(U.col(elNo).data(), grad.data(), scratch.data());
+            sf.integrate_gradient(grad.data(), Y.col(elNo).data(), scratch.data());
+        }
+        double sumfact = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+        std::cout << std::setw(6) << N << std::setw(8) << Nbf << std::setw(10) << denseRule.size()
+                  << std::setw(10) << sf.numQuadPoints() << std::setw(14) << std::setprecision(3)
+                  << dense / numElements << std::setw(14) << sumfact / numElements
+                  << std::setw(10) << dense / sumfact << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    argparse::ArgumentParser program("bench-sumfact");
+    program.add_argument("D")
+        .help("Simplex dimension (D=2: triangle, D=3: tet)")
+        .action([](std::string const& value) { return static_cast<unsigned>(std::stoul(value)); });
+    program.add_argument("--max_degree")
+        .help("Maximum polynomial degree")
+        .default_value(8u)
+        .action([](std::string const& value) { return static_cast<unsigned>(std::stoul(value)); });
+    program.add_argument("--elements")
+        .help("Number of elements")
+        .default_value(10000u)
+        .action([](std::string const& value) { return static_cast<unsigned>(std::stoul(value)); });
+
+    try {
+        program.parse_args(argc, argv);
+    } catch (std::runtime_error& err) {
+        std::cout << err.what() << std::endl;
+        std::cout << program;
+        return 0;
+    }
+
+    auto D = program.get<unsigned>("D");
+    auto maxDegree = program.get<unsigned>("--max_degree");
+    auto numElements = program.get<unsigned>("--elements");
+    switch (D) {
+    case 2u:
+        bench<2u>(maxDegree, numElements);
+        break;
+    case 3u:
+        bench<3u>(maxDegree, numElements);
+        break;
+    default:
+        std::cerr << "Unsupported dimension " << D << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -32,10 +32,10 @@ public:
     auto const& lam() const { return lam_; }
     auto const& mu() const { return mu_; }
 
-    auto make_local_operator(std::shared_ptr<Curvilinear<DomainDimension>> cl,
-                             DGMethod method) const {
-        auto elasticity =
-            std::make_shared<Elasticity>(std::move(cl), lam_, mu_, std::nullopt, method);
+    auto make_local_operator(std::shared_ptr<Curvilinear<DomainDimension>> cl, DGMethod method,
+                             GeometryMode geometry = GeometryMode::Stored) const {
+        auto elasticity = std::make_shared<Elasticity>(std::move(cl), lam_, mu_, std::nullopt,
+                                                       method, std::nullopt, geometry);
         set(*elasticity);
         return elasticity;
     }
@@ -0,0 +1,19 @@
+#ifndef INCREMENTALGREENCONFIG_20261018_H
+#define INCREMENTALGREENCONFIG_20261018_H
+
+#include <cstddef>
+
+namespace tndm {
+
+/**
+ * @brief Incremental traction updates with the discrete Green's function.
+ */
+struct IncrementalGreenConfig {
+    double slip_tolerance;
+    std::size_t refresh_interval;
+    double max_active_fraction;
+};
+
+} // namespace tndm
+
+#endif // INCREMENTALGREENCONFIG_20261018_H
@@ -1,6 +1,7 @@
 #include "MeshConfig.h"
 #include "util/Schema.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -24,6 +25,18 @@ GenMesh<D> GenMeshConfig<D>::create(double resolution, MPI_Comm comm) const {
         };
     }
 
+    if (grading) {
+        for (std::size_t d = 0; d < D; ++d) {
+            for (auto&& bc : bcs[d]) {
+                if (bc.bc == BC::Fault && bc.plane >= intercepts[d].size()) {
+                    throw std::invalid_argument("Fault plane " + std::to_string(bc.plane) +
+                                                " does not exist");
+                }
+            }
+        }
+        return GenMesh(intercepts, h, BCs, std::min(grading->h_fault, resolution),
+                       grading->growth, comm);
+    }
     return GenMesh(intercepts, h, BCs, comm);
 }
 
@@ -42,6 +55,12 @@ template <std::size_t D> void GenMeshConfig<D>::setSchema(TableSchema<GenMeshCon
             case 'f':
             case 'F':
                 return BC::Fault;
+            case 'a':
+            case 'A':
+                return BC::Absorbing;
+            case 'e':
+            case 'E':
+                return BC::Exterior;
             default:
                 break;
             }
@@ -51,6 +70,14 @@ template <std::size_t D> void GenMeshConfig<D>::setSchema(TableSchema<GenMeshCon
     });
     bcConfigSchema.add_value("plane", &BCConfig<D>::plane);
     bcConfigSchema.add_array("region", &BCConfig<D>::region).of_values();
+    auto& gradingSchema = schema.add_table("grading", &GenMeshConfig<D>::grading);
+    gradingSchema.add_value("h_fault", &GradingConfig::h_fault)
+        .validator([](auto&& x) { return x > 0; })
+        .help("Resolution on fault planes");
+    gradingSchema.add_value("growth", &GradingConfig::growth)
+        .validator([](auto&& x) { return x >= 1; })
+        .default_value(1.1)
+        .help("Growth factor of element size with distance to fault planes");
 }
 
 template class GenMeshConfig<2u>;
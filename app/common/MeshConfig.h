@@ -21,9 +21,15 @@ template <std::size_t D> struct BCConfig {
     std::optional<std::array<std::size_t, D - 1u>> region;
 };
 
+struct GradingConfig {
+    double h_fault;
+    double growth;
+};
+
 template <std::size_t D> struct GenMeshConfig {
     std::array<std::vector<double>, D> intercepts;
     std::array<std::vector<BCConfig<D>>, D> bcs;
+    std::optional<GradingConfig> grading;
 
     GenMesh<D> create(double resolution, MPI_Comm comm) const;
     static void setSchema(TableSchema<GenMeshConfig<D>>& schema);
@@ -0,0 +1,21 @@
+#ifndef NEWMARKCONFIG_20261018_H
+#define NEWMARKCONFIG_20261018_H
+
+#include <optional>
+
+namespace tndm {
+
+/**
+ * @brief Parameters of the implicit Newmark time integrator.
+ */
+struct NewmarkConfig {
+    double beta;
+    double gamma;
+    double atol;
+    double rtol;
+    std::optional<double> max_time_step;
+};
+
+} // namespace tndm
+
+#endif // NEWMARKCONFIG_20261018_H
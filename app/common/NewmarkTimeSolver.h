@@ -0,0 +1,308 @@
+#ifndef NEWMARKTIMESOLVER_20261018_H
+#define NEWMARKTIMESOLVER_20261018_H
+
+#include "common/MGConfig.h"
+#include "common/NewmarkConfig.h"
+#include "common/PetscUtil.h"
+#include "common/PetscVector.h"
+#include "interface/BlockVector.h"
+
+#include <mpi.h>
+#include <petscvec.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace tndm {
+
+/**
+ * @brief Implicit time integrator for the fully dynamic SEAS problem.
+ *
+ * The elastodynamic system M a + C v + A u = b(t, S) is advanced with the Newmark family of
+ * methods, which is unconditionally stable for 2 beta >= gamma >= 1/2 (e.g. the default
+ * average acceleration method beta = 1/4, gamma = 1/2). Each stage requires a linear solve with
+ * A + M / (beta dt^2) + gamma C / (beta dt). The fault state is advanced with Heun's method:
+ * The explicit Euler predictor of the fault state provides the slip for a first Newmark solve,
+ * the trapezoidal corrector the slip for a second one. The difference between predictor and
+ * corrector serves as error estimate for the step size control.
+ *
+ * In order to reuse the assembled preconditioner, time steps are restricted to dt0 2^{k/4},
+ * where dt0 is the initial time step and k is an integer.
+ *
+ * The interface follows PetscTimeSolver; the state vectors are (v, u, s).
+ * The wave operator (e.g. SeasFDOperator) provides initial_condition, acceleration (M^{-1} times
+ * the residual), fault_rhs, setup_implicit, and solve_implicit.
+ */
+template <class WaveOp> class NewmarkTimeSolver {
+public:
+    constexpr static std::size_t NumStateVecs = 3;
+    /**
+     * @brief A step is rejected at most this many times in a row before solve throws.
+     */
+    constexpr static std::size_t MaxConsecutiveRejections = 20;
+
+    /**
+     * @brief Sets up the time solver and the initial condition.
+     *
+     * @param seasop Wave operator, e.g. fully dynamic SEAS operator
+     * @param state State vectors (v, u, s)
+     * @param cfg Newmark parameters and error tolerances
+     * @param mg_config Multigrid configuration of the linear solver
+     * @param start_time Time of the initial condition
+     * @param initial_time_step Initial time step
+     * @param near_null_space Attach rigid body modes to the preconditioner
+     */
+    NewmarkTimeSolver(WaveOp& seasop, std::array<std::unique_ptr<PetscVector>, NumStateVecs> state,
+                      NewmarkConfig const& cfg, MGConfig const& mg_config, double start_time,
+                      double initial_time_step, bool near_null_space = false);
+
+    void solve(double upcoming_time);
+
+    auto& state(std::size_t idx) {
+        assert(idx < NumStateVecs);
+        return *state_[idx];
+    }
+    auto const& state(std::size_t idx) const {
+        assert(idx < NumStateVecs);
+        return *state_[idx];
+    }
+
+    template <class Monitor> void set_monitor(Monitor& monitor) {
+        monitor_ = [&monitor](double time, BlockVector const& v, BlockVector const& u,
+                              BlockVector const& s) { monitor.monitor(time, v, u, s); };
+    }
+
+    inline std::size_t get_step_number() const { return steps_; }
+    inline std::size_t get_step_rejections() const { return rejections_; }
+    /**
+     * @brief The fault state rate of the last stage is evaluated at the accepted state
+     */
+    inline bool fsal() const { return true; }
+
+private:
+    constexpr static double Safety = 0.9;
+    constexpr static double MinFactor = 0.2;
+    constexpr static double MaxFactor = 4.0;
+
+    bool step(double dt, double& err);
+    bool newmark_stage(double time, double dt, BlockVector const& s);
+    double error_norm(PetscVector const& s_pred, PetscVector const& s_corr) const;
+    double quantize(double dt) const;
+
+    WaveOp& seasop_;
+    NewmarkConfig cfg_;
+    MGConfig mg_config_;
+    bool near_null_space_;
+
+    std::array<std::unique_ptr<PetscVector>, NumStateVecs> state_;
+    std::array<std::unique_ptr<PetscVector>, NumStateVecs> state_new_;
+    std::unique_ptr<PetscVector> a_, a_new_, v_pred_, u_pred_, r_;
+    std::unique_ptr<PetscVector> ds_, ds_new_, s_pred_;
+
+    std::function<void(double, BlockVector const&, BlockVector const&, BlockVector const&)>
+        monitor_;
+
+    double time_;
+    double dt_;
+    double dt0_;
+    double solver_dt_ = 0.0;
+    bool monitored_initial_ = false;
+    std::size_t steps_ = 0;
+    std::size_t rejections_ = 0;
+};
+
+template <class WaveOp>
+NewmarkTimeSolver<WaveOp>::NewmarkTimeSolver(
+    WaveOp& seasop, std::array<std::unique_ptr<PetscVector>, NumStateVecs> state,
+    NewmarkConfig const& cfg, MGConfig const& mg_config, double start_time,
+    double initial_time_step, bool near_null_space)
+    : seasop_(seasop), cfg_(cfg), mg_config_(mg_config), near_null_space_(near_null_space),
+      state_(std::move(state)), time_(start_time), dt_(initial_time_step),
+      dt0_(initial_time_step) {
+    if (cfg_.gamma < 0.5 || 2.0 * cfg_.beta < cfg_.gamma) {
+        throw std::runtime_error(
+            "Newmark parameters must satisfy 2 beta >= gamma >= 1/2 (unconditional stability)");
+    }
+    if (!(initial_time_step > 0.0)) {
+        throw std::runtime_error("Newmark: initial time step must be positive");
+    }
+    if (cfg_.max_time_step) {
+        dt_ = std::min(dt_, *cfg_.max_time_step);
+        dt0_ = dt_;
+    }
+
+    for (std::size_t n = 0; n < NumStateVecs; ++n) {
+        state_new_[n] = std::make_unique<PetscVector>(*state_[n]);
+    }
+    a_ = std::make_unique<PetscVector>(*state_[0]);
+    a_new_ = std::make_unique<PetscVector>(*state_[0]);
+    v_pred_ = std::make_unique<PetscVector>(*state_[0]);
+    u_pred_ = std::make_unique<PetscVector>(*state_[0]);
+    r_ = std::make_unique<PetscVector>(*state_[0]);
+    ds_ = std::make_unique<PetscVector>(*state_[2]);
+    ds_new_ = std::make_unique<PetscVector>(*state_[2]);
+    s_pred_ = std::make_unique<PetscVector>(*state_[2]);
+
+    auto& v = *state_[0];
+    auto& u = *state_[1];
+    auto& s = *state_[2];
+    seasop_.initial_condition(time_, v, u, s);
+    seasop_.acceleration(time_, v, u, s, *a_);
+    seasop_.fault_rhs(time_, u, s, *ds_);
+}
+
+template <class WaveOp> void NewmarkTimeSolver<WaveOp>::solve(double upcoming_time) {
+    if (!monitored_initial_) {
+        if (monitor_) {
+            monitor_(time_, *state_[0], *state_[1], *state_[2]);
+        }
+        monitored_initial_ = true;
+    }
+
+    std::size_t consecutive_rejections = 0;
+    while (time_ < upcoming_time) {
+        double dt = dt_;
+        bool last_step = time_ + dt >= upcoming_time;
+        if (last_step) {
+            dt = upcoming_time - time_;
+        }
+
+        double err;
+        bool converged = step(dt, err);
+        double factor = MinFactor;
+        if (converged) {
+            factor = std::clamp(Safety / std::sqrt(err), MinFactor, MaxFactor);
+        }
+
+        if (converged && err <= 1.0) {
+            for (std::size_t n = 0; n < NumStateVecs; ++n) {
+                std::swap(state_[n], state_new_[n]);
+            }
+            std::swap(a_, a_new_);
+            std::swap(ds_, ds_new_);
+            time_ = last_step ? upcoming_time : time_ + dt;
+            ++steps_;
+            consecutive_rejections = 0;
+            if (monitor_) {
+                monitor_(time_, *state_[0], *state_[1], *state_[2]);
+            }
+            if (last_step) {
+                // Do not let the shortened last step limit the next solve
+                factor = std::max(factor, dt_ / dt);
+            }
+        } else {
+            ++rejections_;
+            if (++consecutive_rejections >= MaxConsecutiveRejections) {
+                std::stringstream s;
+                s << "Newmark: step rejected " << consecutive_rejections
+                  << " times in a row at time " << time_ << " (dt = " << dt << ", "
+                  << (converged ? "error estimate too large" : "linear solver diverged") << ")";
+                throw std::runtime_error(s.str());
+            }
+        }
+
+        double dt_next = dt * factor;
+        if (cfg_.max_time_step) {
+            dt_next = std::min(dt_next, *cfg_.max_time_step);
+        }
+        dt_ = quantize(dt_next);
+    }
+}
+
+template <class WaveOp> bool NewmarkTimeSolver<WaveOp>::step(double dt, double& err) {
+    err = std::numeric_limits<double>::infinity();
+    double const beta = cfg_.beta;
+    double const gamma = cfg_.gamma;
+    double const time = time_ + dt;
+
+    auto& v = *state_[0];
+    auto& u = *state_[1];
+    auto& s = *state_[2];
+    auto& s_new = *state_new_[2];
+
+    if (dt != solver_dt_) {
+        seasop_.setup_implicit(1.0 / (beta * dt * dt), gamma / (beta * dt), mg_config_,
+                               near_null_space_);
+        solver_dt_ = dt;
+    }
+
+    CHKERRTHROW(VecWAXPY(u_pred_->vec(), dt, v.vec(), u.vec()));
+    CHKERRTHROW(VecAXPY(u_pred_->vec(), (0.5 - beta) * dt * dt, a_->vec()));
+    CHKERRTHROW(VecWAXPY(v_pred_->vec(), (1.0 - gamma) * dt, a_->vec(), v.vec()));
+
+    // Predictor: slip and state from explicit Euler
+    CHKERRTHROW(VecWAXPY(s_pred_->vec(), dt, ds_->vec(), s.vec()));
+    if (!newmark_stage(time, dt, *s_pred_)) {
+        return false;
+    }
+    seasop_.fault_rhs(time, *state_new_[1], *s_pred_, *ds_new_);
+
+    // Corrector: slip and state from the trapezoidal rule
+    CHKERRTHROW(VecCopy(s.vec(), s_new.vec()));
+    CHKERRTHROW(VecAXPBYPCZ(s_new.vec(), 0.5 * dt, 0.5 * dt, 1.0, ds_->vec(), ds_new_->vec()));
+    err = error_norm(*s_pred_, s_new);
+    if (err > 1.0) {
+        return true;
+    }
+
+    if (!newmark_stage(time, dt, s_new)) {
+        err = std::numeric_limits<double>::infinity();
+        return false;
+    }
+    seasop_.fault_rhs(time, *state_new_[1], s_new, *ds_new_);
+    return true;
+}
+
+template <class WaveOp>
+bool NewmarkTimeSolver<WaveOp>::newmark_stage(double time, double dt, BlockVector const& s) {
+    seasop_.acceleration(time, *v_pred_, *u_pred_, s, *r_);
+    if (!seasop_.solve_implicit(*r_, *a_new_)) {
+        return false;
+    }
+    CHKERRTHROW(
+        VecWAXPY(state_new_[1]->vec(), cfg_.beta * dt * dt, a_new_->vec(), u_pred_->vec()));
+    CHKERRTHROW(VecWAXPY(state_new_[0]->vec(), cfg_.gamma * dt, a_new_->vec(), v_pred_->vec()));
+    return true;
+}
+
+template <class WaveOp>
+double NewmarkTimeSolver<WaveOp>::error_norm(PetscVector const& s_pred,
+                                             PetscVector const& s_corr) const {
+    PetscInt n;
+    PetscScalar const *p, *c, *s;
+    CHKERRTHROW(VecGetLocalSize(s_pred.vec(), &n));
+    CHKERRTHROW(VecGetArrayRead(s_pred.vec(), &p));
+    CHKERRTHROW(VecGetArrayRead(s_corr.vec(), &c));
+    CHKERRTHROW(VecGetArrayRead(state_[2]->vec(), &s));
+    double err_local = 0.0;
+    for (PetscInt i = 0; i < n; ++i) {
+        double scale = cfg_.atol + cfg_.rtol * std::max(std::abs(s[i]), std::abs(c[i]));
+        err_local = std::max(err_local, std::abs(c[i] - p[i]) / scale);
+    }
+    CHKERRTHROW(VecRestoreArrayRead(state_[2]->vec(), &s));
+    CHKERRTHROW(VecRestoreArrayRead(s_corr.vec(), &c));
+    CHKERRTHROW(VecRestoreArrayRead(s_pred.vec(), &p));
+
+    double err;
+    MPI_Allreduce(&err_local, &err, 1, MPI_DOUBLE, MPI_MAX, seasop_.comm());
+    return err;
+}
+
+template <class WaveOp> double NewmarkTimeSolver<WaveOp>::quantize(double dt) const {
+    // Rounding errors in dt (e.g. dt_ / dt * dt after a shortened last step) must not drop a level
+    constexpr double eps = 1e-8;
+    return dt0_ * std::exp2(std::floor(4.0 * std::log2(dt / dt0_) + eps) / 4.0);
+}
+
+} // namespace tndm
+
+#endif // NEWMARKTIMESOLVER_20261018_H
@@ -0,0 +1,19 @@
+#ifndef OUTOFCORECONFIG_20261018_H
+#define OUTOFCORECONFIG_20261018_H
+
+#include <cstddef>
+#include <string>
+
+namespace tndm {
+
+/**
+ * @brief Storage of the discrete Green's function on node-local storage.
+ */
+struct OutOfCoreConfig {
+    std::string scratch_dir;
+    std::size_t tile_columns;
+};
+
+} // namespace tndm
+
+#endif // OUTOFCORECONFIG_20261018_H
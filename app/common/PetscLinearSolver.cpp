@@ -4,22 +4,68 @@
 
 namespace tndm {
 
+namespace {
+/**
+ * @brief Orthonormalizes vecs with modified Gram-Schmidt (applied twice) and creates the
+ * null space object. Numerically dependent vectors are dropped.
+ *
+ * Takes ownership of vecs.
+ */
+MatNullSpace make_near_null_space(std::vector<Vec>& vecs, MPI_Comm comm) {
+    std::vector<Vec> basis;
+    for (auto& v : vecs) {
+        PetscReal norm0, norm;
+        CHKERRTHROW(VecNorm(v, NORM_2, &norm0));
+        for (int pass = 0; pass < 2; ++pass) {
+            for (auto& b : basis) {
+                PetscScalar dot;
+                CHKERRTHROW(VecDot(v, b, &dot));
+                CHKERRTHROW(VecAXPY(v, -dot, b));
+            }
+        }
+        CHKERRTHROW(VecNormalize(v, &norm));
+        if (norm > 1.0e-10 * norm0) {
+            basis.push_back(v);
+        } else {
+            CHKERRTHROW(VecDestroy(&v));
+        }
+    }
+    vecs.clear();
+
+    MatNullSpace nsp = nullptr;
+    if (!basis.empty()) {
+        CHKERRTHROW(MatNullSpaceCreate(comm, PETSC_FALSE, basis.size(), basis.data(), &nsp));
+    }
+    // The null space keeps its own references
+    for (auto& b : basis) {
+        CHKERRTHROW(VecDestroy(&b));
+    }
+    return nsp;
+}
+} // namespace
+
 PetscLinearSolver::PetscLinearSolver(AbstractDGOperator<DomainDimension>& dgop, bool matrix_free,
-                                     MGConfig const& mg_config) {
+                                     MGConfig const& mg_config, bool near_null_space) {
     auto const& topo = dgop.topo();
+    if (dgop.has_exterior_coupling() && !matrix_free) {
+        throw std::runtime_error("Exterior boundaries require a matrix-free operator.");
+    }
     if (matrix_free) {
         A_ = std::make_unique<PetscDGShell>(dgop);
     }
 
     P_ = std::make_unique<PetscDGMatrix>(dgop.block_size(), topo);
     dgop.assemble(*P_);
+    if (near_null_space) {
+        setup_near_null_space(dgop);
+    }
 
     b_ = std::make_unique<PetscVector>(dgop.block_size(), topo.numLocalElements(), topo.comm());
     x_ = std::make_unique<PetscVector>(*b_);
     dgop.rhs(*b_);
 
     CHKERRTHROW(KSPCreate(topo.comm(), &ksp_));
-    CHKERRTHROW(KSPSetType(ksp_, KSPCG));
+    CHKERRTHROW(KSPSetType(ksp_, dgop.has_exterior_coupling() ? KSPGMRES : KSPCG));
     if (matrix_free) {
         CHKERRTHROW(KSPSetOperators(ksp_, A_->mat(), P_->mat()));
     } else {
@@ -47,6 +93,15 @@ PetscLinearSolver::~PetscLinearSolver() {
     for (auto&& A : mat_cleanup) {
         MatDestroy(&A);
     }
+    for (auto&& nsp : nsp_cleanup) {
+        MatNullSpaceDestroy(&nsp);
+    }
+    for (auto&& level : nested_) {
+        KSPDestroy(&level.ksp);
+        MatDestroy(&level.A);
+        VecDestroy(&level.b);
+        VecDestroy(&level.x);
+    }
     KSPDestroy(&ksp_);
 }
 
@@ -77,6 +132,7 @@ void PetscLinearSolver::setup_mg(AbstractDGOperator<DomainDimension>& dgop, PC p
         CHKERRTHROW(KSPSetOperators(smooth, P_->mat(), P_->mat()));
     }
     Mat A_lp1 = P_->mat();
+    MatNullSpace nsp_lp1 = near_null_space_;
     for (int l = nlevels - 2; l >= 0; --l) {
         unsigned to_degree = level_degree[l + 1];
         unsigned from_degree = level_degree[l];
@@ -90,11 +146,175 @@ void PetscLinearSolver::setup_mg(AbstractDGOperator<DomainDimension>& dgop, PC p
         CHKERRTHROW(PCMGGetSmoother(pc, l, &smooth));
         CHKERRTHROW(KSPSetOperators(smooth, A_l, A_l));
         mat_cleanup.push_back(A_l);
+
+        if (nsp_lp1) {
+            nsp_lp1 = restrict_near_null_space(nsp_lp1, I.mat(), dgop.topo().comm());
+            if (nsp_lp1) {
+                CHKERRTHROW(MatSetNearNullSpace(A_l, nsp_lp1));
+                nsp_cleanup.push_back(nsp_lp1);
+            }
+        }
         A_lp1 = A_l;
     }
 }
 
-void PetscLinearSolver::warmup() { warmup_ksp(ksp_); }
+void PetscLinearSolver::setup_near_null_space(AbstractDGOperator<DomainDimension>& dgop) {
+    auto modes = dgop.near_null_space();
+    if (modes.empty()) {
+        return;
+    }
+
+    auto const& topo = dgop.topo();
+    auto v = PetscVector(dgop.block_size(), topo.numLocalElements(), topo.comm());
+    std::vector<Vec> vecs;
+    for (auto&& mode : modes) {
+        dgop.project(mode, v);
+        Vec w;
+        CHKERRTHROW(VecDuplicate(v.vec(), &w));
+        CHKERRTHROW(VecCopy(v.vec(), w));
+        vecs.push_back(w);
+    }
+    near_null_space_ = make_near_null_space(vecs, topo.comm());
+    if (!near_null_space_) {
+        return;
+    }
+    nsp_cleanup.push_back(near_null_space_);
+
+    CHKERRTHROW(MatSetNearNullSpace(P_->mat(), near_null_space_));
+    if (A_) {
+        CHKERRTHROW(MatSetNearNullSpace(A_->mat(), near_null_space_));
+    }
+}
+
+MatNullSpace PetscLinearSolver::restrict_near_null_space(MatNullSpace fine, Mat I,
+                                                         MPI_Comm comm) {
+    PetscBool has_const;
+    PetscInt n;
+    Vec const* fine_vecs;
+    CHKERRTHROW(MatNullSpaceGetVecs(fine, &has_const, &n, &fine_vecs));
+
+    // Least-squares restriction min ||I x - v||, which is exact if v lies in the range of I,
+    // e.g. rigid body modes on affine elements for degree >= 1. I^T I is block-diagonal.
+    Mat ItI;
+    CHKERRTHROW(MatTransposeMatMult(I, I, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &ItI));
+    KSP ksp;
+    PC pc;
+    CHKERRTHROW(KSPCreate(comm, &ksp));
+    CHKERRTHROW(KSPSetType(ksp, KSPCG));
+    CHKERRTHROW(KSPGetPC(ksp, &pc));
+    CHKERRTHROW(PCSetType(pc, PCJACOBI));
+    CHKERRTHROW(KSPSetOperators(ksp, ItI, ItI));
+    CHKERRTHROW(KSPSetTolerances(ksp, 1.0e-12, PETSC_DEFAULT, PETSC_DEFAULT, 1000));
+
+    Vec rhs;
+    CHKERRTHROW(MatCreateVecs(I, &rhs, nullptr));
+    std::vector<Vec> vecs;
+    for (PetscInt i = 0; i < n; ++i) {
+        Vec x;
+        CHKERRTHROW(VecDuplicate(rhs, &x));
+        CHKERRTHROW(MatMultTranspose(I, fine_vecs[i], rhs));
+        CHKERRTHROW(KSPSolve(ksp, rhs, x));
+        vecs.push_back(x);
+    }
+    CHKERRTHROW(VecDestroy(&rhs));
+    CHKERRTHROW(KSPDestroy(&ksp));
+    CHKERRTHROW(MatDestroy(&ItI));
+
+    return make_near_null_space(vecs, comm);
+}
+
+std::size_t PetscLinearSolver::near_null_space_size() const {
+    if (!near_null_space_) {
+        return 0;
+    }
+    PetscBool has_const;
+    PetscInt n;
+    Vec const* vecs;
+    CHKERRTHROW(MatNullSpaceGetVecs(near_null_space_, &has_const, &n, &vecs));
+    return n;
+}
+
+void PetscLinearSolver::setup_nested(AbstractDGOperator<DomainDimension>& dgop,
+                                     MGConfig const& mg_config, double rtol) {
+    auto i_op = dgop.interpolation_operator();
+    auto level_degree = mg_config.levels(i_op->max_degree());
+    if (level_degree.size() < 2) {
+        return;
+    }
+
+    KSPType type;
+    CHKERRTHROW(KSPGetType(ksp_, &type));
+
+    nested_.resize(level_degree.size() - 1);
+    Mat A_lp1 = P_->mat();
+    for (int l = nested_.size() - 1; l >= 0; --l) {
+        auto& level = nested_[l];
+        unsigned to_degree = level_degree[l + 1];
+        unsigned from_degree = level_degree[l];
+        level.degree = from_degree;
+        level.I = std::make_unique<PetscInterplMatrix>(
+            i_op->block_size(to_degree), i_op->block_size(from_degree), dgop.topo());
+        i_op->assemble(to_degree, from_degree, *level.I);
+
+        CHKERRTHROW(MatPtAP(A_lp1, level.I->mat(), MAT_INITIAL_MATRIX, PETSC_DEFAULT, &level.A));
+        CHKERRTHROW(MatCreateVecs(level.A, &level.x, &level.b));
+
+        CHKERRTHROW(KSPCreate(dgop.topo().comm(), &level.ksp));
+        CHKERRTHROW(KSPSetOptionsPrefix(level.ksp, "nested_"));
+        CHKERRTHROW(KSPSetType(level.ksp, type));
+        CHKERRTHROW(KSPSetOperators(level.ksp, level.A, level.A));
+        CHKERRTHROW(KSPSetTolerances(level.ksp, rtol, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT));
+        CHKERRTHROW(KSPSetInitialGuessNonzero(level.ksp, l > 0 ? PETSC_TRUE : PETSC_FALSE));
+        CHKERRTHROW(KSPSetFromOptions(level.ksp));
+        A_lp1 = level.A;
+    }
+}
+
+void PetscLinearSolver::solve_nested() {
+    nested_its_.clear();
+    if (nested_.empty()) {
+        solve();
+        PetscInt its;
+        CHKERRTHROW(KSPGetIterationNumber(ksp_, &its));
+        nested_its_.push_back(its);
+        return;
+    }
+
+    // Restrict right-hand side to all degrees
+    Vec b_lp1 = b_->vec();
+    for (auto level = nested_.rbegin(); level != nested_.rend(); ++level) {
+        CHKERRTHROW(MatMultTranspose(level->I->mat(), b_lp1, level->b));
+        b_lp1 = level->b;
+    }
+
+    // Solve and prolongate from coarse to fine
+    PetscInt its;
+    for (std::size_t l = 0; l < nested_.size(); ++l) {
+        auto& level = nested_[l];
+        if (l > 0) {
+            CHKERRTHROW(MatMult(nested_[l - 1].I->mat(), nested_[l - 1].x, level.x));
+        }
+        CHKERRTHROW(KSPSolve(level.ksp, level.b, level.x));
+        CHKERRTHROW(KSPGetIterationNumber(level.ksp, &its));
+        nested_its_.push_back(its);
+    }
+    CHKERRTHROW(MatMult(nested_.back().I->mat(), nested_.back().x, x_->vec()));
+
+    PetscBool guess_nonzero;
+    CHKERRTHROW(KSPGetInitialGuessNonzero(ksp_, &guess_nonzero));
+    CHKERRTHROW(KSPSetInitialGuessNonzero(ksp_, PETSC_TRUE));
+    solve();
+    CHKERRTHROW(KSPSetInitialGuessNonzero(ksp_, guess_nonzero));
+    CHKERRTHROW(KSPGetIterationNumber(ksp_, &its));
+    nested_its_.push_back(its);
+}
+
+void PetscLinearSolver::warmup() {
+    warmup_ksp(ksp_);
+    for (auto&& level : nested_) {
+        warmup_ksp(level.ksp);
+    }
+}
 
 void PetscLinearSolver::warmup_ksp(KSP ksp) {
     PC pc;
@@ -25,13 +25,18 @@
 #include <memory>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace tndm {
 
 class PetscLinearSolver {
 public:
+    /**
+     * @param near_null_space Attach the near null space of dgop (e.g. rigid body modes) to the
+     * operator and to every multigrid level, which is used by algebraic coarse solvers like GAMG
+     */
     PetscLinearSolver(AbstractDGOperator<DomainDimension>& dgop, bool matrix_free = false,
-                      MGConfig const& mg_config = MGConfig());
+                      MGConfig const& mg_config = MGConfig(), bool near_null_space = false);
     ~PetscLinearSolver();
 
     inline void update_rhs(AbstractDGOperator<DomainDimension>& dgop) {
@@ -40,6 +45,33 @@ public:
     }
     void warmup();
     inline void solve() { CHKERRTHROW(KSPSolve(ksp_, b_->vec(), x_->vec())); }
+    /**
+     * @brief Sets up nested iteration over the polynomial degrees of mg_config.
+     *
+     * The coarse-degree operators are the Galerkin projections of the assembled operator.
+     * The coarse KSPs use the options prefix "nested_".
+     *
+     * @param rtol Relative tolerance of the coarse-degree solves
+     */
+    void setup_nested(AbstractDGOperator<DomainDimension>& dgop, MGConfig const& mg_config,
+                      double rtol = 1.0e-2);
+    /**
+     * @brief Solves from the coarsest degree upwards; the prolongated solution of each degree
+     * is the initial guess of the next finer degree.
+     *
+     * Falls back to solve() if setup_nested was not called.
+     */
+    void solve_nested();
+    /**
+     * @brief Iteration counts of the last solve_nested, from coarsest to finest degree.
+     */
+    inline auto const& nested_iterations() const { return nested_its_; }
+    inline bool has_nested() const { return !nested_.empty(); }
+    inline bool initial_guess_nonzero() const {
+        PetscBool flg;
+        KSPGetInitialGuessNonzero(ksp_, &flg);
+        return flg;
+    }
     inline bool is_converged() const {
         KSPConvergedReason reason;
         KSPGetConvergedReason(ksp_, &reason);
@@ -48,19 +80,36 @@ public:
 
     inline auto& x() { return *x_; }
     inline auto const& x() const { return *x_; }
+    inline auto& b() { return *b_; }
+    inline auto const& b() const { return *b_; }
 
     inline KSP ksp() { return ksp_; }
+    /**
+     * @brief Number of near null space vectors attached to the operator.
+     */
+    std::size_t near_null_space_size() const;
 
     void dump() const;
 
 private:
     void setup_mg(AbstractDGOperator<DomainDimension>& dgop, PC pc, MGConfig const& mg_config);
+    void setup_near_null_space(AbstractDGOperator<DomainDimension>& dgop);
+    MatNullSpace restrict_near_null_space(MatNullSpace fine, Mat I, MPI_Comm comm);
 
     void warmup_ksp(KSP ksp);
     void warmup_sub_pcs(PC pc);
     void warmup_composite(PC pc);
     void warmup_mg(PC pc);
 
+    struct NestedLevel {
+        unsigned degree;
+        std::unique_ptr<PetscInterplMatrix> I; ///< Interpolation to the next finer degree
+        Mat A = nullptr;
+        KSP ksp = nullptr;
+        Vec b = nullptr;
+        Vec x = nullptr;
+    };
+
     std::unique_ptr<PetscDGShell> A_;
     std::unique_ptr<PetscDGMatrix> P_;
     std::unique_ptr<PetscVector> b_;
@@ -68,6 +117,11 @@ private:
     KSP ksp_ = nullptr;
 
     std::vector<Mat> mat_cleanup;
+    std::vector<MatNullSpace> nsp_cleanup;
+    MatNullSpace near_null_space_ = nullptr;
+
+    std::vector<NestedLevel> nested_;
+    std::vector<PetscInt> nested_its_;
 };
 
 } // namespace tndm
@@ -32,8 +32,16 @@ protected:
 
 template <std::size_t NumStateVecs> class PetscTimeSolver : public PetscTimeSolverBase {
 public:
+    /**
+     * @brief Sets up the time solver and the initial condition.
+     *
+     * @param timeop Time operator
+     * @param state State vectors
+     * @param start_time Time of the initial condition
+     */
     template <typename TimeOp>
-    PetscTimeSolver(TimeOp& timeop, std::array<std::unique_ptr<PetscVector>, NumStateVecs> state)
+    PetscTimeSolver(TimeOp& timeop, std::array<std::unique_ptr<PetscVector>, NumStateVecs> state,
+                    double start_time = 0.0)
         : PetscTimeSolverBase(timeop.comm()), state_(std::move(state)) {
 
         Vec x[NumStateVecs];
@@ -43,8 +51,11 @@ public:
         MPI_Comm comm;
         CHKERRTHROW(VecCreateNest(timeop.comm(), NumStateVecs, nullptr, x, &ts_state_));
 
-        std::apply([&timeop](auto&... x) { timeop.initial_condition((*x)...); }, state_);
+        std::apply(
+            [&timeop, start_time](auto&... x) { timeop.initial_condition(start_time, (*x)...); },
+            state_);
 
+        CHKERRTHROW(TSSetTime(ts_, start_time));
         CHKERRTHROW(TSSetSolution(ts_, ts_state_));
         CHKERRTHROW(TSSetRHSFunction(ts_, nullptr, RHSFunction<TimeOp>, &timeop));
     }
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 
 namespace tndm {
@@ -26,8 +27,11 @@ public:
 
     auto const& coefficient() const { return coefficient_; }
 
-    auto make_local_operator(std::shared_ptr<Curvilinear<DomainDimension>> cl,
-                             DGMethod method) const {
+    auto make_local_operator(std::shared_ptr<Curvilinear<DomainDimension>> cl, DGMethod method,
+                             GeometryMode geometry = GeometryMode::Stored) const {
+        if (geometry != GeometryMode::Stored) {
+            throw std::runtime_error("On-the-fly geometry is only implemented for elasticity");
+        }
         auto poisson = std::make_shared<Poisson>(std::move(cl), coefficient_, method);
         set(*poisson);
         return poisson;
@@ -3,6 +3,8 @@
 
 #include "form/RefElement.h"
 
+#include <algorithm>
+
 namespace tndm {
 
 SeasFDOperator::SeasFDOperator(std::unique_ptr<dg_t> dgop,
@@ -10,14 +12,20 @@ SeasFDOperator::SeasFDOperator(std::unique_ptr<dg_t> dgop,
                                std::unique_ptr<AbstractFrictionOperator> friction)
     : dgop_(std::move(dgop)), adapter_(std::move(adapter)), friction_(std::move(friction)),
       traction_(adapter_->traction_block_size(), adapter_->num_local_elements(), adapter_->comm()),
-      disp_scatter_(dgop_->topo().elementScatterPlan()),
-      disp_ghost_(disp_scatter_.recv_prototype<double>(dgop_->block_size(), ALIGNMENT)),
-      state_scatter_(adapter_->fault_map().scatter_plan()),
-      state_ghost_(state_scatter_.recv_prototype<double>(friction_->block_size(), ALIGNMENT)) {
+      disp_ghost_(ghost_scatter_.recv_prototype(
+          ghost_scatter_.add_field(dgop_->topo().elementScatterPlan(), dgop_->block_size()),
+          ALIGNMENT)),
+      state_ghost_(ghost_scatter_.recv_prototype(
+          ghost_scatter_.add_field(adapter_->fault_map().scatter_plan(), friction_->block_size()),
+          ALIGNMENT)) {
 
     r_dv = profile_.add("dv");
     r_du = profile_.add("du");
     r_ds = profile_.add("ds");
+    // Nested in du and ds, respectively
+    r_apply = profile_.add("DG apply");
+    r_scatter = profile_.add("ghost scatter");
+    r_friction = profile_.add("friction");
 
     flops_du = dgop_->flops_apply();
 }
@@ -29,10 +37,8 @@ double SeasFDOperator::cfl_time_step() const {
     return global_dt;
 }
 
-void SeasFDOperator::initial_condition(BlockVector& v, BlockVector& u, BlockVector& s) {
-    state_scatter_.begin_scatter(s, state_ghost_);
-    disp_scatter_.begin_scatter(u, disp_ghost_);
-
+void SeasFDOperator::initial_condition(double time, BlockVector& v, BlockVector& u,
+                                       BlockVector& s) {
     if (u_ini_) {
         dgop_->project((*u_ini_)(), u);
     } else {
@@ -45,17 +51,16 @@ void SeasFDOperator::initial_condition(BlockVector& v, BlockVector& u, BlockVect
     }
 
     friction_->pre_init(s);
-    state_scatter_.wait_scatter();
-    disp_scatter_.wait_scatter();
+    ghost_scatter_.begin_scatter({{&u, &disp_ghost_}, {&s, &state_ghost_}});
+    ghost_scatter_.wait_scatter();
     update_traction(u, s);
-    friction_->init(0.0, traction_, s);
+    friction_->init(time, traction_, s);
 }
 
 void SeasFDOperator::rhs(double time, BlockVector const& v, BlockVector const& u,
                          BlockVector const& s, BlockVector& dv, BlockVector& du, BlockVector& ds) {
     profile_.begin(r_dv);
-    state_scatter_.begin_scatter(s, state_ghost_);
-    disp_scatter_.begin_scatter(u, disp_ghost_);
+    ghost_scatter_.begin_scatter({{&u, &disp_ghost_}, {&s, &state_ghost_}});
 
     auto v_handle = v.begin_access_readonly();
     auto du_handle = du.begin_access();
@@ -69,25 +74,114 @@ void SeasFDOperator::rhs(double time, BlockVector const& v, BlockVector const& u
     profile_.end(r_dv, flops_dv);
 
     profile_.begin(r_du);
-    state_scatter_.wait_scatter();
     auto state_view = make_state_view(s);
     dgop_->set_slip(adapter_->slip_bc(state_view));
     if (fun_boundary_) {
         dgop_->set_dirichlet((*fun_boundary_)(time));
     }
 
-    dgop_->wave_rhs(u, dv);
+    // Interior elements only touch locally owned faults, hence the ghost exchange overlaps with
+    // their computation
+    profile_.begin(r_apply);
+    dgop_->wave_rhs(u, dv, [this] {
+        profile_.begin(r_scatter);
+        ghost_scatter_.wait_scatter();
+        profile_.end(r_scatter);
+    });
+    dgop_->wave_damping(v, dv);
+    profile_.end(r_apply, flops_du);
 
     dgop_->set_slip(invalid_slip_bc());
     profile_.end(r_du, flops_du);
 
     profile_.begin(r_ds);
-    disp_scatter_.wait_scatter();
     update_traction(u, s);
+    profile_.begin(r_friction);
     friction_->rhs(time, traction_, s, ds);
+    profile_.end(r_friction);
     profile_.end(r_ds, flops_ds);
 }
 
+void SeasFDOperator::acceleration(double time, BlockVector const& v, BlockVector const& u,
+                                  BlockVector const& s, BlockVector& a) {
+    ghost_scatter_.begin_scatter({{&u, &disp_ghost_}, {&s, &state_ghost_}});
+    ghost_scatter_.wait_scatter();
+    auto state_view = make_state_view(s);
+    dgop_->set_slip(adapter_->slip_bc(state_view));
+    if (fun_boundary_) {
+        dgop_->set_dirichlet((*fun_boundary_)(time));
+    }
+
+    dgop_->wave_rhs(u, a);
+    dgop_->wave_damping(v, a);
+
+    dgop_->set_slip(invalid_slip_bc());
+}
+
+void SeasFDOperator::fault_rhs(double time, BlockVector const& u, BlockVector const& s,
+                               BlockVector& ds) {
+    ghost_scatter_.begin_scatter({{&u, &disp_ghost_}, {&s, &state_ghost_}});
+    ghost_scatter_.wait_scatter();
+    update_traction(u, s);
+    friction_->rhs(time, traction_, s, ds);
+}
+
+void SeasFDOperator::setup_implicit(double mass_shift, double damping_shift,
+                                    MGConfig const& mg_config, bool near_null_space) {
+    // The matrix-free operator of every cached solver applies the current shift of dgop_
+    dgop_->set_wave_shift(mass_shift, damping_shift);
+    mass_shift_ = mass_shift;
+
+    Vec previous_x =
+        implicit_solvers_.empty() ? nullptr : implicit_solvers_.back().solver->x().vec();
+    auto it = std::find_if(implicit_solvers_.begin(), implicit_solvers_.end(),
+                           [&](ImplicitSolver const& s) {
+                               return s.mass_shift == mass_shift &&
+                                      s.damping_shift == damping_shift;
+                           });
+    if (it != implicit_solvers_.end()) {
+        std::rotate(it, it + 1, implicit_solvers_.end());
+    } else {
+        if (implicit_solvers_.size() >= MaxImplicitSolvers) {
+            implicit_solvers_.erase(implicit_solvers_.begin());
+        }
+        // The right-hand side computed by the solver is not used but requires a slip condition
+        dgop_->set_slip(zero_slip_bc());
+        auto solver = std::make_unique<PetscLinearSolver>(*dgop_, true, mg_config, near_null_space);
+        dgop_->set_slip(invalid_slip_bc());
+        CHKERRTHROW(KSPSetInitialGuessNonzero(solver->ksp(), PETSC_TRUE));
+        implicit_solvers_.push_back({mass_shift, damping_shift, std::move(solver)});
+    }
+    // The previous solution is the initial guess
+    Vec x = implicit_solvers_.back().solver->x().vec();
+    if (previous_x && previous_x != x) {
+        CHKERRTHROW(VecCopy(previous_x, x));
+    }
+}
+
+bool SeasFDOperator::solve_implicit(BlockVector const& r, BlockVector& x) {
+    if (implicit_solvers_.empty()) {
+        throw std::logic_error("Implicit solver is not set up");
+    }
+    auto& implicit_solver = *implicit_solvers_.back().solver;
+    auto& b = implicit_solver.b();
+    dgop_->wave_mass(r, b);
+    CHKERRTHROW(VecScale(b.vec(), mass_shift_));
+    implicit_solver.solve();
+
+    auto& y = implicit_solver.x();
+    auto y_handle = y.begin_access_readonly();
+    auto x_handle = x.begin_access();
+    for (std::size_t elNo = 0, num = dgop_->num_local_elements(); elNo < num; ++elNo) {
+        auto y_block = y_handle.subtensor(slice{}, elNo);
+        auto x_block = x_handle.subtensor(slice{}, elNo);
+        x_block.copy_values(y_block);
+    }
+    x.end_access(x_handle);
+    y.end_access_readonly(y_handle);
+    return implicit_solver.is_converged();
+}
+
 void SeasFDOperator::update_traction(BlockVector const& u, BlockVector const& s) {
     auto disp_view = LocalGhostCompositeView(u, disp_ghost_);
     auto state_view = make_state_view(s);
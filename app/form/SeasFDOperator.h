@@ -16,7 +16,7 @@
 #include "interface/BlockVector.h"
 #include "parallel/LocalGhostCompositeView.h"
 #include "parallel/Profile.h"
-#include "parallel/Scatter.h"
+#include "parallel/MultiScatter.h"
 #include "parallel/SparseBlockVector.h"
 #include "tensor/Tensor.h"
 #include "util/LinearAllocator.h"
@@ -29,6 +29,7 @@
 #include <petscdm.h>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace tndm {
 
@@ -66,9 +67,40 @@ public:
     inline AbstractFrictionOperator const& friction() const { return *friction_; }
 
     double cfl_time_step() const;
-    void initial_condition(BlockVector& v, BlockVector& u, BlockVector& s);
+    void initial_condition(double time, BlockVector& v, BlockVector& u, BlockVector& s);
     void rhs(double time, BlockVector const& v, BlockVector const& u, BlockVector const& s,
              BlockVector& dv, BlockVector& du, BlockVector& ds);
+    /**
+     * @brief Computes the acceleration a = M^{-1} (b(t, s) - A u - C v), i.e. dv of rhs
+     */
+    void acceleration(double time, BlockVector const& v, BlockVector const& u,
+                      BlockVector const& s, BlockVector& a);
+    /**
+     * @brief Computes the rate of the fault state, i.e. ds of rhs
+     */
+    void fault_rhs(double time, BlockVector const& u, BlockVector const& s, BlockVector& ds);
+
+    /**
+     * @brief Sets up the linear solver of implicit time integrators.
+     *
+     * The matrix-free operator is A + mass_shift M + damping_shift C, where M and C are
+     * mass and damping matrix of the wave equation; A + mass_shift M is assembled as
+     * preconditioner. The solver may be set up again with different shifts; the solvers of the
+     * MaxImplicitSolvers most recently used shifts are kept, such that returning to a previous
+     * time step (e.g. after a shortened last step) does not assemble the preconditioner again.
+     *
+     * @param near_null_space Attach rigid body modes to the preconditioner (see PetscLinearSolver)
+     */
+    void setup_implicit(double mass_shift, double damping_shift, MGConfig const& mg_config,
+                        bool near_null_space = false);
+    /**
+     * @brief Solves (A + mass_shift M + damping_shift C) x = mass_shift M r
+     *
+     * The solution of the previous solve is used as initial guess.
+     *
+     * @return True if the linear solver converged
+     */
+    bool solve_implicit(BlockVector const& r, BlockVector& x);
 
     auto domain_function(BlockVector const& x, std::vector<std::size_t> const& subset) const {
         return dgop_->solution(x, subset);
@@ -92,6 +124,10 @@ private:
         };
     }
 
+    inline auto zero_slip_bc() {
+        return [](std::size_t, Matrix<double>& f, bool) { f.set_zero(); };
+    }
+
     inline auto make_state_view(BlockVector const& state) -> LocalGhostCompositeView {
         return LocalGhostCompositeView(state, state_ghost_);
     }
@@ -103,18 +139,27 @@ private:
     std::unique_ptr<AbstractFrictionOperator> friction_;
 
     PetscVector traction_;
-    Scatter disp_scatter_;
+    // Displacement and state ghosts are exchanged in a single round
+    MultiScatter ghost_scatter_;
     SparseBlockVector<double> disp_ghost_;
-
-    Scatter state_scatter_;
     SparseBlockVector<double> state_ghost_;
 
     std::unique_ptr<AbstractFacetFunctionalFactory> fun_boundary_ = nullptr;
     std::unique_ptr<AbstractVolumeFunctionalFactory> u_ini_ = nullptr;
     std::unique_ptr<AbstractVolumeFunctionalFactory> v_ini_ = nullptr;
 
+    struct ImplicitSolver {
+        double mass_shift;
+        double damping_shift;
+        std::unique_ptr<PetscLinearSolver> solver;
+    };
+    constexpr static std::size_t MaxImplicitSolvers = 4;
+    // Most recently used solver last
+    std::vector<ImplicitSolver> implicit_solvers_;
+    double mass_shift_ = 0.0;
+
     Profile profile_;
-    std::size_t r_dv, r_du, r_ds;
+    std::size_t r_dv, r_du, r_ds, r_apply, r_scatter, r_friction;
     uint64_t flops_dv = 0, flops_du = 0, flops_ds = 0;
 };
 
@@ -5,16 +5,43 @@
 #include "parallel/LocalGhostCompositeView.h"
 #include "util/Stopwatch.h"
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
 namespace tndm {
 
 SeasQDDiscreteGreenOperator::SeasQDDiscreteGreenOperator(
     std::unique_ptr<typename base::dg_t> dgop, std::unique_ptr<AbstractAdapterOperator> adapter,
-    std::unique_ptr<AbstractFrictionOperator> friction, bool matrix_free, MGConfig const& mg_config)
-    : base(std::move(dgop), std::move(adapter), std::move(friction), matrix_free, mg_config) {
-    compute_discrete_greens_function();
+    std::unique_ptr<AbstractFrictionOperator> friction, bool matrix_free, MGConfig const& mg_config,
+    bool nested_iteration, bool near_null_space, std::optional<OutOfCoreConfig> const& out_of_core,
+    std::optional<IncrementalGreenConfig> const& incremental)
+    : base(std::move(dgop), std::move(adapter), std::move(friction), matrix_free, mg_config,
+           nested_iteration, near_null_space),
+      incremental_(incremental) {
+    r_green_ = profile_.add(out_of_core ? "green (storage)" : "green (memory)");
+    compute_discrete_greens_function(out_of_core);
+
+    if (incremental_) {
+        if (!S_to_all_) {
+            CHKERRTHROW(VecScatterCreateToAll(S_->vec(), &S_to_all_, &S_all_));
+        }
+        PetscInt N;
+        CHKERRTHROW(VecGetSize(S_->vec(), &N));
+        S_ref_.resize(N);
+        active_.reserve(N);
+        dS_.reserve(N);
+        t_green_ = std::make_unique<PetscVector>(*t_boundary_);
+    }
 }
 
-SeasQDDiscreteGreenOperator::~SeasQDDiscreteGreenOperator() { MatDestroy(&G_); }
+SeasQDDiscreteGreenOperator::~SeasQDDiscreteGreenOperator() {
+    MatDestroy(&G_);
+    VecScatterDestroy(&S_to_all_);
+    VecDestroy(&S_all_);
+}
 
 void SeasQDDiscreteGreenOperator::set_boundary(
     std::unique_ptr<AbstractFacetFunctionalFactory> fun) {
@@ -52,11 +79,126 @@ void SeasQDDiscreteGreenOperator::update_traction(double time, BlockVector const
     S_->begin_assembly();
     S_->end_assembly();
 
-    CHKERRTHROW(MatMult(G_, S_->vec(), base::traction_.vec()));
+    mult_greens_function();
     CHKERRTHROW(VecAXPY(base::traction_.vec(), time, t_boundary_->vec()));
 }
 
-void SeasQDDiscreteGreenOperator::compute_discrete_greens_function() {
+void SeasQDDiscreteGreenOperator::mult_greens_function() {
+    profile_.begin(r_green_);
+    if (S_to_all_) {
+        CHKERRTHROW(VecScatterBegin(S_to_all_, S_->vec(), S_all_, INSERT_VALUES, SCATTER_FORWARD));
+        CHKERRTHROW(VecScatterEnd(S_to_all_, S_->vec(), S_all_, INSERT_VALUES, SCATTER_FORWARD));
+    }
+    // Out-of-core we count bytes read from storage, in-memory the bytes of G touched
+    uint64_t bytes_read = G_file_ ? G_file_->bytes_read() : 0;
+    uint64_t flops = flops_green_, bytes = bytes_green_;
+    if (incremental_) {
+        std::size_t num_applied = mult_greens_function_incremental();
+        CHKERRTHROW(VecCopy(t_green_->vec(), base::traction_.vec()));
+        flops = num_applied * flops_green_column_;
+        bytes = num_applied * bytes_green_column_;
+    } else {
+        mult_greens_function_full(base::traction_.vec());
+    }
+    if (G_file_) {
+        bytes = G_file_->bytes_read() - bytes_read;
+    }
+    profile_.end(r_green_, flops, bytes);
+}
+
+void SeasQDDiscreteGreenOperator::mult_greens_function_full(Vec t) {
+    if (G_file_) {
+        PetscScalar const* s;
+        PetscScalar* t_array;
+        CHKERRTHROW(VecGetArrayRead(S_all_, &s));
+        CHKERRTHROW(VecGetArray(t, &t_array));
+        G_file_->mult(s, t_array);
+        CHKERRTHROW(VecRestoreArray(t, &t_array));
+        CHKERRTHROW(VecRestoreArrayRead(S_all_, &s));
+    } else {
+        CHKERRTHROW(MatMult(G_, S_->vec(), t));
+    }
+}
+
+std::size_t SeasQDDiscreteGreenOperator::mult_greens_function_incremental() {
+    PetscInt N;
+    PetscScalar const* s;
+    CHKERRTHROW(VecGetSize(S_all_, &N));
+    CHKERRTHROW(VecGetArrayRead(S_all_, &s));
+
+    // Every rank holds the full slip vector, hence all ranks take the same decision
+    bool full = refresh_required_ || evaluations_since_refresh_ >= incremental_->refresh_interval;
+    active_.clear();
+    dS_.clear();
+    if (!full) {
+        for (PetscInt j = 0; j < N; ++j) {
+            double ds = s[j] - S_ref_[j];
+            if (std::abs(ds) > incremental_->slip_tolerance) {
+                active_.push_back(j);
+                dS_.push_back(ds);
+            }
+        }
+        full = active_.size() > incremental_->max_active_fraction * N;
+    }
+
+    std::size_t num_applied;
+    if (full) {
+        mult_greens_function_full(t_green_->vec());
+        std::copy(s, s + N, S_ref_.begin());
+        refresh_required_ = false;
+        evaluations_since_refresh_ = 0;
+        ++num_full_;
+        num_applied = N;
+    } else {
+        if (!active_.empty()) {
+            PetscScalar* t;
+            CHKERRTHROW(VecGetArray(t_green_->vec(), &t));
+            if (G_file_) {
+                G_file_->mult_add_columns(active_.size(), active_.data(), dS_.data(), t);
+            } else {
+                PetscInt m, lda;
+                PetscScalar const* g;
+                CHKERRTHROW(VecGetLocalSize(t_green_->vec(), &m));
+                CHKERRTHROW(MatDenseGetLDA(G_, &lda));
+                CHKERRTHROW(MatDenseGetArrayRead(G_, &g));
+                for (std::size_t k = 0; k < active_.size(); ++k) {
+                    PetscScalar const* g_j = g + active_[k] * lda;
+                    for (PetscInt i = 0; i < m; ++i) {
+                        t[i] += g_j[i] * dS_[k];
+                    }
+                }
+                CHKERRTHROW(MatDenseRestoreArrayRead(G_, &g));
+            }
+            CHKERRTHROW(VecRestoreArray(t_green_->vec(), &t));
+        }
+        for (auto j : active_) {
+            S_ref_[j] = s[j];
+        }
+        ++evaluations_since_refresh_;
+        ++num_incremental_;
+        num_active_ += active_.size();
+        num_applied = active_.size();
+    }
+
+    CHKERRTHROW(VecRestoreArrayRead(S_all_, &s));
+    return num_applied;
+}
+
+void SeasQDDiscreteGreenOperator::print_incremental_statistics(std::ostream& out) const {
+    int rank;
+    MPI_Comm_rank(base::comm(), &rank);
+    if (!incremental_ || rank != 0) {
+        return;
+    }
+    double mean_active =
+        num_incremental_ > 0 ? static_cast<double>(num_active_) / num_incremental_ : 0.0;
+    out << "Green's function products: " << num_full_ << " full, " << num_incremental_
+        << " incremental (" << mean_active << " of " << S_ref_.size()
+        << " columns applied on average)" << std::endl;
+}
+
+void SeasQDDiscreteGreenOperator::compute_discrete_greens_function(
+    std::optional<OutOfCoreConfig> const& out_of_core) {
     auto slip_block_size = base::friction().slip_block_size();
 
     PetscInt num_local_elements = base::adapter().num_local_elements();
@@ -77,9 +219,6 @@ void SeasQDDiscreteGreenOperator::compute_discrete_greens_function() {
     MPI_Scan(&n, &nb_offset, 1, MPIU_INT, MPI_SUM, comm);
     nb_offset -= n;
 
-    CHKERRTHROW(MatCreateDense(comm, m, n, PETSC_DECIDE, PETSC_DECIDE, nullptr, &G_));
-    CHKERRTHROW(MatSetBlockSizes(G_, m_bs, n_bs));
-
     S_ = std::make_unique<PetscVector>(slip_block_size, num_local_elements, comm);
     t_boundary_ = std::make_unique<PetscVector>(m_bs, num_local_elements, comm);
 
@@ -89,6 +228,26 @@ void SeasQDDiscreteGreenOperator::compute_discrete_greens_function() {
     PetscInt N;
     CHKERRTHROW(VecGetSize(S_->vec(), &N));
 
+    if (out_of_core) {
+        auto file_name = std::filesystem::path(out_of_core->scratch_dir) /
+                         ("tandem_green_" + std::to_string(getpid()) + "_" +
+                          std::to_string(rank) + ".bin");
+        G_file_ = std::make_unique<TiledMatrixFile>(file_name.string(), m, N,
+                                                    out_of_core->tile_columns);
+        CHKERRTHROW(VecScatterCreateToAll(S_->vec(), &S_to_all_, &S_all_));
+        if (rank == 0) {
+            std::cout << "Storing Green's function out-of-core in " << G_file_->num_tiles()
+                      << " tiles per rank" << std::endl;
+        }
+    } else {
+        CHKERRTHROW(MatCreateDense(comm, m, n, PETSC_DECIDE, PETSC_DECIDE, nullptr, &G_));
+        CHKERRTHROW(MatSetBlockSizes(G_, m_bs, n_bs));
+    }
+    flops_green_column_ = 2ull * m;
+    bytes_green_column_ = sizeof(PetscScalar) * m;
+    flops_green_ = flops_green_column_ * N;
+    bytes_green_ = bytes_green_column_ * N;
+
     Stopwatch sw;
     double solve_time = 0.0;
     for (PetscInt i = 0; i < N; ++i) {
@@ -113,12 +272,16 @@ void SeasQDDiscreteGreenOperator::compute_discrete_greens_function() {
         base::update_traction(S_view);
 
         auto traction_handle = base::traction_.begin_access_readonly();
-        for (std::size_t faultNo = 0; faultNo < num_local_elements; ++faultNo) {
-            PetscInt g_m = mb_offset + faultNo;
-            PetscInt g_n = i;
-            auto traction_block = traction_handle.subtensor(slice{}, faultNo);
-            CHKERRTHROW(
-                MatSetValuesBlocked(G_, 1, &g_m, 1, &g_n, traction_block.data(), INSERT_VALUES));
+        if (G_file_) {
+            G_file_->write_column(i, traction_handle.data());
+        } else {
+            for (std::size_t faultNo = 0; faultNo < num_local_elements; ++faultNo) {
+                PetscInt g_m = mb_offset + faultNo;
+                PetscInt g_n = i;
+                auto traction_block = traction_handle.subtensor(slice{}, faultNo);
+                CHKERRTHROW(MatSetValuesBlocked(G_, 1, &g_m, 1, &g_n, traction_block.data(),
+                                                INSERT_VALUES));
+            }
         }
         base::traction_.end_access_readonly(traction_handle);
         solve_time += sw.stop();
@@ -139,8 +302,10 @@ void SeasQDDiscreteGreenOperator::compute_discrete_greens_function() {
         }
     }
 
-    CHKERRTHROW(MatAssemblyBegin(G_, MAT_FINAL_ASSEMBLY));
-    CHKERRTHROW(MatAssemblyEnd(G_, MAT_FINAL_ASSEMBLY));
+    if (G_) {
+        CHKERRTHROW(MatAssemblyBegin(G_, MAT_FINAL_ASSEMBLY));
+        CHKERRTHROW(MatAssemblyEnd(G_, MAT_FINAL_ASSEMBLY));
+    }
 }
 
 void SeasQDDiscreteGreenOperator::compute_boundary_traction() {
@@ -160,7 +325,11 @@ void SeasQDDiscreteGreenOperator::compute_boundary_traction() {
     scatter.wait_scatter();
 
     auto S_view = LocalGhostCompositeView(*S_, ghost);
-    base::solve(1.0, S_view);
+    if (base::boundary_linear()) {
+        base::set_displacement_to_boundary_response();
+    } else {
+        base::solve(1.0, S_view);
+    }
     base::update_traction(S_view);
 
     CHKERRTHROW(VecCopy(base::traction_.vec(), t_boundary_->vec()));
@@ -1,22 +1,40 @@
 #ifndef SEASQDDISCRETEGREENOPERATOR_20210907_H
 #define SEASQDDISCRETEGREENOPERATOR_20210907_H
 
+#include "common/IncrementalGreenConfig.h"
+#include "common/OutOfCoreConfig.h"
 #include "common/PetscVector.h"
 #include "form/AbstractAdapterOperator.h"
 #include "form/AbstractFrictionOperator.h"
 #include "form/FacetFunctionalFactory.h"
 #include "form/SeasQDOperator.h"
+#include "io/TiledMatrixFile.h"
+#include "parallel/Profile.h"
 
 #include <mpi.h>
 #include <petscmat.h>
 #include <petscvec.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 namespace tndm {
 
+/**
+ * @brief Quasi-dynamic SEAS operator with precomputed discrete Green's function.
+ *
+ * With incremental updates the traction due to slip is kept between RHS evaluations.
+ * Every slip component j has a reference value S_ref_j, which is the slip the current traction
+ * is based on. Only the columns of the Green's function for which |S_j - S_ref_j| exceeds the
+ * slip tolerance are applied to the difference, hence the traction error is bounded by the
+ * tolerance times the row sums of |G|. The traction is recomputed from scratch periodically or
+ * when too many components changed.
+ */
 class SeasQDDiscreteGreenOperator : public SeasQDOperator {
 public:
     using base = SeasQDOperator;
@@ -24,39 +42,69 @@ public:
     SeasQDDiscreteGreenOperator(std::unique_ptr<typename base::dg_t> dgop,
                                 std::unique_ptr<AbstractAdapterOperator> adapter,
                                 std::unique_ptr<AbstractFrictionOperator> friction,
-                                bool matrix_free = false, MGConfig const& mg_config = MGConfig());
+                                bool matrix_free = false, MGConfig const& mg_config = MGConfig(),
+                                bool nested_iteration = false, bool near_null_space = false,
+                                std::optional<OutOfCoreConfig> const& out_of_core = std::nullopt,
+                                std::optional<IncrementalGreenConfig> const& incremental =
+                                    std::nullopt);
     ~SeasQDDiscreteGreenOperator();
 
     void set_boundary(std::unique_ptr<AbstractFacetFunctionalFactory> fun) override;
 
-    inline void initial_condition(BlockVector& state) {
+    inline void initial_condition(double time, BlockVector& state) {
         base::friction().pre_init(state);
 
-        update_traction(0.0, state);
+        update_traction(time, state);
 
-        base::friction().init(0.0, base::traction_, state);
+        base::friction().init(time, base::traction_, state);
     }
 
     inline void rhs(double time, BlockVector const& state, BlockVector& result) {
         update_traction(time, state);
 
-        base::friction().rhs(time, base::traction_, state, result);
+        base::friction_rhs(time, state, result);
     }
 
     void update_internal_state(double time, BlockVector const& state,
                                bool state_changed_since_last_rhs, bool require_traction,
                                bool require_displacement) override;
 
+    /**
+     * @brief Prints number of full and incremental products and mean number of applied columns
+     *
+     * Statistics are identical on all ranks and printed on rank 0.
+     */
+    void print_incremental_statistics(std::ostream& out) const;
+
 protected:
     void update_traction(double time, BlockVector const& state);
 
 private:
-    void compute_discrete_greens_function();
+    void compute_discrete_greens_function(std::optional<OutOfCoreConfig> const& out_of_core);
     void compute_boundary_traction();
+    void mult_greens_function();
+    void mult_greens_function_full(Vec t);
+    std::size_t mult_greens_function_incremental();
 
     Mat G_ = nullptr;
+    std::unique_ptr<TiledMatrixFile> G_file_ = nullptr;
+    VecScatter S_to_all_ = nullptr;
+    Vec S_all_ = nullptr;
     std::unique_ptr<PetscVector> S_;
     std::unique_ptr<PetscVector> t_boundary_;
+
+    std::size_t r_green_;
+    uint64_t flops_green_ = 0, bytes_green_ = 0;
+    uint64_t flops_green_column_ = 0, bytes_green_column_ = 0;
+
+    std::optional<IncrementalGreenConfig> incremental_;
+    std::unique_ptr<PetscVector> t_green_;
+    std::vector<double> S_ref_;
+    std::vector<std::size_t> active_;
+    std::vector<double> dS_;
+    bool refresh_required_ = true;
+    std::size_t evaluations_since_refresh_ = 0;
+    std::size_t num_full_ = 0, num_incremental_ = 0, num_active_ = 0;
 };
 
 } // namespace tndm
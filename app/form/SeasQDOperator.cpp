@@ -1,34 +1,49 @@
 #include "SeasQDOperator.h"
 
+#include "common/PetscUtil.h"
 #include "form/RefElement.h"
 
+#include <petscksp.h>
+#include <petscvec.h>
+
+#include <iostream>
+
 namespace tndm {
 
 SeasQDOperator::SeasQDOperator(std::unique_ptr<dg_t> dgop,
                                std::unique_ptr<AbstractAdapterOperator> adapter,
                                std::unique_ptr<AbstractFrictionOperator> friction, bool matrix_free,
-                               MGConfig const& mg_config)
-    : dgop_(std::move(dgop)), linear_solver_(*dgop_, matrix_free, mg_config),
+                               MGConfig const& mg_config, bool nested_iteration,
+                               bool near_null_space)
+    : dgop_(std::move(dgop)), linear_solver_(*dgop_, matrix_free, mg_config, near_null_space),
       adapter_(std::move(adapter)), friction_(std::move(friction)),
       disp_scatter_(dgop_->topo().elementScatterPlan()),
       disp_ghost_(disp_scatter_.recv_prototype<double>(dgop_->block_size(), ALIGNMENT)),
       state_scatter_(adapter_->fault_map().scatter_plan()),
       state_ghost_(state_scatter_.recv_prototype<double>(friction_->block_size(), ALIGNMENT)),
       traction_(adapter_->traction_block_size(), adapter_->num_local_elements(), adapter_->comm()) {
+    if (nested_iteration) {
+        linear_solver_.setup_nested(*dgop_, mg_config);
+    }
+
+    r_solve_ = profile_.add("solve");
+    r_scatter_ = profile_.add("ghost scatter");
+    r_friction_ = profile_.add("friction");
 }
 
 void SeasQDOperator::set_boundary(std::unique_ptr<AbstractFacetFunctionalFactory> fun) {
     fun_boundary_ = std::move(fun);
+    u_boundary_ = nullptr;
 }
 
-void SeasQDOperator::initial_condition(BlockVector& state) {
+void SeasQDOperator::initial_condition(double time, BlockVector& state) {
     friction_->pre_init(state);
 
     update_ghost_state(state);
-    solve(0.0, make_state_view(state));
+    solve(time, make_state_view(state));
     update_traction(make_state_view(state));
 
-    friction_->init(0.0, traction_, state);
+    friction_->init(time, traction_, state);
 }
 
 void SeasQDOperator::rhs(double time, BlockVector const& state, BlockVector& result) {
@@ -36,7 +51,7 @@ void SeasQDOperator::rhs(double time, BlockVector const& state, BlockVector& res
     solve(time, make_state_view(state));
     update_traction(make_state_view(state));
 
-    friction_->rhs(time, traction_, state, result);
+    friction_rhs(time, state, result);
 }
 
 void SeasQDOperator::update_internal_state(double time, BlockVector const& state,
@@ -55,13 +70,85 @@ void SeasQDOperator::update_internal_state(double time, BlockVector const& state
 }
 
 void SeasQDOperator::solve(double time, BlockView const& state_view) {
-    dgop_->set_slip(adapter_->slip_bc(state_view));
-    if (fun_boundary_) {
+    profile_.begin(r_solve_);
+    bool superpose = fun_boundary_ && boundary_linear_;
+    if (superpose) {
+        if (!u_boundary_) {
+            compute_boundary_response();
+        }
+        // Start from the slip-driven part of the previous solution
+        CHKERRTHROW(VecAXPY(linear_solver_.x().vec(), -boundary_time_, u_boundary_->vec()));
+    } else if (fun_boundary_) {
         dgop_->set_dirichlet((*fun_boundary_)(time));
     }
+    dgop_->set_slip(adapter_->slip_bc(state_view));
+    linear_solver_.update_rhs(*dgop_);
+    solve_linear_system();
+    dgop_->set_slip(invalid_slip_bc());
+    if (superpose) {
+        CHKERRTHROW(VecAXPY(linear_solver_.x().vec(), time, u_boundary_->vec()));
+        boundary_time_ = time;
+    }
+    profile_.end(r_solve_);
+
+    profile_.begin(r_scatter_);
+    disp_scatter_.begin_scatter(linear_solver_.x(), disp_ghost_);
+    disp_scatter_.wait_scatter();
+    profile_.end(r_scatter_);
+}
+
+void SeasQDOperator::solve_linear_system() {
+    // Nested iteration pays off whenever the solver would otherwise start from zero
+    bool nested = linear_solver_.has_nested() &&
+                  (first_solve_ || !linear_solver_.initial_guess_nonzero());
+    if (!nested) {
+        linear_solver_.solve();
+        return;
+    }
+
+    PetscInt zero_guess_its = 0;
+    if (first_solve_) {
+        // Solve once from zero such that the saving of nested iteration is reported
+        linear_solver_.x().set_zero();
+        linear_solver_.solve();
+        CHKERRTHROW(KSPGetIterationNumber(linear_solver_.ksp(), &zero_guess_its));
+    }
+    linear_solver_.solve_nested();
+    if (first_solve_) {
+        int rank;
+        MPI_Comm_rank(comm(), &rank);
+        if (rank == 0) {
+            std::cout << "Nested iterations of first solve (coarse to fine):";
+            for (auto its : linear_solver_.nested_iterations()) {
+                std::cout << " " << its;
+            }
+            std::cout << " (zero guess: " << zero_guess_its << ")" << std::endl;
+        }
+    }
+    first_solve_ = false;
+}
+
+void SeasQDOperator::compute_boundary_response() {
+    dgop_->set_slip([](std::size_t, Matrix<double>& f, bool) { f.set_zero(); });
+    dgop_->set_dirichlet((*fun_boundary_)(1.0));
+    linear_solver_.x().set_zero();
     linear_solver_.update_rhs(*dgop_);
+    // Not solve_linear_system: the first solve of the time integration is reported there
     linear_solver_.solve();
+    u_boundary_ = std::make_unique<PetscVector>(linear_solver_.x());
+    CHKERRTHROW(VecCopy(linear_solver_.x().vec(), u_boundary_->vec()));
+    boundary_time_ = 1.0;
+
+    dgop_->set_dirichlet([](std::size_t, Matrix<double>& f, bool) { f.set_zero(); });
     dgop_->set_slip(invalid_slip_bc());
+}
+
+void SeasQDOperator::set_displacement_to_boundary_response() {
+    if (!u_boundary_) {
+        compute_boundary_response();
+    }
+    CHKERRTHROW(VecCopy(u_boundary_->vec(), linear_solver_.x().vec()));
+    boundary_time_ = 1.0;
     disp_scatter_.begin_scatter(linear_solver_.x(), disp_ghost_);
     disp_scatter_.wait_scatter();
 }
@@ -12,6 +12,7 @@
 #include "form/AbstractDGOperator.h"
 #include "interface/BlockVector.h"
 #include "parallel/LocalGhostCompositeView.h"
+#include "parallel/Profile.h"
 #include "parallel/Scatter.h"
 #include "parallel/SparseBlockVector.h"
 #include "tensor/Tensor.h"
@@ -32,11 +33,19 @@ public:
 
     SeasQDOperator(std::unique_ptr<dg_t> dgop, std::unique_ptr<AbstractAdapterOperator> adapter,
                    std::unique_ptr<AbstractFrictionOperator> friction, bool matrix_free = false,
-                   MGConfig const& mg_config = MGConfig());
+                   MGConfig const& mg_config = MGConfig(), bool nested_iteration = false,
+                   bool near_null_space = false);
 
     inline void warmup() { linear_solver_.warmup(); }
 
     virtual void set_boundary(std::unique_ptr<AbstractFacetFunctionalFactory> fun);
+    /**
+     * @brief Assert that the boundary data is linear in time, i.e. boundary(x, t) = f(x) t.
+     *
+     * The response to the unit boundary load f is then solved once and each solve only
+     * computes the slip-driven part of the displacement.
+     */
+    inline void set_boundary_linear(bool boundary_linear) { boundary_linear_ = boundary_linear; }
 
     inline auto block_sizes() -> std::array<std::size_t, 1> const {
         return {friction_->block_size()};
@@ -53,7 +62,7 @@ public:
     inline AbstractFrictionOperator& friction() { return *friction_; }
     inline AbstractFrictionOperator const& friction() const { return *friction_; }
 
-    void initial_condition(BlockVector& state);
+    void initial_condition(double time, BlockVector& state);
     void rhs(double time, BlockVector const& state, BlockVector& result);
     virtual void update_internal_state(double time, BlockVector const& state,
                                        bool state_changed_since_last_rhs, bool require_traction,
@@ -72,6 +81,12 @@ public:
         return friction_->state(time, traction_, state_vec);
     }
 
+    /**
+     * @brief Profile of the DG solve, the ghost exchanges of state and displacement, and the
+     * friction law
+     */
+    inline Profile const& profile() const { return profile_; };
+
 protected:
     inline auto invalid_slip_bc() {
         return [](std::size_t, Matrix<double>&, bool) {
@@ -80,8 +95,16 @@ protected:
     }
 
     inline void update_ghost_state(BlockVector const& state) {
+        profile_.begin(r_scatter_);
         state_scatter_.begin_scatter(state, state_ghost_);
         state_scatter_.wait_scatter();
+        profile_.end(r_scatter_);
+    }
+
+    inline void friction_rhs(double time, BlockVector const& state, BlockVector& result) {
+        profile_.begin(r_friction_);
+        friction_->rhs(time, traction_, state, result);
+        profile_.end(r_friction_);
     }
 
     inline auto make_state_view(BlockVector const& state) -> LocalGhostCompositeView {
@@ -90,6 +113,15 @@ protected:
 
     void solve(double time, BlockView const& state_view);
     void update_traction(BlockView const& state_view);
+    void solve_linear_system();
+    void compute_boundary_response();
+    inline bool boundary_linear() const { return fun_boundary_ && boundary_linear_; }
+    /**
+     * @brief Sets the displacement to the response to the unit boundary load at zero slip.
+     *
+     * Requires linear boundary data; the response is computed on first use.
+     */
+    void set_displacement_to_boundary_response();
 
 private:
     std::unique_ptr<dg_t> dgop_;
@@ -104,9 +136,15 @@ private:
     SparseBlockVector<double> state_ghost_;
 
     std::unique_ptr<AbstractFacetFunctionalFactory> fun_boundary_ = nullptr;
+    bool boundary_linear_ = false;
+    std::unique_ptr<PetscVector> u_boundary_ = nullptr;
+    double boundary_time_ = 0.0;
+    bool first_solve_ = true;
 
 protected:
     PetscVector traction_;
+    Profile profile_;
+    std::size_t r_solve_, r_scatter_, r_friction_;
 };
 
 } // namespace tndm
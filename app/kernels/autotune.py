@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+
+# Generates several variants of the kernels of an app, benchmarks every variant on the
+# build host, and generates the fastest variant into the output directory.
+# The selection is stored in a cache file such that subsequent builds are reproducible.
+
+import os
+import sys
+
+import argparse
+import hashlib
+import json
+import re
+import shlex
+import shutil
+import subprocess
+import tempfile
+
+cmdLineParser = argparse.ArgumentParser()
+cmdLineParser.add_argument('--app', required=True)
+cmdLineParser.add_argument('--arch', required=True)
+cmdLineParser.add_argument('--options', required=True)
+cmdLineParser.add_argument('--outputDir', required=True)
+cmdLineParser.add_argument('--with_libxsmm', type=str, default='')
+cmdLineParser.add_argument('--petsc_memalign', type=int, default=8)
+cmdLineParser.add_argument('--cache', required=True)
+cmdLineParser.add_argument('--cxx', required=True)
+cmdLineParser.add_argument('--cxx_flags', type=str, default='')
+cmdLineParser.add_argument('--include_dirs', nargs='*', default=[])
+cmdLineParser.add_argument('--alignment', type=int, default=64)
+cmdLineArgs = cmdLineParser.parse_args()
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+generate_script = os.path.join(script_dir, 'generate.py')
+flop_counter = os.path.join(script_dir, 'flop_counter.cpp')
+kernel_sources = ['init.cpp', 'kernel.cpp', 'subroutine.cpp', 'tensor.cpp']
+
+
+def variants():
+    gemms = ['generic', 'eigen']
+    if cmdLineArgs.with_libxsmm:
+        gemms.append('libxsmm')
+    return [{'gemm': gemm, 'padding': padding} for gemm in gemms for padding in ['auto', 'none']]
+
+
+def variant_name(variant):
+    return '{}-{}'.format(variant['gemm'], variant['padding'])
+
+
+def cache_key():
+    """Hashes everything the generated kernels depend on, including the kernel definitions."""
+    h = hashlib.sha256()
+    for file_name in [
+            cmdLineArgs.options, generate_script,
+            os.path.join(script_dir, '{}.py'.format(cmdLineArgs.app))
+    ]:
+        with open(file_name, 'rb') as f:
+            h.update(f.read())
+    for item in [
+            cmdLineArgs.app, cmdLineArgs.arch,
+            str(cmdLineArgs.petsc_memalign),
+            str(bool(cmdLineArgs.with_libxsmm)), cmdLineArgs.cxx, cmdLineArgs.cxx_flags
+    ]:
+        h.update(item.encode())
+    return h.hexdigest()
+
+
+def generate(variant, outputDir, quiet=True):
+    cmd = [
+        sys.executable, generate_script, '--app', cmdLineArgs.app, '--arch', cmdLineArgs.arch,
+        '--options', cmdLineArgs.options, '--outputDir', outputDir, '--with_libxsmm',
+        cmdLineArgs.with_libxsmm, '--petsc_memalign',
+        str(cmdLineArgs.petsc_memalign), '--gemm', variant['gemm'], '--padding',
+        variant['padding']
+    ]
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL if quiet else None, cwd=script_dir)
+
+
+def parse_kernels(kernel_h):
+    """Extracts members and execute functions of the yateto kernel structs."""
+    with open(kernel_h) as f:
+        code = f.read()
+    kernels = []
+    for match in re.finditer(r'struct (\w+) \{(.*?)\n\s*\};', code, re.DOTALL):
+        name, body = match.group(1), match.group(2)
+        executes = re.findall(r'void (execute\d*)\(\);', body)
+        if not executes:
+            continue
+        kernels.append({
+            'name': name,
+            'pointers': re.findall(r'^\s*double(?: const)?\* (\w+)\{\};', body, re.MULTILINE),
+            'containers': re.findall(r'tensor::(\w+)::Container<[^>]*> (\w+);', body),
+            'scalars': re.findall(r'^\s*double (\w+) = ', body, re.MULTILINE),
+            'executes': executes
+        })
+    return kernels
+
+
+def write_driver(kernels, file_name):
+    ns = 'tndm::{}'.format(cmdLineArgs.app)
+    lines = [
+        '#include "kernel.h"', '#include "tensor.h"', '', '#include <algorithm>',
+        '#include <chrono>', '#include <cstdio>', '#include <cstdlib>', '#include <limits>', '',
+        'namespace {', 'constexpr std::size_t Alignment = {};'.format(cmdLineArgs.alignment),
+        'double* alloc(std::size_t size) {',
+        '    std::size_t bytes = std::max(std::size_t(1), size * sizeof(double));',
+        '    bytes = ((bytes + Alignment - 1) / Alignment) * Alignment;',
+        '    auto p = static_cast<double*>(std::aligned_alloc(Alignment, bytes));',
+        '    for (std::size_t i = 0; i < size; ++i) {', '        p[i] = 1.0 / (1.0 + i % 7);',
+        '    }', '    return p;', '}', 'template <typename F> double bench(F&& f) {',
+        '    for (int i = 0; i < 16; ++i) {', '        f();', '    }',
+        '    double best = std::numeric_limits<double>::max();',
+        '    for (int r = 0; r < 5; ++r) {',
+        '        auto start = std::chrono::steady_clock::now();',
+        '        for (int i = 0; i < 256; ++i) {', '            f();', '        }',
+        '        std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;',
+        '        best = std::min(best, t.count() / 256);', '    }', '    return best;', '}',
+        '} // namespace', '', 'int main() {'
+    ]
+    for kernel in kernels:
+        lines.append('    {')
+        lines.append('        {}::kernel::{} k;'.format(ns, kernel['name']))
+        for member in kernel['pointers']:
+            lines.append('        k.{0} = alloc({1}::tensor::{0}::Size);'.format(member, ns))
+        for tensor, member in kernel['containers']:
+            lines.append(
+                '        for (unsigned i = 0; i < sizeof(k.{0}.data) / sizeof(k.{0}.data[0]); ++i) {{'
+                .format(member))
+            lines.append('            k.{0}.data[i] = alloc({1}::tensor::{2}::Size[i]);'.format(
+                member, ns, tensor))
+            lines.append('        }')
+        for member in kernel['scalars']:
+            lines.append('        k.{} = 1.0;'.format(member))
+        for execute in kernel['executes']:
+            lines.append(
+                '        std::printf("{0}::{1} %.9e\\n", bench([&k]() {{ k.{1}(); }}));'.format(
+                    kernel['name'], execute))
+        lines.append('    }')
+    lines += ['    return 0;', '}']
+    with open(file_name, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+def benchmark(variant, work_dir):
+    """Returns the time per kernel or None if the variant does not work on this host."""
+    variant_dir = os.path.join(work_dir, variant_name(variant))
+    try:
+        generate(variant, variant_dir)
+        driver = os.path.join(variant_dir, 'autotune.cpp')
+        write_driver(parse_kernels(os.path.join(variant_dir, 'kernel.h')), driver)
+        exe = os.path.join(variant_dir, 'autotune')
+        cmd = [cmdLineArgs.cxx, '-std=c++17', '-O3', '-DNDEBUG']
+        cmd += shlex.split(cmdLineArgs.cxx_flags)
+        cmd += ['-DEIGEN_STACK_ALLOCATION_LIMIT=2097152', '-I' + variant_dir]
+        cmd += ['-I' + d for d in cmdLineArgs.include_dirs]
+        cmd += [driver, flop_counter] + [os.path.join(variant_dir, s) for s in kernel_sources]
+        cmd += ['-o', exe]
+        subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+        out = subprocess.run([exe], check=True, stdout=subprocess.PIPE,
+                             universal_newlines=True).stdout
+    except (subprocess.CalledProcessError, OSError, ValueError) as e:
+        print('Kernel variant {} skipped: {}'.format(variant_name(variant), e))
+        return None
+    timings = {}
+    for line in out.splitlines():
+        name, time = line.split()
+        timings[name] = float(time)
+    return timings
+
+
+cache = {}
+if os.path.exists(cmdLineArgs.cache):
+    with open(cmdLineArgs.cache) as f:
+        cache = json.load(f)
+key = cache_key()
+
+if key in cache:
+    selected = cache[key]['variant']
+    print('Using cached kernel variant {} for {}'.format(variant_name(selected),
+                                                          cmdLineArgs.app))
+else:
+    work_dir = tempfile.mkdtemp(prefix='tandem-autotune-{}-'.format(cmdLineArgs.app))
+    results = {}
+    try:
+        for variant in variants():
+            timings = benchmark(variant, work_dir)
+            if timings is not None:
+                results[variant_name(variant)] = {'variant': variant, 'timings': timings}
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+    if not results:
+        selected = {'gemm': 'default', 'padding': 'auto'}
+        print('No kernel variant could be benchmarked; using default for {}'.format(
+            cmdLineArgs.app))
+    else:
+        total = lambda r: sum(r['timings'].values())
+        for name, result in sorted(results.items(), key=lambda x: total(x[1])):
+            print('{:>16} {:12.3e} s'.format(name, total(result)))
+        best = min(results.values(), key=total)
+        selected = best['variant']
+        print('Selected kernel variant {} for {}'.format(variant_name(selected),
+                                                         cmdLineArgs.app))
+    cache[key] = {'variant': selected, 'results': results}
+    cache_dir = os.path.dirname(cmdLineArgs.cache)
+    if cache_dir:
+        os.makedirs(cache_dir, exist_ok=True)
+    with open(cmdLineArgs.cache, 'w') as f:
+        json.dump(cache, f, indent=2, sort_keys=True)
+
+generate(selected, cmdLineArgs.outputDir, quiet=False)
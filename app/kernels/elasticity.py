@@ -237,6 +237,19 @@ def add(generator, dim, nbf, Nbf, nq, Nq, petsc_alignment):
 
     generator.add('project_u_rhs', U['kp'] <= E_Q['kq'] * W['q'] * J['q'] * U_Q['pq'])
 
+    # absorbing boundaries and sponge layers
+
+    Zs_q = Tensor('Zs_q', (nq,))
+    Zps_q = Tensor('Zps_q', (nq,))
+    damping_W_J_Q = Tensor('damping_W_J_Q', (Nq,))
+
+    generator.add('absorbing_facet', Unew['kp'] <= Unew['kp'] + w['q'] * nl_q['q'] * E_q[0]['kq'] *
+        (Zs_q['q'] * E_q[0]['lq'] * U['lp'] +
+         Zps_q['q'] * n_unit_q['pq'] * n_unit_q['rq'] * E_q[0]['lq'] * U['lr']))
+
+    generator.add('sponge_volume', Unew['kp'] <= Unew['kp'] +
+        E_Q['kq'] * damping_W_J_Q['q'] * E_Q['lq'] * U['lp'])
+
     # traction
 
     generator.add('compute_traction',
@@ -24,11 +24,16 @@ cmdLineParser.add_argument('--options', required=True)
 cmdLineParser.add_argument('--outputDir', required=True)
 cmdLineParser.add_argument('--with_libxsmm', type=str, default='')
 cmdLineParser.add_argument('--petsc_memalign', type=int, default=8)
+cmdLineParser.add_argument('--gemm',
+                           choices=['default', 'generic', 'eigen', 'libxsmm'],
+                           default='default')
+cmdLineParser.add_argument('--padding', choices=['auto', 'none'], default='auto')
 cmdLineArgs = cmdLineParser.parse_args()
 
 arch = useArchitectureIdentifiedBy(cmdLineArgs.arch)
 petsc_aligned = arch.alignment <= cmdLineArgs.petsc_memalign
-petsc_alignment = Alignment.Automatic if petsc_aligned else Alignment.Unaligned
+petsc_alignment = Alignment.Automatic if petsc_aligned and cmdLineArgs.padding == 'auto' \
+    else Alignment.Unaligned
 g = Generator(arch)
 
 options = None
@@ -53,10 +58,19 @@ elif cmdLineArgs.app == 'elasticity_adapter':
                            options['numFaultBasisFunctions'],
                            options['numFacetQuadPoints'])
 
+# An empty list of GEMM generators lets yateto emit generic loops
 gemmgen_list = []
-if cmdLineArgs.with_libxsmm and cmdLineArgs.app == 'elasticity':
+if cmdLineArgs.gemm == 'default':
+    if cmdLineArgs.with_libxsmm and cmdLineArgs.app == 'elasticity':
+        gemmgen_list.append(LIBXSMM(arch, cmd=cmdLineArgs.with_libxsmm))
+    gemmgen_list.append(Eigen(arch))
+elif cmdLineArgs.gemm == 'libxsmm':
+    if not cmdLineArgs.with_libxsmm:
+        raise ValueError('--gemm libxsmm requires --with_libxsmm')
     gemmgen_list.append(LIBXSMM(arch, cmd=cmdLineArgs.with_libxsmm))
-gemmgen_list.append(Eigen(arch))
+    gemmgen_list.append(Eigen(arch))
+elif cmdLineArgs.gemm == 'eigen':
+    gemmgen_list.append(Eigen(arch))
 
 # Generate code
 g.generate(outputDir=cmdLineArgs.outputDir,
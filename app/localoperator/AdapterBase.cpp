@@ -6,6 +6,7 @@
 #include "form/RefElement.h"
 #include "geometry/Vector.h"
 #include "tensor/EigenMap.h"
+#include "tensor/FixedTensor.h"
 #include "tensor/Utility.h"
 
 #include <Eigen/Core>
@@ -76,10 +77,9 @@ void AdapterBase::prepare(std::size_t faultNo, FacetInfo const& info,
     cl_->facetBasis(up_, normal, fault_basis_q);
     for (std::size_t q = 0; q < nq; ++q) {
         if (fault_[faultNo].template get<SignFlipped>()[q]) {
-            for (std::size_t i = 0; i < fault_basis_q.shape(1); ++i) {
-                for (std::size_t j = 0; j < fault_basis_q.shape(0); ++j) {
-                    fault_basis_q(i, j, q) *= -1.0;
-                }
+            auto fb = fixed_subtensor<DomainDimension, DomainDimension>(fault_basis_q, q);
+            for (std::ptrdiff_t i = 0; i < fb.size(); ++i) {
+                fb.data()[i] *= -1.0;
             }
         }
     }
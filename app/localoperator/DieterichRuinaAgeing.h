@@ -14,11 +14,13 @@
 #include <cstddef>
 #include <exception>
 #include <iostream>
+#include <memory>
 
 namespace tndm {
 
 class DieterichRuinaAgeing {
 public:
+    constexpr static char Name[] = "ageing";
     static constexpr std::size_t TangentialComponents = DomainDimension - 1u;
 
     struct ConstantParams {
@@ -36,28 +38,32 @@ public:
         std::array<double, TangentialComponents> Sinit;
     };
 
-    void set_num_nodes(std::size_t num_nodes) { p_.resize(num_nodes); }
+    void set_num_nodes(std::size_t num_nodes) { p_->resize(num_nodes); }
+    /**
+     * @brief Uses the parameters of other instead of a copy (set_params of other applies).
+     */
+    void share_params(DieterichRuinaAgeing const& other) { p_ = other.p_; }
     void set_constant_params(ConstantParams const& params) { cp_ = params; }
     void set_params(std::size_t index, Params const& params) {
-        p_[index].get<A>() = params.a;
-        p_[index].get<Eta>() = params.eta;
-        p_[index].get<L>() = params.L;
-        p_[index].get<SnPre>() = params.sn_pre;
-        p_[index].get<TauPre>() = params.tau_pre;
-        p_[index].get<Vinit>() = params.Vinit;
-        p_[index].get<Sinit>() = params.Sinit;
+        (*p_)[index].get<A>() = params.a;
+        (*p_)[index].get<Eta>() = params.eta;
+        (*p_)[index].get<L>() = params.L;
+        (*p_)[index].get<SnPre>() = params.sn_pre;
+        (*p_)[index].get<TauPre>() = params.tau_pre;
+        (*p_)[index].get<Vinit>() = params.Vinit;
+        (*p_)[index].get<Sinit>() = params.Sinit;
     }
 
     double psi_init(std::size_t index, double sn,
                     std::array<double, TangentialComponents> const& tau) const {
-        double snAbs = -sn + p_[index].get<SnPre>();
-        double tauAbs = norm(tau + p_[index].get<TauPre>());
-        auto Vi = norm(p_[index].get<Vinit>());
+        double snAbs = -sn + (*p_)[index].get<SnPre>();
+        double tauAbs = norm(tau + (*p_)[index].get<TauPre>());
+        auto Vi = norm((*p_)[index].get<Vinit>());
         if (Vi == 0.0) {
             return cp_.f0;
         }
-        auto a = p_[index].get<A>();
-        auto eta = p_[index].get<Eta>();
+        auto a = (*p_)[index].get<A>();
+        auto eta = (*p_)[index].get<Eta>();
         double s = sinh((tauAbs - eta * Vi) / (a * snAbs));
         double l = log((2.0 * cp_.V0 / Vi) * s);
         return a * l;
@@ -66,7 +72,7 @@ public:
     /**
      * @brief Absolute normal stress on fault (positive in compression)
      */
-    double sn_hat(std::size_t index, double sn) const { return -sn + p_[index].get<SnPre>(); }
+    double sn_hat(std::size_t index, double sn) const { return -sn + (*p_)[index].get<SnPre>(); }
     /**
      * @brief Absolute shear stress on fault.
      *
@@ -74,16 +80,16 @@ public:
      */
     auto tau_hat(std::size_t index, std::array<double, TangentialComponents> const& tau,
                  std::array<double, TangentialComponents> const& V) const {
-        return tau + p_[index].get<TauPre>() + p_[index].get<Eta>() * V;
+        return tau + (*p_)[index].get<TauPre>() + (*p_)[index].get<Eta>() * V;
     }
-    auto S_init(std::size_t index) const { return p_[index].get<Sinit>(); }
+    auto S_init(std::size_t index) const { return (*p_)[index].get<Sinit>(); }
 
     auto slip_rate(std::size_t index, double sn,
                    std::array<double, TangentialComponents> const& tau, double psi) const
         -> std::array<double, TangentialComponents> {
-        auto eta = p_[index].get<Eta>();
-        auto tauAbsVec = tau + p_[index].get<TauPre>();
-        double snAbs = -sn + p_[index].get<SnPre>();
+        auto eta = (*p_)[index].get<Eta>();
+        auto tauAbsVec = tau + (*p_)[index].get<TauPre>();
+        double snAbs = -sn + (*p_)[index].get<SnPre>();
         double tauAbs = norm(tauAbsVec);
         double V = 0.0;
         if (eta == 0.0) {
@@ -114,7 +120,7 @@ public:
     }
 
     double state_rhs(std::size_t index, double V, double psi) const {
-        double myL = p_[index].get<L>();
+        double myL = (*p_)[index].get<L>();
         return cp_.b * cp_.V0 / myL * (exp((cp_.f0 - psi) / cp_.b) - V / cp_.V0);
     }
 
@@ -137,19 +143,19 @@ public:
     template <typename VecT> void params(std::size_t index, VecT& result) const {
         assert(result.shape(0) == 4 + TangentialComponents);
         std::ptrdiff_t i = 0;
-        result(i++) = p_[index].get<A>();
-        result(i++) = p_[index].get<Eta>();
-        result(i++) = p_[index].get<L>();
-        result(i++) = p_[index].get<SnPre>();
-        auto const& tau_pre = p_[index].get<TauPre>();
+        result(i++) = (*p_)[index].get<A>();
+        result(i++) = (*p_)[index].get<Eta>();
+        result(i++) = (*p_)[index].get<L>();
+        result(i++) = (*p_)[index].get<SnPre>();
+        auto const& tau_pre = (*p_)[index].get<TauPre>();
         for (auto const& t : tau_pre) {
             result(i++) = t;
         }
     }
 
-private:
+protected:
     double F(std::size_t index, double snAbs, double V, double psi) const {
-        auto a = p_[index].get<A>();
+        auto a = (*p_)[index].get<A>();
         double e = exp(psi / a);
         double f = a * asinh((V / (2.0 * cp_.V0)) * e);
         return snAbs * f;
@@ -160,7 +166,7 @@ private:
         // V = 2 V_0 sinh(tauAbs / (a snAbs)) exp(-psi / a)
         // substituting r = tauAbs / snAbs and sinh(x) = (exp(x) - exp(-x)) / 2 we obtain
         // V = V_0 (exp((r - psi) / a) - exp(-(r + psi) / a))
-        auto a = p_[index].get<A>();
+        auto a = (*p_)[index].get<A>();
         double r = tauAbs / snAbs;
         return cp_.V0 * (exp((r - psi) / a) - exp(-(r + psi) / a));
     }
@@ -188,7 +194,9 @@ private:
     struct Sinit {
         using type = std::array<double, TangentialComponents>;
     };
-    mneme::MultiStorage<mneme::DataLayout::SoA, SnPre, TauPre, A, Eta, L, Vinit, Sinit> p_;
+    using params_t = mneme::MultiStorage<mneme::DataLayout::SoA, SnPre, TauPre, A, Eta, L, Vinit,
+                                         Sinit>;
+    std::shared_ptr<params_t> p_ = std::make_shared<params_t>();
 };
 
 } // namespace tndm
@@ -0,0 +1,34 @@
+#ifndef DIETERICHRUINASLIP_20261018_H
+#define DIETERICHRUINASLIP_20261018_H
+
+#include "DieterichRuinaAgeing.h"
+
+#include <cmath>
+#include <cstddef>
+
+namespace tndm {
+
+/**
+ * @brief Rate and state friction with Ruina's slip law.
+ *
+ * Friction and parameters are identical to DieterichRuinaAgeing; only the state evolution
+ * differs. With psi = f0 + b ln(V0 theta / L) the slip law reads
+ *
+ * dpsi/dt = -V/L (psi - f_ss(V)), where f_ss(V) = f0 - b ln(V / V0).
+ */
+class DieterichRuinaSlip : public DieterichRuinaAgeing {
+public:
+    constexpr static char Name[] = "slip";
+
+    double state_rhs(std::size_t index, double V, double psi) const {
+        if (V == 0.0) {
+            return 0.0;
+        }
+        double myL = (*p_)[index].get<L>();
+        return -V / myL * (psi - cp_.f0 + cp_.b * log(V / cp_.V0));
+    }
+};
+
+} // namespace tndm
+
+#endif // DIETERICHRUINASLIP_20261018_H
@@ -15,8 +15,13 @@
 #include "util/LinearAllocator.h"
 #include "util/Stopwatch.h"
 
+#include <Eigen/Cholesky>
 #include <Eigen/LU>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <optional>
+#include <tuple>
 
 namespace tensor = tndm::elasticity::tensor;
 namespace init = tndm::elasticity::init;
@@ -24,14 +29,33 @@ namespace kernel = tndm::elasticity::kernel;
 
 namespace tndm {
 
+namespace {
+// G_T(i, j, q) = G(j, i, q)
+void transpose_G(double const* G, double* G_T, std::size_t numPoints) {
+    constexpr std::size_t Dim = DomainDimension;
+    for (std::size_t q = 0; q < numPoints; ++q) {
+        for (std::size_t i = 0; i < Dim; ++i) {
+            for (std::size_t j = 0; j < Dim; ++j) {
+                G_T[i + j * Dim + q * Dim * Dim] = G[j + i * Dim + q * Dim * Dim];
+            }
+        }
+    }
+}
+} // namespace
+
 Elasticity::Elasticity(std::shared_ptr<Curvilinear<DomainDimension>> cl, functional_t<1> lam,
-                       functional_t<1> mu, std::optional<functional_t<1>> rho, DGMethod method)
-    : DGCurvilinearCommon<DomainDimension>(std::move(cl), MinQuadOrder()), method_(method),
+                       functional_t<1> mu, std::optional<functional_t<1>> rho, DGMethod method,
+                       std::optional<functional_t<1>> damping, GeometryMode geometry)
+    : DGCurvilinearCommon<DomainDimension>(std::move(cl), MinQuadOrder(), geometry),
+      method_(method),
       space_(PolynomialDegree, WarpAndBlendFactory<DomainDimension>(), ALIGNMENT),
       materialSpace_(PolynomialDegree, WarpAndBlendFactory<DomainDimension>(), ALIGNMENT),
       fun_lam(make_volume_functional(std::move(lam))),
       fun_mu(make_volume_functional(std::move(mu))),
       fun_rho(rho ? make_volume_functional(std::move(*rho)) : one_volume_function) {
+    if (damping) {
+        fun_damping = make_volume_functional(std::move(*damping));
+    }
 
     MhatInv = space_.inverseMassMatrix();
     E_Q = space_.evaluateBasisAt(volRule.points());
@@ -93,11 +117,23 @@ void Elasticity::begin_preparation(std::size_t numElements, std::size_t numLocal
     volPre.setStorage(std::make_shared<vol_pre_t>(numElements * volRule.size()), 0u, numElements,
                       volRule.size());
 
-    fctPre.setStorage(std::make_shared<fct_pre_t>(numLocalFacets * fctRule.size()), 0u,
-                      numLocalFacets, fctRule.size());
+    if (geometry_ == GeometryMode::Stored) {
+        volPreGeo.setStorage(std::make_shared<vol_pre_geo_t>(numElements * volRule.size()), 0u,
+                             numElements, volRule.size());
+        fctPre.setStorage(std::make_shared<fct_pre_t>(numLocalFacets * fctRule.size()), 0u,
+                          numLocalFacets, fctRule.size());
+    }
+
+    lamMuConst_.assign(numElements, {0.0, 0.0});
+    volMaterialOffset_.assign(numElements, ConstantMaterial);
+    volMaterial_.clear();
+    fctMaterialOffset_.assign(numLocalFacets, {ConstantMaterial, ConstantMaterial});
+    fctMaterial_.clear();
+    fctMaterialPool_.clear();
 
     penalty_.resize(numLocalFacets);
     cfl_dt_.resize(numLocalElements, 0.0);
+    has_sponge_.resize(numElements, false);
 }
 
 void Elasticity::prepare_volume(std::size_t elNo, LinearAllocator<double>& scratch) {
@@ -114,6 +150,21 @@ void Elasticity::prepare_volume(std::size_t elNo, LinearAllocator<double>& scrat
     alignas(ALIGNMENT) double rhoInv_Q_raw[tensor::rhoInv_Q::size()];
     auto rhoInv_Q = Matrix<double>(rhoInv_Q_raw, 1, volRule.size());
     fun_rho(elNo, rhoInv_Q);
+    auto damping_Q = volPre[elNo].get<damping_W_J_Q>();
+    if (fun_damping) {
+        auto damping_Q_mat = Matrix<double>(damping_Q.data(), 1, volRule.size());
+        (*fun_damping)(elNo, damping_Q_mat);
+        auto J_Q = vol[elNo].get<AbsDetJ>();
+        for (unsigned q = 0; q < volRule.size(); ++q) {
+            has_sponge_[elNo] = has_sponge_[elNo] || damping_Q[q] != 0.0;
+            // rhoInv_Q still holds rho here
+            damping_Q[q] *= rhoInv_Q(0, q) * volRule.weights()[q] * J_Q[q];
+        }
+    } else {
+        for (unsigned q = 0; q < volRule.size(); ++q) {
+            damping_Q[q] = 0.0;
+        }
+    }
     for (unsigned q = 0; q < tensor::rhoInv_Q::Shape[0]; ++q) {
         rhoInv_Q(0, q) = 1.0 / rhoInv_Q(0, q);
     }
@@ -162,46 +213,61 @@ void Elasticity::prepare_volume(std::size_t elNo, LinearAllocator<double>& scrat
     auto rhoInv_eigen = RhoInvMap(rhoInv_field);
     rhoInv_eigen = proj.solve(rhoInv_eigen);
 
-    auto G_Q = init::G::view::create(vol[elNo].get<JInv>().data()->data());
-    auto G_Q_T = init::G_Q_T::view::create(volPre[elNo].get<JInvT>().data()->data());
-    for (std::ptrdiff_t q = 0; q < G_Q.shape(2); ++q) {
-        for (std::ptrdiff_t i = 0; i < G_Q.shape(0); ++i) {
-            for (std::ptrdiff_t j = 0; j < G_Q.shape(1); ++j) {
-                G_Q_T(i, j, q) = G_Q(j, i, q);
-            }
-        }
+    // Detect constant Lame parameters. The projection of a constant is only constant up to
+    // round-off, therefore the values are compared with a relative tolerance and left unchanged.
+    // The constant is taken from the input values at the quadrature points, such that elements
+    // of the same material obtain equal constants and share facet data.
+    auto const is_constant = [](double const* values, std::size_t n) {
+        auto [min, max] = std::minmax_element(values, values + n);
+        return *max - *min <= 1e-12 * std::max(std::fabs(*min), std::fabs(*max));
+    };
+    if (compactMaterial_ && is_constant(lam_field, tensor::lam::Shape[0]) &&
+        is_constant(mu_field, tensor::mu::Shape[0]) && is_constant(lam_Q_raw, volRule.size()) &&
+        is_constant(mu_Q_raw, volRule.size())) {
+        lamMuConst_[elNo] = {lam_Q(0, 0), mu_Q(0, 0)};
+    } else {
+        volMaterialOffset_[elNo] = volMaterial_.size();
+        volMaterial_.resize(volMaterial_.size() + 2 * padded(volRule.size()));
+    }
+
+    if (geometry_ == GeometryMode::Stored) {
+        transpose_G(volGeo[elNo].get<JInv>().data()->data(),
+                    volPreGeo[elNo].get<JInvT>().data()->data(), volRule.size());
     }
 }
 
 void Elasticity::transpose_JInv(std::size_t fctNo, int side) {
-    const auto G_q = (side == 1) ? fct[fctNo].get<JInv1>() : fct[fctNo].get<JInv0>();
+    if (geometry_ != GeometryMode::Stored) {
+        return;
+    }
     auto G_q_T = (side == 1) ? fctPre[fctNo].get<JInvT1>() : fctPre[fctNo].get<JInvT0>();
-    for (std::size_t q = 0; q < fctRule.size(); ++q) {
-        for (std::ptrdiff_t i = 0; i < Dim; ++i) {
-            for (std::ptrdiff_t j = 0; j < Dim; ++j) {
-                G_q_T[q][i + j * Dim] = G_q[q][j + i * Dim];
-            }
-        }
+    transpose_G(jInv_q(fctNo, side, nullptr), G_q_T.data()->data(), fctRule.size());
+}
+
+double const* Elasticity::jInvT_Q(std::size_t elNo, double const* G, double* buffer) const {
+    if (geometry_ == GeometryMode::Stored) {
+        return volPreGeo[elNo].get<JInvT>().data()->data();
     }
-};
+    transpose_G(G, buffer, volRule.size());
+    return buffer;
+}
+
+double const* Elasticity::jInvT_q(std::size_t fctNo, int side, double* buffer) const {
+    if (geometry_ == GeometryMode::Stored) {
+        return (side == 1) ? fctPre[fctNo].get<JInvT1>().data()->data()
+                           : fctPre[fctNo].get<JInvT0>().data()->data();
+    }
+    alignas(ALIGNMENT) double G_q[tensor::G_q_T::size(0)];
+    transpose_G(jInv_q(fctNo, side, G_q), buffer, fctRule.size());
+    return buffer;
+}
 
 void Elasticity::prepare_skeleton(std::size_t fctNo, FacetInfo const& info,
                                   LinearAllocator<double>& scratch) {
     base::prepare_skeleton(fctNo, info, scratch);
 
-    kernel::precomputeSurface krnl;
-    for (unsigned side = 0; side < 2; ++side) {
-        krnl.matE_q_T(side) = matE_q_T[info.localNo[side]].data();
-    }
-    krnl.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    krnl.lam_q(1) = fctPre[fctNo].get<lam_q_1>().data();
-    krnl.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    krnl.mu_q(1) = fctPre[fctNo].get<mu_q_1>().data();
-
     for (unsigned side = 0; side < 2; ++side) {
-        krnl.lam = material[info.up[side]].get<lam>().data();
-        krnl.mu = material[info.up[side]].get<mu>().data();
-        krnl.execute(side);
+        fctMaterialOffset_[fctNo][side] = add_facet_material(info.up[side], info.localNo[side]);
     }
 
     transpose_JInv(fctNo, 0);
@@ -212,15 +278,59 @@ void Elasticity::prepare_boundary(std::size_t fctNo, FacetInfo const& info,
                                   LinearAllocator<double>& scratch) {
     base::prepare_boundary(fctNo, info, scratch);
 
+    fctMaterialOffset_[fctNo][0] = add_facet_material(info.up[0], info.localNo[0]);
+    fctMaterialOffset_[fctNo][1] = fctMaterialOffset_[fctNo][0];
+
+    transpose_JInv(fctNo, 0);
+}
+
+std::size_t Elasticity::add_facet_material(std::size_t elNo, unsigned localNo) {
+    auto const nq = padded(fctRule.size());
+    auto const add_block = [&]() {
+        auto offset = fctMaterial_.size();
+        fctMaterial_.resize(offset + 2 * nq, 0.0);
+        return offset;
+    };
+
+    if (volMaterialOffset_[elNo] == ConstantMaterial) {
+        auto const& lam_mu = lamMuConst_[elNo];
+        auto it = fctMaterialPool_.find(lam_mu);
+        if (it != fctMaterialPool_.end()) {
+            return it->second;
+        }
+        auto offset = add_block();
+        std::fill_n(fctMaterial_.data() + offset, fctRule.size(), lam_mu.first);
+        std::fill_n(fctMaterial_.data() + offset + nq, fctRule.size(), lam_mu.second);
+        fctMaterialPool_.emplace(lam_mu, offset);
+        return offset;
+    }
+
+    auto offset = add_block();
     kernel::precomputeSurface krnl;
-    krnl.matE_q_T(0) = matE_q_T[info.localNo[0]].data();
-    krnl.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    krnl.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    krnl.lam = material[info.up[0]].get<lam>().data();
-    krnl.mu = material[info.up[0]].get<mu>().data();
+    krnl.matE_q_T(0) = matE_q_T[localNo].data();
+    krnl.lam_q(0) = fctMaterial_.data() + offset;
+    krnl.mu_q(0) = fctMaterial_.data() + offset + nq;
+    krnl.lam = material[elNo].get<lam>().data();
+    krnl.mu = material[elNo].get<mu>().data();
     krnl.execute(0);
+    return offset;
+}
 
-    transpose_JInv(fctNo, 0);
+std::pair<double const*, double const*>
+Elasticity::lam_mu_W_J_Q(std::size_t elNo, double* lam_buffer, double* mu_buffer) const {
+    auto offset = volMaterialOffset_[elNo];
+    if (offset != ConstantMaterial) {
+        double const* lam_W_J_Q = volMaterial_.data() + offset;
+        return {lam_W_J_Q, lam_W_J_Q + padded(volRule.size())};
+    }
+    auto const [lam_c, mu_c] = lamMuConst_[elNo];
+    auto J_Q = vol[elNo].get<AbsDetJ>();
+    for (std::size_t q = 0; q < volRule.size(); ++q) {
+        double const WJ = volRule.weights()[q] * J_Q[q];
+        lam_buffer[q] = lam_c * WJ;
+        mu_buffer[q] = mu_c * WJ;
+    }
+    return {lam_buffer, mu_buffer};
 }
 
 void Elasticity::prepare_volume_post_skeleton(std::size_t elNo, LinearAllocator<double>& scratch) {
@@ -236,14 +346,24 @@ void Elasticity::prepare_volume_post_skeleton(std::size_t elNo, LinearAllocator<
         Jinv_Q[q] = 1.0 / J_Q[q];
     }
 
+    // The product for constant elements is discarded; it is recomputed in lam_mu_W_J_Q
+    alignas(ALIGNMENT) double lam_W_J_Q_discard[tensor::lam_W_J_Q::size()];
+    alignas(ALIGNMENT) double mu_W_J_Q_discard[tensor::mu_W_J_Q::size()];
+    double* lam_W_J_Q = lam_W_J_Q_discard;
+    double* mu_W_J_Q = mu_W_J_Q_discard;
+    if (volMaterialOffset_[elNo] != ConstantMaterial) {
+        lam_W_J_Q = volMaterial_.data() + volMaterialOffset_[elNo];
+        mu_W_J_Q = lam_W_J_Q + padded(volRule.size());
+    }
+
     kernel::precomputeVolume krnl_pre;
     krnl_pre.matE_Q_T = matE_Q_T.data();
     krnl_pre.J = vol[elNo].get<AbsDetJ>().data();
     krnl_pre.Jinv_Q = Jinv_Q;
     krnl_pre.lam = lam_field.data();
-    krnl_pre.lam_W_J_Q = volPre[elNo].template get<lam_W_J_Q>().data();
+    krnl_pre.lam_W_J_Q = lam_W_J_Q;
     krnl_pre.mu = mu_field.data();
-    krnl_pre.mu_W_J_Q = volPre[elNo].template get<mu_W_J_Q>().data();
+    krnl_pre.mu_W_J_Q = mu_W_J_Q;
     krnl_pre.rhoInv = rhoInv_field.data();
     krnl_pre.negative_rhoInv_W_Jinv_Q =
         volPre[elNo].template get<negative_rhoInv_W_Jinv_Q>().data();
@@ -322,18 +442,20 @@ bool Elasticity::assemble_volume(std::size_t elNo, Matrix<double>& A00,
     assert(Dxi_Q.shape(1) == tensor::Dxi_Q::Shape[1]);
     assert(Dxi_Q.shape(2) == tensor::Dxi_Q::Shape[2]);
 
+    alignas(ALIGNMENT) double G_Q[tensor::G::size()];
     kernel::Dx_Q dxKrnl;
     dxKrnl.Dx_Q = Dx_Q;
     dxKrnl.Dxi_Q = Dxi_Q.data();
-    dxKrnl.G = vol[elNo].get<JInv>().data()->data();
+    dxKrnl.G = jInv_Q(elNo, G_Q);
     dxKrnl.execute();
 
     kernel::assembleVolume krnl;
     krnl.A = A00.data();
     krnl.delta = init::delta::Values;
     krnl.Dx_Q = Dx_Q;
-    krnl.lam_W_J_Q = volPre[elNo].get<lam_W_J_Q>().data();
-    krnl.mu_W_J_Q = volPre[elNo].get<mu_W_J_Q>().data();
+    alignas(ALIGNMENT) double lam_W_J_Q[tensor::lam_W_J_Q::size()];
+    alignas(ALIGNMENT) double mu_W_J_Q[tensor::mu_W_J_Q::size()];
+    std::tie(krnl.lam_W_J_Q, krnl.mu_W_J_Q) = lam_mu_W_J_Q(elNo, lam_W_J_Q, mu_W_J_Q);
     krnl.execute();
     return true;
 }
@@ -351,16 +473,21 @@ bool Elasticity::assemble_skeleton(std::size_t fctNo, FacetInfo const& info, Mat
     alignas(ALIGNMENT) double Dx_q0[tensor::Dx_q::size(0)];
     alignas(ALIGNMENT) double Dx_q1[tensor::Dx_q::size(1)];
 
+    alignas(ALIGNMENT) double g0[tensor::g::size(0)];
+    alignas(ALIGNMENT) double g1[tensor::g::size(1)];
     kernel::Dx_q dxKrnl;
     dxKrnl.Dx_q(0) = Dx_q0;
     dxKrnl.Dx_q(1) = Dx_q1;
-    dxKrnl.g(0) = fct[fctNo].get<JInv0>().data()->data();
-    dxKrnl.g(1) = fct[fctNo].get<JInv1>().data()->data();
+    dxKrnl.g(0) = jInv_q(fctNo, 0, g0);
+    dxKrnl.g(1) = jInv_q(fctNo, 1, g1);
     for (unsigned side = 0; side < 2; ++side) {
         dxKrnl.Dxi_q(side) = Dxi_q[info.localNo[side]].data();
         dxKrnl.execute(side);
     }
 
+    alignas(ALIGNMENT) double n_q_raw[tensor::n_q::size()];
+    double const* n_q = normal_q(fctNo, n_q_raw);
+
     alignas(ALIGNMENT) double traction_op_q0[tensor::traction_op_q::size(0)];
     alignas(ALIGNMENT) double traction_op_q1[tensor::traction_op_q::size(1)];
 
@@ -368,11 +495,11 @@ bool Elasticity::assemble_skeleton(std::size_t fctNo, FacetInfo const& info, Mat
     tOpKrnl.delta = init::delta::Values;
     tOpKrnl.Dx_q(0) = Dx_q0;
     tOpKrnl.Dx_q(1) = Dx_q1;
-    tOpKrnl.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    tOpKrnl.lam_q(1) = fctPre[fctNo].get<lam_q_1>().data();
-    tOpKrnl.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    tOpKrnl.mu_q(1) = fctPre[fctNo].get<mu_q_1>().data();
-    tOpKrnl.n_q = fct[fctNo].get<Normal>().data()->data();
+    tOpKrnl.lam_q(0) = fct_lam_q(fctNo, 0);
+    tOpKrnl.lam_q(1) = fct_lam_q(fctNo, 1);
+    tOpKrnl.mu_q(0) = fct_mu_q(fctNo, 0);
+    tOpKrnl.mu_q(1) = fct_mu_q(fctNo, 1);
+    tOpKrnl.n_q = n_q;
     tOpKrnl.traction_op_q(0) = traction_op_q0;
     tOpKrnl.traction_op_q(1) = traction_op_q1;
     tOpKrnl.execute(0);
@@ -394,11 +521,11 @@ bool Elasticity::assemble_skeleton(std::size_t fctNo, FacetInfo const& info, Mat
         lift.delta = init::delta::Values;
         lift.Lift(0) = Lift0;
         lift.Lift(1) = Lift1;
-        lift.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-        lift.lam_q(1) = fctPre[fctNo].get<lam_q_1>().data();
-        lift.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-        lift.mu_q(1) = fctPre[fctNo].get<mu_q_1>().data();
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.lam_q(0) = fct_lam_q(fctNo, 0);
+        lift.lam_q(1) = fct_lam_q(fctNo, 1);
+        lift.mu_q(0) = fct_mu_q(fctNo, 0);
+        lift.mu_q(1) = fct_mu_q(fctNo, 1);
+        lift.n_q = n_q;
         lift.w = fctRule.weights().data();
         for (int i = 0; i < 2; ++i) {
             lift.E_q(i) = E_q[info.localNo[i]].data();
@@ -447,10 +574,13 @@ bool Elasticity::assemble_skeleton(std::size_t fctNo, FacetInfo const& info, Mat
 
 bool Elasticity::assemble_boundary(std::size_t fctNo, FacetInfo const& info, Matrix<double>& A00,
                                    LinearAllocator<double>& scratch) const {
-    if (info.bc == BC::Natural) {
+    if (info.bc == BC::Natural || info.bc == BC::Absorbing || info.bc == BC::Exterior) {
         return false;
     }
 
+    alignas(ALIGNMENT) double n_q_raw[tensor::n_q::size()];
+    double const* n_q = normal_q(fctNo, n_q_raw);
+
     assert(fctRule.size() == tensor::w::Shape[0]);
     assert(E_q[0].shape(0) == tensor::E_q::Shape[0][0]);
     assert(E_q[0].shape(1) == tensor::E_q::Shape[0][1]);
@@ -460,9 +590,10 @@ bool Elasticity::assemble_boundary(std::size_t fctNo, FacetInfo const& info, Mat
 
     alignas(ALIGNMENT) double Dx_q0[tensor::Dx_q::size(0)];
 
+    alignas(ALIGNMENT) double g0[tensor::g::size(0)];
     kernel::Dx_q dxKrnl;
     dxKrnl.Dx_q(0) = Dx_q0;
-    dxKrnl.g(0) = fct[fctNo].get<JInv0>().data()->data();
+    dxKrnl.g(0) = jInv_q(fctNo, 0, g0);
     dxKrnl.Dxi_q(0) = Dxi_q[info.localNo[0]].data();
     dxKrnl.execute(0);
 
@@ -471,9 +602,9 @@ bool Elasticity::assemble_boundary(std::size_t fctNo, FacetInfo const& info, Mat
     kernel::assembleTractionOp tOpKrnl;
     tOpKrnl.delta = init::delta::Values;
     tOpKrnl.Dx_q(0) = Dx_q0;
-    tOpKrnl.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    tOpKrnl.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    tOpKrnl.n_q = fct[fctNo].get<Normal>().data()->data();
+    tOpKrnl.lam_q(0) = fct_lam_q(fctNo, 0);
+    tOpKrnl.mu_q(0) = fct_mu_q(fctNo, 0);
+    tOpKrnl.n_q = n_q;
     tOpKrnl.traction_op_q(0) = traction_op_q0;
     tOpKrnl.execute(0);
 
@@ -486,9 +617,9 @@ bool Elasticity::assemble_boundary(std::size_t fctNo, FacetInfo const& info, Mat
         kernel::lift_boundary lift;
         lift.delta = init::delta::Values;
         lift.Lift(0) = Lift0;
-        lift.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-        lift.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.lam_q(0) = fct_lam_q(fctNo, 0);
+        lift.mu_q(0) = fct_mu_q(fctNo, 0);
+        lift.n_q = n_q;
         lift.w = fctRule.weights().data();
         lift.E_q(0) = E_q[info.localNo[0]].data();
         lift.L_q(0) = L_q0;
@@ -574,11 +705,15 @@ bool Elasticity::bc_boundary(std::size_t fctNo, BC bc, double f_q_raw[]) const {
 bool Elasticity::rhs_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<double>& B0,
                               Vector<double>& B1, LinearAllocator<double>& scratch) const {
     alignas(ALIGNMENT) double Dx_q[tensor::Dx_q::size(0)];
+    alignas(ALIGNMENT) double g_q[tensor::g::size(0)];
     alignas(ALIGNMENT) double f_q_raw[tensor::f_q::size()];
     if (!bc_skeleton(fctNo, info.bc, f_q_raw)) {
         return false;
     }
 
+    alignas(ALIGNMENT) double n_q_raw[tensor::n_q::size()];
+    double const* n_q = normal_q(fctNo, n_q_raw);
+
     alignas(ALIGNMENT) double f_lifted_q[tensor::f_lifted_q::size()];
     if (method_ == DGMethod::BR2) {
         alignas(ALIGNMENT) double f_lifted0[tensor::f_lifted::size(0)];
@@ -594,11 +729,11 @@ bool Elasticity::rhs_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<d
         lift.f_lifted(0) = f_lifted0;
         lift.f_lifted(1) = f_lifted1;
         lift.f_lifted_q = f_lifted_q;
-        lift.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-        lift.lam_q(1) = fctPre[fctNo].get<lam_q_1>().data();
-        lift.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-        lift.mu_q(1) = fctPre[fctNo].get<mu_q_1>().data();
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.lam_q(0) = fct_lam_q(fctNo, 0);
+        lift.lam_q(1) = fct_lam_q(fctNo, 1);
+        lift.mu_q(0) = fct_mu_q(fctNo, 0);
+        lift.mu_q(1) = fct_mu_q(fctNo, 1);
+        lift.n_q = n_q;
         lift.w = fctRule.weights().data();
         for (int i = 0; i < 2; ++i) {
             lift.E_q(i) = E_q[info.localNo[i]].data();
@@ -622,10 +757,10 @@ bool Elasticity::rhs_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<d
     rhs.E_q(0) = E_q[info.localNo[0]].data();
     rhs.f_q = f_q_raw;
     rhs.f_lifted_q = f_lifted_q;
-    rhs.g(0) = fct[fctNo].get<JInv0>().data()->data();
-    rhs.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    rhs.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    rhs.n_q = fct[fctNo].get<Normal>().data()->data();
+    rhs.g(0) = jInv_q(fctNo, 0, g_q);
+    rhs.lam_q(0) = fct_lam_q(fctNo, 0);
+    rhs.mu_q(0) = fct_mu_q(fctNo, 0);
+    rhs.n_q = n_q;
     rhs.w = fctRule.weights().data();
     rhs.execute();
 
@@ -633,9 +768,9 @@ bool Elasticity::rhs_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<d
     rhs.c20 *= -1.0;
     rhs.Dxi_q(0) = Dxi_q[info.localNo[1]].data();
     rhs.E_q(0) = E_q[info.localNo[1]].data();
-    rhs.g(0) = fct[fctNo].get<JInv1>().data()->data();
-    rhs.lam_q(0) = fctPre[fctNo].get<lam_q_1>().data();
-    rhs.mu_q(0) = fctPre[fctNo].get<mu_q_1>().data();
+    rhs.g(0) = jInv_q(fctNo, 1, g_q);
+    rhs.lam_q(0) = fct_lam_q(fctNo, 1);
+    rhs.mu_q(0) = fct_mu_q(fctNo, 1);
     rhs.execute();
 
     return true;
@@ -644,11 +779,15 @@ bool Elasticity::rhs_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<d
 bool Elasticity::rhs_boundary(std::size_t fctNo, FacetInfo const& info, Vector<double>& B0,
                               LinearAllocator<double>& scratch) const {
     alignas(ALIGNMENT) double Dx_q[tensor::Dx_q::size(0)];
+    alignas(ALIGNMENT) double g_q[tensor::g::size(0)];
     alignas(ALIGNMENT) double f_q_raw[tensor::f_q::size()];
     if (!bc_boundary(fctNo, info.bc, f_q_raw)) {
         return false;
     }
 
+    alignas(ALIGNMENT) double n_q_raw[tensor::n_q::size()];
+    double const* n_q = normal_q(fctNo, n_q_raw);
+
     alignas(ALIGNMENT) double f_lifted_q[tensor::f_lifted_q::size()];
     if (method_ == DGMethod::BR2) {
         alignas(ALIGNMENT) double f_lifted0[tensor::f_lifted::size(0)];
@@ -660,9 +799,9 @@ bool Elasticity::rhs_boundary(std::size_t fctNo, FacetInfo const& info, Vector<d
         lift.f_q = f_q_raw;
         lift.f_lifted(0) = f_lifted0;
         lift.f_lifted_q = f_lifted_q;
-        lift.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-        lift.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.lam_q(0) = fct_lam_q(fctNo, 0);
+        lift.mu_q(0) = fct_mu_q(fctNo, 0);
+        lift.n_q = n_q;
         lift.w = fctRule.weights().data();
         lift.E_q(0) = E_q[info.localNo[0]].data();
         lift.Minv(0) = Minv0;
@@ -684,10 +823,10 @@ bool Elasticity::rhs_boundary(std::size_t fctNo, FacetInfo const& info, Vector<d
     rhs.E_q(0) = E_q[info.localNo[0]].data();
     rhs.f_q = f_q_raw;
     rhs.f_lifted_q = f_lifted_q;
-    rhs.g(0) = fct[fctNo].get<JInv0>().data()->data();
-    rhs.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    rhs.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    rhs.n_q = fct[fctNo].get<Normal>().data()->data();
+    rhs.g(0) = jInv_q(fctNo, 0, g_q);
+    rhs.lam_q(0) = fct_lam_q(fctNo, 0);
+    rhs.mu_q(0) = fct_mu_q(fctNo, 0);
+    rhs.n_q = n_q;
     rhs.w = fctRule.weights().data();
     rhs.execute();
 
@@ -705,10 +844,13 @@ void Elasticity::apply_(std::size_t elNo, mneme::span<SideInfo> info,
     av.Dxi_Q = Dxi_Q.data();
     av.Dxi_Q_120 = Dxi_Q_120.data();
     av.Ju_Q = Ju_Q;
-    av.G = vol[elNo].get<JInv>().data()->data();
-    av.G_Q_T = volPre[elNo].get<JInvT>().data()->data();
-    av.lam_W_J_Q = volPre[elNo].get<lam_W_J_Q>().data();
-    av.mu_W_J_Q = volPre[elNo].get<mu_W_J_Q>().data();
+    alignas(ALIGNMENT) double G_Q[tensor::G::size()];
+    alignas(ALIGNMENT) double G_Q_T[tensor::G_Q_T::size()];
+    av.G = jInv_Q(elNo, G_Q);
+    av.G_Q_T = jInvT_Q(elNo, av.G, G_Q_T);
+    alignas(ALIGNMENT) double lam_W_J_Q[tensor::lam_W_J_Q::size()];
+    alignas(ALIGNMENT) double mu_W_J_Q[tensor::mu_W_J_Q::size()];
+    std::tie(av.lam_W_J_Q, av.mu_W_J_Q) = lam_mu_W_J_Q(elNo, lam_W_J_Q, mu_W_J_Q);
     av.U = x_0.data();
     av.Unew = y_0.data();
     av.execute();
@@ -717,19 +859,24 @@ void Elasticity::apply_(std::size_t elNo, mneme::span<SideInfo> info,
     alignas(ALIGNMENT) double Ju_q1[tensor::Ju_q::size(1)];
     alignas(ALIGNMENT) double n_q_flipped[tensor::n_q::size()];
     alignas(ALIGNMENT) double n_unit_q_flipped[tensor::n_unit_q::size()];
+    alignas(ALIGNMENT) double n_q_raw[tensor::n_q::size()];
+    alignas(ALIGNMENT) double n_unit_q_raw[tensor::n_unit_q::size()];
+    alignas(ALIGNMENT) double G_q_T0_raw[tensor::G_q_T::size(0)];
+    alignas(ALIGNMENT) double G_q_T1_raw[tensor::G_q_T::size(1)];
     for (std::size_t f = 0; f < NumFacets; ++f) {
         bool is_skeleton_face = elNo != info[f].lid;
         bool is_fault_or_dirichlet = info[f].bc == BC::Fault || info[f].bc == BC::Dirichlet;
 
         auto fctNo = info[f].fctNo;
-        double const* n_q = fct[fctNo].get<Normal>().data()->data();
-        double const* n_unit_q = fct[fctNo].get<UnitNormal>().data()->data();
-        double const* lam_q0 = fctPre[fctNo].get<lam_q_0>().data();
-        double const* lam_q1 = fctPre[fctNo].get<lam_q_1>().data();
-        double const* mu_q0 = fctPre[fctNo].get<mu_q_0>().data();
-        double const* mu_q1 = fctPre[fctNo].get<mu_q_1>().data();
-        double const* G_q_T0 = fctPre[fctNo].get<JInvT0>().data()->data();
-        double const* G_q_T1 = fctPre[fctNo].get<JInvT1>().data()->data();
+        double const* n_q = normal_q(fctNo, n_q_raw);
+        double const* n_unit_q = unit_normal_q(fctNo, n_q, n_unit_q_raw);
+        double const* lam_q0 = fct_lam_q(fctNo, 0);
+        double const* lam_q1 = fct_lam_q(fctNo, 1);
+        double const* mu_q0 = fct_mu_q(fctNo, 0);
+        double const* mu_q1 = fct_mu_q(fctNo, 1);
+        double const* G_q_T0 = jInvT_q(fctNo, 0, G_q_T0_raw);
+        // Side 1 is only read on skeleton faces
+        double const* G_q_T1 = is_skeleton_face ? jInvT_q(fctNo, 1, G_q_T1_raw) : G_q_T0;
         if (is_skeleton_face && info[f].side == 1) {
             std::swap(lam_q0, lam_q1);
             std::swap(mu_q0, mu_q1);
@@ -878,6 +1025,145 @@ void Elasticity::wave_rhs(std::size_t elNo, mneme::span<SideInfo> info,
     krnl.execute();
 }
 
+void Elasticity::wave_damping(std::size_t elNo, mneme::span<SideInfo> info,
+                              Vector<double const> const& v_0, Vector<double>& y_0) const {
+    alignas(ALIGNMENT) double Bv_raw[tensor::Unew::size()] = {};
+    bool has_damping = false;
+
+    for (std::size_t f = 0; f < NumFacets; ++f) {
+        if (info[f].bc != BC::Absorbing || elNo != info[f].lid) {
+            continue;
+        }
+        auto fctNo = info[f].fctNo;
+        auto lam_q = fct_lam_q(fctNo, 0);
+        auto mu_q = fct_mu_q(fctNo, 0);
+        auto rhoInv_field = material[elNo].get<rhoInv>();
+        auto const& matE = matE_q_T[f];
+
+        // Impedances rho c_s and rho (c_p - c_s) at the quadrature points
+        alignas(ALIGNMENT) double Zs_q[tensor::Zs_q::size()];
+        alignas(ALIGNMENT) double Zps_q[tensor::Zps_q::size()];
+        alignas(ALIGNMENT) double n_unit_q[tensor::n_unit_q::size()];
+        for (std::size_t q = 0; q < fctRule.size(); ++q) {
+            double rhoInv_q = 0.0;
+            for (std::size_t t = 0; t < rhoInv_field.size(); ++t) {
+                rhoInv_q += matE(q, t) * rhoInv_field[t];
+            }
+            double rho_q = 1.0 / rhoInv_q;
+            Zs_q[q] = std::sqrt(rho_q * mu_q[q]);
+            Zps_q[q] = std::sqrt(rho_q * (lam_q[q] + 2.0 * mu_q[q])) - Zs_q[q];
+        }
+
+        kernel::absorbing_facet af;
+        af.E_q(0) = E_q[f].data();
+        af.n_unit_q = unit_normal_q(fctNo, n_unit_q);
+        af.nl_q = fct[fctNo].get<NormalLength>().data();
+        af.U = v_0.data();
+        af.Unew = Bv_raw;
+        af.w = fctRule.weights().data();
+        af.Zps_q = Zps_q;
+        af.Zs_q = Zs_q;
+        af.execute();
+        has_damping = true;
+    }
+
+    if (has_sponge_[elNo]) {
+        kernel::sponge_volume sv;
+        sv.damping_W_J_Q = volPre[elNo].get<damping_W_J_Q>().data();
+        sv.E_Q = E_Q.data();
+        sv.U = v_0.data();
+        sv.Unew = Bv_raw;
+        sv.execute();
+        has_damping = true;
+    }
+
+    if (!has_damping) {
+        return;
+    }
+
+    alignas(ALIGNMENT) double damping_raw[tensor::Unew::size()];
+    kernel::apply_inverse_mass krnl;
+    krnl.E_Q = E_Q.data();
+    krnl.MinvRef = MhatInv.data();
+    krnl.Jinv_Q = volPre[elNo].get<negative_rhoInv_W_Jinv_Q>().data();
+    krnl.U = Bv_raw;
+    krnl.Unew = damping_raw;
+    krnl.execute();
+    for (std::size_t i = 0; i < y_0.size(); ++i) {
+        y_0(i) += damping_raw[i];
+    }
+}
+
+void Elasticity::setup_wave_mass(std::size_t numLocalElements) {
+    if (!waveMass_.empty()) {
+        return;
+    }
+    std::size_t nbf = space_.numBasisFunctions();
+    std::size_t nq = volRule.size();
+    Eigen::MatrixXd Mhat = EigenMap(MhatInv).inverse();
+    auto E = EigenMap(E_Q);
+
+    waveMass_.resize(numLocalElements * nbf * nbf);
+    for (std::size_t elNo = 0; elNo < numLocalElements; ++elNo) {
+        auto w = Eigen::Map<Eigen::VectorXd const>(
+            volPre[elNo].get<negative_rhoInv_W_Jinv_Q>().data(), nq);
+        Eigen::MatrixXd M_rhoInv_Jinv = -E * w.asDiagonal() * E.transpose();
+        auto M = Eigen::Map<Eigen::MatrixXd>(waveMass_.data() + elNo * nbf * nbf, nbf, nbf);
+        M = Mhat * M_rhoInv_Jinv.llt().solve(Mhat);
+    }
+}
+
+void Elasticity::wave_mass(std::size_t elNo, Vector<double const> const& x_0,
+                           Vector<double>& y_0) const {
+    assert(!waveMass_.empty());
+    std::size_t nbf = space_.numBasisFunctions();
+    auto M = Eigen::Map<Eigen::MatrixXd const>(waveMass_.data() + elNo * nbf * nbf, nbf, nbf);
+    auto x = Eigen::Map<Eigen::MatrixXd const>(x_0.data(), nbf, NumQuantities);
+    auto y = Eigen::Map<Eigen::MatrixXd>(y_0.data(), nbf, NumQuantities);
+    y = M * x;
+}
+
+bool Elasticity::assemble_wave_mass(std::size_t elNo, Matrix<double>& A00,
+                                    LinearAllocator<double>&) const {
+    assert(!waveMass_.empty());
+    std::size_t nbf = space_.numBasisFunctions();
+    auto M = Eigen::Map<Eigen::MatrixXd const>(waveMass_.data() + elNo * nbf * nbf, nbf, nbf);
+    A00.set_zero();
+    for (std::size_t p = 0; p < NumQuantities; ++p) {
+        for (std::size_t l = 0; l < nbf; ++l) {
+            for (std::size_t k = 0; k < nbf; ++k) {
+                A00(k + p * nbf, l + p * nbf) = M(k, l);
+            }
+        }
+    }
+    return true;
+}
+
+auto Elasticity::near_null_space() const -> std::vector<volume_functional_t> {
+    std::vector<volume_functional_t> modes;
+    for (std::size_t d = 0; d < Dim; ++d) {
+        modes.emplace_back(make_volume_functional(
+            functional_t<NumQuantities>([d](std::array<double, Dim> const&) {
+                std::array<double, NumQuantities> u = {};
+                u[d] = 1.0;
+                return u;
+            })));
+    }
+    // Infinitesimal rotation in the (i, j)-plane
+    for (std::size_t i = 0; i < Dim; ++i) {
+        for (std::size_t j = i + 1; j < Dim; ++j) {
+            modes.emplace_back(make_volume_functional(
+                functional_t<NumQuantities>([i, j](std::array<double, Dim> const& x) {
+                    std::array<double, NumQuantities> u = {};
+                    u[i] = -x[j];
+                    u[j] = x[i];
+                    return u;
+                })));
+        }
+    }
+    return modes;
+}
+
 void Elasticity::project(std::size_t elNo, volume_functional_t x, Vector<double>& y) const {
     alignas(ALIGNMENT) double U_Q_raw[tensor::U_Q::size()];
     alignas(ALIGNMENT) double U_raw[tensor::U::size()];
@@ -928,6 +1214,13 @@ std::size_t Elasticity::flops_apply(std::size_t elNo, mneme::span<SideInfo> info
     return flops;
 }
 
+std::size_t Elasticity::geometry_memory() const {
+    std::size_t bytes = base::geometry_memory();
+    bytes += volPreGeo.size() * volRule.size() * sizeof(JInvT::type);
+    bytes += fctPre.size() * fctRule.size() * (sizeof(JInvT0::type) + sizeof(JInvT1::type));
+    return bytes;
+}
+
 void Elasticity::coefficients_volume(std::size_t elNo, Matrix<double>& C,
                                      LinearAllocator<double>&) const {
     auto const coeff_lam = material[elNo].get<lam>();
@@ -955,17 +1248,20 @@ void Elasticity::traction_skeleton(std::size_t fctNo, FacetInfo const& info,
     alignas(ALIGNMENT) double Dx_q0[tensor::Dx_q::size(0)];
     alignas(ALIGNMENT) double Dx_q1[tensor::Dx_q::size(1)];
 
+    alignas(ALIGNMENT) double g0[tensor::g::size(0)];
+    alignas(ALIGNMENT) double g1[tensor::g::size(1)];
     kernel::Dx_q dxKrnl;
     dxKrnl.Dx_q(0) = Dx_q0;
     dxKrnl.Dx_q(1) = Dx_q1;
-    dxKrnl.g(0) = fct[fctNo].get<JInv0>().data()->data();
-    dxKrnl.g(1) = fct[fctNo].get<JInv1>().data()->data();
+    dxKrnl.g(0) = jInv_q(fctNo, 0, g0);
+    dxKrnl.g(1) = jInv_q(fctNo, 1, g1);
     for (unsigned side = 0; side < 2; ++side) {
         dxKrnl.Dxi_q(side) = Dxi_q[info.localNo[side]].data();
         dxKrnl.execute(side);
     }
 
     alignas(ALIGNMENT) double f_q_raw[tensor::f_q::size()];
+    alignas(ALIGNMENT) double n_unit_q[tensor::n_unit_q::size()];
     bc_skeleton(fctNo, info.bc, f_q_raw);
 
     kernel::compute_traction krnl;
@@ -975,11 +1271,11 @@ void Elasticity::traction_skeleton(std::size_t fctNo, FacetInfo const& info,
     krnl.E_q(0) = E_q[info.localNo[0]].data();
     krnl.E_q(1) = E_q[info.localNo[1]].data();
     krnl.f_q = f_q_raw;
-    krnl.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    krnl.lam_q(1) = fctPre[fctNo].get<lam_q_1>().data();
-    krnl.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    krnl.mu_q(1) = fctPre[fctNo].get<mu_q_1>().data();
-    krnl.n_unit_q = fct[fctNo].get<UnitNormal>().data()->data();
+    krnl.lam_q(0) = fct_lam_q(fctNo, 0);
+    krnl.lam_q(1) = fct_lam_q(fctNo, 1);
+    krnl.mu_q(0) = fct_mu_q(fctNo, 0);
+    krnl.mu_q(1) = fct_mu_q(fctNo, 1);
+    krnl.n_unit_q = unit_normal_q(fctNo, n_unit_q);
     krnl.traction_q = result.data();
     krnl.u(0) = u0.data();
     krnl.u(1) = u1.data();
@@ -994,13 +1290,15 @@ void Elasticity::traction_boundary(std::size_t fctNo, FacetInfo const& info,
 
     alignas(ALIGNMENT) double Dx_q0[tensor::Dx_q::size(0)];
 
+    alignas(ALIGNMENT) double g0[tensor::g::size(0)];
     kernel::Dx_q dxKrnl;
     dxKrnl.Dx_q(0) = Dx_q0;
-    dxKrnl.g(0) = fct[fctNo].get<JInv0>().data()->data();
+    dxKrnl.g(0) = jInv_q(fctNo, 0, g0);
     dxKrnl.Dxi_q(0) = Dxi_q[info.localNo[0]].data();
     dxKrnl.execute(0);
 
     alignas(ALIGNMENT) double f_q_raw[tensor::f_q::size()];
+    alignas(ALIGNMENT) double n_unit_q[tensor::n_unit_q::size()];
     bc_boundary(fctNo, info.bc, f_q_raw);
 
     kernel::compute_traction_bnd krnl;
@@ -1008,9 +1306,9 @@ void Elasticity::traction_boundary(std::size_t fctNo, FacetInfo const& info,
     krnl.Dx_q(0) = Dx_q0;
     krnl.E_q(0) = E_q[info.localNo[0]].data();
     krnl.f_q = f_q_raw;
-    krnl.lam_q(0) = fctPre[fctNo].get<lam_q_0>().data();
-    krnl.mu_q(0) = fctPre[fctNo].get<mu_q_0>().data();
-    krnl.n_unit_q = fct[fctNo].get<UnitNormal>().data()->data();
+    krnl.lam_q(0) = fct_lam_q(fctNo, 0);
+    krnl.mu_q(0) = fct_mu_q(fctNo, 0);
+    krnl.n_unit_q = unit_normal_q(fctNo, n_unit_q);
     krnl.traction_q = result.data();
     krnl.u(0) = u0.data();
     krnl.execute();
@@ -22,6 +22,8 @@
 #include <array>
 #include <cstddef>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -37,10 +39,13 @@ public:
 
     Elasticity(std::shared_ptr<Curvilinear<DomainDimension>> cl, functional_t<1> lam,
                functional_t<1> mu, std::optional<functional_t<1>> rho = std::nullopt,
-               DGMethod method = DGMethod::IP);
+               DGMethod method = DGMethod::IP,
+               std::optional<functional_t<1>> damping = std::nullopt,
+               GeometryMode geometry = GeometryMode::Stored);
 
     constexpr std::size_t alignment() const { return ALIGNMENT; }
     std::size_t block_size() const { return space_.numBasisFunctions() * NumQuantities; }
+    auto degree_projector(unsigned degree) const { return space_.degreeProjector(degree); }
     auto make_interpolation_op() const {
         return std::make_unique<NodalInterpolation<Dim>>(
             PolynomialDegree, WarpAndBlendFactory<Dim>(), NumQuantities, alignment());
@@ -76,9 +81,38 @@ public:
     void wave_rhs(std::size_t elNo, mneme::span<SideInfo> info, Vector<double const> const& x_0,
                   std::array<Vector<double const>, NumFacets> const& x_n,
                   Vector<double>& y_0) const;
+    /**
+     * @brief Adds -M_rho^{-1} B v to y_0, where B is the damping matrix of absorbing boundaries
+     * and sponge layers.
+     *
+     * Absorbing boundaries are Lysmer-Kuhlemeyer dashpots, i.e. the traction on the boundary is
+     * -rho * (c_p * (v.n) n + c_s * (v - (v.n) n)), which absorbs waves at normal incidence.
+     * In the sponge layer, the acceleration is damped by -damping(x) * v.
+     */
+    void wave_damping(std::size_t elNo, mneme::span<SideInfo> info,
+                      Vector<double const> const& v_0, Vector<double>& y_0) const;
+    /**
+     * @brief Precomputes the mass matrix M_rho of wave_rhs for the local elements.
+     *
+     * wave_rhs applies the weight-adjusted inverse M_rho^{-1} = Mhat^{-1} M_{1/(rho J)} Mhat^{-1},
+     * hence M_rho = Mhat M_{1/(rho J)}^{-1} Mhat is formed explicitly.
+     * The matrices are only required by implicit time integrators and are computed on first use.
+     */
+    void setup_wave_mass(std::size_t numLocalElements);
+    /**
+     * @brief Computes y_0 = M_rho x_0 (requires setup_wave_mass)
+     */
+    void wave_mass(std::size_t elNo, Vector<double const> const& x_0, Vector<double>& y_0) const;
+    bool assemble_wave_mass(std::size_t elNo, Matrix<double>& A00,
+                            LinearAllocator<double>& scratch) const;
     void project(std::size_t elNo, volume_functional_t x, Vector<double>& y) const;
+    /**
+     * @brief Rigid body modes, i.e. Dim translations and Dim (Dim - 1) / 2 rotations.
+     */
+    std::vector<volume_functional_t> near_null_space() const;
 
     std::size_t flops_apply(std::size_t elNo, mneme::span<SideInfo> info) const;
+    std::size_t geometry_memory() const;
 
     TensorBase<Matrix<double>> tractionResultInfo() const;
     void traction_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<double const>& u0,
@@ -122,6 +156,13 @@ public:
         fun_slip = make_facet_functional(std::move(fun), refNormal);
     }
     void set_slip(facet_functional_t fun) { fun_slip = std::move(fun); }
+    /**
+     * @brief Store the Lame parameters of constant-material elements compactly (default: true)
+     *
+     * Must be set before preparation. With false, every element keeps full per-quadrature-point
+     * storage, which is only useful as reference.
+     */
+    void set_compact_material(bool compact) { compactMaterial_ = compact; }
 
 private:
     template <bool WithRHS>
@@ -141,6 +182,8 @@ private:
     bool bc_skeleton(std::size_t fctNo, BC bc, double f_q_raw[]) const;
     bool bc_boundary(std::size_t fctNo, BC bc, double f_q_raw[]) const;
     void transpose_JInv(std::size_t fctNo, int side);
+    double const* jInvT_Q(std::size_t elNo, double const* G, double* buffer) const;
+    double const* jInvT_q(std::size_t fctNo, int side, double* buffer) const;
 
     DGMethod method_;
 
@@ -169,6 +212,7 @@ private:
     volume_functional_t fun_lam;
     volume_functional_t fun_mu;
     volume_functional_t fun_rho;
+    std::optional<volume_functional_t> fun_damping = std::nullopt;
     std::optional<volume_functional_t> fun_force = std::nullopt;
     std::optional<facet_functional_t> fun_dirichlet = std::nullopt;
     std::optional<facet_functional_t> fun_slip = std::nullopt;
@@ -186,31 +230,11 @@ private:
         using type = double;
         using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
     };
-    struct lam_W_J_Q {
-        using type = double;
-        using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
-    };
-    struct mu_W_J_Q {
-        using type = double;
-        using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
-    };
     struct negative_rhoInv_W_Jinv_Q {
         using type = double;
         using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
     };
-    struct lam_q_0 {
-        using type = double;
-        using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
-    };
-    struct mu_q_0 {
-        using type = double;
-        using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
-    };
-    struct lam_q_1 {
-        using type = double;
-        using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
-    };
-    struct mu_q_1 {
+    struct damping_W_J_Q {
         using type = double;
         using allocator = mneme::AlignedAllocator<type, ALIGNMENT>;
     };
@@ -230,16 +254,54 @@ private:
     using material_vol_t = mneme::MultiStorage<mneme::DataLayout::SoA, lam, mu, rhoInv>;
     mneme::StridedView<material_vol_t> material;
 
-    using vol_pre_t = mneme::MultiStorage<mneme::DataLayout::SoA, lam_W_J_Q, mu_W_J_Q,
-                                          negative_rhoInv_W_Jinv_Q, JInvT>;
+    using vol_pre_t =
+        mneme::MultiStorage<mneme::DataLayout::SoA, negative_rhoInv_W_Jinv_Q, damping_W_J_Q>;
     mneme::StridedView<vol_pre_t> volPre;
 
-    using fct_pre_t = mneme::MultiStorage<mneme::DataLayout::SoA, lam_q_0, mu_q_0, lam_q_1, mu_q_1,
-                                          JInvT0, JInvT1>;
+    // Transposed metric terms (only allocated in stored mode)
+    using vol_pre_geo_t = mneme::MultiStorage<mneme::DataLayout::SoA, JInvT>;
+    mneme::StridedView<vol_pre_geo_t> volPreGeo;
+
+    using fct_pre_t = mneme::MultiStorage<mneme::DataLayout::SoA, JInvT0, JInvT1>;
     mneme::StridedView<fct_pre_t> fctPre;
 
+    /*
+     * Compressed Lame parameters at quadrature points.
+     *
+     * Elements whose nodal lam and mu are constant (up to round-off) only store the constant
+     * pair; lam W J and mu W J are then formed on the fly. Otherwise, a block [lam W J, mu W J]
+     * is stored in volMaterial_. On facets, every side points to a block [lam_q, mu_q] in
+     * fctMaterial_; constant sides with equal parameters share a single block.
+     */
+    using material_storage_t = std::vector<double, mneme::AlignedAllocator<double, ALIGNMENT>>;
+    constexpr static std::size_t ConstantMaterial = std::numeric_limits<std::size_t>::max();
+
+    std::size_t padded(std::size_t n) const {
+        constexpr std::size_t P = ALIGNMENT / sizeof(double);
+        return P > 1 ? (n + P - 1) / P * P : n;
+    }
+    std::size_t add_facet_material(std::size_t elNo, unsigned localNo);
+    std::pair<double const*, double const*> lam_mu_W_J_Q(std::size_t elNo, double* lam_buffer,
+                                                         double* mu_buffer) const;
+    double const* fct_lam_q(std::size_t fctNo, int side) const {
+        return fctMaterial_.data() + fctMaterialOffset_[fctNo][side];
+    }
+    double const* fct_mu_q(std::size_t fctNo, int side) const {
+        return fct_lam_q(fctNo, side) + padded(fctRule.size());
+    }
+
+    std::vector<std::pair<double, double>> lamMuConst_;
+    std::vector<std::size_t> volMaterialOffset_;
+    material_storage_t volMaterial_;
+    std::vector<std::array<std::size_t, 2>> fctMaterialOffset_;
+    material_storage_t fctMaterial_;
+    std::map<std::pair<double, double>, std::size_t> fctMaterialPool_;
+
     std::vector<double> penalty_;
     std::vector<double> cfl_dt_;
+    std::vector<double> waveMass_; ///< M_rho per local element (empty if not set up)
+    std::vector<bool> has_sponge_;
+    bool compactMaterial_ = true;
 
     // Options
     constexpr static double epsilon = -1.0;
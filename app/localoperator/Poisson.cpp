@@ -11,12 +11,17 @@
 #include "form/RefElement.h"
 #include "geometry/Curvilinear.h"
 #include "quadrules/SimplexQuadratureRule.h"
+#include "quadrules/TensorProductRule.h"
 #include "tensor/EigenMap.h"
 #include "util/LinearAllocator.h"
 
+#include <Eigen/Cholesky>
 #include <Eigen/Core>
 #include <Eigen/LU>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 
 namespace tensor = tndm::poisson::tensor;
 namespace init = tndm::poisson::init;
@@ -29,6 +34,9 @@ Poisson::Poisson(std::shared_ptr<Curvilinear<DomainDimension>> cl, functional_t<
     : DGCurvilinearCommon<DomainDimension>(std::move(cl), MinQuadOrder()), method_(method),
       space_(PolynomialDegree, ALIGNMENT),
       materialSpace_(PolynomialDegree, WarpAndBlendFactory<DomainDimension>(), ALIGNMENT),
+#ifdef TANDEM_SUM_FACTORIZATION
+      sumFact_(PolynomialDegree, MinQuadOrder()),
+#endif
       fun_K(make_volume_functional(std::move(K))), fun_force(zero_volume_function),
       fun_dirichlet(zero_facet_function), fun_slip(zero_facet_function) {
 
@@ -89,7 +97,7 @@ void Poisson::compute_K_Dx_q(std::size_t fctNo, FacetInfo const& info,
     kernel::K_Dx_q dx;
     for (int i = 0; i < 2; ++i) {
         if (K_Dx_q[i]) {
-            auto JInv = (i == 1) ? fct[fctNo].get<JInv1>() : fct[fctNo].get<JInv0>();
+            auto JInv = (i == 1) ? fctGeo[fctNo].get<JInv1>() : fctGeo[fctNo].get<JInv0>();
             dx.G_q = JInv.data()->data();
             dx.matE_q_T = matE_q_T[info.localNo[i]].data();
             dx.K = material[info.up[i]].get<K>().data();
@@ -170,8 +178,8 @@ void Poisson::prepare_skeleton(std::size_t fctNo, FacetInfo const& info,
 
     for (int side = 0; side < 2; ++side) {
         kernel::K_G_q k;
-        k.G_q = side == 1 ? fct[fctNo].get<JInv1>().data()->data()
-                          : fct[fctNo].get<JInv0>().data()->data();
+        k.G_q = side == 1 ? fctGeo[fctNo].get<JInv1>().data()->data()
+                          : fctGeo[fctNo].get<JInv0>().data()->data();
         k.K = material[info.up[side]].get<K>().data();
         k.K_G_q(0) = side == 1 ? fctPre[fctNo].get<KJInv1>().data()->data()
                                : fctPre[fctNo].get<KJInv0>().data()->data();
@@ -185,7 +193,7 @@ void Poisson::prepare_boundary(std::size_t fctNo, FacetInfo const& info,
     base::prepare_boundary(fctNo, info, scratch);
 
     kernel::K_G_q k;
-    k.G_q = fct[fctNo].get<JInv0>().data()->data();
+    k.G_q = fctGeo[fctNo].get<JInv0>().data()->data();
     k.K = material[info.up[0]].get<K>().data();
     k.K_G_q(0) = fctPre[fctNo].get<KJInv0>().data()->data();
     k.matE_q_T = matE_q_T[info.localNo[0]].data();
@@ -234,7 +242,7 @@ bool Poisson::assemble_volume(std::size_t elNo, Matrix<double>& A00,
     kernel::Dx_Q dx;
     dx.Dx_Q = Dx_Q;
     dx.Dxi_Q = Dxi_Q.data();
-    dx.G_Q = vol[elNo].get<JInv>().data()->data();
+    dx.G_Q = volGeo[elNo].get<JInv>().data()->data();
     dx.execute();
 
     kernel::assembleVolume krnl;
@@ -281,7 +289,7 @@ bool Poisson::assemble_skeleton(std::size_t fctNo, FacetInfo const& info, Matrix
         kernel::lift_skeleton lift;
         lift.Lift(0) = Lift0;
         lift.Lift(1) = Lift1;
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.n_q = fctGeo[fctNo].get<Normal>().data()->data();
         lift.w = fctRule.weights().data();
         for (int i = 0; i < 2; ++i) {
             lift.K_q(i) = K_q[i];
@@ -318,7 +326,7 @@ bool Poisson::assemble_skeleton(std::size_t fctNo, FacetInfo const& info, Matrix
         assemble.E_q(i) = E_q[info.localNo[i]].data();
         assemble.L_q(i) = L_q[i];
     }
-    assemble.n_q = fct[fctNo].get<Normal>().data()->data();
+    assemble.n_q = fctGeo[fctNo].get<Normal>().data()->data();
     assemble.w = fctRule.weights().data();
     assemble.execute(0, 0);
     assemble.execute(0, 1);
@@ -330,7 +338,7 @@ bool Poisson::assemble_skeleton(std::size_t fctNo, FacetInfo const& info, Matrix
 
 bool Poisson::assemble_boundary(std::size_t fctNo, FacetInfo const& info, Matrix<double>& A00,
                                 LinearAllocator<double>& scratch) const {
-    if (info.bc == BC::Natural) {
+    if (info.bc == BC::Natural || info.bc == BC::Absorbing || info.bc == BC::Exterior) {
         return false;
     }
 
@@ -356,7 +364,7 @@ bool Poisson::assemble_boundary(std::size_t fctNo, FacetInfo const& info, Matrix
         lift.L_q(0) = L0;
         lift.Minv(0) = Minv0;
         lift.E_q(0) = E_q[info.localNo[0]].data();
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.n_q = fctGeo[fctNo].get<Normal>().data()->data();
         lift.w = fctRule.weights().data();
         lift.execute();
     } else { // IP
@@ -378,7 +386,7 @@ bool Poisson::assemble_boundary(std::size_t fctNo, FacetInfo const& info, Matrix
     assemble.K_Dx_q(0) = K_Dx_q0;
     assemble.E_q(0) = E_q[info.localNo[0]].data();
     assemble.L_q(0) = L0;
-    assemble.n_q = fct[fctNo].get<Normal>().data()->data();
+    assemble.n_q = fctGeo[fctNo].get<Normal>().data()->data();
     assemble.w = fctRule.weights().data();
     assemble.execute(0, 0);
     return true;
@@ -457,7 +465,7 @@ bool Poisson::rhs_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<doub
             lift.K_q(i) = K_q[i];
             lift.Minv(i) = Minv[i];
         }
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.n_q = fctGeo[fctNo].get<Normal>().data()->data();
         lift.f_q = f_q_raw;
         lift.f_lifted(0) = f_lifted0;
         lift.f_lifted(1) = f_lifted1;
@@ -482,7 +490,7 @@ bool Poisson::rhs_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<doub
     rhs.c20 = penalty(fctNo);
     rhs.f_q = f_q_raw;
     rhs.f_lifted_q = f_lifted_q;
-    rhs.n_q = fct[fctNo].get<Normal>().data()->data();
+    rhs.n_q = fctGeo[fctNo].get<Normal>().data()->data();
     rhs.w = fctRule.weights().data();
     rhs.K_Dx_q(0) = K_Dx_q0;
     rhs.E_q(0) = E_q[info.localNo[0]].data();
@@ -515,7 +523,7 @@ bool Poisson::rhs_boundary(std::size_t fctNo, FacetInfo const& info, Vector<doub
 
         kernel::rhs_lift_boundary lift;
         lift.E_q(0) = E_q[info.localNo[0]].data();
-        lift.n_q = fct[fctNo].get<Normal>().data()->data();
+        lift.n_q = fctGeo[fctNo].get<Normal>().data()->data();
         lift.K_q(0) = K_q;
         lift.Minv(0) = M0;
         lift.f_q = f_q_raw;
@@ -540,7 +548,7 @@ bool Poisson::rhs_boundary(std::size_t fctNo, FacetInfo const& info, Vector<doub
     rhs.c20 = penalty(fctNo);
     rhs.f_q = f_q_raw;
     rhs.f_lifted_q = f_lifted_q;
-    rhs.n_q = fct[fctNo].get<Normal>().data()->data();
+    rhs.n_q = fctGeo[fctNo].get<Normal>().data()->data();
     rhs.w = fctRule.weights().data();
     rhs.K_Dx_q(0) = K_Dx_q0;
     rhs.E_q(0) = E_q[info.localNo[0]].data();
@@ -552,15 +560,46 @@ void Poisson::apply(std::size_t elNo, mneme::span<SideInfo> info, Vector<double
                     std::array<Vector<double const>, NumFacets> const& x_n,
                     Vector<double>& y_0) const {
 
+#ifdef TANDEM_SUM_FACTORIZATION
+    // Same as apply_volume but with sum factorisation in the collapsed coordinates
+    constexpr std::size_t NumPointsPerDim = TensorProductRule<Dim>::pointsPerDim(MinQuadOrder());
+    constexpr std::size_t NumQuadPoints = TensorProductRule<Dim>::size(MinQuadOrder());
+    assert(NumQuadPoints == volRule.size());
+    alignas(ALIGNMENT) double grad[Dim * NumQuadPoints];
+    alignas(ALIGNMENT) double scratch[SumFactorization<Dim>::scratch_size(PolynomialDegree,
+                                                                          NumPointsPerDim)];
+    sumFact_.evaluate_gradient(x_0.data(), grad, scratch);
+    double const* G_Q = volGeo[elNo].get<JInv>().data()->data();
+    double const* J_W_K_Q = volPre[elNo].get<AbsDetJWK>().data()->data();
+    for (std::size_t q = 0; q < volRule.size(); ++q) {
+        double* g = grad + Dim * q;
+        double const* G = G_Q + Dim * Dim * q;
+        std::array<double, Dim> gx = {};
+        for (std::size_t r = 0; r < Dim; ++r) {
+            for (std::size_t e = 0; e < Dim; ++e) {
+                gx[r] += G[e + Dim * r] * g[e];
+            }
+            gx[r] *= J_W_K_Q[q];
+        }
+        for (std::size_t e = 0; e < Dim; ++e) {
+            g[e] = 0.0;
+            for (std::size_t r = 0; r < Dim; ++r) {
+                g[e] += G[e + Dim * r] * gx[r];
+            }
+        }
+    }
+    sumFact_.integrate_gradient(grad, y_0.data(), scratch);
+#else
     alignas(ALIGNMENT) double Dx_Q[tensor::Dx_Q::size()];
     kernel::apply_volume av;
     av.Dx_Q = Dx_Q;
     av.Dxi_Q = Dxi_Q.data();
-    av.G_Q = vol[elNo].get<JInv>().data()->data();
+    av.G_Q = volGeo[elNo].get<JInv>().data()->data();
     av.J_W_K_Q = volPre[elNo].get<AbsDetJWK>().data()->data();
     av.U = x_0.data();
     av.U_new = y_0.data();
     av.execute();
+#endif
 
     alignas(ALIGNMENT) double n_q_flipped[tensor::n_q::size()];
     alignas(ALIGNMENT) double n_unit_q_flipped[tensor::n_unit_q::size()];
@@ -569,8 +608,8 @@ void Poisson::apply(std::size_t elNo, mneme::span<SideInfo> info, Vector<double
         bool is_fault_or_dirichlet = info[f].bc == BC::Fault || info[f].bc == BC::Dirichlet;
 
         auto fctNo = info[f].fctNo;
-        double const* n_q = fct[fctNo].get<Normal>().data()->data();
-        double const* n_unit_q = fct[fctNo].get<UnitNormal>().data()->data();
+        double const* n_q = fctGeo[fctNo].get<Normal>().data()->data();
+        double const* n_unit_q = fctGeo[fctNo].get<UnitNormal>().data()->data();
         double const* K_G_q0 = fctPre[fctNo].get<KJInv0>().data()->data();
         double const* K_G_q1 = fctPre[fctNo].get<KJInv1>().data()->data();
         if (is_skeleton_face && info[f].side == 1) {
@@ -644,7 +683,11 @@ void Poisson::apply(std::size_t elNo, mneme::span<SideInfo> info, Vector<double
 }
 
 std::size_t Poisson::flops_apply(std::size_t elNo, mneme::span<SideInfo> info) const {
+#ifdef TANDEM_SUM_FACTORIZATION
+    std::size_t flops = sumFact_.flops_gradient() + volRule.size() * (4 * Dim * Dim + Dim);
+#else
     std::size_t flops = kernel::apply_volume::HardwareFlops;
+#endif
     for (std::size_t f = 0; f < NumFacets; ++f) {
         bool is_skeleton_face = elNo != info[f].lid;
         bool is_fault_or_dirichlet = info[f].bc == BC::Fault || info[f].bc == BC::Dirichlet;
@@ -662,6 +705,185 @@ std::size_t Poisson::flops_apply(std::size_t elNo, mneme::span<SideInfo> info) c
     return flops;
 }
 
+double Poisson::max_K(std::size_t elNo) const {
+    auto Kfield = material[elNo].get<K>().data();
+    return *std::max_element(Kfield, Kfield + materialSpace_.numBasisFunctions());
+}
+
+void Poisson::compute_normal_flux_q(std::size_t fctNo, FacetInfo const& info, int side,
+                                    Vector<double const> const& u, double* u_q,
+                                    double* flux_q) const {
+    auto const& E = E_q[info.localNo[side]];
+    auto const& Dxi = Dxi_q[info.localNo[side]];
+    auto const& KG_q = side == 1 ? fctPre[fctNo].get<KJInv1>() : fctPre[fctNo].get<KJInv0>();
+    auto const& n_q = fctGeo[fctNo].get<UnitNormal>();
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        std::array<double, Dim> grad_xi = {};
+        u_q[q] = 0.0;
+        for (std::size_t k = 0; k < E.shape(0); ++k) {
+            u_q[q] += E(k, q) * u(k);
+            for (std::size_t e = 0; e < Dim; ++e) {
+                grad_xi[e] += Dxi(k, e, q) * u(k);
+            }
+        }
+        flux_q[q] = 0.0;
+        for (std::size_t i = 0; i < Dim; ++i) {
+            for (std::size_t e = 0; e < Dim; ++e) {
+                flux_q[q] += n_q[q][i] * KG_q[q][e + i * Dim] * grad_xi[e];
+            }
+        }
+    }
+}
+
+double Poisson::error_indicator_volume(std::size_t elNo, Vector<double const> const& u0,
+                                       LinearAllocator<double>& scratch) const {
+    std::size_t const Nbf = space_.numBasisFunctions();
+    auto const& G_Q = volGeo[elNo].get<JInv>();
+    auto const& J_Q = vol[elNo].get<AbsDetJ>();
+    auto Kfield = material[elNo].get<K>().data();
+
+    alignas(ALIGNMENT) double F_Q_raw[tensor::F_Q::size()];
+    auto F_Q = Matrix<double>(F_Q_raw, 1, tensor::F_Q::Shape[0]);
+    fun_force(elNo, F_Q);
+
+    auto const Dx = [&](std::size_t k, std::size_t i, std::size_t q) {
+        double dx = 0.0;
+        for (std::size_t e = 0; e < Dim; ++e) {
+            dx += G_Q[q][e + i * Dim] * Dxi_Q(k, e, q);
+        }
+        return dx;
+    };
+
+    // L2 projection of K grad u onto the modal space
+    auto M = Eigen::Map<Eigen::MatrixXd>(scratch.allocate(Nbf * Nbf), Nbf, Nbf);
+    auto flux = Eigen::Map<Eigen::MatrixXd>(scratch.allocate(Nbf * Dim), Nbf, Dim);
+    M.setZero();
+    flux.setZero();
+    for (std::size_t q = 0; q < volRule.size(); ++q) {
+        double K_q = 0.0;
+        for (std::size_t m = 0; m < materialSpace_.numBasisFunctions(); ++m) {
+            K_q += matE_Q_T(q, m) * Kfield[m];
+        }
+        std::array<double, Dim> grad_u = {};
+        for (std::size_t k = 0; k < Nbf; ++k) {
+            for (std::size_t i = 0; i < Dim; ++i) {
+                grad_u[i] += Dx(k, i, q) * u0(k);
+            }
+        }
+        double wJ = volRule.weights()[q] * J_Q[q];
+        for (std::size_t k = 0; k < Nbf; ++k) {
+            for (std::size_t l = 0; l < Nbf; ++l) {
+                M(k, l) += wJ * E_Q(k, q) * E_Q(l, q);
+            }
+            for (std::size_t i = 0; i < Dim; ++i) {
+                flux(k, i) += wJ * E_Q(k, q) * K_q * grad_u[i];
+            }
+        }
+    }
+    // In-place Cholesky factorisation such that nothing is allocated on the heap
+    Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>> llt(M);
+    llt.solveInPlace(flux);
+
+    double r2 = 0.0;
+    for (std::size_t q = 0; q < volRule.size(); ++q) {
+        double r = F_Q(0, q);
+        for (std::size_t k = 0; k < Nbf; ++k) {
+            for (std::size_t i = 0; i < Dim; ++i) {
+                r += flux(k, i) * Dx(k, i, q);
+            }
+        }
+        r2 += volRule.weights()[q] * J_Q[q] * r * r;
+    }
+
+    constexpr double p = std::max(PolynomialDegree, 1u);
+    double h = std::pow(volume_[elNo], 1.0 / Dim);
+    return h * h / (p * p * max_K(elNo)) * r2;
+}
+
+double Poisson::error_indicator_skeleton(std::size_t fctNo, FacetInfo const& info,
+                                         Vector<double const> const& u0,
+                                         Vector<double const> const& u1,
+                                         LinearAllocator<double>&) const {
+    alignas(ALIGNMENT) double f_q[tensor::f_q::size()];
+    bool has_jump = bc_skeleton(fctNo, info.bc, f_q);
+
+    alignas(ALIGNMENT) double u_q[2][tensor::f_q::size()];
+    alignas(ALIGNMENT) double flux_q[2][tensor::f_q::size()];
+    compute_normal_flux_q(fctNo, info, 0, u0, u_q[0], flux_q[0]);
+    compute_normal_flux_q(fctNo, info, 1, u1, u_q[1], flux_q[1]);
+
+    auto const& nl_q = fct[fctNo].get<NormalLength>();
+    double flux_jump2 = 0.0;
+    double jump2 = 0.0;
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        double w = fctRule.weights()[q] * nl_q[q];
+        double flux_jump = flux_q[0][q] - flux_q[1][q];
+        double jump = u_q[0][q] - u_q[1][q] - (has_jump ? f_q[q] : 0.0);
+        flux_jump2 += w * flux_jump * flux_jump;
+        jump2 += w * jump * jump;
+    }
+
+    constexpr double p = std::max(PolynomialDegree, 1u);
+    double h = std::pow(area_[fctNo], 1.0 / (Dim - 1u));
+    double K_max = std::max(max_K(info.up[0]), max_K(info.up[1]));
+    return h / (p * K_max) * flux_jump2 + penalty_[fctNo] * jump2;
+}
+
+double Poisson::error_indicator_boundary(std::size_t fctNo, FacetInfo const& info,
+                                         Vector<double const> const& u0,
+                                         LinearAllocator<double>&) const {
+    if (info.bc == BC::Exterior) {
+        return 0.0;
+    }
+
+    alignas(ALIGNMENT) double f_q[tensor::f_q::size()];
+    bool is_dirichlet = bc_boundary(fctNo, info.bc, f_q);
+
+    alignas(ALIGNMENT) double u_q[tensor::f_q::size()];
+    alignas(ALIGNMENT) double flux_q[tensor::f_q::size()];
+    compute_normal_flux_q(fctNo, info, 0, u0, u_q, flux_q);
+
+    auto const& nl_q = fct[fctNo].get<NormalLength>();
+    double r2 = 0.0;
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        double r = is_dirichlet ? u_q[q] - f_q[q] : flux_q[q];
+        r2 += fctRule.weights()[q] * nl_q[q] * r * r;
+    }
+
+    if (is_dirichlet) {
+        return penalty_[fctNo] * r2;
+    }
+    constexpr double p = std::max(PolynomialDegree, 1u);
+    double h = std::pow(area_[fctNo], 1.0 / (Dim - 1u));
+    return h / (p * max_K(info.up[0])) * r2;
+}
+
+void Poisson::exterior_trace(std::size_t fctNo, FacetInfo const& info,
+                             Vector<double const> const& u0, double* u_q) const {
+    auto const& E = E_q[info.localNo[0]];
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        u_q[q] = 0.0;
+        for (std::size_t k = 0; k < E.shape(0); ++k) {
+            u_q[q] += E(k, q) * u0(k);
+        }
+    }
+}
+
+void Poisson::exterior_flux(std::size_t fctNo, FacetInfo const& info, double const* t_q,
+                            Vector<double>& y0) const {
+    alignas(ALIGNMENT) double K_q[tensor::K_q::size(0)];
+    compute_K_q(fctNo, info, {K_q, nullptr});
+    auto const& nl_q = fct[fctNo].get<NormalLength>();
+    auto const& E = E_q[info.localNo[0]];
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        double K_ext = exterior_K_ ? *exterior_K_ : K_q[q];
+        double flux = fctRule.weights()[q] * nl_q[q] * K_ext * t_q[q];
+        for (std::size_t k = 0; k < E.shape(0); ++k) {
+            y0(k) -= E(k, q) * flux;
+        }
+    }
+}
+
 void Poisson::coefficients_volume(std::size_t elNo, Matrix<double>& C,
                                   LinearAllocator<double>&) const {
     auto const coeff_K = material[elNo].get<K>();
@@ -694,7 +916,7 @@ void Poisson::traction_skeleton(std::size_t fctNo, FacetInfo const& info, Vector
     krnl.E_q(1) = E_q[info.localNo[1]].data();
     krnl.f_q = f_q_raw;
     krnl.grad_u = result.data();
-    krnl.n_unit_q = fct[fctNo].get<UnitNormal>().data()->data();
+    krnl.n_unit_q = fctGeo[fctNo].get<UnitNormal>().data()->data();
     krnl.u(0) = u0.data();
     krnl.u(1) = u1.data();
     krnl.execute();
@@ -716,7 +938,7 @@ void Poisson::traction_boundary(std::size_t fctNo, FacetInfo const& info, Vector
     krnl.E_q(0) = E_q[info.localNo[0]].data();
     krnl.f_q = f_q_raw;
     krnl.grad_u = result.data();
-    krnl.n_unit_q = fct[fctNo].get<UnitNormal>().data()->data();
+    krnl.n_unit_q = fctGeo[fctNo].get<UnitNormal>().data()->data();
     krnl.u(0) = u0.data();
     krnl.execute();
 }
@@ -5,9 +5,11 @@
 #include "localoperator/ModalInterpolation.h"
 
 #include "form/DGCurvilinearCommon.h"
+#include "form/ExteriorDtN.h"
 #include "form/FacetInfo.h"
 #include "form/FiniteElementFunction.h"
 #include "form/RefElement.h"
+#include "form/SumFactorization.h"
 #include "geometry/Curvilinear.h"
 #include "tensor/Managed.h"
 #include "tensor/Tensor.h"
@@ -23,6 +25,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -39,6 +42,14 @@ public:
 
     constexpr std::size_t alignment() const { return ALIGNMENT; }
     std::size_t block_size() const { return space_.numBasisFunctions(); }
+    auto degree_projector(unsigned degree) const { return space_.degreeProjector(degree); }
+    std::size_t scratch_mem_size() const {
+        // error_indicator_volume needs a mass matrix and a right-hand side per dimension
+        std::size_t Nbf = space_.numBasisFunctions();
+        return std::max(base::scratch_mem_size(),
+                        LinearAllocator<double>::allocation_size(Nbf * Nbf, ALIGNMENT) +
+                            LinearAllocator<double>::allocation_size(Nbf * Dim, ALIGNMENT));
+    }
     auto make_interpolation_op() const {
         return std::make_unique<ModalInterpolation<Dim>>(PolynomialDegree, NumQuantities,
                                                          alignment());
@@ -73,6 +84,47 @@ public:
 
     std::size_t flops_apply(std::size_t elNo, mneme::span<SideInfo> info) const;
 
+    /**
+     * @brief Squared residual indicator h^2/p^2 ||f + div(K grad u)||^2 / K of an element.
+     *
+     * The divergence is taken of the L2 projection of K grad u onto the modal space.
+     */
+    double error_indicator_volume(std::size_t elNo, Vector<double const> const& u0,
+                                  LinearAllocator<double>& scratch) const;
+    /**
+     * @brief Squared jump indicator h/p ||[K grad u . n]||^2 / K + sigma ||[u] - s||^2.
+     */
+    double error_indicator_skeleton(std::size_t fctNo, FacetInfo const& info,
+                                    Vector<double const> const& u0, Vector<double const> const& u1,
+                                    LinearAllocator<double>& scratch) const;
+    /**
+     * @brief Squared boundary indicator (Dirichlet defect or normal flux on natural boundaries).
+     */
+    double error_indicator_boundary(std::size_t fctNo, FacetInfo const& info,
+                                    Vector<double const> const& u0,
+                                    LinearAllocator<double>& scratch) const;
+
+    /**
+     * @brief Evaluates u at the quadrature points of an exterior boundary facet.
+     */
+    void exterior_trace(std::size_t fctNo, FacetInfo const& info, Vector<double const> const& u0,
+                        double* u_q) const;
+    /**
+     * @brief Adds the boundary term -∫ K_ext t v ds of an exterior boundary facet, where t is
+     * the normal derivative of the exterior solution at the quadrature points.
+     *
+     * Flux continuity K ∂u/∂n = K_ext t holds across the exterior boundary. Unless set with
+     * set_exterior_conductivity, K_ext is the interior K at the quadrature points, that is,
+     * the material is assumed to continue homogeneously across the boundary.
+     */
+    void exterior_flux(std::size_t fctNo, FacetInfo const& info, double const* t_q,
+                       Vector<double>& y0) const;
+    void set_exterior_free_surface(FreeSurfacePlane<Dim> const& plane) {
+        exterior_free_surface_ = plane;
+    }
+    auto const& exterior_free_surface() const { return exterior_free_surface_; }
+    void set_exterior_conductivity(double K) { exterior_K_ = K; }
+
     TensorBase<Matrix<double>> tractionResultInfo() const;
     void traction_skeleton(std::size_t fctNo, FacetInfo const& info, Vector<double const>& u0,
                            Vector<double const>& u1, Matrix<double>& result) const;
@@ -120,6 +172,9 @@ private:
     void compute_K_Dx_q(std::size_t fctNo, FacetInfo const& info,
                         std::array<double*, 2> K_Dx_q) const;
     void compute_K_q(std::size_t fctNo, FacetInfo const& info, std::array<double*, 2> K_q) const;
+    void compute_normal_flux_q(std::size_t fctNo, FacetInfo const& info, int side,
+                               Vector<double const> const& u, double* u_q, double* flux_q) const;
+    double max_K(std::size_t elNo) const;
     bool bc_skeleton(std::size_t fctNo, BC bc, double f_q_raw[]) const;
     bool bc_boundary(std::size_t fctNo, BC bc, double f_q_raw[]) const;
 
@@ -128,6 +183,9 @@ private:
     // Ref elements
     ModalRefElement<DomainDimension> space_;
     NodalRefElement<DomainDimension> materialSpace_;
+#ifdef TANDEM_SUM_FACTORIZATION
+    SumFactorization<DomainDimension> sumFact_;
+#endif
 
     // Matrices
     Managed<Matrix<double>> Minv_;
@@ -179,6 +237,8 @@ private:
     mneme::StridedView<fct_pre_t> fctPre;
 
     std::vector<double> penalty_;
+    std::optional<FreeSurfacePlane<Dim>> exterior_free_surface_ = std::nullopt;
+    std::optional<double> exterior_K_ = std::nullopt;
 
     // Options
     constexpr static double epsilon = -1.0;
@@ -8,43 +8,92 @@
 #include "tensor/Reshape.h"
 #include "tensor/Tensor.h"
 #include "util/LinearAllocator.h"
+#include "util/LocalIndex.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace tndm {
 
-template <class Law> class RateAndState : public RateAndStateBase {
+/**
+ * @brief Rate and state friction with one or more friction laws.
+ *
+ * The law of every fault node is selected at setup (see set_law). The nodes of each fault
+ * element are grouped by law such that every node loop is specialised for a single law.
+ * All laws must share the parameter types of the first law, which is the default law, and
+ * accept its parameters in share_params, such that the per-node parameters are stored once.
+ */
+template <class... Laws> class RateAndState : public RateAndStateBase {
 public:
     using RateAndStateBase::RateAndStateBase;
     static constexpr std::size_t PsiIndex = TangentialComponents;
+    static constexpr std::size_t NumLaws = sizeof...(Laws);
+    using default_law_t = std::tuple_element_t<0, std::tuple<Laws...>>;
+    static constexpr std::array<char const*, NumLaws> LawNames = {Laws::Name...};
 
     using param_fun_t =
-        std::function<typename Law::Params(std::array<double, DomainDimension> const&)>;
+        std::function<typename default_law_t::Params(std::array<double, DomainDimension> const&)>;
+    using law_fun_t =
+        std::function<std::array<double, 1>(std::array<double, DomainDimension> const&)>;
     using source_fun_t =
         std::function<std::array<double, 1>(std::array<double, DomainDimension + 1> const&)>;
     using delta_tau_fun_t = std::function<std::array<double, TangentialComponents>(
         std::array<double, DomainDimension + 1> const&)>;
+    using state_fun_t = std::function<std::array<double, NumQuantities>(
+        std::array<double, DomainDimension> const&)>;
 
-    void set_constant_params(typename Law::ConstantParams const& cps) {
-        law_.set_constant_params(cps);
+    void end_preparation() {
+        set_law([](std::array<double, DomainDimension> const&) -> std::array<double, 1> {
+            return {0.0};
+        });
     }
+
+    void set_constant_params(typename default_law_t::ConstantParams const& cps) {
+        std::apply([&cps](auto&... law) { (law.set_constant_params(cps), ...); }, laws_);
+    }
+    /**
+     * @brief Sets the per-node parameters, which are stored once and shared by all laws.
+     */
     void set_params(param_fun_t pfun) {
+        auto& default_law = std::get<0>(laws_);
         auto num_nodes = fault_.storage().size();
-        law_.set_num_nodes(num_nodes);
+        default_law.set_num_nodes(num_nodes);
         for (std::size_t index = 0; index < num_nodes; ++index) {
-            auto params = pfun(fault_.storage()[index].template get<Coords>());
-            law_.set_params(index, params);
+            default_law.set_params(index, pfun(fault_.storage()[index].template get<Coords>()));
         }
+        std::apply([&default_law](auto&... law) { (law.share_params(default_law), ...); },
+                   laws_);
     }
+    /**
+     * @brief Selects the friction law per fault node.
+     *
+     * @param lfun Returns the index of the law in LawNames
+     */
+    void set_law(law_fun_t lfun);
 
     void set_source_fun(source_fun_t source) { source_ = std::make_optional(std::move(source)); }
     void set_delta_tau_fun(delta_tau_fun_t delta_tau) {
         delta_tau_ = std::make_optional(std::move(delta_tau));
     }
+    /**
+     * @brief Prescribes slip and state variable at the start of the simulation.
+     *
+     * Replaces the initial slip (S_init) and the initial state variable (psi_init) of the laws,
+     * e.g. to continue from a state transferred from another discretisation.
+     */
+    void set_initial_state_fun(state_fun_t state) {
+        initial_state_ = std::make_optional(std::move(state));
+    }
 
     void pre_init(std::size_t faultNo, Vector<double>& state, LinearAllocator<double>&) const;
     double init(double time, std::size_t faultNo, Vector<double const> const& traction,
@@ -83,73 +132,148 @@ private:
         return (*delta_tau_)(xt);
     }
 
-    Law law_;
+    /**
+     * @brief Calls fun(law, first, last) for every law, where [first, last) are the
+     * element-local node numbers of faultNo governed by law.
+     */
+    template <typename Fun> void for_each_batch(std::size_t faultNo, Fun&& fun) const {
+        for_each_batch(faultNo, std::forward<Fun>(fun), std::index_sequence_for<Laws...>{});
+    }
+    template <typename Fun, std::size_t... Is>
+    void for_each_batch(std::size_t faultNo, Fun&& fun, std::index_sequence<Is...>) const {
+        std::size_t nbf = space_.numBasisFunctions();
+        local_index_t const* nodes = &batch_nodes_[faultNo * nbf];
+        std::size_t const* begin = &batch_begin_[faultNo * (NumLaws + 1)];
+        (fun(std::get<Is>(laws_), nodes + begin[Is], nodes + begin[Is + 1]), ...);
+    }
+
+    std::tuple<Laws...> laws_;
+    std::vector<local_index_t> batch_nodes_;
+    std::vector<std::size_t> batch_begin_;
     std::optional<source_fun_t> source_;
     std::optional<delta_tau_fun_t> delta_tau_;
+    std::optional<state_fun_t> initial_state_;
 };
 
-template <class Law>
-void RateAndState<Law>::pre_init(std::size_t faultNo, Vector<double>& state,
-                                 LinearAllocator<double>&) const {
+template <class... Laws> void RateAndState<Laws...>::set_law(law_fun_t lfun) {
+    std::size_t nbf = space_.numBasisFunctions();
+    std::size_t num_elements = fault_.size();
+    batch_nodes_.resize(num_elements * nbf);
+    batch_begin_.resize(num_elements * (NumLaws + 1));
+    auto law_of_node = std::vector<std::size_t>(nbf);
+    for (std::size_t faultNo = 0; faultNo < num_elements; ++faultNo) {
+        auto coords = fault_[faultNo].template get<Coords>();
+        for (std::size_t node = 0; node < nbf; ++node) {
+            double law = std::round(lfun(coords[node])[0]);
+            if (!(law >= 0.0 && law < NumLaws)) {
+                std::string names;
+                for (std::size_t l = 0; l < NumLaws; ++l) {
+                    names += (l > 0 ? ", " : "") + std::to_string(l) + " = " + LawNames[l];
+                }
+                throw std::runtime_error("Invalid friction law " +
+                                         std::to_string(static_cast<long>(law)) +
+                                         " (available: " + names + ")");
+            }
+            law_of_node[node] = static_cast<std::size_t>(law);
+        }
+        local_index_t* nodes = &batch_nodes_[faultNo * nbf];
+        std::size_t* begin = &batch_begin_[faultNo * (NumLaws + 1)];
+        std::size_t n = 0;
+        for (std::size_t l = 0; l < NumLaws; ++l) {
+            begin[l] = n;
+            for (std::size_t node = 0; node < nbf; ++node) {
+                if (law_of_node[node] == l) {
+                    nodes[n++] = node;
+                }
+            }
+        }
+        begin[NumLaws] = n;
+    }
+}
+
+template <class... Laws>
+void RateAndState<Laws...>::pre_init(std::size_t faultNo, Vector<double>& state,
+                                     LinearAllocator<double>&) const {
     auto s_mat = state_mat(state);
     std::size_t nbf = space_.numBasisFunctions();
-    std::size_t index = faultNo * nbf;
-    for (std::size_t node = 0; node < nbf; ++node) {
-        auto Sini = law_.S_init(index + node);
-        for (std::size_t t = 0; t < TangentialComponents; ++t) {
-            s_mat(node, t) = Sini[t];
+    if (initial_state_) {
+        auto coords = fault_[faultNo].template get<Coords>();
+        for (std::size_t node = 0; node < nbf; ++node) {
+            auto s = (*initial_state_)(coords[node]);
+            for (std::size_t q = 0; q < NumQuantities; ++q) {
+                s_mat(node, q) = s[q];
+            }
         }
+        return;
     }
+    std::size_t index = faultNo * nbf;
+    for_each_batch(faultNo, [&](auto const& law, auto first, auto last) {
+        for (; first != last; ++first) {
+            std::size_t node = *first;
+            auto Sini = law.S_init(index + node);
+            for (std::size_t t = 0; t < TangentialComponents; ++t) {
+                s_mat(node, t) = Sini[t];
+            }
+        }
+    });
 }
 
-template <class Law>
-double RateAndState<Law>::init(double time, std::size_t faultNo,
-                               Vector<double const> const& traction, Vector<double>& state,
-                               LinearAllocator<double>&) const {
+template <class... Laws>
+double RateAndState<Laws...>::init(double time, std::size_t faultNo,
+                                   Vector<double const> const& traction, Vector<double>& state,
+                                   LinearAllocator<double>&) const {
     double VMax = 0.0;
     auto s_mat = state_mat(state);
     auto t_mat = traction_mat(traction);
     std::size_t nbf = space_.numBasisFunctions();
     std::size_t index = faultNo * nbf;
-    for (std::size_t node = 0; node < nbf; ++node) {
-        auto sn = t_mat(node, 0);
-        auto tau = get_tau(node, t_mat);
-        if (delta_tau_) {
-            tau = tau + get_delta_tau(time, faultNo, node);
+    for_each_batch(faultNo, [&](auto const& law, auto first, auto last) {
+        for (; first != last; ++first) {
+            std::size_t node = *first;
+            auto sn = t_mat(node, 0);
+            auto tau = get_tau(node, t_mat);
+            if (delta_tau_) {
+                tau = tau + get_delta_tau(time, faultNo, node);
+            }
+            auto psi = initial_state_ ? s_mat(node, PsiIndex)
+                                      : law.psi_init(index + node, sn, tau);
+            double V = norm(law.slip_rate(index + node, sn, tau, psi));
+            VMax = std::max(VMax, V);
+            s_mat(node, PsiIndex) = psi;
         }
-        auto psi = law_.psi_init(index + node, sn, tau);
-        double V = norm(law_.slip_rate(index + node, sn, tau, psi));
-        VMax = std::max(VMax, V);
-        s_mat(node, PsiIndex) = psi;
-    }
+    });
     return VMax;
 }
 
-template <class Law>
-double RateAndState<Law>::rhs(double time, std::size_t faultNo,
-                              Vector<double const> const& traction, Vector<double const>& state,
-                              Vector<double>& result, LinearAllocator<double>&) const {
+template <class... Laws>
+double RateAndState<Laws...>::rhs(double time, std::size_t faultNo,
+                                  Vector<double const> const& traction,
+                                  Vector<double const>& state, Vector<double>& result,
+                                  LinearAllocator<double>&) const {
     double VMax = 0.0;
     std::size_t nbf = space_.numBasisFunctions();
     std::size_t index = faultNo * nbf;
     auto s_mat = state_mat(state);
     auto r_mat = state_mat(result);
     auto t_mat = traction_mat(traction);
-    for (std::size_t node = 0; node < nbf; ++node) {
-        auto sn = t_mat(node, 0);
-        auto psi = s_mat(node, PsiIndex);
-        auto tau = get_tau(node, t_mat);
-        if (delta_tau_) {
-            tau = tau + get_delta_tau(time, faultNo, node);
+    for_each_batch(faultNo, [&](auto const& law, auto first, auto last) {
+        for (; first != last; ++first) {
+            std::size_t node = *first;
+            auto sn = t_mat(node, 0);
+            auto psi = s_mat(node, PsiIndex);
+            auto tau = get_tau(node, t_mat);
+            if (delta_tau_) {
+                tau = tau + get_delta_tau(time, faultNo, node);
+            }
+            auto Vi = law.slip_rate(index + node, sn, tau, psi);
+            double V = norm(Vi);
+            VMax = std::max(VMax, V);
+            for (std::size_t t = 0; t < TangentialComponents; ++t) {
+                r_mat(node, t) = Vi[t];
+            }
+            r_mat(node, PsiIndex) = law.state_rhs(index + node, V, psi);
         }
-        auto Vi = law_.slip_rate(index + node, sn, tau, psi);
-        double V = norm(Vi);
-        VMax = std::max(VMax, V);
-        for (std::size_t t = 0; t < TangentialComponents; ++t) {
-            r_mat(node, t) = Vi[t];
-        }
-        r_mat(node, PsiIndex) = law_.state_rhs(index + node, V, psi);
-    }
+    });
     if (source_) {
         auto coords = fault_[faultNo].template get<Coords>();
         std::array<double, DomainDimension + 1> xt;
@@ -163,7 +287,8 @@ double RateAndState<Law>::rhs(double time, std::size_t faultNo,
     return VMax;
 }
 
-template <class Law> auto RateAndState<Law>::state_prototype(std::size_t numLocalElements) const {
+template <class... Laws>
+auto RateAndState<Laws...>::state_prototype(std::size_t numLocalElements) const {
     auto names = std::vector<std::string>(2 + 3 * TangentialComponents);
     char buf[100];
 
@@ -185,53 +310,61 @@ template <class Law> auto RateAndState<Law>::state_prototype(std::size_t numLoca
     return FiniteElementFunction<DomainDimension - 1u>(space_.clone(), names, numLocalElements);
 }
 
-template <class Law>
-void RateAndState<Law>::state(double time, std::size_t faultNo,
-                              Vector<double const> const& traction, Vector<double const>& state,
-                              Matrix<double>& result, LinearAllocator<double>&) const {
+template <class... Laws>
+void RateAndState<Laws...>::state(double time, std::size_t faultNo,
+                                  Vector<double const> const& traction,
+                                  Vector<double const>& state, Matrix<double>& result,
+                                  LinearAllocator<double>&) const {
     auto s_mat = state_mat(state);
     auto t_mat = traction_mat(traction);
     std::size_t nbf = space_.numBasisFunctions();
     std::size_t index = faultNo * nbf;
-    for (std::size_t node = 0; node < nbf; ++node) {
-        auto sn = t_mat(node, 0);
-        auto tau = get_tau(node, t_mat);
-        if (delta_tau_) {
-            tau = tau + get_delta_tau(time, faultNo, node);
+    for_each_batch(faultNo, [&](auto const& law, auto first, auto last) {
+        for (; first != last; ++first) {
+            std::size_t node = *first;
+            auto sn = t_mat(node, 0);
+            auto tau = get_tau(node, t_mat);
+            if (delta_tau_) {
+                tau = tau + get_delta_tau(time, faultNo, node);
+            }
+            auto psi = s_mat(node, PsiIndex);
+            auto V = law.slip_rate(index + node, sn, tau, psi);
+            auto tau_hat = law.tau_hat(index + node, tau, V);
+            std::size_t out = 0;
+            result(node, out++) = psi;
+            for (std::size_t t = 0; t < TangentialComponents; ++t) {
+                result(node, out++) = s_mat(node, t);
+            }
+            for (std::size_t t = 0; t < TangentialComponents; ++t) {
+                result(node, out++) = tau_hat[t];
+            }
+            for (std::size_t t = 0; t < TangentialComponents; ++t) {
+                result(node, out++) = V[t];
+            }
+            result(node, out++) = law.sn_hat(index + node, sn);
         }
-        auto psi = s_mat(node, PsiIndex);
-        auto V = law_.slip_rate(index + node, sn, tau, psi);
-        auto tau_hat = law_.tau_hat(index + node, tau, V);
-        std::size_t out = 0;
-        result(node, out++) = psi;
-        for (std::size_t t = 0; t < TangentialComponents; ++t) {
-            result(node, out++) = s_mat(node, t);
-        }
-        for (std::size_t t = 0; t < TangentialComponents; ++t) {
-            result(node, out++) = tau_hat[t];
-        }
-        for (std::size_t t = 0; t < TangentialComponents; ++t) {
-            result(node, out++) = V[t];
-        }
-        result(node, out++) = law_.sn_hat(index + node, sn);
-    }
+    });
 }
 
-template <class Law> auto RateAndState<Law>::params_prototype(std::size_t numLocalElements) const {
-    return FiniteElementFunction<DomainDimension - 1u>(space_.clone(), law_.param_names(),
-                                                       numLocalElements);
+template <class... Laws>
+auto RateAndState<Laws...>::params_prototype(std::size_t numLocalElements) const {
+    return FiniteElementFunction<DomainDimension - 1u>(
+        space_.clone(), std::get<0>(laws_).param_names(), numLocalElements);
 }
 
-template <class Law>
-void RateAndState<Law>::params(std::size_t faultNo, Matrix<double>& result,
-                               LinearAllocator<double>&) const {
+template <class... Laws>
+void RateAndState<Laws...>::params(std::size_t faultNo, Matrix<double>& result,
+                                   LinearAllocator<double>&) const {
 
     std::size_t nbf = space_.numBasisFunctions();
     std::size_t index = faultNo * nbf;
-    for (std::size_t node = 0; node < nbf; ++node) {
-        auto row = result.subtensor(node, slice{});
-        law_.params(index + node, row);
-    }
+    for_each_batch(faultNo, [&](auto const& law, auto first, auto last) {
+        for (; first != last; ++first) {
+            std::size_t node = *first;
+            auto row = result.subtensor(node, slice{});
+            law.params(index + node, row);
+        }
+    });
 }
 
 } // namespace tndm
@@ -0,0 +1,598 @@
+#include "form/InverseInequality.h"
+#include "geometry/Curvilinear.h"
+#include "io/GMSHParser.h"
+#include "io/GMSHRecorder.h"
+#include "io/GlobalSimplexMeshBuilder.h"
+#include "io/VTUAdapter.h"
+#include "io/VTUWriter.h"
+#include "mesh/GlobalSimplexMesh.h"
+#include "mesh/LocalSimplexMesh.h"
+#include "mesh/MeshData.h"
+#include "parallel/MPITraits.h"
+#include "quadrules/AutoRule.h"
+#include "tensor/Managed.h"
+#include "util/Math.h"
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <argparse.hpp>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tndm;
+
+template <std::size_t D> using simplex_verts_t = std::array<std::array<double, D>, D + 1u>;
+
+/**
+ * @brief Measure of the K-simplex with vertices v (Gram determinant)
+ */
+template <std::size_t D, std::size_t K>
+double simplex_measure(std::array<std::array<double, D>, K + 1u> const& v) {
+    Eigen::Matrix<double, D, K> E;
+    for (std::size_t k = 0; k < K; ++k) {
+        for (std::size_t d = 0; d < D; ++d) {
+            E(d, k) = v[k + 1][d] - v[0][d];
+        }
+    }
+    double gram = (E.transpose() * E).determinant();
+    return std::sqrt(std::max(gram, 0.0)) / factorial(K);
+}
+
+template <std::size_t D> double signed_volume(simplex_verts_t<D> const& v) {
+    Eigen::Matrix<double, D, D> E;
+    for (std::size_t k = 0; k < D; ++k) {
+        for (std::size_t d = 0; d < D; ++d) {
+            E(d, k) = v[k + 1][d] - v[0][d];
+        }
+    }
+    return E.determinant() / factorial(D);
+}
+
+template <std::size_t D>
+std::array<std::array<double, D>, D> facet_verts(simplex_verts_t<D> const& v, std::size_t f) {
+    std::array<std::array<double, D>, D> fv;
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < D + 1u; ++i) {
+        if (i != f) {
+            fv[j++] = v[i];
+        }
+    }
+    return fv;
+}
+
+/**
+ * @brief Radius ratio D r / R; 1 for the regular simplex and 0 for a degenerate one.
+ */
+template <std::size_t D> double radius_ratio(simplex_verts_t<D> const& v) {
+    double volume = simplex_measure<D, D>(v);
+    if (volume <= 0.0) {
+        return 0.0;
+    }
+    double surface = 0.0;
+    for (std::size_t f = 0; f < D + 1u; ++f) {
+        surface += simplex_measure<D, D - 1u>(facet_verts<D>(v, f));
+    }
+
+    Eigen::Matrix<double, D, D> A;
+    Eigen::Matrix<double, D, 1> b;
+    for (std::size_t i = 0; i < D; ++i) {
+        b(i) = 0.0;
+        for (std::size_t d = 0; d < D; ++d) {
+            A(i, d) = 2.0 * (v[i + 1][d] - v[0][d]);
+            b(i) += v[i + 1][d] * v[i + 1][d] - v[0][d] * v[0][d];
+        }
+    }
+    Eigen::Matrix<double, D, 1> c = A.partialPivLu().solve(b);
+    double R = 0.0;
+    for (std::size_t d = 0; d < D; ++d) {
+        R += (c(d) - v[0][d]) * (c(d) - v[0][d]);
+    }
+    R = std::sqrt(R);
+    double r = D * volume / surface;
+    return D * r / R;
+}
+
+/**
+ * @brief Constrained Laplacian smoothing on the raw GMSH data.
+ *
+ * Vertices on tagged lower-dimensional elements (boundaries, faults) and on the boundary of
+ * the domain stay fixed. A vertex is moved towards the centroid of its neighbours only if the
+ * minimum radius ratio of the adjacent elements improves and no element is inverted.
+ *
+ * @return Number of vertex moves
+ */
+template <std::size_t D>
+std::size_t smooth(GMSHRecorder& rec, GlobalSimplexMeshBuilder<D>& builder, unsigned iterations,
+                   double& min_before, double& min_after) {
+    std::vector<GMSHRecorder::Record const*> elements;
+    std::vector<bool> fixed(rec.vertices.size(), false);
+    std::map<std::array<long, D>, int> facet_count;
+    for (auto const& r : rec.records) {
+        if (is_gmsh_simplex<D>(r.type)) {
+            if (r.nodes.size() > D + 1u) {
+                throw std::runtime_error("Smoothing of high-order meshes is not supported.");
+            }
+            elements.push_back(&r);
+            for (std::size_t f = 0; f < D + 1u; ++f) {
+                std::array<long, D> fct;
+                std::size_t j = 0;
+                for (std::size_t i = 0; i < D + 1u; ++i) {
+                    if (i != f) {
+                        fct[j++] = r.nodes[i];
+                    }
+                }
+                std::sort(fct.begin(), fct.end());
+                ++facet_count[fct];
+            }
+        } else {
+            for (auto n : r.nodes) {
+                fixed[n] = true;
+            }
+        }
+    }
+    for (auto const& [fct, count] : facet_count) {
+        if (count == 1) {
+            for (auto n : fct) {
+                fixed[n] = true;
+            }
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> v2e(rec.vertices.size());
+    for (std::size_t elNo = 0; elNo < elements.size(); ++elNo) {
+        for (auto n : elements[elNo]->nodes) {
+            v2e[n].push_back(elNo);
+        }
+    }
+
+    auto verts = [&](std::size_t elNo) {
+        simplex_verts_t<D> v;
+        for (std::size_t i = 0; i < D + 1u; ++i) {
+            auto const& x = rec.vertices[elements[elNo]->nodes[i]];
+            std::copy(x.begin(), x.begin() + D, v[i].begin());
+        }
+        return v;
+    };
+    auto min_quality = [&](std::vector<std::size_t> const& elNos) {
+        double q = std::numeric_limits<double>::max();
+        for (auto elNo : elNos) {
+            q = std::min(q, radius_ratio<D>(verts(elNo)));
+        }
+        return q;
+    };
+    std::vector<double> orientation(elements.size());
+    std::vector<std::size_t> all(elements.size());
+    std::iota(all.begin(), all.end(), 0);
+    for (auto elNo : all) {
+        orientation[elNo] = signed_volume<D>(verts(elNo));
+    }
+    min_before = min_quality(all);
+
+    std::size_t moves = 0;
+    for (unsigned it = 0; it < iterations; ++it) {
+        for (std::size_t vNo = 0; vNo < rec.vertices.size(); ++vNo) {
+            if (fixed[vNo] || v2e[vNo].empty()) {
+                continue;
+            }
+            auto target = std::array<double, 3>{};
+            std::size_t count = 0;
+            for (auto elNo : v2e[vNo]) {
+                for (auto n : elements[elNo]->nodes) {
+                    if (static_cast<std::size_t>(n) != vNo) {
+                        for (std::size_t d = 0; d < D; ++d) {
+                            target[d] += rec.vertices[n][d];
+                        }
+                        ++count;
+                    }
+                }
+            }
+            auto const old_x = rec.vertices[vNo];
+            double const old_q = min_quality(v2e[vNo]);
+            for (double step : {1.0, 0.5, 0.25}) {
+                for (std::size_t d = 0; d < D; ++d) {
+                    rec.vertices[vNo][d] = (1.0 - step) * old_x[d] + step * target[d] / count;
+                }
+                bool valid = true;
+                for (auto elNo : v2e[vNo]) {
+                    valid = valid && signed_volume<D>(verts(elNo)) * orientation[elNo] > 0.0;
+                }
+                if (valid && min_quality(v2e[vNo]) > old_q) {
+                    ++moves;
+                    break;
+                }
+                rec.vertices[vNo] = old_x;
+            }
+        }
+    }
+    min_after = min_quality(all);
+
+    for (std::size_t vNo = 0; vNo < rec.vertices.size(); ++vNo) {
+        builder.setVertex(vNo, rec.vertices[vNo]);
+    }
+    return moves;
+}
+
+/**
+ * @brief Physical tags of the D-simplices, keyed by their sorted vertex ids.
+ *
+ * The vertex ids are those of the GlobalSimplexMesh, i.e. the ids of the local mesh's vertices.
+ * For high-order meshes GlobalSimplexMeshBuilder drops the high-order nodes and numbers the
+ * remaining vertices in order of first appearance, which is replicated here.
+ */
+template <std::size_t D>
+std::map<std::array<uint64_t, D + 1u>, long> element_tags(GMSHRecorder const& rec) {
+    bool high_order = false;
+    for (auto const& r : rec.records) {
+        high_order = high_order || (is_gmsh_simplex<D>(r.type) && r.nodes.size() > D + 1u);
+    }
+    constexpr uint64_t Invalid = std::numeric_limits<uint64_t>::max();
+    auto map = std::vector<uint64_t>(rec.vertices.size(), Invalid);
+    uint64_t new_id = 0;
+    std::map<std::array<uint64_t, D + 1u>, long> tags;
+    for (auto const& r : rec.records) {
+        if (is_gmsh_simplex<D>(r.type)) {
+            std::array<uint64_t, D + 1u> key;
+            for (std::size_t j = 0; j < D + 1u; ++j) {
+                key[j] = r.nodes[j];
+                if (high_order) {
+                    if (map[key[j]] == Invalid) {
+                        map[key[j]] = new_id++;
+                    }
+                    key[j] = map[key[j]];
+                }
+            }
+            std::sort(key.begin(), key.end());
+            tags[key] = r.physicalTag;
+        }
+    }
+    return tags;
+}
+
+/**
+ * @brief Per-element quality metrics of the local (owned) elements.
+ *
+ * cfl_dt and penalty assume unit material parameters (rho = lambda = mu = 1, i.e. wave speeds
+ * of order one). For other materials scale cfl_dt by 1/c_max and the penalty by the modulus.
+ */
+struct Quality {
+    std::vector<double> radius_ratio;
+    std::vector<double> cfl_dt;
+    std::vector<double> penalty;
+    std::vector<double> distortion;
+};
+
+template <std::size_t D>
+Quality compute_quality(LocalSimplexMesh<D> const& mesh, Curvilinear<D> const& cl,
+                        unsigned degree, unsigned geometry_degree) {
+    auto vertexData = dynamic_cast<VertexData<D> const*>(mesh.vertices().data());
+    if (!vertexData) {
+        throw std::runtime_error("Expected vertex data");
+    }
+    auto const& vertices = vertexData->getVertices();
+    auto element_verts = [&](std::size_t elNo) {
+        simplex_verts_t<D> v;
+        auto vlids = mesh.template downward<0, D>(elNo);
+        for (std::size_t i = 0; i < D + 1u; ++i) {
+            v[i] = vertices[vlids[i]];
+        }
+        return v;
+    };
+
+    std::vector<double> volume(mesh.numElements());
+    for (std::size_t elNo = 0; elNo < mesh.numElements(); ++elNo) {
+        volume[elNo] = simplex_measure<D, D>(element_verts(elNo));
+    }
+    std::vector<double> area(mesh.numFacets());
+    for (std::size_t fctNo = 0; fctNo < mesh.numFacets(); ++fctNo) {
+        std::array<std::array<double, D>, D> fv;
+        auto vlids = mesh.template downward<0, D - 1u>(fctNo);
+        for (std::size_t i = 0; i < D; ++i) {
+            fv[i] = vertices[vlids[i]];
+        }
+        area[fctNo] = simplex_measure<D, D - 1u>(fv);
+    }
+
+    // Penalty and CFL estimate as in the Elasticity operator for unit material parameters;
+    // material is deliberately left out such that the metrics only depend on the mesh
+    double const c_N_1 = InverseInequality<D>::trace_constant(degree - 1);
+    double const c_N = InverseInequality<D>::trace_constant(degree);
+    double const C_N = InverseInequality<D>::grad_constant(degree);
+    auto penalty = [&](std::size_t fctNo, std::size_t elNo) {
+        return (D + 1) * c_N_1 * area[fctNo] / volume[elNo];
+    };
+
+    auto rule = simplexQuadratureRule<D>(2u * geometry_degree);
+    auto gradE = cl.evaluateGradientAt(rule.points());
+    auto J = Managed(cl.jacobianResultInfo(rule.size()));
+    auto detJ = Managed(cl.detJResultInfo(rule.size()));
+
+    std::size_t numLocal = mesh.elements().localSize();
+    Quality q;
+    q.radius_ratio.resize(numLocal);
+    q.cfl_dt.resize(numLocal);
+    q.penalty.resize(numLocal);
+    q.distortion.resize(numLocal);
+    for (std::size_t elNo = 0; elNo < numLocal; ++elNo) {
+        q.radius_ratio[elNo] = radius_ratio<D>(element_verts(elNo));
+
+        double l_max = 0.0;
+        double bnd_area = 0.0;
+        double max_penalty = 0.0;
+        auto fctNos = mesh.template downward<D - 1u, D>(elNo);
+        for (auto fctNo : fctNos) {
+            auto const& up = mesh.template upward<D - 1u>(fctNo);
+            double p = penalty(fctNo, elNo);
+            max_penalty = std::max(max_penalty, p);
+            double gamma = 1.0;
+            if (up.size() > 1) {
+                auto other = up[0] == elNo ? up[1] : up[0];
+                p = (p + penalty(fctNo, other)) / 4.0;
+                gamma = 2.0;
+            }
+            l_max += gamma * p * c_N * area[fctNo] / volume[elNo];
+            bnd_area += area[fctNo];
+        }
+        double h_1 = bnd_area / volume[elNo];
+        l_max += C_N * h_1 * h_1;
+        q.cfl_dt[elNo] = 1.0 / std::sqrt(2.0 * l_max);
+        q.penalty[elNo] = max_penalty;
+
+        cl.jacobian(elNo, gradE, J);
+        cl.detJ(elNo, J, detJ);
+        double dmin = std::numeric_limits<double>::max();
+        double dmax = std::numeric_limits<double>::lowest();
+        for (std::size_t i = 0; i < rule.size(); ++i) {
+            dmin = std::min(dmin, detJ(i));
+            dmax = std::max(dmax, detJ(i));
+        }
+        q.distortion[elNo] = dmin * dmax > 0.0 ? std::max(dmax / dmin, dmin / dmax)
+                                               : std::numeric_limits<double>::infinity();
+    }
+    return q;
+}
+
+template <std::size_t D>
+bool mesh_quality(std::string const& mesh_file, unsigned geometry_degree, unsigned degree,
+                  std::size_t num_worst, unsigned smooth_iterations, std::string const& smoothed,
+                  std::string const& output) {
+    int rank, procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &procs);
+
+    bool ok = false;
+    GlobalSimplexMeshBuilder<D> builder;
+    GMSHRecorder rec(&builder);
+    if (rank == 0) {
+        GMSHParser parser(&rec);
+        ok = parser.parseFile(mesh_file);
+        if (!ok) {
+            std::cerr << mesh_file << std::endl << parser.getErrorMessage();
+        }
+        if (ok && smooth_iterations > 0) {
+            double before, after;
+            try {
+                auto moves = smooth<D>(rec, builder, smooth_iterations, before, after);
+                std::cout << "Smoothing: " << moves << " vertex moves, minimum radius ratio "
+                          << before << " -> " << after << std::endl;
+                rec.write(smoothed);
+                std::cout << "Smoothed mesh written to " << smoothed << std::endl;
+            } catch (std::runtime_error const& e) {
+                std::cerr << "Smoothing skipped: " << e.what() << std::endl;
+            }
+        }
+    }
+    MPI_Bcast(&ok, 1, MPI_CXX_BOOL, 0, MPI_COMM_WORLD);
+    if (!ok) {
+        return false;
+    }
+    auto globalMesh = builder.create(MPI_COMM_WORLD);
+    if (procs > 1) {
+        globalMesh->repartitionByHash();
+    }
+    globalMesh->repartition();
+    auto mesh = globalMesh->getLocalMesh(1);
+    auto cl = std::make_shared<Curvilinear<D>>(
+        *mesh, [](typename Curvilinear<D>::vertex_t const& v) { return v; }, geometry_degree);
+
+    auto q = compute_quality<D>(*mesh, *cl, degree, geometry_degree);
+    std::size_t numLocal = q.radius_ratio.size();
+
+    // Summary
+    std::vector<std::vector<double> const*> metrics = {&q.radius_ratio, &q.cfl_dt, &q.penalty,
+                                                       &q.distortion};
+    std::vector<char const*> names = {"radius ratio", "CFL time step", "penalty", "distortion"};
+    std::size_t numElements = numLocal;
+    MPI_Allreduce(MPI_IN_PLACE, &numElements, 1, mpi_type_t<std::size_t>(), MPI_SUM,
+                  MPI_COMM_WORLD);
+    if (rank == 0) {
+        std::cout << numElements
+                  << " elements (CFL time step and penalty for unit material parameters)"
+                  << std::endl;
+        std::cout << std::setw(16) << "metric" << std::setw(14) << "min" << std::setw(14)
+                  << "mean" << std::setw(14) << "max" << std::endl;
+    }
+    for (std::size_t m = 0; m < metrics.size(); ++m) {
+        auto const& v = *metrics[m];
+        double mn = v.empty() ? std::numeric_limits<double>::max()
+                              : *std::min_element(v.begin(), v.end());
+        double mx = v.empty() ? std::numeric_limits<double>::lowest()
+                              : *std::max_element(v.begin(), v.end());
+        double sum = std::accumulate(v.begin(), v.end(), 0.0);
+        MPI_Allreduce(MPI_IN_PLACE, &mn, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+        MPI_Allreduce(MPI_IN_PLACE, &mx, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        if (rank == 0) {
+            std::cout << std::setw(16) << names[m] << std::setw(14) << mn << std::setw(14)
+                      << sum / numElements << std::setw(14) << mx << std::endl;
+        }
+    }
+
+    // Worst offenders by radius ratio
+    constexpr std::size_t RecordSize = 4 + D * (D + 1u);
+    std::vector<std::size_t> order(numLocal);
+    std::iota(order.begin(), order.end(), 0);
+    std::size_t numLocalWorst = std::min(num_worst, numLocal);
+    std::partial_sort(order.begin(), order.begin() + numLocalWorst, order.end(),
+                      [&](std::size_t a, std::size_t b) {
+                          return q.radius_ratio[a] < q.radius_ratio[b];
+                      });
+    auto vertexData = dynamic_cast<VertexData<D> const*>(mesh->vertices().data());
+    std::vector<double> worst(numLocalWorst * RecordSize);
+    std::vector<uint64_t> worst_vids(numLocalWorst * (D + 1u));
+    for (std::size_t i = 0; i < numLocalWorst; ++i) {
+        auto elNo = order[i];
+        double* w = worst.data() + i * RecordSize;
+        w[0] = q.radius_ratio[elNo];
+        w[1] = q.cfl_dt[elNo];
+        w[2] = q.penalty[elNo];
+        w[3] = q.distortion[elNo];
+        auto vlids = mesh->template downward<0, D>(elNo);
+        for (std::size_t j = 0; j < D + 1u; ++j) {
+            auto const& x = vertexData->getVertices()[vlids[j]];
+            std::copy(x.begin(), x.end(), w + 4 + j * D);
+        }
+        auto const& elem = mesh->elements()[elNo];
+        std::copy(elem.begin(), elem.end(), worst_vids.begin() + i * (D + 1u));
+    }
+    int count = worst.size();
+    std::vector<int> counts(procs), displs(procs);
+    MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+    std::exclusive_scan(counts.begin(), counts.end(), displs.begin(), 0);
+    std::vector<double> all_worst(rank == 0 ? displs.back() + counts.back() : 0);
+    MPI_Gatherv(worst.data(), count, MPI_DOUBLE, all_worst.data(), counts.data(), displs.data(),
+                MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    for (int p = 0; p < procs; ++p) {
+        counts[p] = counts[p] / RecordSize * (D + 1u);
+        displs[p] = displs[p] / RecordSize * (D + 1u);
+    }
+    std::vector<uint64_t> all_worst_vids(all_worst.size() / RecordSize * (D + 1u));
+    MPI_Gatherv(worst_vids.data(), worst_vids.size(), mpi_type_t<uint64_t>(),
+                all_worst_vids.data(), counts.data(), displs.data(), mpi_type_t<uint64_t>(), 0,
+                MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        auto tags = element_tags<D>(rec);
+        auto tag_of = [&](uint64_t const* vids) -> long {
+            std::array<uint64_t, D + 1u> key;
+            std::copy(vids, vids + D + 1u, key.begin());
+            std::sort(key.begin(), key.end());
+            auto it = tags.find(key);
+            return it != tags.end() ? it->second : -1;
+        };
+
+        std::size_t numWorst = all_worst.size() / RecordSize;
+        std::vector<std::size_t> idx(numWorst);
+        std::iota(idx.begin(), idx.end(), 0);
+        std::sort(idx.begin(), idx.end(), [&](std::size_t a, std::size_t b) {
+            return all_worst[a * RecordSize] < all_worst[b * RecordSize];
+        });
+        std::cout << std::endl << "Worst elements by radius ratio:" << std::endl;
+        std::cout << std::setw(14) << "radius ratio" << std::setw(14) << "CFL time step"
+                  << std::setw(14) << "penalty" << std::setw(14) << "distortion" << std::setw(8)
+                  << "tag"
+                  << "   centroid" << std::endl;
+        for (std::size_t i = 0; i < std::min(num_worst, numWorst); ++i) {
+            double const* w = all_worst.data() + idx[i] * RecordSize;
+            std::cout << std::setw(14) << w[0] << std::setw(14) << w[1] << std::setw(14) << w[2]
+                      << std::setw(14) << w[3] << std::setw(8)
+                      << tag_of(all_worst_vids.data() + idx[i] * (D + 1u)) << "  ";
+            for (std::size_t d = 0; d < D; ++d) {
+                double c = 0.0;
+                for (std::size_t j = 0; j < D + 1u; ++j) {
+                    c += w[4 + j * D + d];
+                }
+                std::cout << ' ' << c / (D + 1u);
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    if (!output.empty()) {
+        auto adapter = CurvilinearVTUAdapter(cl, numLocal);
+        auto writer = VTUWriter<D>(geometry_degree, true, MPI_COMM_WORLD);
+        auto& piece = writer.addPiece(adapter);
+        piece.addCellData("radius_ratio", q.radius_ratio);
+        piece.addCellData("cfl_dt", q.cfl_dt);
+        piece.addCellData("penalty", q.penalty);
+        piece.addCellData("distortion", q.distortion);
+        writer.write(output);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+
+    argparse::ArgumentParser program("mesh-quality");
+    program.add_argument("-N", "--degree")
+        .help("Polynomial degree for geometry approximation")
+        .default_value(1ul)
+        .action([](std::string const& value) { return std::stoul(value); });
+    program.add_argument("-p", "--polynomial_degree")
+        .help("Polynomial degree of the discretisation used for penalty and CFL estimate "
+              "(both assume unit material parameters)")
+        .default_value(2ul)
+        .action([](std::string const& value) { return std::stoul(value); });
+    program.add_argument("-k", "--worst")
+        .help("Number of worst elements to report")
+        .default_value(10ul)
+        .action([](std::string const& value) { return std::stoul(value); });
+    program.add_argument("-s", "--smooth")
+        .help("Number of constrained smoothing sweeps (0 = no smoothing)")
+        .default_value(0ul)
+        .action([](std::string const& value) { return std::stoul(value); });
+    program.add_argument("--smoothed_mesh")
+        .help("Output file name of smoothed mesh")
+        .default_value(std::string("smoothed.msh"));
+    program.add_argument("-o", "--output")
+        .help("Prefix of VTU output with per-element metrics")
+        .default_value(std::string(""));
+    program.add_argument("dim")
+        .help("Simplex dimension (D=2: triangle, D=3: tet)")
+        .action([](std::string const& value) { return std::stoul(value); });
+    program.add_argument("mesh_file").help(".msh file");
+
+    try {
+        program.parse_args(argc, argv);
+    } catch (std::runtime_error& err) {
+        std::cout << err.what() << std::endl;
+        std::cout << program;
+        MPI_Finalize();
+        return 0;
+    }
+
+    auto N = program.get<unsigned long>("-N");
+    auto p = program.get<unsigned long>("-p");
+    auto k = program.get<unsigned long>("-k");
+    auto s = program.get<unsigned long>("-s");
+    auto smoothed = program.get<std::string>("--smoothed_mesh");
+    auto output = program.get<std::string>("-o");
+    auto D = program.get<unsigned long>("dim");
+    auto mesh_file = program.get<std::string>("mesh_file");
+
+    bool ok = false;
+    if (D == 2u) {
+        ok = mesh_quality<2u>(mesh_file, N, p, k, s, smoothed, output);
+    } else if (D == 3u) {
+        ok = mesh_quality<3u>(mesh_file, N, p, k, s, smoothed, output);
+    } else {
+        std::cerr << "Unsupported dimension " << D << std::endl;
+    }
+
+    MPI_Finalize();
+    return ok ? 0 : -1;
+}
@@ -1,3 +1,4 @@
+#include "form/SumFactorization.h"
 #include "quadrules/AutoRule.h"
 #include "util/Combinatorics.h"
 
@@ -11,7 +12,11 @@
 template <std::size_t D>
 void preprocess(unsigned N, unsigned minQuadOrder, std::string const& outputFileName) {
     auto fctRule = tndm::simplexQuadratureRule<D - 1u>(minQuadOrder);
+#ifdef TANDEM_SUM_FACTORIZATION
+    auto elRule = tndm::SumFactorization<D>::rule(minQuadOrder);
+#else
     auto elRule = tndm::simplexQuadratureRule<D>(minQuadOrder);
+#endif
 
     std::ofstream file;
     file.open(outputFileName);
@@ -15,13 +15,17 @@
 #include "form/DGOperator.h"
 #include "form/Error.h"
 #include "geometry/Curvilinear.h"
+#include "geometry/Vector.h"
 #include "io/GMSHParser.h"
 #include "io/GlobalSimplexMeshBuilder.h"
 #include "io/VTUAdapter.h"
 #include "io/VTUWriter.h"
 #include "mesh/GenMesh.h"
 #include "mesh/GlobalSimplexMesh.h"
+#include "mesh/Refinement.h"
 #include "parallel/Affinity.h"
+#include "parallel/RankPlacement.h"
+#include "parallel/ScatterPlan.h"
 #include "tensor/Managed.h"
 #include "util/Schema.h"
 #include "util/SchemaHelper.h"
@@ -38,37 +42,67 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 using namespace tndm;
 
+struct AdaptConfig {
+    std::optional<double> tolerance;
+    std::size_t max_elements;
+    unsigned max_steps;
+    double theta;
+    bool uniform;
+};
+
 struct Config {
     std::optional<double> resolution;
     DGMethod method;
+    GeometryMode geometry;
     LocalOpType type;
     std::string lib;
     std::string scenario;
+    std::array<double, DomainDimension> up;
     std::array<double, DomainDimension> ref_normal;
     bool matrix_free;
     bool test_matrix_free;
     MGStrategy mg_strategy;
     unsigned mg_coarse_level;
+    bool near_null_space;
+    bool nested_iteration;
+    bool rank_placement;
+    std::optional<double> exterior_free_surface;
+    std::optional<double> exterior_conductivity;
     int profile;
     std::optional<std::string> output;
     std::optional<std::string> mesh_file;
     std::optional<GenMeshConfig<DomainDimension>> generate_mesh;
+    std::optional<AdaptConfig> adapt;
+};
+
+struct StaticResult {
+    bool converged = false;
+    std::size_t num_elements = 0;
+    std::size_t num_dofs = 0;
+    std::optional<double> L2_error = std::nullopt;
+    std::optional<double> estimator = std::nullopt;
+    std::vector<double> eta2;
 };
 
 template <class Scenario>
-void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario const& scenario,
-                    Config const& cfg) {
+StaticResult static_problem(LocalSimplexMesh<DomainDimension> const& mesh,
+                            Scenario const& scenario, Config const& cfg) {
+    StaticResult result;
     tndm::Stopwatch sw;
     double time;
 
@@ -78,12 +112,25 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
     int rank;
     MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
 
+    sw.start();
     auto cl = std::make_shared<Curvilinear<DomainDimension>>(mesh, scenario.transform(),
                                                              PolynomialDegree);
 
-    auto lop = scenario.make_local_operator(cl, cfg.method);
+    auto lop = scenario.make_local_operator(cl, cfg.method, cfg.geometry);
+    if constexpr (std::is_same_v<Scenario, PoissonScenario>) {
+        if (cfg.exterior_free_surface) {
+            lop->set_exterior_free_surface({normalize(cfg.up), *cfg.exterior_free_surface});
+        }
+        if (cfg.exterior_conductivity) {
+            lop->set_exterior_conductivity(*cfg.exterior_conductivity);
+        }
+    }
     auto topo = std::make_shared<DGOperatorTopo>(mesh, PETSC_COMM_WORLD);
     auto dgop = DGOperator(topo, std::move(lop));
+    time = sw.stop();
+    if (rank == 0) {
+        std::cout << "Preparation: " << time << " s" << std::endl;
+    }
 
     const auto reduce_number = [&topo](std::size_t number) {
         std::size_t number_global;
@@ -91,6 +138,13 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
         return number_global;
     };
 
+    auto geometry_memory = reduce_number(dgop.lop().geometry_memory());
+    if (rank == 0) {
+        std::cout << "Geometry memory: " << geometry_memory / (1024.0 * 1024.0) << " MiB ("
+                  << (cfg.geometry == GeometryMode::Stored ? "stored" : "on-the-fly") << ")"
+                  << std::endl;
+    }
+
     if (cfg.test_matrix_free) {
         auto A = std::make_unique<PetscDGShell>(dgop);
         Vec x, y;
@@ -121,6 +175,8 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
     }
 
     std::size_t num_dofs_domain = reduce_number(dgop.number_of_local_dofs());
+    result.num_elements = reduce_number(dgop.num_local_elements());
+    result.num_dofs = num_dofs_domain;
 
     double local_mesh_size = cl->local_mesh_size();
     double mesh_size;
@@ -132,11 +188,19 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
     }
 
     sw.start();
-    auto solver =
-        PetscLinearSolver(dgop, cfg.matrix_free, MGConfig(cfg.mg_coarse_level, cfg.mg_strategy));
+    auto solver = PetscLinearSolver(dgop, cfg.matrix_free,
+                                    MGConfig(cfg.mg_coarse_level, cfg.mg_strategy),
+                                    cfg.near_null_space);
+    if (cfg.nested_iteration) {
+        solver.setup_nested(dgop, MGConfig(cfg.mg_coarse_level, cfg.mg_strategy));
+    }
     time = sw.stop();
     if (rank == 0) {
         std::cout << "Assembly: " << time << " s" << std::endl;
+        if (solver.near_null_space_size() > 0) {
+            std::cout << "Near null space: " << solver.near_null_space_size() << " vectors"
+                      << std::endl;
+        }
     }
 
     sw.start();
@@ -180,7 +244,7 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
     PetscLogStagePop();
     if (!solver.is_converged()) {
         std::cout << "Solver did not converge." << std::endl;
-        return;
+        return result;
     }
 
     PetscReal rnorm;
@@ -192,6 +256,24 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
         std::cout << "Iterations: " << its << std::endl;
     }
 
+    if (cfg.nested_iteration) {
+        sw.start();
+        solver.solve_nested();
+        time = sw.stop();
+        if (!solver.is_converged()) {
+            std::cout << "Nested solve did not converge." << std::endl;
+            return result;
+        }
+        if (rank == 0) {
+            std::cout << "Nested solve: " << time << " s" << std::endl;
+            std::cout << "Nested iterations (coarse to fine):";
+            for (auto nested_its : solver.nested_iterations()) {
+                std::cout << " " << nested_its;
+            }
+            std::cout << " (zero guess: " << its << ")" << std::endl;
+        }
+    }
+
     auto numeric = dgop.solution(solver.x());
     auto solution = scenario.solution();
     if (solution) {
@@ -200,6 +282,7 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
         if (rank == 0) {
             std::cout << "L2 error: " << error << std::endl;
         }
+        result.L2_error = error;
     }
     auto solution_jacobian = scenario.solution_jacobian();
     if (solution_jacobian) {
@@ -210,6 +293,26 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
         }
     }
 
+    if constexpr (decltype(dgop)::has_error_indicator()) {
+        if (cfg.adapt) {
+            sw.start();
+            result.eta2 = dgop.error_indicator(solver.x());
+            double eta2_sum = 0.0;
+            for (auto eta2 : result.eta2) {
+                eta2_sum += eta2;
+            }
+            MPI_Allreduce(MPI_IN_PLACE, &eta2_sum, 1, mpi_type_t<double>(), MPI_SUM,
+                          topo->comm());
+            result.estimator = std::sqrt(eta2_sum);
+            time = sw.stop();
+            if (rank == 0) {
+                std::cout << "Error estimator: " << *result.estimator << " (" << time << " s)"
+                          << std::endl;
+            }
+        }
+    }
+    result.converged = true;
+
     if (cfg.output) {
         auto coeffs = dgop.params();
         VTUWriter<DomainDimension> writer(PolynomialDegree, true, PETSC_COMM_WORLD);
@@ -220,6 +323,104 @@ void static_problem(LocalSimplexMesh<DomainDimension> const& mesh, Scenario cons
         piece.addPointData(coeffs);
         writer.write(*cfg.output);
     }
+    return result;
+}
+
+/**
+ * @brief Solves, estimates, and refines until the estimator drops below the tolerance or the
+ * element budget or the maximum number of steps is exhausted.
+ *
+ * Refinement is done on rank 0 (conforming longest-edge bisection) and the refined mesh is
+ * redistributed with the regular partitioners.
+ */
+template <class Scenario>
+void adaptive_problem(std::unique_ptr<LocalSimplexMesh<DomainDimension>> mesh,
+                      Scenario const& scenario, Config const& cfg) {
+    auto const& adapt = *cfg.adapt;
+    int rank, procs;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    MPI_Comm_size(PETSC_COMM_WORLD, &procs);
+
+    struct Step {
+        std::size_t num_elements;
+        std::size_t num_dofs;
+        std::optional<double> estimator;
+        std::optional<double> L2_error;
+        double time;
+    };
+    std::vector<Step> steps;
+
+    auto step_cfg = cfg;
+    tndm::Stopwatch sw;
+    double time = 0.0;
+    for (unsigned step = 0; step < adapt.max_steps; ++step) {
+        if (rank == 0) {
+            std::cout << std::endl << "Adaptive step " << step << std::endl;
+        }
+        if (cfg.output) {
+            step_cfg.output = *cfg.output + "_" + std::to_string(step);
+        }
+
+        sw.start();
+        auto result = static_problem(*mesh, scenario, step_cfg);
+        time += sw.stop();
+        if (!result.converged) {
+            break;
+        }
+        steps.push_back(
+            {result.num_elements, result.num_dofs, result.estimator, result.L2_error, time});
+
+        if ((adapt.tolerance && result.estimator && *result.estimator <= *adapt.tolerance) ||
+            result.num_elements >= adapt.max_elements || step + 1 >= adapt.max_steps) {
+            break;
+        }
+
+        sw.start();
+        auto globalMesh =
+            adapt.uniform
+                ? refineLocalMeshUniformly(*mesh, PETSC_COMM_WORLD)
+                : refineLocalMesh(*mesh, result.eta2, adapt.theta, PETSC_COMM_WORLD);
+        if (procs > 1) {
+            globalMesh->repartitionByHash();
+        }
+        globalMesh->repartition();
+        mesh = globalMesh->getLocalMesh(1);
+        time += sw.stop();
+    }
+
+    if (rank == 0) {
+        std::cout << std::endl
+                  << (adapt.uniform ? "Uniform" : "Adaptive") << " refinement summary" << std::endl;
+        std::cout << std::setw(6) << "step" << std::setw(12) << "elements" << std::setw(12)
+                  << "DOFs" << std::setw(14) << "estimator" << std::setw(14) << "L2 error"
+                  << std::setw(12) << "time [s]" << std::endl;
+        for (std::size_t i = 0; i < steps.size(); ++i) {
+            auto const& st = steps[i];
+            std::cout << std::setw(6) << i << std::setw(12) << st.num_elements << std::setw(12)
+                      << st.num_dofs << std::setw(14);
+            if (st.estimator) {
+                std::cout << *st.estimator;
+            } else {
+                std::cout << "-";
+            }
+            std::cout << std::setw(14);
+            if (st.L2_error) {
+                std::cout << *st.L2_error;
+            } else {
+                std::cout << "-";
+            }
+            std::cout << std::setw(12) << st.time << std::endl;
+        }
+        if (adapt.tolerance) {
+            if (!steps.empty() && steps.back().estimator &&
+                *steps.back().estimator <= *adapt.tolerance) {
+                std::cout << "Tolerance reached with " << steps.back().num_elements
+                          << " elements in " << steps.back().time << " s" << std::endl;
+            } else {
+                std::cout << "Tolerance not reached." << std::endl;
+            }
+        }
+    }
 }
 
 int main(int argc, char** argv) {
@@ -259,6 +460,20 @@ int main(int argc, char** argv) {
         })
         .default_value(DGMethod::IP)
         .validator([](DGMethod const& type) { return type != DGMethod::Unknown; });
+    schema.add_value("geometry", &Config::geometry)
+        .converter([](std::string_view value) {
+            if (iEquals(value, "stored")) {
+                return GeometryMode::Stored;
+            } else if (iEquals(value, "on-the-fly")) {
+                return GeometryMode::OnTheFly;
+            } else {
+                return GeometryMode::Unknown;
+            }
+        })
+        .default_value(GeometryMode::Stored)
+        .validator([](GeometryMode const& mode) { return mode != GeometryMode::Unknown; })
+        .help("Store metric terms at quadrature points or recompute them on the fly from the "
+              "element nodes (\"stored\" or \"on-the-fly\", the latter for elasticity only)");
     schema.add_value("type", &Config::type)
         .converter([](std::string_view value) {
             if (iEquals(value, "poisson")) {
@@ -274,6 +489,11 @@ int main(int argc, char** argv) {
         .converter(makePathRelativeToConfig)
         .validator(PathExists());
     schema.add_value("scenario", &Config::scenario);
+    {
+        auto default_up = std::array<double, DomainDimension>{};
+        default_up.back() = 1.0;
+        schema.add_array("up", &Config::up).default_value(std::move(default_up)).of_values();
+    }
     {
         auto default_ref_normal = std::array<double, DomainDimension>{};
         default_ref_normal[0] = 1.0;
@@ -298,6 +518,24 @@ int main(int argc, char** argv) {
         })
         .default_value(MGStrategy::TwoLevel)
         .validator([](MGStrategy const& type) { return type != MGStrategy::Unknown; });
+    schema.add_value("near_null_space", &Config::near_null_space)
+        .default_value(false)
+        .help("Attach the near null space (rigid body modes for elasticity) to the operator and "
+              "all multigrid levels, e.g. for -pc_type gamg or -mg_coarse_pc_type gamg");
+    schema.add_value("nested_iteration", &Config::nested_iteration)
+        .default_value(false)
+        .help("Additionally solve with nested iteration over the multigrid degrees, where each "
+              "degree starts from the prolongated solution of the next coarser degree");
+    schema.add_value("rank_placement", &Config::rank_placement)
+        .default_value(false)
+        .help("Map partitions to ranks such that ghost exchange stays on-node where possible");
+    schema.add_value("exterior_free_surface", &Config::exterior_free_surface)
+        .help("Height (in up direction) of the free surface bounding the exterior of exterior "
+              "boundaries");
+    schema.add_value("exterior_conductivity", &Config::exterior_conductivity)
+        .validator([](auto&& x) { return x > 0.0; })
+        .help("Coefficient K of the homogeneous exterior of exterior boundaries "
+              "(default: K of the adjacent interior element at every point)");
     schema.add_value("profile", &Config::profile)
         .default_value(0)
         .validator([](auto&& x) { return x >= 0; })
@@ -308,6 +546,25 @@ int main(int argc, char** argv) {
         .validator(PathExists());
     auto& genMeshSchema = schema.add_table("generate_mesh", &Config::generate_mesh);
     GenMeshConfig<DomainDimension>::setSchema(genMeshSchema);
+    auto& adaptSchema = schema.add_table("adapt", &Config::adapt);
+    adaptSchema.add_value("tolerance", &AdaptConfig::tolerance)
+        .validator([](auto&& x) { return x > 0; })
+        .help("Stop once the a-posteriori error estimator is below the tolerance");
+    adaptSchema.add_value("max_elements", &AdaptConfig::max_elements)
+        .default_value(std::numeric_limits<std::size_t>::max())
+        .help("Stop refining once the mesh has at least this many elements");
+    adaptSchema.add_value("max_steps", &AdaptConfig::max_steps)
+        .default_value(10)
+        .validator([](auto&& x) { return x > 0; })
+        .help("Maximum number of solves");
+    adaptSchema.add_value("theta", &AdaptConfig::theta)
+        .default_value(0.5)
+        .validator([](auto&& x) { return 0.0 < x && x <= 1.0; })
+        .help("Doerfler marking parameter: refine the smallest set of elements whose squared "
+              "indicators sum up to theta times the squared estimator");
+    adaptSchema.add_value("uniform", &AdaptConfig::uniform)
+        .default_value(false)
+        .help("Refine every element instead (for comparison with adaptive refinement)");
 
     std::optional<Config> cfg = readFromConfigurationFileAndCmdLine(schema, program, argc, argv);
     if (!cfg) {
@@ -359,16 +616,39 @@ int main(int argc, char** argv) {
     }
     globalMesh->repartition();
     auto mesh = globalMesh->getLocalMesh(1);
+    if (cfg->rank_placement) {
+        auto placement = RankPlacement(PETSC_COMM_WORLD);
+        int newRank = placement.place(ScatterPlan(mesh->elements(), PETSC_COMM_WORLD));
+        if (placement.changed()) {
+            globalMesh->moveToRank(newRank);
+            mesh = globalMesh->getLocalMesh(1);
+        }
+        placement.print(std::cout);
+    }
+
+    auto run = [&](auto const& scenario) {
+        if (cfg->adapt) {
+            adaptive_problem(std::move(mesh), scenario, *cfg);
+        } else {
+            static_problem(*mesh, scenario, *cfg);
+        }
+    };
 
     switch (cfg->type) {
     case LocalOpType::Poisson: {
         auto scenario = PoissonScenario(cfg->lib, cfg->scenario, cfg->ref_normal);
-        static_problem(*mesh, scenario, *cfg);
+        run(scenario);
         break;
     }
     case LocalOpType::Elasticity: {
+        if (cfg->adapt && (!cfg->adapt->uniform || cfg->adapt->tolerance)) {
+            std::cerr << "Elasticity has no error estimator: adaptive refinement and "
+                         "adapt.tolerance are only available for Poisson."
+                      << std::endl;
+            break;
+        }
         auto scenario = ElasticityScenario(cfg->lib, cfg->scenario, cfg->ref_normal);
-        static_problem(*mesh, scenario, *cfg);
+        run(scenario);
         break;
     }
     default:
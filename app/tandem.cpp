@@ -14,6 +14,8 @@
 #include "mesh/GenMesh.h"
 #include "mesh/GlobalSimplexMesh.h"
 #include "parallel/Affinity.h"
+#include "parallel/RankPlacement.h"
+#include "parallel/ScatterPlan.h"
 #include "util/Schema.h"
 #include "util/SchemaHelper.h"
 
@@ -114,6 +116,15 @@ int main(int argc, char** argv) {
     }
     globalMesh->repartition();
     auto mesh = globalMesh->getLocalMesh(1);
+    if (cfg->rank_placement) {
+        auto placement = RankPlacement(PETSC_COMM_WORLD);
+        int newRank = placement.place(ScatterPlan(mesh->elements(), PETSC_COMM_WORLD));
+        if (placement.changed()) {
+            globalMesh->moveToRank(newRank);
+            mesh = globalMesh->getLocalMesh(1);
+        }
+        placement.print(std::cout);
+    }
 
     solveSEASProblem(*mesh, *cfg);
 
@@ -8,6 +8,7 @@
 #include "form/FrictionOperator.h"
 #include "form/SeasQDOperator.h"
 #include "localoperator/DieterichRuinaAgeing.h"
+#include "localoperator/DieterichRuinaSlip.h"
 #include "localoperator/Elasticity.h"
 #include "localoperator/Poisson.h"
 #include "localoperator/RateAndState.h"
@@ -17,26 +18,36 @@
 
 #include "form/AbstractDGOperator.h"
 #include "form/DGOperator.h"
+#include "tensor/Managed.h"
+#include "tensor/Tensor.h"
 
 #include <petscsys.h>
 
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <optional>
+#include <stdexcept>
+#include <vector>
 
 namespace tndm::seas::detail {
 
 template <typename Type> struct make_lop;
 template <> struct make_lop<Poisson> {
     static auto dg(std::shared_ptr<Curvilinear<DomainDimension>> cl,
-                   SeasScenario<Poisson> const& scenario) {
+                   SeasScenario<Poisson> const& scenario, GeometryMode geometry) {
+        if (geometry != GeometryMode::Stored) {
+            throw std::runtime_error("On-the-fly geometry is only implemented for elasticity");
+        }
         return std::make_shared<Poisson>(std::move(cl), scenario.mu(), DGMethod::IP);
     }
 };
 template <> struct make_lop<Elasticity> {
     static auto dg(std::shared_ptr<Curvilinear<DomainDimension>> cl,
-                   SeasScenario<Elasticity> const& scenario) {
+                   SeasScenario<Elasticity> const& scenario, GeometryMode geometry) {
         return std::make_shared<Elasticity>(std::move(cl), scenario.lam(), scenario.mu(),
-                                            scenario.rho(), DGMethod::IP);
+                                            scenario.rho(), DGMethod::IP, scenario.damping(),
+                                            geometry);
     }
 };
 
@@ -48,31 +59,44 @@ template <typename Type> class Context : public ContextBase {
 public:
     using adapter_t = AdapterOperator<Type>;
     using dg_t = DGOperator<Type>;
-    using friction_lop_t = RateAndState<DieterichRuinaAgeing>;
+    using friction_lop_t = RateAndState<DieterichRuinaAgeing, DieterichRuinaSlip>;
     using friction_t = FrictionOperator<friction_lop_t>;
 
     Context(LocalSimplexMesh<DomainDimension> const& mesh,
             std::unique_ptr<SeasScenario<Type>> seas_sc,
-            std::unique_ptr<DieterichRuinaAgeingScenario> friction_sc,
-            std::array<double, DomainDimension> up, std::array<double, DomainDimension> ref_normal)
+            std::unique_ptr<RateAndStateScenario> friction_sc,
+            std::array<double, DomainDimension> up, std::array<double, DomainDimension> ref_normal,
+            GeometryMode geometry = GeometryMode::Stored)
         : ContextBase(mesh, seas_sc->transform()), scenario(std::move(seas_sc)),
           friction_scenario(std::move(friction_sc)),
-          dg_lop(detail::make_lop<Type>::dg(cl, *scenario)), up(up), ref_normal(ref_normal) {}
+          dg_lop(detail::make_lop<Type>::dg(cl, *scenario, geometry)), up(up),
+          ref_normal(ref_normal) {}
 
     auto dg() -> std::unique_ptr<AbstractDGOperator<DomainDimension>> override {
-        return std::make_unique<dg_t>(topo, dg_lop);
+        auto dgop = std::make_unique<dg_t>(topo, dg_lop);
+        if (scenario->degree()) {
+            dgop->set_element_degree(element_degree(*scenario->degree()));
+        }
+        return dgop;
     }
     auto friction() -> std::unique_ptr<AbstractFrictionOperator> override {
         auto fric =
             std::make_unique<friction_t>(std::make_unique<friction_lop_t>(cl), topo, fault_map);
         fric->lop().set_constant_params(friction_scenario->constant_params());
         fric->lop().set_params(friction_scenario->param_fun());
+        if (friction_scenario->law_fun()) {
+            fric->lop().set_law(*friction_scenario->law_fun());
+        }
         if (friction_scenario->source_fun()) {
             fric->lop().set_source_fun(*friction_scenario->source_fun());
         }
         if (friction_scenario->delta_tau_fun()) {
             fric->lop().set_delta_tau_fun(*friction_scenario->delta_tau_fun());
         }
+        if (initial_state) {
+            fric->lop().set_initial_state_fun(
+                make_snapshot_fun<friction_lop_t::NumQuantities>(initial_state->fault));
+        }
         return fric;
     }
     auto adapter() -> std::unique_ptr<AbstractAdapterOperator> override {
@@ -101,6 +125,17 @@ public:
             seasop.set_initial_velocity(std::make_unique<VolumeFunctionalFactory<Type>>(
                 dg_lop, *scenario->initial_velocity()));
         }
+        if (initial_state) {
+            if (!initial_state->displacement || !initial_state->velocity) {
+                throw std::runtime_error(
+                    "Initial state lacks displacement and velocity (fully dynamic runs only "
+                    "continue from fully dynamic snapshots)");
+            }
+            seasop.set_initial_displacement(std::make_unique<VolumeFunctionalFactory<Type>>(
+                dg_lop, make_snapshot_fun<Type::NumQuantities>(*initial_state->displacement)));
+            seasop.set_initial_velocity(std::make_unique<VolumeFunctionalFactory<Type>>(
+                dg_lop, make_snapshot_fun<Type::NumQuantities>(*initial_state->velocity)));
+        }
     }
     auto domain_solution(double time) -> std::unique_ptr<SolutionInterface> override {
         return scenario->solution(time);
@@ -108,12 +143,52 @@ public:
     auto fault_solution(double time) -> std::unique_ptr<SolutionInterface> override {
         return friction_scenario->solution(time);
     }
+    std::size_t geometry_memory() const override { return dg_lop->geometry_memory(); }
 
     std::unique_ptr<SeasScenario<Type>> scenario;
-    std::unique_ptr<DieterichRuinaAgeingScenario> friction_scenario;
+    std::unique_ptr<RateAndStateScenario> friction_scenario;
     std::shared_ptr<Type> dg_lop;
 
 private:
+    template <std::size_t NumQuantities, typename Snapshot>
+    auto make_snapshot_fun(Snapshot const& snapshot) const {
+        if (snapshot.numQuantities() != NumQuantities) {
+            throw std::runtime_error("Number of quantities in initial state does not match");
+        }
+        // Keep the snapshot alive as long as the function exists
+        return [state = initial_state, &snapshot](std::array<double, DomainDimension> const& x) {
+            std::array<double, NumQuantities> result;
+            snapshot.evaluate(x, result.data());
+            return result;
+        };
+    }
+
+    /**
+     * @brief Evaluates the degree function at the centroid of every local and ghost element
+     */
+    template <typename Functional>
+    auto element_degree(Functional const& degree) const -> std::vector<unsigned> {
+        constexpr std::size_t D = DomainDimension;
+        auto centroid = std::array<double, D>{};
+        centroid.fill(1.0 / (D + 1));
+        auto E = cl->evaluateBasisAt({centroid});
+        auto X = Managed<Matrix<double>>(cl->mapResultInfo(1));
+        auto result = std::vector<unsigned>(topo->numElements());
+        for (std::size_t elNo = 0; elNo < result.size(); ++elNo) {
+            cl->map(elNo, E, X);
+            auto x = std::array<double, D>{};
+            for (std::size_t d = 0; d < D; ++d) {
+                x[d] = X(d, 0);
+            }
+            double p = std::round(degree(x)[0]);
+            if (p < 0.0) {
+                throw std::runtime_error("Polynomial degree must not be negative");
+            }
+            result[elNo] = static_cast<unsigned>(p);
+        }
+        return result;
+    }
+
     std::array<double, DomainDimension> up;
     std::array<double, DomainDimension> ref_normal;
 };
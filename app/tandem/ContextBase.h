@@ -6,6 +6,7 @@
 #include "form/AbstractFrictionOperator.h"
 #include "form/SeasFDOperator.h"
 #include "form/SeasQDOperator.h"
+#include "tandem/StateSnapshot.h"
 
 #include "form/AbstractDGOperator.h"
 #include "form/BoundaryMap.h"
@@ -16,6 +17,9 @@
 
 #include <petscsys.h>
 
+#include <cstddef>
+#include <memory>
+
 namespace tndm::seas {
 
 class ContextBase {
@@ -37,10 +41,16 @@ public:
     virtual void setup_seasop(SeasFDOperator& seasop) = 0;
     virtual auto domain_solution(double time) -> std::unique_ptr<SolutionInterface> = 0;
     virtual auto fault_solution(double time) -> std::unique_ptr<SolutionInterface> = 0;
+    /**
+     * @brief Memory in bytes of precomputed geometry data of the domain operator on this rank
+     */
+    virtual std::size_t geometry_memory() const = 0;
 
     std::shared_ptr<Curvilinear<DomainDimension>> cl;
     std::shared_ptr<BoundaryMap> fault_map;
     std::shared_ptr<DGOperatorTopo> topo;
+    /// Continue from this state instead of the initial condition of the scenario
+    std::shared_ptr<StateSnapshot const> initial_state;
 };
 
 } // namespace tndm::seas
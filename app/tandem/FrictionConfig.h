@@ -18,7 +18,13 @@
 
 namespace tndm {
 
-class DieterichRuinaAgeingScenario {
+/**
+ * @brief Rate and state parameters from a Lua scenario.
+ *
+ * The optional member "law" returns the index of the friction law at a point;
+ * see RateAndState::LawNames (0 = ageing law if omitted).
+ */
+class RateAndStateScenario {
 public:
     template <std::size_t D>
     using functional_t = std::function<std::array<double, 1>(std::array<double, D> const&)>;
@@ -41,13 +47,17 @@ public:
     constexpr static char Source[] = "source";
     constexpr static char DeltaTau[] = "delta_tau";
     constexpr static char FaultSolution[] = "fault_solution";
+    constexpr static char Law[] = "law";
 
-    DieterichRuinaAgeingScenario(std::string const& lib, std::string const& scenario) {
+    RateAndStateScenario(std::string const& lib, std::string const& scenario) {
         lib_.loadFile(lib);
 
         a_ = lib_.getMemberFunction<DomainDimension, 1>(scenario, A);
         eta_ = lib_.getMemberFunction<DomainDimension, 1>(scenario, Eta);
         L_ = lib_.getMemberFunction<DomainDimension, 1>(scenario, L);
+        if (lib_.hasMember(scenario, Law)) {
+            law_ = std::make_optional(lib_.getMemberFunction<DomainDimension, 1>(scenario, Law));
+        }
         if (lib_.hasMember(scenario, SnPre)) {
             sn_pre_ = lib_.getMemberFunction<DomainDimension, 1>(scenario, SnPre);
         }
@@ -100,6 +110,7 @@ public:
             return p;
         };
     }
+    auto const& law_fun() const { return law_; }
     auto const& source_fun() const { return source_; }
     auto const& delta_tau_fun() const { return delta_tau_; }
     std::unique_ptr<SolutionInterface> solution(double time) const {
@@ -122,6 +133,7 @@ protected:
     vector_functional_t<DomainDimension> Vinit_;
     vector_functional_t<DomainDimension> Sinit_ = [](std::array<double, DomainDimension> const& x)
         -> std::array<double, DieterichRuinaAgeing::TangentialComponents> { return {}; };
+    std::optional<functional_t<DomainDimension>> law_ = std::nullopt;
     std::optional<functional_t<DomainDimension + 1>> source_ = std::nullopt;
     std::optional<vector_functional_t<DomainDimension + 1>> delta_tau_ = std::nullopt;
     std::optional<SeasSolution<NumQuantities>> solution_ = std::nullopt;
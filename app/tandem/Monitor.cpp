@@ -25,7 +25,8 @@ void MonitorQD::monitor(double time, BlockVector const& state) {
         bool require_displacement = false;
         for (auto const& writer : writers_) {
             if (writer->is_write_required(time, VMax)) {
-                require_traction = require_traction || writer->level() == DataLevel::Boundary;
+                require_traction = require_traction || writer->level() == DataLevel::Boundary ||
+                                   writer->level() == DataLevel::Event;
                 require_displacement = require_displacement || writer->level() == DataLevel::Volume;
             }
         }
@@ -42,6 +43,11 @@ void MonitorQD::monitor(double time, BlockVector const& state) {
                     writer->write(time, mneme::span(&data, 1));
                     break;
                 }
+                case DataLevel::Event: {
+                    auto data = boundary_data(time, state, nullptr);
+                    writer->write(time, mneme::span(&data, 1));
+                    break;
+                }
                 case DataLevel::Volume: {
                     auto data = volume_data(writer->subset());
                     writer->write(time, mneme::span(&data, 1));
@@ -60,6 +66,7 @@ void MonitorQD::write_static() {
     for (auto const& writer : writers_) {
         switch (writer->level()) {
         case DataLevel::Scalar:
+        case DataLevel::Event:
             break;
         case DataLevel::Boundary: {
             auto data = static_boundary_data(writer->subset());
@@ -91,6 +98,11 @@ void MonitorFD::monitor(double time, BlockVector const& v, BlockVector const& u,
                     writer->write(time, mneme::span(&data, 1));
                     break;
                 }
+                case DataLevel::Event: {
+                    auto data = boundary_data(time, s, nullptr);
+                    writer->write(time, mneme::span(&data, 1));
+                    break;
+                }
                 case DataLevel::Volume: {
                     auto data = volume_data(v, u, writer->subset());
                     data[0].setNames(velocity_names(data[0].numQuantities()));
@@ -110,6 +122,7 @@ void MonitorFD::write_static() {
     for (auto const& writer : writers_) {
         switch (writer->level()) {
         case DataLevel::Scalar:
+        case DataLevel::Event:
             break;
         case DataLevel::Boundary: {
             auto data = static_boundary_data(writer->subset());
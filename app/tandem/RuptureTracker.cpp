@@ -0,0 +1,114 @@
+#include "RuptureTracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+namespace tndm::seas {
+
+void RuptureTracker::find_quantities(fault_function_t const& fault_state) {
+    for (std::size_t q = 0; q < fault_state.numQuantities(); ++q) {
+        auto name = fault_state.name(q);
+        if (name.rfind("slip-rate", 0) == 0) {
+            slip_rate_q_.push_back(q);
+        } else if (name.rfind("slip", 0) == 0) {
+            slip_q_.push_back(q);
+        }
+    }
+    if (slip_rate_q_.empty() || slip_q_.size() != slip_rate_q_.size()) {
+        throw std::runtime_error("Rupture tracking requires slip and slip-rate in the fault state");
+    }
+}
+
+void RuptureTracker::begin_event(double time, fault_function_t const& fault_state) {
+    auto names = std::vector<std::string>{"rupture-time", "peak-slip-rate", "peak-time"};
+    char buf[100];
+    for (std::size_t t = 0; t < slip_q_.size(); ++t) {
+        snprintf(buf, sizeof(buf), "slip%lu", t);
+        names.emplace_back(buf);
+    }
+    acc_ = std::make_unique<fault_function_t>(fault_state.refElement().clone(), std::move(names),
+                                              fault_state.numElements());
+
+    auto& acc = acc_->values();
+    auto const& s = fault_state.values();
+    for (std::size_t elNo = 0; elNo < fault_state.numElements(); ++elNo) {
+        for (std::size_t node = 0; node < fault_state.numBasisFunctions(); ++node) {
+            acc(node, 0, elNo) = -1.0;
+            acc(node, 1, elNo) = 0.0;
+            acc(node, 2, elNo) = time;
+            for (std::size_t t = 0; t < slip_q_.size(); ++t) {
+                acc(node, 3 + t, elNo) = s(node, slip_q_[t], elNo);
+            }
+        }
+    }
+    in_event_ = true;
+    start_time_ = time;
+}
+
+bool RuptureTracker::update(double time, fault_function_t const& fault_state) {
+    if (slip_rate_q_.empty()) {
+        find_quantities(fault_state);
+    }
+
+    auto const& s = fault_state.values();
+    auto const slip_rate = [&](std::size_t node, std::size_t elNo) {
+        double V = 0.0;
+        for (auto q : slip_rate_q_) {
+            V += s(node, q, elNo) * s(node, q, elNo);
+        }
+        return std::sqrt(V);
+    };
+
+    double VMax_local = 0.0;
+    for (std::size_t elNo = 0; elNo < fault_state.numElements(); ++elNo) {
+        for (std::size_t node = 0; node < fault_state.numBasisFunctions(); ++node) {
+            VMax_local = std::max(VMax_local, slip_rate(node, elNo));
+        }
+    }
+    double VMax;
+    MPI_Allreduce(&VMax_local, &VMax, 1, MPI_DOUBLE, MPI_MAX, comm_);
+
+    if (!in_event_) {
+        if (VMax < threshold_) {
+            return false;
+        }
+        begin_event(time, fault_state);
+    }
+
+    auto& acc = acc_->values();
+    for (std::size_t elNo = 0; elNo < fault_state.numElements(); ++elNo) {
+        for (std::size_t node = 0; node < fault_state.numBasisFunctions(); ++node) {
+            double V = slip_rate(node, elNo);
+            if (V >= threshold_ && acc(node, 0, elNo) < 0.0) {
+                acc(node, 0, elNo) = time;
+            }
+            if (V > acc(node, 1, elNo)) {
+                acc(node, 1, elNo) = V;
+                acc(node, 2, elNo) = time;
+            }
+        }
+    }
+
+    if (VMax >= threshold_) {
+        return false;
+    }
+
+    // Event ended: slip accumulators hold the slip at the start of the event
+    for (std::size_t elNo = 0; elNo < fault_state.numElements(); ++elNo) {
+        for (std::size_t node = 0; node < fault_state.numBasisFunctions(); ++node) {
+            for (std::size_t t = 0; t < slip_q_.size(); ++t) {
+                acc(node, 3 + t, elNo) = s(node, slip_q_[t], elNo) - acc(node, 3 + t, elNo);
+            }
+        }
+    }
+    event_ = std::move(acc_);
+    in_event_ = false;
+    end_time_ = time;
+    ++num_events_;
+    return true;
+}
+
+} // namespace tndm::seas
@@ -0,0 +1,87 @@
+#ifndef RUPTURETRACKER_20261018_H
+#define RUPTURETRACKER_20261018_H
+
+#include "config.h"
+#include "form/FiniteElementFunction.h"
+#include "form/RefElement.h"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace tndm::seas {
+
+/**
+ * @brief In-situ rupture statistics per fault node.
+ *
+ * An event starts when the maximum slip-rate on the fault exceeds the threshold and ends when
+ * it drops below the threshold again. During an event the following quantities are accumulated
+ * at every node of the fault state:
+ *
+ * - rupture-time: First time the slip-rate exceeds the threshold (-1 if never)
+ * - peak-slip-rate: Maximum slip-rate
+ * - peak-time: Time of the maximum slip-rate
+ * - slip<t>: Slip since the start of the event
+ *
+ * The fault state is expected to be nodal and to contain the quantities slip<t> and
+ * slip-rate<t> (see RateAndState::state_prototype). Slip accumulated before the start of
+ * an event is neglected; it is bounded by threshold * time step.
+ */
+class RuptureTracker {
+public:
+    using fault_function_t = FiniteElementFunction<DomainDimension - 1u>;
+
+    RuptureTracker(double slip_rate_threshold, MPI_Comm comm)
+        : threshold_(slip_rate_threshold), comm_(comm) {}
+
+    /**
+     * @brief True if update must be called for this time step.
+     *
+     * @param VMax Global maximum slip-rate
+     */
+    bool is_update_required(double VMax) const { return in_event_ || VMax >= threshold_; }
+
+    /**
+     * @brief Updates the accumulators after an accepted time step.
+     *
+     * @param time Current time
+     * @param fault_state Fault state of all local fault facets
+     *
+     * @return True if an event ended in this step; the result is then available in event()
+     */
+    bool update(double time, fault_function_t const& fault_state);
+
+    bool in_event() const { return in_event_; }
+    std::size_t num_events() const { return num_events_; }
+    double event_start_time() const { return start_time_; }
+    double event_end_time() const { return end_time_; }
+
+    /**
+     * @brief Accumulated fields of the last completed event.
+     */
+    auto event() const -> fault_function_t const& { return *event_; }
+
+private:
+    void find_quantities(fault_function_t const& fault_state);
+    void begin_event(double time, fault_function_t const& fault_state);
+
+    double threshold_;
+    MPI_Comm comm_;
+
+    std::vector<std::size_t> slip_q_;
+    std::vector<std::size_t> slip_rate_q_;
+
+    bool in_event_ = false;
+    std::size_t num_events_ = 0;
+    double start_time_ = 0.0;
+    double end_time_ = 0.0;
+    std::unique_ptr<fault_function_t> acc_;
+    std::unique_ptr<fault_function_t> event_;
+};
+
+} // namespace tndm::seas
+
+#endif // RUPTURETRACKER_20261018_H
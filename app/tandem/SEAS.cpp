@@ -1,4 +1,6 @@
 #include "SEAS.h"
+#include "common/MGConfig.h"
+#include "common/NewmarkTimeSolver.h"
 #include "common/PetscTimeSolver.h"
 #include "config.h"
 #include "form/AbstractDGOperator.h"
@@ -22,14 +24,17 @@
 #include "tandem/FrictionConfig.h"
 #include "tandem/Monitor.h"
 #include "tandem/SeasScenario.h"
+#include "tandem/StateSnapshot.h"
 #include "tandem/Writer.h"
 
 #include "form/DGOperator.h"
 #include "form/DGOperatorTopo.h"
 #include "form/Error.h"
 #include "geometry/Curvilinear.h"
+#include "geometry/Vector.h"
 #include "parallel/MPITraits.h"
 #include "tensor/Managed.h"
+#include "util/PerfCounters.h"
 #include "util/Stopwatch.h"
 
 #include <limits>
@@ -51,10 +56,20 @@ namespace tndm::detail {
 
 template <typename Type>
 auto make_context(LocalSimplexMesh<DomainDimension> const& mesh, Config const& cfg) {
-    return std::make_unique<seas::Context<Type>>(
+    auto ctx = std::make_unique<seas::Context<Type>>(
         mesh, std::make_unique<SeasScenario<Type>>(cfg.lib, cfg.scenario),
-        std::make_unique<DieterichRuinaAgeingScenario>(cfg.lib, cfg.scenario), cfg.up,
-        cfg.ref_normal);
+        std::make_unique<RateAndStateScenario>(cfg.lib, cfg.scenario), cfg.up, cfg.ref_normal,
+        cfg.geometry);
+    if constexpr (std::is_same_v<Type, Poisson>) {
+        if (cfg.exterior_free_surface) {
+            ctx->dg_lop->set_exterior_free_surface(
+                {normalize(cfg.up), *cfg.exterior_free_surface});
+        }
+        if (cfg.exterior_conductivity) {
+            ctx->dg_lop->set_exterior_conductivity(*cfg.exterior_conductivity);
+        }
+    }
+    return ctx;
 }
 
 template <std::size_t N>
@@ -90,15 +105,27 @@ auto add_writers(Config const& cfg, LocalSimplexMesh<DomainDimension> const& mes
     }
     if (cfg.fault_output) {
         auto const& oc = *cfg.fault_output;
-        monitor.add_writer(std::make_unique<seas::FaultWriter<DomainDimension>>(
-            oc.prefix, oc.make_adaptive_output_interval(), mesh, cl, PolynomialDegree, fault_map,
-            comm));
+        if (oc.sparse) {
+            monitor.add_writer(std::make_unique<seas::SparseFaultWriter<DomainDimension>>(
+                oc.prefix, oc.make_adaptive_output_interval(), mesh, cl, PolynomialDegree,
+                fault_map, oc.slip_rate_threshold, oc.state_threshold, oc.keyframe_interval,
+                comm));
+        } else {
+            monitor.add_writer(std::make_unique<seas::FaultWriter<DomainDimension>>(
+                oc.prefix, oc.make_adaptive_output_interval(), mesh, cl, PolynomialDegree,
+                fault_map, comm));
+        }
     }
     if (cfg.fault_scalar_output) {
         auto const& oc = *cfg.fault_scalar_output;
         monitor.add_writer(std::make_unique<seas::FaultScalarWriter>(
             oc.prefix, oc.make_writer(), oc.make_adaptive_output_interval(), comm));
     }
+    if (cfg.rupture_output) {
+        auto const& oc = *cfg.rupture_output;
+        monitor.add_writer(std::make_unique<seas::RuptureWriter<DomainDimension>>(
+            oc.prefix, mesh, cl, PolynomialDegree, fault_map, oc.slip_rate_threshold, comm));
+    }
     if (cfg.domain_output) {
         auto const& oc = *cfg.domain_output;
         monitor.add_writer(std::make_unique<seas::DomainWriter<DomainDimension>>(
@@ -113,9 +140,11 @@ template <typename T> struct qd_operator_specifics {
     using monitor_t = seas::MonitorQD;
 
     static auto make(Config const& cfg, seas::ContextBase& ctx) {
-        auto seasop = std::make_shared<T>(std::move(ctx.dg()), std::move(ctx.adapter()),
-                                          std::move(ctx.friction()), cfg.matrix_free,
-                                          MGConfig(cfg.mg_coarse_level, cfg.mg_strategy));
+        auto seasop = std::make_shared<T>(
+            std::move(ctx.dg()), std::move(ctx.adapter()), std::move(ctx.friction()),
+            cfg.matrix_free, MGConfig(cfg.mg_coarse_level, cfg.mg_strategy), cfg.nested_iteration,
+            cfg.near_null_space);
+        seasop->set_boundary_linear(cfg.boundary_linear);
         ctx.setup_seasop(*seasop);
         seasop->warmup();
         return seasop;
@@ -133,13 +162,41 @@ template <typename T> struct qd_operator_specifics {
         return seasop.friction().raw_state(ts.state(0));
     }
 
-    static void print_profile(T const&) {}
+    template <typename TimeSolver>
+    static auto snapshot(double time, TimeSolver const& ts, T& seasop, seas::ContextBase& ctx) {
+        auto snapshot = seas::StateSnapshot{};
+        snapshot.time = time;
+        snapshot.fault = seas::StateSnapshot::fault_snapshot_t::gather(
+            seasop.friction().raw_state(ts.state(0)),
+            seas::fault_vertices(*ctx.cl, *ctx.topo, *ctx.fault_map), seasop.comm());
+        return snapshot;
+    }
+
+    static void print_profile(T const& seasop) {
+        seasop.profile().print(std::cout, seasop.comm());
+    }
 };
 template <>
 struct operator_specifics<SeasQDOperator> : public qd_operator_specifics<SeasQDOperator> {};
 template <>
 struct operator_specifics<SeasQDDiscreteGreenOperator>
-    : public qd_operator_specifics<SeasQDDiscreteGreenOperator> {};
+    : public qd_operator_specifics<SeasQDDiscreteGreenOperator> {
+    static auto make(Config const& cfg, seas::ContextBase& ctx) {
+        auto seasop = std::make_shared<SeasQDDiscreteGreenOperator>(
+            std::move(ctx.dg()), std::move(ctx.adapter()), std::move(ctx.friction()),
+            cfg.matrix_free, MGConfig(cfg.mg_coarse_level, cfg.mg_strategy), cfg.nested_iteration,
+            cfg.near_null_space, cfg.green_out_of_core, cfg.green_incremental);
+        seasop->set_boundary_linear(cfg.boundary_linear);
+        ctx.setup_seasop(*seasop);
+        seasop->warmup();
+        return seasop;
+    }
+
+    static void print_profile(SeasQDDiscreteGreenOperator const& seasop) {
+        seasop.profile().print(std::cout, seasop.comm());
+        seasop.print_incremental_statistics(std::cout);
+    }
+};
 
 template <> struct operator_specifics<SeasFDOperator> {
     using monitor_t = seas::MonitorFD;
@@ -165,25 +222,76 @@ template <> struct operator_specifics<SeasFDOperator> {
         return seasop.friction().raw_state(ts.state(2));
     }
 
+    template <typename TimeSolver>
+    static auto snapshot(double time, TimeSolver const& ts, SeasFDOperator& seasop,
+                         seas::ContextBase& ctx) {
+        using volume_snapshot_t = seas::StateSnapshot::volume_snapshot_t;
+        auto vertices = seas::element_vertices(*ctx.cl, *ctx.topo);
+        auto snapshot = seas::StateSnapshot{};
+        snapshot.time = time;
+        snapshot.fault = seas::StateSnapshot::fault_snapshot_t::gather(
+            seasop.friction().raw_state(ts.state(2)),
+            seas::fault_vertices(*ctx.cl, *ctx.topo, *ctx.fault_map), seasop.comm());
+        snapshot.displacement = volume_snapshot_t::gather(seasop.domain_function(ts.state(1)),
+                                                          vertices, seasop.comm());
+        snapshot.velocity = volume_snapshot_t::gather(seasop.domain_function(ts.state(0)),
+                                                      vertices, seasop.comm());
+        return snapshot;
+    }
+
     static void print_profile(SeasFDOperator const& seasop) {
         seasop.profile().print(std::cout, seasop.comm());
     }
 };
 
+template <typename seas_t, typename TimeSolver>
+void run_seas_problem(LocalSimplexMesh<DomainDimension> const& mesh, Config const& cfg,
+                      seas::ContextBase& ctx, std::shared_ptr<seas_t> seasop, TimeSolver& ts,
+                      double start_time, std::optional<double> cfl_time_step);
+
 template <typename seas_t>
 void solve_seas_problem(LocalSimplexMesh<DomainDimension> const& mesh, Config const& cfg,
                         seas::ContextBase& ctx) {
+    double start_time = 0.0;
+    if (cfg.initial_state) {
+        ctx.initial_state = std::make_shared<seas::StateSnapshot const>(
+            seas::StateSnapshot::read(*cfg.initial_state, PETSC_COMM_WORLD));
+        start_time = ctx.initial_state->time;
+        if (start_time > cfg.final_time) {
+            throw std::runtime_error("Time of initial state exceeds final time");
+        }
+    }
+
     auto seasop = operator_specifics<seas_t>::make(cfg, ctx);
+    auto state_vecs =
+        make_state_vecs(seasop->block_sizes(), seasop->num_local_elements(), seasop->comm());
+    auto cfl_time_step = operator_specifics<seas_t>::cfl_time_step(*seasop);
 
-    auto ts =
-        PetscTimeSolver(*seasop, make_state_vecs(seasop->block_sizes(),
-                                                 seasop->num_local_elements(), seasop->comm()));
+    if constexpr (std::is_same_v<seas_t, SeasFDOperator>) {
+        if (cfg.newmark) {
+            if (!cfl_time_step) {
+                throw std::runtime_error("The Newmark time integrator requires a CFL time step");
+            }
+            auto ts = NewmarkTimeSolver(*seasop, std::move(state_vecs), *cfg.newmark,
+                                        MGConfig(cfg.mg_coarse_level, cfg.mg_strategy),
+                                        start_time, *cfl_time_step * cfg.cfl,
+                                        cfg.near_null_space);
+            run_seas_problem(mesh, cfg, ctx, seasop, ts, start_time, cfl_time_step);
+            return;
+        }
+    }
 
-    auto cfl_time_step = operator_specifics<seas_t>::cfl_time_step(*seasop);
+    auto ts = PetscTimeSolver(*seasop, std::move(state_vecs), start_time);
     if (cfl_time_step) {
         ts.set_max_time_step(*cfl_time_step * cfg.cfl);
     }
+    run_seas_problem(mesh, cfg, ctx, seasop, ts, start_time, cfl_time_step);
+}
 
+template <typename seas_t, typename TimeSolver>
+void run_seas_problem(LocalSimplexMesh<DomainDimension> const& mesh, Config const& cfg,
+                      seas::ContextBase& ctx, std::shared_ptr<seas_t> seasop, TimeSolver& ts,
+                      double start_time, std::optional<double> cfl_time_step) {
     auto monitor =
         std::make_unique<typename operator_specifics<seas_t>::monitor_t>(seasop, ts.fsal());
     add_writers(cfg, mesh, ctx.cl, seasop->adapter().fault_map(), *monitor, seasop->comm());
@@ -202,6 +310,7 @@ void solve_seas_problem(LocalSimplexMesh<DomainDimension> const& mesh, Config co
     };
     std::size_t num_dofs_domain = reduce_number(seasop->domain().number_of_local_dofs());
     std::size_t num_dofs_fault = reduce_number(seasop->friction().number_of_local_dofs());
+    std::size_t geometry_memory = reduce_number(ctx.geometry_memory());
 
     double local_mesh_size = ctx.cl->local_mesh_size();
     double mesh_size;
@@ -211,9 +320,26 @@ void solve_seas_problem(LocalSimplexMesh<DomainDimension> const& mesh, Config co
         std::cout << "DOFs (domain): " << num_dofs_domain << std::endl;
         std::cout << "DOFs (fault): " << num_dofs_fault << std::endl;
         std::cout << "Mesh size: " << mesh_size << std::endl;
+        std::cout << "Geometry memory: " << geometry_memory / (1024.0 * 1024.0) << " MiB ("
+                  << (cfg.geometry == GeometryMode::Stored ? "stored" : "on-the-fly") << ")"
+                  << std::endl;
         if (cfl_time_step) {
             std::cout << "CFL time step: " << *cfl_time_step << std::endl;
         }
+        if (cfg.newmark) {
+            std::cout << "Time integrator: Newmark (beta = " << cfg.newmark->beta
+                      << ", gamma = " << cfg.newmark->gamma << ")" << std::endl;
+        }
+        if (cfg.initial_state) {
+            std::cout << "Initial state: " << *cfg.initial_state << " (time = " << start_time
+                      << ")" << std::endl;
+        }
+    }
+
+    if (cfg.hardware_counters && !PerfCounters::enable() && rank == 0) {
+        std::cout << "Hardware performance counters are not available "
+                     "(check /proc/sys/kernel/perf_event_paranoid)."
+                  << std::endl;
     }
 
     Stopwatch sw;
@@ -221,6 +347,13 @@ void solve_seas_problem(LocalSimplexMesh<DomainDimension> const& mesh, Config co
     ts.solve(cfg.final_time);
     double solve_time = sw.stop();
 
+    if (cfg.state_output) {
+        auto snapshot = operator_specifics<seas_t>::snapshot(cfg.final_time, ts, *seasop, ctx);
+        if (rank == 0) {
+            snapshot.write(*cfg.state_output);
+        }
+    }
+
     std::optional<double> L2_error_domain = std::nullopt;
     auto domain_solution = ctx.domain_solution(cfg.final_time);
     if (domain_solution) {
@@ -258,6 +391,7 @@ void solve_seas_problem(LocalSimplexMesh<DomainDimension> const& mesh, Config co
         std::cout << "dofs_domain=" << num_dofs_domain << std::endl;
         std::cout << "dofs_fault=" << num_dofs_fault << std::endl;
         std::cout << "mesh_size=" << mesh_size << std::endl;
+        std::cout << "geometry_memory=" << geometry_memory << std::endl;
         if (cfl_time_step) {
             std::cout << "dt_cfl=" << *cfl_time_step << std::endl;
         }
@@ -288,6 +422,9 @@ void solveSEASProblem(LocalSimplexMesh<DomainDimension> const& mesh, Config cons
         throw std::runtime_error("Unknown seas type");
         break;
     };
+    if (cfg.newmark && cfg.mode != SeasMode::FullyDynamic) {
+        throw std::runtime_error("The Newmark time integrator requires the fully dynamic mode");
+    }
     switch (cfg.mode) {
     case SeasMode::QuasiDynamicDiscreteGreen:
         detail::solve_seas_problem<SeasQDDiscreteGreenOperator>(mesh, cfg, *ctx);
@@ -39,6 +39,26 @@ template <typename Derived> void setDomainOutputConfigSchema(TableSchema<Derived
         .help("Output Jacobian");
 };
 
+template <typename Derived> void setFaultOutputConfigSchema(TableSchema<Derived>& outputSchema) {
+    setOutputConfigSchema(outputSchema);
+
+    outputSchema.add_value("sparse", up_cast<Derived>(&Derived::sparse))
+        .default_value(false)
+        .help("Only write facets whose slip-rate or state changed (see keyframe_interval)");
+    outputSchema.add_value("slip_rate_threshold", up_cast<Derived>(&Derived::slip_rate_threshold))
+        .validator([](auto&& x) { return x >= 0; })
+        .default_value(1e-9)
+        .help("Sparse output: facet is written if a slip-rate component changed by more");
+    outputSchema.add_value("state_threshold", up_cast<Derived>(&Derived::state_threshold))
+        .validator([](auto&& x) { return x >= 0; })
+        .default_value(1e-3)
+        .help("Sparse output: facet is written if the state variable changed by more");
+    outputSchema.add_value("keyframe_interval", up_cast<Derived>(&Derived::keyframe_interval))
+        .validator([](auto&& x) { return x > 0; })
+        .default_value(100)
+        .help("Sparse output: every n-th output contains all facets");
+};
+
 template <typename Derived> void setTabularOutputConfigSchema(TableSchema<Derived>& outputSchema) {
     setOutputConfigSchema(outputSchema);
 
@@ -115,14 +135,45 @@ void setConfigSchema(TableSchema<Config>& schema,
     schema.add_array("ref_normal", &Config::ref_normal).of_values();
     schema.add_value("boundary_linear", &Config::boundary_linear)
         .default_value(false)
-        .help("Assert that boundary is a linear function of time (i.e. boundary(x, t) = f(x) t).");
+        .help("Assert that boundary is a linear function of time (i.e. boundary(x, t) = f(x) t). "
+              "The response to f is then precomputed and superposed in quasi-dynamic solves.");
+    schema.add_value("exterior_free_surface", &Config::exterior_free_surface)
+        .help("Height (in up direction) of the free surface bounding the exterior of exterior "
+              "boundaries");
+    schema.add_value("exterior_conductivity", &Config::exterior_conductivity)
+        .validator([](auto&& x) { return x > 0.0; })
+        .help("Shear modulus of the homogeneous exterior of exterior boundaries "
+              "(default: shear modulus of the adjacent interior element at every point)");
 
     schema.add_value("matrix_free", &Config::matrix_free)
         .default_value(false)
         .help("Use matrix-free operators");
+    schema.add_value("geometry", &Config::geometry)
+        .converter([](std::string_view value) {
+            if (iEquals(value, "stored")) {
+                return GeometryMode::Stored;
+            } else if (iEquals(value, "on-the-fly")) {
+                return GeometryMode::OnTheFly;
+            } else {
+                return GeometryMode::Unknown;
+            }
+        })
+        .default_value(GeometryMode::Stored)
+        .validator([](GeometryMode const& mode) { return mode != GeometryMode::Unknown; })
+        .help("Store metric terms at quadrature points or recompute them on the fly from the "
+              "element nodes (\"stored\" or \"on-the-fly\", the latter for elasticity only)");
     schema.add_value("mg_coarse_level", &Config::mg_coarse_level)
         .default_value(1)
         .help("Polynomial degree of coarsest MG level");
+    schema.add_value("nested_iteration", &Config::nested_iteration)
+        .default_value(false)
+        .help("Start linear solves from a nested iteration over the MG degrees if no previous "
+              "solution is used as initial guess; the first solve is also run from zero to report "
+              "the iteration count without nested iteration");
+    schema.add_value("near_null_space", &Config::near_null_space)
+        .default_value(false)
+        .help("Attach the near null space (rigid body modes for elasticity) to the operator and "
+              "all multigrid levels, e.g. for -pc_type gamg or -mg_coarse_pc_type gamg");
     schema.add_value("mg_strategy", &Config::mg_strategy)
         .converter([](std::string_view value) {
             if (iEquals(value, "TwoLevel")) {
@@ -139,11 +190,76 @@ void setConfigSchema(TableSchema<Config>& schema,
         .validator([](MGStrategy const& type) { return type != MGStrategy::Unknown; })
         .help("MG level selection strategy (TwoLevel|Logarithmic|Full)");
 
+    schema.add_value("rank_placement", &Config::rank_placement)
+        .default_value(false)
+        .help("Map partitions to ranks such that ghost exchange stays on-node where possible");
+    // The counters are opened with inherit = 1, which only covers threads created after opening;
+    // OpenMP threads that are already running (e.g. of a threaded BLAS) are not counted
+    schema.add_value("hardware_counters", &Config::hardware_counters)
+        .default_value(false)
+        .help("Read hardware performance counters (Linux perf_event) in profiled regions; threads "
+              "running before the counters are enabled, e.g. OpenMP pools, are not counted");
+    schema.add_value("initial_state", &Config::initial_state)
+        .converter(path_converter)
+        .validator(PathExists())
+        .help("Continue from state snapshot (e.g. of a spin-up run on another mesh)");
+    schema.add_value("state_output", &Config::state_output)
+        .validator(ParentPathExists())
+        .help("Write state snapshot at final time to this file");
+
+    auto& greenOutOfCoreSchema = schema.add_table("green_out_of_core", &Config::green_out_of_core);
+    greenOutOfCoreSchema.add_value("scratch_dir", &OutOfCoreConfig::scratch_dir)
+        .converter(path_converter)
+        .validator(PathExists())
+        .help("Node-local directory in which the discrete Green's function is stored");
+    greenOutOfCoreSchema.add_value("tile_columns", &OutOfCoreConfig::tile_columns)
+        .validator([](auto&& x) { return x > 0; })
+        .default_value(256)
+        .help("Number of columns of the Green's function read from storage at once");
+
+    auto& greenIncrementalSchema =
+        schema.add_table("green_incremental", &Config::green_incremental);
+    greenIncrementalSchema.add_value("slip_tolerance", &IncrementalGreenConfig::slip_tolerance)
+        .validator([](auto&& x) { return x >= 0.0; })
+        .default_value(1e-9)
+        .help("Only apply columns of the Green's function whose slip changed by more than this");
+    greenIncrementalSchema
+        .add_value("refresh_interval", &IncrementalGreenConfig::refresh_interval)
+        .validator([](auto&& x) { return x > 0; })
+        .default_value(100)
+        .help("Number of RHS evaluations after which tractions are recomputed from scratch");
+    greenIncrementalSchema
+        .add_value("max_active_fraction", &IncrementalGreenConfig::max_active_fraction)
+        .validator([](auto&& x) { return x >= 0.0 && x <= 1.0; })
+        .default_value(0.5)
+        .help("Recompute tractions from scratch if a larger fraction of the slip changed");
+
+    auto& newmarkSchema = schema.add_table("newmark", &Config::newmark);
+    newmarkSchema.add_value("beta", &NewmarkConfig::beta)
+        .validator([](auto&& x) { return x > 0.0; })
+        .default_value(0.25)
+        .help("Newmark parameter beta");
+    newmarkSchema.add_value("gamma", &NewmarkConfig::gamma)
+        .validator([](auto&& x) { return x >= 0.5; })
+        .default_value(0.5)
+        .help("Newmark parameter gamma (gamma > 1/2 adds numerical damping)");
+    newmarkSchema.add_value("atol", &NewmarkConfig::atol)
+        .validator([](auto&& x) { return x >= 0.0; })
+        .default_value(1e-8)
+        .help("Absolute tolerance for slip and state variable");
+    newmarkSchema.add_value("rtol", &NewmarkConfig::rtol)
+        .validator([](auto&& x) { return x >= 0.0; })
+        .default_value(1e-6)
+        .help("Relative tolerance for slip and state variable");
+    newmarkSchema.add_value("max_time_step", &NewmarkConfig::max_time_step)
+        .validator([](auto&& x) { return x > 0.0; })
+        .help("Maximum time step");
+
     auto& genMeshSchema = schema.add_table("generate_mesh", &Config::generate_mesh);
     GenMeshConfig<DomainDimension>::setSchema(genMeshSchema);
 
     auto& faultOutputSchema = schema.add_table("fault_output", &Config::fault_output);
-    detail::setOutputConfigSchema(faultOutputSchema);
+    detail::setFaultOutputConfigSchema(faultOutputSchema);
     auto& faultScalarOutputSchema =
         schema.add_table("fault_scalar_output", &Config::fault_scalar_output);
     detail::setTabularOutputConfigSchema(faultScalarOutputSchema);
@@ -155,6 +271,15 @@ void setConfigSchema(TableSchema<Config>& schema,
     auto& domainProbeOutputSchema =
         schema.add_table("domain_probe_output", &Config::domain_probe_output);
     detail::setProbeOutputConfigSchema(domainProbeOutputSchema);
+    auto& ruptureOutputSchema = schema.add_table("rupture_output", &Config::rupture_output);
+    ruptureOutputSchema.add_value("prefix", &RuptureOutputConfig::prefix)
+        .validator(ParentPathExists())
+        .help("Output file name prefix");
+    ruptureOutputSchema.add_value("slip_rate_threshold", &RuptureOutputConfig::slip_rate_threshold)
+        .validator([](auto&& x) { return x > 0; })
+        .default_value(1e-3)
+        .help("An event lasts while the maximum slip-rate exceeds the threshold; rupture-time "
+              "is the first time the slip-rate at a node exceeds the threshold");
 }
 
 } // namespace tndm
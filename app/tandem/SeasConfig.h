@@ -1,10 +1,14 @@
 #ifndef CONFIG_20200825_H
 #define CONFIG_20200825_H
 
+#include "common/IncrementalGreenConfig.h"
 #include "common/MGConfig.h"
 #include "common/MeshConfig.h"
+#include "common/NewmarkConfig.h"
+#include "common/OutOfCoreConfig.h"
 #include "common/Type.h"
 #include "config.h"
+#include "form/DGCurvilinearCommon.h"
 #include "io/CSVWriter.h"
 #include "io/Probe.h"
 #include "io/TecplotWriter.h"
@@ -37,6 +41,18 @@ struct DomainOutputConfig : OutputConfig {
     bool jacobian;
 };
 
+struct FaultOutputConfig : OutputConfig {
+    bool sparse;
+    double slip_rate_threshold;
+    double state_threshold;
+    std::size_t keyframe_interval;
+};
+
+struct RuptureOutputConfig {
+    std::string prefix;
+    double slip_rate_threshold;
+};
+
 struct TabularOutputConfig : OutputConfig {
     TableWriterType type;
 
@@ -70,17 +86,30 @@ struct Config {
     std::array<double, DomainDimension> up;
     std::array<double, DomainDimension> ref_normal;
     bool boundary_linear;
+    std::optional<double> exterior_free_surface;
+    std::optional<double> exterior_conductivity;
 
     bool matrix_free;
+    GeometryMode geometry;
     MGStrategy mg_strategy;
     unsigned mg_coarse_level;
+    bool nested_iteration;
+    bool near_null_space;
+    std::optional<OutOfCoreConfig> green_out_of_core;
+    std::optional<IncrementalGreenConfig> green_incremental;
+    std::optional<NewmarkConfig> newmark;
+    bool rank_placement;
+    bool hardware_counters;
+    std::optional<std::string> initial_state;
+    std::optional<std::string> state_output;
 
     std::optional<GenMeshConfig<DomainDimension>> generate_mesh;
-    std::optional<OutputConfig> fault_output;
+    std::optional<FaultOutputConfig> fault_output;
     std::optional<TabularOutputConfig> fault_scalar_output;
     std::optional<DomainOutputConfig> domain_output;
     std::optional<ProbeOutputConfig> fault_probe_output;
     std::optional<ProbeOutputConfig> domain_probe_output;
+    std::optional<RuptureOutputConfig> rupture_output;
 };
 
 void setConfigSchema(TableSchema<Config>& schema,
@@ -31,6 +31,8 @@ public:
     constexpr static char Mu[] = "mu";
     constexpr static char Lam[] = "lam";
     constexpr static char Rho[] = "rho";
+    constexpr static char Damping[] = "damping";
+    constexpr static char Degree[] = "degree";
     constexpr static char Boundary[] = "boundary";
     constexpr static char Solution[] = "solution";
     constexpr static char InitialDisplacement[] = "initial_displacement";
@@ -51,6 +53,14 @@ public:
         if (lib_.hasMember(scenario, Rho)) {
             rho_ = std::make_optional(lib_.getMemberFunction<DomainDimension, 1>(scenario, Rho));
         }
+        if (lib_.hasMember(scenario, Damping)) {
+            damping_ =
+                std::make_optional(lib_.getMemberFunction<DomainDimension, 1>(scenario, Damping));
+        }
+        if (lib_.hasMember(scenario, Degree)) {
+            degree_ =
+                std::make_optional(lib_.getMemberFunction<DomainDimension, 1>(scenario, Degree));
+        }
 
         if (lib_.hasMember(scenario, Boundary)) {
             boundary_ = std::make_optional(
@@ -77,6 +87,8 @@ public:
     auto const& mu() const { return mu_; }
     auto const& lam() const { return lam_; }
     auto const& rho() const { return rho_; }
+    auto const& damping() const { return damping_; }
+    auto const& degree() const { return degree_; }
     auto const& boundary() const { return boundary_; }
     std::unique_ptr<SolutionInterface> solution(double time) const {
         if (solution_) {
@@ -99,6 +111,8 @@ protected:
         return {0.0};
     };
     std::optional<functional_t> rho_ = std::nullopt;
+    std::optional<functional_t> damping_ = std::nullopt;
+    std::optional<functional_t> degree_ = std::nullopt;
     std::optional<time_functional_t> boundary_ = std::nullopt;
     std::optional<SeasSolution<NumQuantities>> solution_ = std::nullopt;
     std::optional<vector_functional_t> u_ini_ = std::nullopt;
@@ -0,0 +1,133 @@
+#include "StateSnapshot.h"
+#include "mesh/Simplex.h"
+#include "tensor/Managed.h"
+#include "tensor/Tensor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace tndm::seas {
+
+namespace {
+constexpr char Magic[8] = {'T', 'N', 'D', 'M', 'S', 'T', 'A', 'T'};
+constexpr uint64_t Version = 1;
+} // namespace
+
+void StateSnapshot::write(std::string const& file_name) const {
+    auto out = std::ofstream(file_name, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Could not open " + file_name + " for writing");
+    }
+    uint8_t has_volume = displacement && velocity;
+    out.write(Magic, sizeof(Magic));
+    out.write(reinterpret_cast<char const*>(&Version), sizeof(Version));
+    out.write(reinterpret_cast<char const*>(&time), sizeof(time));
+    out.write(reinterpret_cast<char const*>(&has_volume), sizeof(has_volume));
+    fault.write(out);
+    if (has_volume) {
+        displacement->write(out);
+        velocity->write(out);
+    }
+    if (!out) {
+        throw std::runtime_error("Could not write " + file_name);
+    }
+}
+
+auto StateSnapshot::read(std::string const& file_name, MPI_Comm comm) -> StateSnapshot {
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    std::string buffer;
+    uint64_t size = 0;
+    if (rank == 0) {
+        auto in = std::ifstream(file_name, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Could not open " + file_name);
+        }
+        std::stringstream ss;
+        ss << in.rdbuf();
+        buffer = ss.str();
+        size = buffer.size();
+    }
+    MPI_Bcast(&size, 1, MPI_UINT64_T, 0, comm);
+    buffer.resize(size);
+    // MPI counts are int, hence snapshots larger than 2 GiB are sent in chunks
+    constexpr uint64_t MaxChunk = std::numeric_limits<int>::max();
+    for (uint64_t offset = 0; offset < size; offset += MaxChunk) {
+        int count = std::min(size - offset, MaxChunk);
+        MPI_Bcast(buffer.data() + offset, count, MPI_CHAR, 0, comm);
+    }
+
+    auto in = std::istringstream(buffer);
+    char magic[sizeof(Magic)];
+    uint64_t version;
+    uint8_t has_volume;
+    auto snapshot = StateSnapshot{};
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&snapshot.time), sizeof(snapshot.time));
+    in.read(reinterpret_cast<char*>(&has_volume), sizeof(has_volume));
+    if (!in || std::memcmp(magic, Magic, sizeof(Magic)) != 0 || version != Version) {
+        throw std::runtime_error(file_name + " is not a state snapshot");
+    }
+    snapshot.fault = fault_snapshot_t::read(in);
+    if (has_volume) {
+        snapshot.displacement = volume_snapshot_t::read(in);
+        snapshot.velocity = volume_snapshot_t::read(in);
+    }
+    return snapshot;
+}
+
+auto fault_vertices(Curvilinear<DomainDimension> const& cl, DGOperatorTopo const& topo,
+                    BoundaryMap const& fault_map)
+    -> std::vector<StateSnapshot::fault_snapshot_t::vertices_t> {
+    constexpr std::size_t D = DomainDimension;
+    auto ref_verts = Simplex<D - 1u>::referenceSimplexVertices();
+    auto chis = std::vector<std::array<double, D - 1u>>(ref_verts.begin(), ref_verts.end());
+    std::array<Managed<Matrix<double>>, D + 1u> E;
+    for (std::size_t f = 0; f < D + 1u; ++f) {
+        E[f] = cl.evaluateBasisAt(cl.facetParam(f, chis));
+    }
+
+    auto X = Managed<Matrix<double>>(cl.mapResultInfo(D));
+    auto vertices =
+        std::vector<StateSnapshot::fault_snapshot_t::vertices_t>(fault_map.local_size());
+    for (std::size_t faultNo = 0; faultNo < vertices.size(); ++faultNo) {
+        auto const& info = topo.info(fault_map.fctNo(faultNo));
+        cl.map(info.up[0], E[info.localNo[0]], X);
+        for (std::size_t j = 0; j < D; ++j) {
+            for (std::size_t d = 0; d < D; ++d) {
+                vertices[faultNo][j][d] = X(d, j);
+            }
+        }
+    }
+    return vertices;
+}
+
+auto element_vertices(Curvilinear<DomainDimension> const& cl, DGOperatorTopo const& topo)
+    -> std::vector<StateSnapshot::volume_snapshot_t::vertices_t> {
+    constexpr std::size_t D = DomainDimension;
+    auto ref_verts = Simplex<D>::referenceSimplexVertices();
+    auto E = cl.evaluateBasisAt(std::vector<std::array<double, D>>(ref_verts.begin(),
+                                                                    ref_verts.end()));
+
+    auto X = Managed<Matrix<double>>(cl.mapResultInfo(D + 1u));
+    auto vertices =
+        std::vector<StateSnapshot::volume_snapshot_t::vertices_t>(topo.numLocalElements());
+    for (std::size_t elNo = 0; elNo < vertices.size(); ++elNo) {
+        cl.map(elNo, E, X);
+        for (std::size_t j = 0; j < D + 1u; ++j) {
+            for (std::size_t d = 0; d < D; ++d) {
+                vertices[elNo][j][d] = X(d, j);
+            }
+        }
+    }
+    return vertices;
+}
+
+} // namespace tndm::seas
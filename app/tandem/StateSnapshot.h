@@ -0,0 +1,63 @@
+#ifndef STATESNAPSHOT_20261018_H
+#define STATESNAPSHOT_20261018_H
+
+#include "config.h"
+#include "form/BoundaryMap.h"
+#include "form/DGOperatorTopo.h"
+#include "form/FunctionSnapshot.h"
+#include "geometry/Curvilinear.h"
+
+#include <mpi.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tndm::seas {
+
+/**
+ * @brief Discretisation-independent state of a SEAS simulation at a given time.
+ *
+ * Written at the end of a (typically coarse) spin-up run and read by a run on another mesh,
+ * polynomial degree, or number of ranks, which then continues from the snapshot time.
+ * The fault snapshot contains the raw fault state (slip and state variable); the volume
+ * snapshots are only present for fully dynamic runs, where displacement and velocity are part of
+ * the state. In quasi-dynamic runs the displacement follows from slip and boundary data.
+ */
+struct StateSnapshot {
+    using fault_snapshot_t = FunctionSnapshot<DomainDimension, DomainDimension - 1u>;
+    using volume_snapshot_t = FunctionSnapshot<DomainDimension, DomainDimension>;
+
+    double time = 0.0;
+    fault_snapshot_t fault;
+    std::optional<volume_snapshot_t> displacement;
+    std::optional<volume_snapshot_t> velocity;
+
+    /**
+     * @brief Writes snapshot to file (call on the rank that holds the gathered snapshot)
+     */
+    void write(std::string const& file_name) const;
+    /**
+     * @brief Reads snapshot on rank 0 and distributes it to all ranks of comm
+     */
+    static auto read(std::string const& file_name, MPI_Comm comm) -> StateSnapshot;
+};
+
+/**
+ * @brief Physical vertex coordinates of the local fault facets
+ *
+ * Vertex order follows the facet parametrisation of the fault basis (see RateAndStateBase).
+ */
+auto fault_vertices(Curvilinear<DomainDimension> const& cl, DGOperatorTopo const& topo,
+                    BoundaryMap const& fault_map)
+    -> std::vector<StateSnapshot::fault_snapshot_t::vertices_t>;
+
+/**
+ * @brief Physical vertex coordinates of the local elements
+ */
+auto element_vertices(Curvilinear<DomainDimension> const& cl, DGOperatorTopo const& topo)
+    -> std::vector<StateSnapshot::volume_snapshot_t::vertices_t>;
+
+} // namespace tndm::seas
+
+#endif // STATESNAPSHOT_20261018_H
@@ -2,24 +2,30 @@
 #define SEASWRITER_20201006_H
 
 #include "tandem/AdaptiveOutputStrategy.h"
+#include "tandem/RuptureTracker.h"
 
+#include "basis/Equidistant.h"
 #include "form/BoundaryMap.h"
 #include "geometry/Curvilinear.h"
 #include "io/BoundaryProbeWriter.h"
 #include "io/PVDWriter.h"
 #include "io/ProbeWriter.h"
 #include "io/ScalarWriter.h"
+#include "io/SparseSnapshotWriter.h"
 #include "io/TableWriter.h"
 #include "io/VTUAdapter.h"
 #include "io/VTUWriter.h"
 #include "mesh/LocalSimplexMesh.h"
+#include "tensor/Managed.h"
 
 #include <mneme/span.hpp>
 #include <mpi.h>
 
 #include <cstddef>
+#include <iostream>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -27,7 +33,12 @@
 
 namespace tndm::seas {
 
-enum class DataLevel { Scalar, Boundary, Volume };
+/**
+ * Scalar, Boundary, and Volume writers receive samples at adaptive output intervals.
+ * Event writers receive the full fault state after every time step for which
+ * is_write_required returns true.
+ */
+enum class DataLevel { Scalar, Boundary, Volume, Event };
 
 class Writer {
 public:
@@ -38,7 +49,7 @@ public:
     virtual std::vector<std::size_t> const* subset() const { return nullptr; }
     virtual bool has_static_writer() const { return false; }
 
-    inline bool is_write_required(double time, double VMax) const {
+    virtual bool is_write_required(double time, double VMax) const {
         double delta_time = time - last_output_time_;
         return oi_(delta_time, last_output_VMax_, VMax);
     }
@@ -160,6 +171,165 @@ private:
     MPI_Comm comm_;
 };
 
+/**
+ * @brief Fault output which only contains facets whose slip-rate or state changed
+ * noticeably since they were written the last time, plus periodic keyframes.
+ *
+ * Each rank writes the file <prefix>_<rank>.sfo; tools/sparse_fault_reader.py reconstructs
+ * full snapshots.
+ */
+template <std::size_t D> class SparseFaultWriter : public Writer {
+public:
+    SparseFaultWriter(std::string_view prefix, AdaptiveOutputInterval oi,
+                      LocalSimplexMesh<D> const& mesh, std::shared_ptr<Curvilinear<D>> cl,
+                      unsigned degree, BoundaryMap const& bnd_map, double slip_rate_threshold,
+                      double state_threshold, std::size_t keyframe_interval, MPI_Comm comm)
+        : Writer(prefix, oi), adapter_(mesh, std::move(cl), bnd_map.localFctNos()),
+          refNodes_(EquidistantNodesFactory<D - 1u>(NumberingConvention::VTK)(degree)),
+          degree_(degree), slip_rate_threshold_(slip_rate_threshold),
+          state_threshold_(state_threshold), keyframe_interval_(keyframe_interval),
+          comm_(std::move(comm)) {
+        auto fctNos = bnd_map.localFctNos();
+        ids_.reserve(fctNos.size());
+        for (auto const& fctNo : fctNos) {
+            ids_.emplace_back(mesh.facets().l2cg(fctNo));
+        }
+    }
+
+    DataLevel level() const override { return DataLevel::Boundary; }
+    bool has_static_writer() const override { return true; }
+    void write(double time, mneme::span<FiniteElementFunction<D - 1u>> data) override {
+        auto numPoints = refNodes_.size();
+        auto numQuantities = std::size_t(0);
+        for (auto const& fun : data) {
+            numQuantities += fun.numQuantities();
+        }
+        auto values = Managed<Tensor<double, 3u>>(numPoints, numQuantities, ids_.size());
+        auto q0 = std::size_t(0);
+        for (auto const& fun : data) {
+            auto E = fun.evaluationMatrix(refNodes_);
+            auto result = Managed(fun.mapResultInfo(numPoints));
+            for (std::size_t no = 0; no < fun.numElements(); ++no) {
+                fun.map(no, E, result);
+                for (std::size_t p = 0; p < fun.numQuantities(); ++p) {
+                    for (std::size_t i = 0; i < numPoints; ++i) {
+                        values(i, q0 + p, no) = result(i, p);
+                    }
+                }
+            }
+            q0 += fun.numQuantities();
+        }
+        if (!writer_) {
+            open(data);
+        }
+        writer_->write(time, values);
+    }
+
+    void write_static(mneme::span<FiniteElementFunction<D - 1u>> data) override {
+        auto writer = VTUWriter<D - 1u>(degree_, true, comm_);
+        auto& piece = writer.addPiece(adapter_);
+        for (auto const& fun : data) {
+            piece.addPointData(fun);
+        }
+        writer.write(prefix_ + "-static");
+    }
+
+private:
+    void open(mneme::span<FiniteElementFunction<D - 1u>> data) {
+        int rank;
+        MPI_Comm_rank(comm_, &rank);
+
+        auto names = std::vector<std::string>{};
+        auto criteria = std::vector<SparseSnapshotWriter::Criterion>{};
+        for (auto const& fun : data) {
+            for (std::size_t p = 0; p < fun.numQuantities(); ++p) {
+                auto name = fun.name(p);
+                if (name == "state") {
+                    criteria.push_back({names.size(), state_threshold_});
+                } else if (name.rfind("slip-rate", 0) == 0) {
+                    criteria.push_back({names.size(), slip_rate_threshold_});
+                }
+                names.emplace_back(std::move(name));
+            }
+        }
+
+        auto numPoints = refNodes_.size();
+        adapter_.setRefNodes(refNodes_);
+        auto coords = std::vector<double>(ids_.size() * numPoints * D);
+        for (std::size_t no = 0; no < ids_.size(); ++no) {
+            auto result = Matrix<double>(&coords[no * numPoints * D], D, numPoints);
+            adapter_.map(no, result);
+        }
+
+        std::stringstream ss;
+        ss << prefix_ << "_" << rank << ".sfo";
+        writer_ = std::make_unique<SparseSnapshotWriter>(ss.str(), names, ids_, numPoints, D,
+                                                         coords, std::move(criteria),
+                                                         keyframe_interval_);
+    }
+
+    CurvilinearBoundaryVTUAdapter<D> adapter_;
+    std::vector<std::array<double, D - 1u>> refNodes_;
+    std::vector<uint64_t> ids_;
+    unsigned degree_;
+    double slip_rate_threshold_;
+    double state_threshold_;
+    std::size_t keyframe_interval_;
+    MPI_Comm comm_;
+    std::unique_ptr<SparseSnapshotWriter> writer_;
+};
+
+/**
+ * @brief Writes rupture-time, peak slip-rate, and slip once per event (see RuptureTracker).
+ *
+ * Output files are <prefix>_<event number>; the pvd file lists every event at its end time.
+ */
+template <std::size_t D> class RuptureWriter : public Writer {
+public:
+    RuptureWriter(std::string_view prefix, LocalSimplexMesh<D> const& mesh,
+                  std::shared_ptr<Curvilinear<D>> cl, unsigned degree, BoundaryMap const& bnd_map,
+                  double slip_rate_threshold, MPI_Comm comm)
+        : Writer(prefix, AdaptiveOutputInterval(0.0, 0.0, 0.0, 0.0)), pvd_(prefix),
+          adapter_(mesh, std::move(cl), bnd_map.localFctNos()), degree_(degree),
+          tracker_(slip_rate_threshold, comm), comm_(std::move(comm)) {}
+
+    DataLevel level() const override { return DataLevel::Event; }
+    bool is_write_required(double, double VMax) const override {
+        return tracker_.is_update_required(VMax);
+    }
+    void write(double time, mneme::span<FiniteElementFunction<D - 1u>> data) override {
+        if (!tracker_.update(time, data[0])) {
+            return;
+        }
+        int rank;
+        MPI_Comm_rank(comm_, &rank);
+
+        double start_time = tracker_.event_start_time();
+        auto writer = VTUWriter<D - 1u>(degree_, true, comm_);
+        writer.addFieldData("time", &time, 1);
+        writer.addFieldData("event_start_time", &start_time, 1);
+        auto& piece = writer.addPiece(adapter_);
+        piece.addPointData(tracker_.event());
+
+        std::stringstream ss;
+        ss << prefix_ << "_" << tracker_.num_events() - 1;
+        writer.write(ss.str());
+        if (rank == 0) {
+            pvd_.addTimestep(time, writer.pvtuFileName(ss.str()));
+            pvd_.write();
+            std::cout << "Event " << tracker_.num_events() - 1 << ": " << start_time << " s to "
+                      << time << " s" << std::endl;
+        }
+    }
+
+private:
+    PVDWriter pvd_;
+    CurvilinearBoundaryVTUAdapter<D> adapter_;
+    unsigned degree_;
+    RuptureTracker tracker_;
+    MPI_Comm comm_;
+};
+
 class FaultScalarWriter : public Writer {
 public:
     FaultScalarWriter(std::string_view prefix, std::unique_ptr<TableWriter> table_writer,
@@ -1,7 +1,9 @@
 #include "io/GMSHParser.h"
 #include "io/GlobalSimplexMeshBuilder.h"
 #include "mesh/LocalSimplexMesh.h"
+#include "parallel/MPITraits.h"
 #include "parallel/SimpleScatter.h"
+#include "util/LocalIndex.h"
 #include "util/Stopwatch.h"
 
 #include <argparse.hpp>
@@ -22,8 +24,8 @@ template <std::size_t D> void test_scatter(LocalSimplexMesh<D> const& mesh) {
     for (std::size_t elNo = 0; elNo < elements.localSize(); ++elNo) {
         test_data[elNo] = elements.l2cg(elNo);
     }
-    auto scatter =
-        SimpleScatter<std::size_t>(std::make_shared<ScatterPlan>(elements, MPI_COMM_WORLD));
+    auto plan = std::make_shared<ScatterPlan>(elements, MPI_COMM_WORLD);
+    auto scatter = SimpleScatter<std::size_t>(plan);
     scatter.scatter(test_data.data());
 
     const auto check_scatter = [](const auto& elements, std::vector<std::size_t> const& data) {
@@ -44,8 +46,14 @@ template <std::size_t D> void test_scatter(LocalSimplexMesh<D> const& mesh) {
             scatter.scatter(test_data.data());
         }
         auto time = sw.stop();
+        std::size_t index_bytes =
+            sizeof(local_index_t) * (plan->send_indices().size() + plan->recv_indices().size());
+        MPI_Allreduce(MPI_IN_PLACE, &index_bytes, 1, mpi_type_t<std::size_t>(), MPI_SUM,
+                      MPI_COMM_WORLD);
         if (rank == 0) {
             std::cout << "Time per scatter: " << time / nrepeat << std::endl;
+            std::cout << "Scatter index memory: " << index_bytes << " bytes ("
+                      << 8 * sizeof(local_index_t) << " bit local indices)" << std::endl;
         }
     }
 }
@@ -0,0 +1,151 @@
+#include "config.h"
+#include "localoperator/DieterichRuinaAgeing.h"
+#include "localoperator/DieterichRuinaSlip.h"
+#include "localoperator/RateAndState.h"
+
+#include "form/BC.h"
+#include "form/DGOperatorTopo.h"
+#include "geometry/Curvilinear.h"
+#include "mesh/GenMesh.h"
+#include "tensor/Tensor.h"
+#include "util/LinearAllocator.h"
+
+#include "doctest.h"
+
+#include <petscsys.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace tndm;
+
+namespace {
+
+constexpr std::size_t D = DomainDimension;
+using Multi = RateAndState<DieterichRuinaAgeing, DieterichRuinaSlip>;
+
+/**
+ * @brief Friction operator on the fault x_0 = 0 of the unit square / cube
+ */
+template <class Lop> class FaultSetup {
+public:
+    FaultSetup() {
+        auto BCs = std::array<std::pair<BC, BC>, D>{};
+        BCs.fill(std::make_pair(BC::Dirichlet, BC::Dirichlet));
+        BCs[0].first = BC::Fault;
+        auto N = std::array<uint64_t, D>{};
+        N.fill(2);
+        auto globalMesh = GenMesh<D>(N, BCs, PETSC_COMM_WORLD).uniformMesh();
+        globalMesh->repartition();
+        auto mesh = globalMesh->getLocalMesh(1);
+        auto cl = std::make_shared<Curvilinear<D>>(*mesh, [](auto const& v) { return v; },
+                                                   PolynomialDegree);
+        auto topo = DGOperatorTopo(*mesh, PETSC_COMM_WORLD);
+
+        auto faults = std::vector<std::size_t>{};
+        for (std::size_t fctNo = 0; fctNo < topo.numLocalFacets(); ++fctNo) {
+            if (topo.info(fctNo).bc == BC::Fault) {
+                faults.push_back(fctNo);
+            }
+        }
+        double scratch_mem[8];
+        auto scratch = LinearAllocator<double>(scratch_mem, scratch_mem + 8);
+        lop = std::make_unique<Lop>(cl);
+        lop->begin_preparation(faults.size());
+        for (std::size_t faultNo = 0; faultNo < faults.size(); ++faultNo) {
+            lop->prepare(faultNo, topo.info(faults[faultNo]), scratch);
+        }
+        lop->end_preparation();
+
+        lop->set_constant_params({1.0e-6, 0.015, 0.6});
+        lop->set_params([](std::array<double, D> const& x) {
+            auto p = typename Lop::default_law_t::Params{};
+            p.a = 0.010 + 0.01 * x[1];
+            p.eta = 0.0;
+            p.L = 0.008;
+            p.sn_pre = 50.0;
+            p.tau_pre.fill(20.0);
+            p.Vinit.fill(1.0e-9);
+            p.Sinit.fill(0.0);
+            return p;
+        });
+        num_faults = faults.size();
+    }
+
+    /**
+     * @brief Returns the right-hand side of every node of fault element faultNo
+     */
+    std::vector<double> rhs(std::size_t faultNo) const {
+        std::size_t nbf = lop->space().numBasisFunctions();
+        auto state = std::vector<double>(nbf * Lop::NumQuantities, 0.0);
+        auto traction = std::vector<double>(nbf * D, 0.0);
+        auto result = std::vector<double>(nbf * Lop::NumQuantities);
+        for (std::size_t node = 0; node < nbf; ++node) {
+            state[node + Lop::PsiIndex * nbf] = 0.6 + 0.01 * node;
+            traction[node + 1 * nbf] = 0.1 * node;
+        }
+        auto state_v = Vector<double const>(state.data(), state.size());
+        auto traction_v = Vector<double const>(traction.data(), traction.size());
+        auto result_v = Vector<double>(result.data(), result.size());
+        double scratch_mem[8];
+        auto scratch = LinearAllocator<double>(scratch_mem, scratch_mem + 8);
+        lop->rhs(0.0, faultNo, traction_v, state_v, result_v, scratch);
+        return result;
+    }
+
+    std::unique_ptr<Lop> lop;
+    std::size_t num_faults;
+};
+
+} // namespace
+
+TEST_CASE("Friction law batches") {
+    auto multi = FaultSetup<Multi>();
+    auto ageing = FaultSetup<RateAndState<DieterichRuinaAgeing>>();
+    auto slip = FaultSetup<RateAndState<DieterichRuinaSlip>>();
+    REQUIRE(multi.num_faults > 0);
+    std::size_t nbf = multi.lop->space().numBasisFunctions();
+
+    SUBCASE("Mixed laws in one element") {
+        // set_law visits the nodes element by element
+        auto law = std::vector<std::size_t>{};
+        multi.lop->set_law([&law](std::array<double, D> const& x) -> std::array<double, 1> {
+            law.push_back(x[1] < 0.25 ? 0 : 1);
+            return {static_cast<double>(law.back())};
+        });
+        REQUIRE(law.size() == multi.num_faults * nbf);
+
+        std::size_t num_mixed = 0;
+        for (std::size_t faultNo = 0; faultNo < multi.num_faults; ++faultNo) {
+            auto r_multi = multi.rhs(faultNo);
+            auto r_ageing = ageing.rhs(faultNo);
+            auto r_slip = slip.rhs(faultNo);
+            std::size_t num_ageing = 0;
+            for (std::size_t node = 0; node < nbf; ++node) {
+                bool is_ageing = law[faultNo * nbf + node] == 0;
+                num_ageing += is_ageing ? 1 : 0;
+                auto const& r_ref = is_ageing ? r_ageing : r_slip;
+                for (std::size_t q = 0; q < Multi::NumQuantities; ++q) {
+                    CHECK(r_multi[node + q * nbf] ==
+                          doctest::Approx(r_ref[node + q * nbf]).epsilon(1e-13));
+                }
+            }
+            num_mixed += num_ageing > 0 && num_ageing < nbf ? 1 : 0;
+        }
+        CHECK(num_mixed > 0);
+    }
+
+    SUBCASE("Invalid law") {
+        for (double invalid : {-1.0, static_cast<double>(Multi::NumLaws)}) {
+            auto lfun = [invalid](std::array<double, D> const&) -> std::array<double, 1> {
+                return {invalid};
+            };
+            CHECK_THROWS_AS(multi.lop->set_law(lfun), std::runtime_error);
+        }
+    }
+}
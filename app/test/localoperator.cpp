@@ -0,0 +1,205 @@
+#include "common/PetscDGMatrix.h"
+#include "common/PetscDGShell.h"
+#include "common/PetscUtil.h"
+#include "config.h"
+#include "localoperator/Elasticity.h"
+#include "localoperator/Poisson.h"
+
+#include "form/BC.h"
+#include "form/DGOperator.h"
+#include "form/DGOperatorTopo.h"
+#include "geometry/Curvilinear.h"
+#include "mesh/GenMesh.h"
+
+#include "doctest.h"
+
+#include <petscmat.h>
+#include <petscsys.h>
+#include <petscvec.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace tndm;
+
+namespace {
+
+constexpr std::size_t D = DomainDimension;
+
+auto make_mesh(std::array<std::pair<BC, BC>, D> const& BCs) {
+    auto N = std::array<uint64_t, D>{};
+    N.fill(2);
+    auto meshGen = GenMesh<D>(N, BCs, PETSC_COMM_WORLD);
+    auto globalMesh = meshGen.uniformMesh();
+    globalMesh->repartition();
+    return globalMesh->getLocalMesh(1);
+}
+
+/**
+ * @brief Returns |A_assembled x - A_matrix_free x|_inf / |A_assembled x|_inf for random x
+ *
+ * @param degree Element degrees (see DGOperator::set_element_degree); full degree if empty
+ */
+template <typename LocalOperator>
+double assembled_vs_matrix_free(std::shared_ptr<DGOperatorTopo> const& topo,
+                                std::shared_ptr<LocalOperator> lop,
+                                std::vector<unsigned> const& degree = {}) {
+    auto dgop = DGOperator<LocalOperator>(topo, std::move(lop));
+    if (!degree.empty()) {
+        dgop.set_element_degree(degree);
+    }
+    auto A = PetscDGMatrix(dgop.block_size(), *topo);
+    dgop.assemble(A);
+    auto shell = PetscDGShell(dgop);
+
+    Vec x, y_assembled, y_shell;
+    CHKERRTHROW(MatCreateVecs(shell.mat(), &x, &y_shell));
+    CHKERRTHROW(VecDuplicate(y_shell, &y_assembled));
+    PetscRandom rctx;
+    CHKERRTHROW(PetscRandomCreate(PETSC_COMM_WORLD, &rctx));
+    CHKERRTHROW(VecSetRandom(x, rctx));
+    CHKERRTHROW(PetscRandomDestroy(&rctx));
+
+    CHKERRTHROW(MatMult(A.mat(), x, y_assembled));
+    CHKERRTHROW(MatMult(shell.mat(), x, y_shell));
+    PetscReal norm, diff;
+    CHKERRTHROW(VecNorm(y_assembled, NORM_INFINITY, &norm));
+    CHKERRTHROW(VecAXPY(y_shell, -1.0, y_assembled));
+    CHKERRTHROW(VecNorm(y_shell, NORM_INFINITY, &diff));
+
+    CHKERRTHROW(VecDestroy(&x));
+    CHKERRTHROW(VecDestroy(&y_assembled));
+    CHKERRTHROW(VecDestroy(&y_shell));
+    return diff / norm;
+}
+
+/**
+ * @brief Returns |A_compact x - A_full x|_inf / |A_full x|_inf for random x, where the operators
+ * are compared assembled and matrix-free (maximum of both)
+ */
+double compact_vs_full(std::shared_ptr<DGOperatorTopo> const& topo,
+                       std::shared_ptr<Elasticity> compact, std::shared_ptr<Elasticity> full) {
+    full->set_compact_material(false);
+    auto dgop_compact = DGOperator<Elasticity>(topo, std::move(compact));
+    auto dgop_full = DGOperator<Elasticity>(topo, std::move(full));
+    auto A_compact = PetscDGMatrix(dgop_compact.block_size(), *topo);
+    auto A_full = PetscDGMatrix(dgop_full.block_size(), *topo);
+    dgop_compact.assemble(A_compact);
+    dgop_full.assemble(A_full);
+    auto shell_compact = PetscDGShell(dgop_compact);
+    auto shell_full = PetscDGShell(dgop_full);
+
+    Vec x, y_compact, y_full;
+    CHKERRTHROW(MatCreateVecs(A_full.mat(), &x, &y_full));
+    CHKERRTHROW(VecDuplicate(y_full, &y_compact));
+    PetscRandom rctx;
+    CHKERRTHROW(PetscRandomCreate(PETSC_COMM_WORLD, &rctx));
+    CHKERRTHROW(VecSetRandom(x, rctx));
+    CHKERRTHROW(PetscRandomDestroy(&rctx));
+
+    double result = 0.0;
+    for (auto [A, B] : {std::make_pair(A_compact.mat(), A_full.mat()),
+                        std::make_pair(shell_compact.mat(), shell_full.mat())}) {
+        CHKERRTHROW(MatMult(A, x, y_compact));
+        CHKERRTHROW(MatMult(B, x, y_full));
+        PetscReal norm, diff;
+        CHKERRTHROW(VecNorm(y_full, NORM_INFINITY, &norm));
+        CHKERRTHROW(VecAXPY(y_compact, -1.0, y_full));
+        CHKERRTHROW(VecNorm(y_compact, NORM_INFINITY, &diff));
+        result = std::max(result, diff / norm);
+    }
+
+    CHKERRTHROW(VecDestroy(&x));
+    CHKERRTHROW(VecDestroy(&y_compact));
+    CHKERRTHROW(VecDestroy(&y_full));
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Absorbing boundary in assembled and matrix-free operator") {
+    // Absorbing boundaries only enter through the damping term, hence they must act as natural
+    // boundaries in the static operator
+    auto BCs = std::array<std::pair<BC, BC>, D>{};
+    BCs.fill(std::make_pair(BC::Absorbing, BC::Absorbing));
+    BCs[0].first = BC::Dirichlet;
+    auto mesh = make_mesh(BCs);
+    auto cl = std::make_shared<Curvilinear<D>>(*mesh, [](auto const& v) { return v; },
+                                               PolynomialDegree);
+    auto topo = std::make_shared<DGOperatorTopo>(*mesh, PETSC_COMM_WORLD);
+    auto one = [](std::array<double, D> const&) -> std::array<double, 1> { return {1.0}; };
+
+    SUBCASE("Elasticity") {
+        for (auto method : {DGMethod::IP, DGMethod::BR2}) {
+            auto lop = std::make_shared<Elasticity>(cl, one, one, std::nullopt, method);
+            CHECK(assembled_vs_matrix_free(topo, std::move(lop)) < 1.0e-10);
+        }
+    }
+
+    SUBCASE("Poisson") {
+        for (auto method : {DGMethod::IP, DGMethod::BR2}) {
+            auto lop = std::make_shared<Poisson>(cl, one, method);
+            CHECK(assembled_vs_matrix_free(topo, std::move(lop)) < 1.0e-10);
+        }
+    }
+}
+
+TEST_CASE("Compact and full storage of Lame parameters") {
+    auto BCs = std::array<std::pair<BC, BC>, D>{};
+    BCs.fill(std::make_pair(BC::Dirichlet, BC::Natural));
+    auto mesh = make_mesh(BCs);
+    auto cl = std::make_shared<Curvilinear<D>>(*mesh, [](auto const& v) { return v; },
+                                               PolynomialDegree);
+    auto topo = std::make_shared<DGOperatorTopo>(*mesh, PETSC_COMM_WORLD);
+
+    using fun_t = Elasticity::functional_t<1>;
+    auto constant = fun_t([](std::array<double, D> const&) -> std::array<double, 1> {
+        return {32.04};
+    });
+    // The layers coincide with element boundaries, i.e. every element is constant
+    auto layered = fun_t([](std::array<double, D> const& x) -> std::array<double, 1> {
+        return {x[D - 1] < 0.5 ? 32.04 : 20.0};
+    });
+    auto linear = fun_t([](std::array<double, D> const& x) -> std::array<double, 1> {
+        return {20.0 + x[0]};
+    });
+
+    for (auto method : {DGMethod::IP, DGMethod::BR2}) {
+        for (auto const& lam : {constant, layered, linear}) {
+            auto make = [&] {
+                return std::make_shared<Elasticity>(cl, lam, constant, std::nullopt, method);
+            };
+            CHECK(compact_vs_full(topo, make(), make()) < 1.0e-12);
+        }
+    }
+}
+
+TEST_CASE("Element degrees in assembled and matrix-free operator") {
+    auto BCs = std::array<std::pair<BC, BC>, D>{};
+    BCs.fill(std::make_pair(BC::Dirichlet, BC::Natural));
+    auto mesh = make_mesh(BCs);
+    auto cl = std::make_shared<Curvilinear<D>>(*mesh, [](auto const& v) { return v; },
+                                               PolynomialDegree);
+    auto topo = std::make_shared<DGOperatorTopo>(*mesh, PETSC_COMM_WORLD);
+    auto one = [](std::array<double, D> const&) -> std::array<double, 1> { return {1.0}; };
+
+    // Neighbouring elements differ in degree; the last degree is not restricted
+    auto degree = std::vector<unsigned>(topo->numElements());
+    for (std::size_t elNo = 0; elNo < degree.size(); ++elNo) {
+        degree[elNo] = elNo % (PolynomialDegree + 1);
+    }
+
+    SUBCASE("Elasticity") {
+        auto lop = std::make_shared<Elasticity>(cl, one, one);
+        CHECK(assembled_vs_matrix_free(topo, std::move(lop), degree) < 1.0e-10);
+    }
+
+    SUBCASE("Poisson") {
+        auto lop = std::make_shared<Poisson>(cl, one, DGMethod::IP);
+        CHECK(assembled_vs_matrix_free(topo, std::move(lop), degree) < 1.0e-10);
+    }
+}
@@ -0,0 +1,11 @@
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+
+#include <petscsys.h>
+
+int main(int argc, char** argv) {
+    CHKERRQ(PetscInitialize(&argc, &argv, nullptr, nullptr));
+    int res = doctest::Context(argc, argv).run();
+    PetscFinalize();
+    return res;
+}
@@ -0,0 +1,146 @@
+#include "common/MGConfig.h"
+#include "common/NewmarkConfig.h"
+#include "common/NewmarkTimeSolver.h"
+#include "common/PetscVector.h"
+#include "interface/BlockVector.h"
+
+#include "doctest.h"
+
+#include <mpi.h>
+#include <petscsys.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+using namespace tndm;
+
+namespace {
+
+/**
+ * @brief Undamped harmonic oscillator u'' + omega^2 u = 0 with u(0) = 1, v(0) = 0.
+ *
+ * The fault state is constant such that the step size is only limited by max_time_step.
+ */
+class Oscillator {
+public:
+    Oscillator(double omega) : omega2_(omega * omega) {}
+
+    MPI_Comm comm() const { return PETSC_COMM_WORLD; }
+
+    void initial_condition(double, BlockVector& v, BlockVector& u, BlockVector& s) {
+        set(v, 0.0);
+        set(u, 1.0);
+        set(s, 0.0);
+    }
+    void acceleration(double, BlockVector const&, BlockVector const& u, BlockVector const&,
+                      BlockVector& a) {
+        set(a, -omega2_ * get(u));
+    }
+    void fault_rhs(double, BlockVector const&, BlockVector const&, BlockVector& ds) {
+        set(ds, 0.0);
+    }
+    void setup_implicit(double mass_shift, double, MGConfig const&, bool) {
+        mass_shift_ = mass_shift;
+        ++num_setups;
+    }
+    bool solve_implicit(BlockVector const& r, BlockVector& x) {
+        set(x, mass_shift_ * get(r) / (omega2_ + mass_shift_));
+        return !diverge;
+    }
+
+    double energy(BlockVector const& v, BlockVector const& u) const {
+        return 0.5 * get(v) * get(v) + 0.5 * omega2_ * get(u) * get(u);
+    }
+
+    static double get(BlockVector const& x) {
+        auto x_data = x.begin_access_readonly();
+        double value = x_data(0, 0);
+        x.end_access_readonly(x_data);
+        return value;
+    }
+    static void set(BlockVector& x, double value) {
+        auto x_data = x.begin_access();
+        x_data(0, 0) = value;
+        x.end_access(x_data);
+    }
+
+    bool diverge = false;
+    std::size_t num_setups = 0;
+
+private:
+    double omega2_;
+    double mass_shift_ = 0.0;
+};
+
+auto make_state() {
+    auto state = std::array<std::unique_ptr<PetscVector>, 3>{};
+    for (auto& x : state) {
+        x = std::make_unique<PetscVector>(1, 1, PETSC_COMM_WORLD);
+    }
+    return state;
+}
+
+auto make_solver(Oscillator& osc, double dt) {
+    auto cfg = NewmarkConfig{0.25, 0.5, 1e-8, 1e-8, dt};
+    return NewmarkTimeSolver(osc, make_state(), cfg, MGConfig{}, 0.0, dt);
+}
+
+} // namespace
+
+TEST_CASE("Newmark time solver") {
+    constexpr double pi = 3.14159265358979323846;
+    constexpr double omega = 2.0 * pi;
+    constexpr double end_time = 1.0;
+
+    SUBCASE("Energy conservation") {
+        auto osc = Oscillator(omega);
+        auto ts = make_solver(osc, 1.0 / 16.0);
+        double E0 = osc.energy(ts.state(0), ts.state(1));
+        ts.solve(end_time);
+        CHECK(ts.get_step_number() == 16);
+        CHECK(ts.get_step_rejections() == 0);
+        CHECK(osc.num_setups == 1);
+        CHECK(osc.energy(ts.state(0), ts.state(1)) == doctest::Approx(E0).epsilon(1e-12));
+    }
+
+    SUBCASE("Second order convergence") {
+        // After a full period the phase error only enters quadratically, hence a quarter period
+        constexpr double quarter_period = 0.25;
+        double err[2];
+        for (int k = 0; k < 2; ++k) {
+            auto osc = Oscillator(omega);
+            auto ts = make_solver(osc, 1.0 / (32.0 * (1 << k)));
+            ts.solve(quarter_period);
+            err[k] = std::abs(Oscillator::get(ts.state(1)) - std::cos(omega * quarter_period));
+        }
+        CHECK(std::log2(err[0] / err[1]) == doctest::Approx(2.0).epsilon(0.05));
+    }
+
+    SUBCASE("Shortened last steps") {
+        // Every segment ends with a shortened step, after which the step size must return to
+        // exactly dt, i.e. each segment requires one setup for dt and one for the last step
+        constexpr double dt = 0.1;
+        constexpr std::size_t num_segments = 100;
+        auto osc = Oscillator(omega);
+        auto ts = make_solver(osc, dt);
+        double time = 0.0;
+        for (std::size_t k = 0; k < num_segments; ++k) {
+            time += dt * (2.0 + std::fmod(0.618034 * (k + 1), 0.98) + 0.01);
+            ts.solve(time);
+        }
+        CHECK(osc.num_setups == 2 * num_segments);
+        CHECK(ts.get_step_rejections() == 0);
+    }
+
+    SUBCASE("Rejection cap") {
+        auto osc = Oscillator(omega);
+        auto ts = make_solver(osc, 1.0 / 16.0);
+        osc.diverge = true;
+        CHECK_THROWS_AS(ts.solve(end_time), std::runtime_error);
+        CHECK(ts.get_step_rejections() == decltype(ts)::MaxConsecutiveRejections);
+        CHECK(ts.get_step_number() == 0);
+    }
+}
@@ -1,6 +1,11 @@
 set(DOMAIN_DIMENSION 2 CACHE STRING "Dimension of the domain")
 set(POLYNOMIAL_DEGREE 2 CACHE STRING "Polynomial degree")
 set(MIN_QUADRATURE_ORDER 0 CACHE STRING "Minimum order of quadrature rule, 0 = automatic")
+option(LOCAL_INDEX_64 "Use 64 bit integers for rank-local indices" OFF)
+option(SUM_FACTORIZATION "Use sum-factorised volume kernels in collapsed coordinates" OFF)
+option(AUTOTUNE_KERNELS "Benchmark kernel variants on the build host and use the fastest" OFF)
+set(KERNEL_TUNING_CACHE_DIR ${CMAKE_BINARY_DIR}/kernel_tuning CACHE PATH
+    "Directory in which the kernel variant selection is stored")
 
 if(NOT ${POLYNOMIAL_DEGREE} GREATER 0)
     message(FATAL_ERROR "Polynomial degree must be integer and greater 0.")
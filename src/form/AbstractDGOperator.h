@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <functional>
 #include <optional>
+#include <vector>
 
 namespace tndm {
 
@@ -33,8 +34,48 @@ public:
     virtual void rhs(BlockVector& vector) = 0;
     virtual void apply(BlockVector const& x, BlockVector& y) = 0;
     virtual std::size_t flops_apply() const = 0;
+    /**
+     * @brief True if exterior boundaries couple all exterior facets via a dense boundary
+     * element operator. Then apply() is not symmetric and assemble() only yields a
+     * preconditioner.
+     */
+    virtual bool has_exterior_coupling() const { return false; }
     virtual void wave_rhs(BlockVector const& x, BlockVector& y) = 0;
+    /**
+     * @brief Same as wave_rhs, but calls wait before the first element with ghost neighbours.
+     *
+     * Ghost data that only elements at the process boundary depend on (e.g. the fault state of
+     * the slip condition) may thus be exchanged while the interior elements are computed.
+     */
+    virtual void wave_rhs(BlockVector const& x, BlockVector& y,
+                          std::function<void()> const& wait) = 0;
+    /**
+     * @brief Adds the damping of absorbing boundaries and sponge layers to y.
+     *
+     * @param v Velocity
+     * @param y Acceleration as computed by wave_rhs
+     */
+    virtual void wave_damping(BlockVector const& v, BlockVector& y) = 0;
+    /**
+     * @brief Computes y = M x, where M is the mass matrix of the wave equation, i.e.
+     * wave_rhs(x) = M^{-1} (b - A x) and wave_damping(v) adds -M^{-1} C v.
+     */
+    virtual void wave_mass(BlockVector const& x, BlockVector& y) = 0;
+    /**
+     * @brief Shifts the operator by mass and damping matrix of the wave equation.
+     *
+     * Afterwards, apply() computes (A + mass_shift M + damping_shift C) x and assemble()
+     * yields A + mass_shift M, which is used by implicit time integrators. The damping matrix
+     * is not assembled, hence the assembled matrix is only a preconditioner if
+     * damping_shift != 0.
+     */
+    virtual void set_wave_shift(double mass_shift, double damping_shift) = 0;
     virtual void project(volume_functional_t x, BlockVector& y) = 0;
+    /**
+     * @brief Functions spanning the near null space of the operator, e.g. the rigid body modes
+     * in elasticity. Use project() to obtain the coefficient vectors.
+     */
+    virtual auto near_null_space() -> std::vector<volume_functional_t> { return {}; }
     virtual double local_cfl_time_step() const = 0;
 
     virtual auto solution(BlockVector const& vector, std::vector<std::size_t> const& subset)
@@ -3,7 +3,14 @@
 
 namespace tndm {
 
-enum class BC : int { None = 0, Natural = 1, Fault = 3, Dirichlet = 5 };
+enum class BC : int {
+    None = 0,
+    Natural = 1,
+    Fault = 3,
+    Dirichlet = 5,
+    Absorbing = 7,
+    Exterior = 9
+};
 
 }
 
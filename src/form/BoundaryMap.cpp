@@ -53,8 +53,8 @@ BoundaryMap::BoundaryMap(LocalSimplexMesh<D> const& mesh, BC bc, MPI_Comm comm)
     bndNos_.resize(numLocalFacets, std::numeric_limits<std::size_t>::max());
     fctNos_.reserve(theFctNos.size());
     local_size_ = 0;
-    std::unordered_map<int, std::vector<std::size_t>> send_map;
-    std::unordered_map<int, std::vector<std::size_t>> recv_map;
+    ScatterPlan::index_map_t send_map;
+    ScatterPlan::index_map_t recv_map;
     for (auto const& [other_rank, fctNo] : theFctNos) {
         std::size_t bndNo = fctNos_.size();
         bndNos_[fctNo] = bndNo;
@@ -74,7 +74,7 @@ BoundaryMap::BoundaryMap(LocalSimplexMesh<D> const& mesh, BC bc, MPI_Comm comm)
         }
     }
 
-    scatter_plan_ = std::make_shared<ScatterPlan>(send_map, recv_map);
+    scatter_plan_ = std::make_shared<ScatterPlan>(send_map, recv_map, comm);
 }
 
 template BoundaryMap::BoundaryMap(LocalSimplexMesh<1> const&, BC, MPI_Comm);
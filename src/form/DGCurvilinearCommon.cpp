@@ -1,9 +1,11 @@
 #include "DGCurvilinearCommon.h"
 
+#include "form/SumFactorization.h"
 #include "geometry/Vector.h"
 #include "parallel/SimpleScatter.h"
 #include "quadrules/AutoRule.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -11,10 +13,14 @@ namespace tndm {
 
 template <std::size_t D>
 DGCurvilinearCommon<D>::DGCurvilinearCommon(std::shared_ptr<Curvilinear<D>> cl,
-                                            unsigned minQuadOrder)
-    : cl_(std::move(cl)) {
+                                            unsigned minQuadOrder, GeometryMode geometry)
+    : cl_(std::move(cl)), geometry_(geometry) {
     fctRule = simplexQuadratureRule<D - 1u>(minQuadOrder);
+#ifdef TANDEM_SUM_FACTORIZATION
+    volRule = SumFactorization<D>::rule(minQuadOrder);
+#else
     volRule = simplexQuadratureRule<D>(minQuadOrder);
+#endif
 
     geoE_Q = cl_->evaluateBasisAt(volRule.points());
     geoDxi_Q = cl_->evaluateGradientAt(volRule.points());
@@ -23,6 +29,16 @@ DGCurvilinearCommon<D>::DGCurvilinearCommon(std::shared_ptr<Curvilinear<D>> cl,
         geoE_q.emplace_back(cl_->evaluateBasisAt(facetParam));
         geoDxi_q.emplace_back(cl_->evaluateGradientAt(facetParam));
     }
+    if (geometry_ == GeometryMode::OnTheFly) {
+        for (auto& gradE : geoDxi_q) {
+            auto& at = geoDxi_q_at_.emplace_back();
+            auto const stride = gradE.shape(0) * gradE.shape(1);
+            for (std::size_t q = 0; q < fctRule.size(); ++q) {
+                at.emplace_back(gradE.data() + q * stride,
+                                TensorBase<Tensor<double, 3u>>(gradE.shape(0), gradE.shape(1), 1));
+            }
+        }
+    }
 }
 
 template <std::size_t D>
@@ -33,6 +49,14 @@ void DGCurvilinearCommon<D>::begin_preparation(std::size_t numElements,
                    fctRule.size());
     vol.setStorage(std::make_shared<vol_t>(numElements * volRule.size()), 0u, numElements,
                    volRule.size());
+    if (geometry_ == GeometryMode::Stored) {
+        fctGeo.setStorage(std::make_shared<fct_geo_t>(numLocalFacets * fctRule.size()), 0u,
+                          numLocalFacets, fctRule.size());
+        volGeo.setStorage(std::make_shared<vol_geo_t>(numElements * volRule.size()), 0u,
+                          numElements, volRule.size());
+    } else {
+        fctSides_.resize(numLocalFacets);
+    }
     area_.resize(numLocalFacets);
     volume_.resize(numElements);
 }
@@ -41,15 +65,17 @@ template <std::size_t D>
 void DGCurvilinearCommon<D>::prepare_volume(std::size_t elNo, LinearAllocator<double>& scratch) {
     double* Jmem = scratch.allocate(volRule.size() * D * D);
     auto J = Tensor(Jmem, cl_->jacobianResultInfo(volRule.size()));
-    auto jInv = Tensor(vol[elNo].template get<JInv>().data()->data(),
-                       cl_->jacobianResultInfo(volRule.size()));
     auto coords =
         Tensor(vol[elNo].template get<Coords>().data()->data(), cl_->mapResultInfo(volRule.size()));
     auto absDetJ =
         Tensor(vol[elNo].template get<AbsDetJ>().data(), cl_->detJResultInfo(volRule.size()));
     cl_->jacobian(elNo, geoDxi_Q, J);
     cl_->absDetJ(elNo, J, absDetJ);
-    cl_->jacobianInv(J, jInv);
+    if (geometry_ == GeometryMode::Stored) {
+        auto jInv = Tensor(volGeo[elNo].template get<JInv>().data()->data(),
+                           cl_->jacobianResultInfo(volRule.size()));
+        cl_->jacobianInv(J, jInv);
+    }
     cl_->map(elNo, geoE_Q, coords);
 
     double volume = 0.0;
@@ -62,29 +88,45 @@ void DGCurvilinearCommon<D>::prepare_volume(std::size_t elNo, LinearAllocator<do
 template <std::size_t D>
 void DGCurvilinearCommon<D>::prepare_bndskl(std::size_t fctNo, FacetInfo const& info,
                                             LinearAllocator<double>& scratch) {
-    double* Jmem = scratch.allocate(fctRule.size() * D * D);
-    double* detJmem = scratch.allocate(fctRule.size());
-    auto J = Tensor(Jmem, cl_->jacobianResultInfo(fctRule.size()));
-    auto detJ = Tensor(detJmem, cl_->detJResultInfo(fctRule.size()));
-
-    auto jInv0 = Tensor(fct[fctNo].template get<JInv0>().data()->data(),
-                        cl_->jacobianResultInfo(fctRule.size()));
-    auto normal = Tensor(fct[fctNo].template get<Normal>().data()->data(),
-                         cl_->normalResultInfo(fctRule.size()));
-    auto unit_normal = Tensor(fct[fctNo].template get<UnitNormal>().data()->data(),
-                              cl_->normalResultInfo(fctRule.size()));
-    auto coords = Tensor(fct[fctNo].template get<Coords>().data()->data(),
-                         cl_->mapResultInfo(fctRule.size()));
-    cl_->jacobian(info.up[0], geoDxi_q[info.localNo[0]], J);
-    cl_->detJ(info.up[0], J, detJ);
-    cl_->jacobianInv(J, jInv0);
-    cl_->normal(info.localNo[0], detJ, jInv0, normal);
+    std::array<double, D> const* normal;
+    if (geometry_ == GeometryMode::Stored) {
+        double* Jmem = scratch.allocate(fctRule.size() * D * D);
+        double* detJmem = scratch.allocate(fctRule.size());
+        auto J = Tensor(Jmem, cl_->jacobianResultInfo(fctRule.size()));
+        auto detJ = Tensor(detJmem, cl_->detJResultInfo(fctRule.size()));
+
+        auto jInv0 = Tensor(fctGeo[fctNo].template get<JInv0>().data()->data(),
+                            cl_->jacobianResultInfo(fctRule.size()));
+        auto n = Tensor(fctGeo[fctNo].template get<Normal>().data()->data(),
+                        cl_->normalResultInfo(fctRule.size()));
+        auto unit_normal = Tensor(fctGeo[fctNo].template get<UnitNormal>().data()->data(),
+                                  cl_->normalResultInfo(fctRule.size()));
+        cl_->jacobian(info.up[0], geoDxi_q[info.localNo[0]], J);
+        cl_->detJ(info.up[0], J, detJ);
+        cl_->jacobianInv(J, jInv0);
+        cl_->normal(info.localNo[0], detJ, jInv0, n);
+        cl_->normal(info.localNo[0], detJ, jInv0, unit_normal);
+        cl_->normalize(unit_normal);
+
+        auto jInv1 = Tensor(fctGeo[fctNo].template get<JInv1>().data()->data(),
+                            cl_->jacobianResultInfo(fctRule.size()));
+        cl_->jacobian(info.up[1], geoDxi_q[info.localNo[1]], J);
+        cl_->jacobianInv(J, jInv1);
+
+        normal = fctGeo[fctNo].template get<Normal>().data();
+    } else {
+        fctSides_[fctNo] = {info.up, info.localNo};
+        double* normalMem = scratch.allocate(fctRule.size() * D);
+        normal_q(fctNo, normalMem);
+        normal = reinterpret_cast<std::array<double, D> const*>(normalMem);
+    }
+
     auto& length = fct[fctNo].template get<NormalLength>();
     for (std::size_t i = 0; i < length.size(); ++i) {
-        length[i] = norm(fct[fctNo].template get<Normal>()[i]);
+        length[i] = norm(normal[i]);
     }
-    cl_->normal(info.localNo[0], detJ, jInv0, unit_normal);
-    cl_->normalize(unit_normal);
+    auto coords = Tensor(fct[fctNo].template get<Coords>().data()->data(),
+                         cl_->mapResultInfo(fctRule.size()));
     cl_->map(info.up[0], geoE_q[info.localNo[0]], coords);
 
     double area = 0.0;
@@ -92,12 +134,132 @@ void DGCurvilinearCommon<D>::prepare_bndskl(std::size_t fctNo, FacetInfo const&
         area += fctRule.weights()[i] * length[i];
     }
     area_[fctNo] = area;
+}
+
+template <std::size_t D>
+void DGCurvilinearCommon<D>::compute_normal(std::size_t fctNo, std::size_t q,
+                                            double* normal) const {
+    auto const& sides = fctSides_[fctNo];
+    double J_raw[D * D], jInv_raw[D * D], detJ_raw;
+    auto J = Tensor(J_raw, cl_->jacobianResultInfo(1));
+    auto jInv = Tensor(jInv_raw, cl_->jacobianResultInfo(1));
+    auto detJ = Tensor(&detJ_raw, cl_->detJResultInfo(1));
+    auto n = Tensor(normal, cl_->normalResultInfo(1));
+    cl_->jacobian(sides.up[0], geoDxi_q_at_[sides.localNo[0]][q], J);
+    cl_->detJ(sides.up[0], J, detJ);
+    cl_->jacobianInv(J, jInv);
+    cl_->normal(sides.localNo[0], detJ, jInv, n);
+}
+
+template <std::size_t D>
+void DGCurvilinearCommon<D>::invert_jacobian(double* J, std::size_t numPoints) const {
+    double J_raw[D * D];
+    auto J_at = Tensor(J_raw, cl_->jacobianResultInfo(1));
+    for (std::size_t q = 0; q < numPoints; ++q) {
+        std::copy(J + q * D * D, J + (q + 1) * D * D, J_raw);
+        auto jInv = Tensor(J + q * D * D, cl_->jacobianResultInfo(1));
+        cl_->jacobianInv(J_at, jInv);
+    }
+}
+
+template <std::size_t D>
+double const* DGCurvilinearCommon<D>::jInv_Q(std::size_t elNo, double* buffer) const {
+    if (geometry_ == GeometryMode::Stored) {
+        return volGeo[elNo].template get<JInv>().data()->data();
+    }
+    // The Jacobian is computed in buffer and inverted in place
+    auto J = Tensor(buffer, cl_->jacobianResultInfo(volRule.size()));
+    cl_->jacobian(elNo, geoDxi_Q, J);
+    invert_jacobian(buffer, volRule.size());
+    return buffer;
+}
+
+template <std::size_t D>
+double const* DGCurvilinearCommon<D>::jInv_q(std::size_t fctNo, int side, double* buffer) const {
+    if (geometry_ == GeometryMode::Stored) {
+        return side == 1 ? fctGeo[fctNo].template get<JInv1>().data()->data()
+                         : fctGeo[fctNo].template get<JInv0>().data()->data();
+    }
+    auto const& sides = fctSides_[fctNo];
+    auto J = Tensor(buffer, cl_->jacobianResultInfo(fctRule.size()));
+    cl_->jacobian(sides.up[side], geoDxi_q[sides.localNo[side]], J);
+    invert_jacobian(buffer, fctRule.size());
+    return buffer;
+}
+
+template <std::size_t D>
+double const* DGCurvilinearCommon<D>::normal_q(std::size_t fctNo, double* buffer) const {
+    if (geometry_ == GeometryMode::Stored) {
+        return fctGeo[fctNo].template get<Normal>().data()->data();
+    }
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        compute_normal(fctNo, q, buffer + q * D);
+    }
+    return buffer;
+}
+
+template <std::size_t D>
+auto DGCurvilinearCommon<D>::normal_at(std::size_t fctNo, std::size_t q) const
+    -> std::array<double, D> {
+    if (geometry_ == GeometryMode::Stored) {
+        return fctGeo[fctNo].template get<Normal>()[q];
+    }
+    auto normal = std::array<double, D>{};
+    compute_normal(fctNo, q, normal.data());
+    return normal;
+}
 
-    auto jInv1 = Tensor(fct[fctNo].template get<JInv1>().data()->data(),
-                        cl_->jacobianResultInfo(fctRule.size()));
+template <std::size_t D>
+double const* DGCurvilinearCommon<D>::unit_normal_q(std::size_t fctNo, double* buffer) const {
+    if (geometry_ == GeometryMode::Stored) {
+        return fctGeo[fctNo].template get<UnitNormal>().data()->data();
+    }
+    normal_q(fctNo, buffer);
+    return unit_normal_q(fctNo, buffer, buffer);
+}
 
-    cl_->jacobian(info.up[1], geoDxi_q[info.localNo[1]], J);
-    cl_->jacobianInv(J, jInv1);
+template <std::size_t D>
+double const* DGCurvilinearCommon<D>::unit_normal_q(std::size_t fctNo, double const* normal,
+                                                    double* buffer) const {
+    if (geometry_ == GeometryMode::Stored) {
+        return fctGeo[fctNo].template get<UnitNormal>().data()->data();
+    }
+    auto const& length = fct[fctNo].template get<NormalLength>();
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        for (std::size_t d = 0; d < D; ++d) {
+            buffer[d + q * D] = normal[d + q * D] / length[q];
+        }
+    }
+    return buffer;
+}
+
+template <std::size_t D> std::size_t DGCurvilinearCommon<D>::geometry_memory() const {
+    std::size_t bytes = vol.size() * volRule.size() *
+                        (sizeof(typename AbsDetJ::type) + sizeof(typename Coords::type));
+    bytes += volGeo.size() * volRule.size() * sizeof(typename JInv::type);
+    bytes += fct.size() * fctRule.size() *
+             (sizeof(typename NormalLength::type) + sizeof(typename Coords::type));
+    bytes += fctGeo.size() * fctRule.size() *
+             (sizeof(typename JInv0::type) + sizeof(typename JInv1::type) +
+              sizeof(typename Normal::type) + sizeof(typename UnitNormal::type));
+    bytes += fctSides_.size() * sizeof(FacetSides);
+    bytes += (area_.size() + volume_.size()) * sizeof(double);
+    return bytes;
+}
+
+template <std::size_t D>
+void DGCurvilinearCommon<D>::boundary_quadrature(std::size_t fctNo, std::array<double, D>* points,
+                                                 std::array<double, D>* normals,
+                                                 double* weights) const {
+    auto coords = fct[fctNo].template get<Coords>();
+    auto unit_normal = reinterpret_cast<std::array<double, D> const*>(
+        unit_normal_q(fctNo, reinterpret_cast<double*>(normals)));
+    auto length = fct[fctNo].template get<NormalLength>();
+    for (std::size_t q = 0; q < fctRule.size(); ++q) {
+        points[q] = coords[q];
+        normals[q] = unit_normal[q];
+        weights[q] = fctRule.weights()[q] * length[q];
+    }
 }
 
 template <std::size_t D>
@@ -9,6 +9,7 @@
 #include "tensor/Managed.h"
 #include "tensor/Tensor.h"
 #include "util/LinearAllocator.h"
+#include "util/LocalIndex.h"
 
 #include "mneme/storage.hpp"
 #include "mneme/view.hpp"
@@ -24,6 +25,15 @@ namespace tndm {
 
 enum class DGMethod { IP, BR2, Unknown };
 
+/**
+ * @brief Treatment of the metric terms (inverse Jacobian and normals) at quadrature points
+ *
+ * Stored: Precomputed once and read from memory in every operator application.
+ * OnTheFly: Recomputed from the element nodes of Curvilinear whenever needed, which trades
+ * flops for memory bandwidth and footprint.
+ */
+enum class GeometryMode { Stored, OnTheFly, Unknown };
+
 template <std::size_t D> class DGCurvilinearCommon {
 public:
     template <std::size_t Q>
@@ -34,10 +44,17 @@ public:
 
     constexpr static std::size_t NumFacets = D + 1;
 
-    DGCurvilinearCommon(std::shared_ptr<Curvilinear<D>> cl, unsigned minQuadOrder);
+    DGCurvilinearCommon(std::shared_ptr<Curvilinear<D>> cl, unsigned minQuadOrder,
+                        GeometryMode geometry = GeometryMode::Stored);
 
     Curvilinear<D> const& cl() const { return *cl_; }
     std::shared_ptr<Curvilinear<D>> cl_ptr() const { return cl_; }
+    GeometryMode geometry() const { return geometry_; }
+
+    /**
+     * @brief Memory in bytes occupied by precomputed geometry data on this rank
+     */
+    std::size_t geometry_memory() const;
 
     std::size_t scratch_mem_size() const {
         return std::max(volRule.size(), fctRule.size()) * (D * D + 1);
@@ -93,8 +110,7 @@ public:
             for (std::size_t q = 0; q < f.shape(1); ++q) {
                 auto fx = fun(coords[q]);
                 if (!is_boundary) {
-                    auto normal = this->fct[fctNo].template get<Normal>()[q];
-                    if (dot(refNormal, normal) < 0) {
+                    if (dot(refNormal, this->normal_at(fctNo, q)) < 0) {
                         fx = -1.0 * fx;
                     }
                 }
@@ -109,13 +125,47 @@ public:
     static void one_volume_function(std::size_t, Matrix<double>& x) { x.set_constant(1.0); }
     static void zero_facet_function(std::size_t, Matrix<double>& x, bool) { x.set_zero(); }
 
+    /**
+     * @brief Quadrature data of a boundary facet.
+     *
+     * @param fctNo Facet number
+     * @param points Physical coordinates of the quadrature points
+     * @param normals Unit normals pointing out of the element
+     * @param weights Quadrature weights times surface element
+     */
+    void boundary_quadrature(std::size_t fctNo, std::array<double, D>* points,
+                             std::array<double, D>* normals, double* weights) const;
+
     SimplexQuadratureRule<D - 1u> const& facetQuadratureRule() const { return fctRule; }
     SimplexQuadratureRule<D> const& volQuadratureRule() const { return volRule; }
 
 protected:
     void prepare_bndskl(std::size_t fctNo, FacetInfo const& info, LinearAllocator<double>& scratch);
 
+    /**
+     * @name Metric terms at quadrature points
+     *
+     * In stored mode a pointer to the precomputed data is returned. Otherwise, the data is
+     * computed in buffer, whose size must be at least D * D (inverse Jacobian) or D (normals)
+     * times the number of quadrature points, and buffer is returned.
+     */
+    ///@{
+    double const* jInv_Q(std::size_t elNo, double* buffer) const;
+    double const* jInv_q(std::size_t fctNo, int side, double* buffer) const;
+    double const* normal_q(std::size_t fctNo, double* buffer) const;
+    double const* unit_normal_q(std::size_t fctNo, double* buffer) const;
+    /**
+     * @brief Unit normal from the normal returned by normal_q (avoids recomputing the Jacobian)
+     */
+    double const* unit_normal_q(std::size_t fctNo, double const* normal, double* buffer) const;
+    /**
+     * @brief Normal at a single quadrature point (no buffer required)
+     */
+    std::array<double, D> normal_at(std::size_t fctNo, std::size_t q) const;
+    ///@}
+
     std::shared_ptr<Curvilinear<D>> cl_;
+    GeometryMode geometry_;
 
     // Rules
     SimplexQuadratureRule<D - 1u> fctRule;
@@ -153,14 +203,30 @@ protected:
         using type = std::array<double, D>;
     };
 
-    using fct_t = mneme::MultiStorage<mneme::DataLayout::SoA, JInv0, JInv1, Normal, UnitNormal,
-                                      NormalLength, Coords>;
-    using vol_t = mneme::MultiStorage<mneme::DataLayout::SoA, AbsDetJ, JInv, Coords>;
+    using fct_t = mneme::MultiStorage<mneme::DataLayout::SoA, NormalLength, Coords>;
+    using fct_geo_t = mneme::MultiStorage<mneme::DataLayout::SoA, JInv0, JInv1, Normal, UnitNormal>;
+    using vol_t = mneme::MultiStorage<mneme::DataLayout::SoA, AbsDetJ, Coords>;
+    using vol_geo_t = mneme::MultiStorage<mneme::DataLayout::SoA, JInv>;
 
     mneme::StridedView<fct_t> fct;
     mneme::StridedView<vol_t> vol;
+    // Metric terms (only allocated in stored mode)
+    mneme::StridedView<fct_geo_t> fctGeo;
+    mneme::StridedView<vol_geo_t> volGeo;
     std::vector<double> area_;
     std::vector<double> volume_;
+
+private:
+    void compute_normal(std::size_t fctNo, std::size_t q, double* normal) const;
+    void invert_jacobian(double* J, std::size_t numPoints) const;
+
+    struct FacetSides {
+        std::array<local_index_t, 2> up;
+        std::array<local_index_t, 2> localNo;
+    };
+    std::vector<FacetSides> fctSides_;
+    /// Views of geoDxi_q at single quadrature points (only in on-the-fly mode)
+    std::vector<std::vector<Tensor<double, 3u>>> geoDxi_q_at_;
 };
 
 } // namespace tndm
@@ -3,7 +3,9 @@
 
 #include "form/AbstractDGOperator.h"
 #include "form/AbstractInterpolationOperator.h"
+#include "form/BC.h"
 #include "form/DGOperatorTopo.h"
+#include "form/ExteriorCoupling.h"
 #include "form/FiniteElementFunction.h"
 #include "form/InterpolationOperator.h"
 #include "interface/BlockMatrix.h"
@@ -11,15 +13,23 @@
 #include "parallel/LocalGhostCompositeView.h"
 #include "parallel/Scatter.h"
 #include "parallel/SparseBlockVector.h"
+#include "tensor/EigenMap.h"
 #include "tensor/Managed.h"
 #include "tensor/Reshape.h"
 #include "tensor/Tensor.h"
+#include "util/Combinatorics.h"
 #include "util/Scratch.h"
 
+#include <Eigen/Core>
+
+#include <algorithm>
 #include <cassert>
 #include <experimental/type_traits>
+#include <functional>
 #include <memory>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace tndm {
 
@@ -48,8 +58,17 @@ public:
     template <class T> using apply_t = decltype(&T::apply);
     template <class T> using flops_apply_t = decltype(&T::flops_apply);
     template <class T> using wave_rhs_t = decltype(&T::wave_rhs);
+    template <class T> using wave_damping_t = decltype(&T::wave_damping);
+    template <class T> using wave_mass_t = decltype(&T::wave_mass);
+    template <class T> using assemble_wave_mass_t = decltype(&T::assemble_wave_mass);
     template <class T> using project_t = decltype(&T::project);
+    template <class T> using near_null_space_t = decltype(&T::near_null_space);
     template <class T> using cfl_time_step_t = decltype(&T::cfl_time_step);
+    template <class T> using exterior_trace_t = decltype(&T::exterior_trace);
+    template <class T> using error_indicator_volume_t = decltype(&T::error_indicator_volume);
+    template <class T> using error_indicator_skeleton_t = decltype(&T::error_indicator_skeleton);
+    template <class T> using error_indicator_boundary_t = decltype(&T::error_indicator_boundary);
+    template <class T> using degree_projector_t = decltype(&T::degree_projector);
 
     DGOperator(std::shared_ptr<DGOperatorTopo> const& topo, std::shared_ptr<LocalOperator> lop)
         : topo_(std::move(topo)), lop_(std::move(lop)),
@@ -102,6 +121,8 @@ public:
                 lop_->prepare_cfl(elNo, topo_->neighbours(elNo), scratch_);
             }
         }
+
+        setup_exterior();
     }
 
     std::size_t block_size() const override { return lop_->block_size(); }
@@ -135,7 +156,7 @@ public:
                 a_scratch.reset();
                 auto A00 = scratch_matrix(a_scratch);
                 if (lop_->assemble_volume(elNo, A00, scratch_)) {
-                    matrix.add_block(elNo, elNo, A00);
+                    add_block(matrix, elNo, elNo, A00);
                 }
             }
         }
@@ -154,19 +175,19 @@ public:
                     auto A11 = scratch_matrix(a_scratch);
                     if (lop_->assemble_skeleton(fctNo, info, A00, A01, A10, A11, scratch_)) {
                         if (info.inside[0]) {
-                            matrix.add_block(ib0, ib0, A00);
-                            matrix.add_block(ib0, ib1, A01);
+                            add_block(matrix, ib0, ib0, A00);
+                            add_block(matrix, ib0, ib1, A01);
                         }
                         if (info.inside[1]) {
-                            matrix.add_block(ib1, ib0, A10);
-                            matrix.add_block(ib1, ib1, A11);
+                            add_block(matrix, ib1, ib0, A10);
+                            add_block(matrix, ib1, ib1, A11);
                         }
                     }
                 } else {
                     if (info.inside[0]) {
                         auto A00 = scratch_matrix(a_scratch);
                         if (lop_->assemble_boundary(fctNo, info, A00, scratch_)) {
-                            matrix.add_block(ib0, ib0, A00);
+                            add_block(matrix, ib0, ib0, A00);
                         }
                     }
                 }
@@ -179,6 +200,43 @@ public:
                 a_scratch.reset();
                 auto A00 = scratch_matrix(a_scratch);
                 if (lop_->assemble_volume_post_skeleton(elNo, A00, scratch_)) {
+                    add_block(matrix, elNo, elNo, A00);
+                }
+            }
+        }
+        if (exterior_) {
+            a_scratch.reset();
+            auto A00 = scratch_matrix(a_scratch);
+            for (std::size_t k = 0; k < exterior_facets_.size(); ++k) {
+                assemble_exterior(k, A00);
+                matrix.add_block(topo_->info(exterior_facets_[k]).up[0],
+                                 topo_->info(exterior_facets_[k]).up[0], A00);
+            }
+        }
+        if constexpr (std::experimental::is_detected_v<assemble_wave_mass_t, LocalOperator>) {
+            if (mass_shift_ != 0.0) {
+                for (std::size_t elNo = 0; elNo < topo_->numLocalElements(); ++elNo) {
+                    scratch_.reset();
+                    a_scratch.reset();
+                    auto A00 = scratch_matrix(a_scratch);
+                    if (lop_->assemble_wave_mass(elNo, A00, scratch_)) {
+                        for (std::size_t j = 0; j < bs; ++j) {
+                            for (std::size_t i = 0; i < bs; ++i) {
+                                A00(i, j) *= mass_shift_;
+                            }
+                        }
+                        add_block(matrix, elNo, elNo, A00);
+                    }
+                }
+            }
+        }
+        if (!element_degree_.empty()) {
+            a_scratch.reset();
+            auto A00 = scratch_matrix(a_scratch);
+            for (std::size_t elNo = 0; elNo < topo_->numLocalElements(); ++elNo) {
+                if (auto P = projector(elNo)) {
+                    // Identity on the complement of the restricted space
+                    complement_block(*P, A00);
                     matrix.add_block(elNo, elNo, A00);
                 }
             }
@@ -233,6 +291,15 @@ public:
                 lop_->rhs_volume_post_skeleton(elNo, B0, scratch_);
             }
         }
+        if (!element_degree_.empty()) {
+            for (std::size_t elNo = 0; elNo < topo_->numLocalElements(); ++elNo) {
+                if (auto P = projector(elNo)) {
+                    auto B0 = access_handle.subtensor(slice{}, elNo);
+                    std::copy(B0.data(), B0.data() + bs, restrict_buf_.data());
+                    project_block(*P, restrict_buf_.data(), B0.data());
+                }
+            }
+        }
         vector.end_access(access_handle);
     }
 
@@ -240,13 +307,75 @@ public:
         if constexpr (std::experimental::is_detected_v<apply_t, LocalOperator>) {
             apply_(x, y, &LocalOperator::apply);
         }
+        if (exterior_) {
+            apply_exterior(x, y);
+        }
+        if (mass_shift_ != 0.0 || damping_shift_ != 0.0) {
+            apply_wave_shift(x, y);
+        }
     }
 
+    bool has_exterior_coupling() const override { return exterior_ != nullptr; }
+
     void wave_rhs(BlockVector const& x, BlockVector& y) override {
+        require_full_degree();
         if constexpr (std::experimental::is_detected_v<wave_rhs_t, LocalOperator>) {
             apply_(x, y, &LocalOperator::wave_rhs);
         }
     }
+    void wave_rhs(BlockVector const& x, BlockVector& y,
+                  std::function<void()> const& wait) override {
+        require_full_degree();
+        if constexpr (std::experimental::is_detected_v<wave_rhs_t, LocalOperator>) {
+            apply_(x, y, &LocalOperator::wave_rhs, wait);
+        } else {
+            wait();
+        }
+    }
+
+    void wave_damping(BlockVector const& v, BlockVector& y) override {
+        if constexpr (std::experimental::is_detected_v<wave_damping_t, LocalOperator>) {
+            auto v_handle = v.begin_access_readonly();
+            auto y_handle = y.begin_access();
+            for (std::size_t elNo = 0, num = topo_->numLocalElements(); elNo < num; ++elNo) {
+                auto v_0 = v_handle.subtensor(slice{}, elNo);
+                auto y_0 = y_handle.subtensor(slice{}, elNo);
+                lop_->wave_damping(elNo, topo_->neighbours(elNo), v_0, y_0);
+            }
+            y.end_access(y_handle);
+            v.end_access_readonly(v_handle);
+        }
+    }
+
+    void wave_mass(BlockVector const& x, BlockVector& y) override {
+        if constexpr (std::experimental::is_detected_v<wave_mass_t, LocalOperator>) {
+            lop_->setup_wave_mass(topo_->numLocalElements());
+            auto x_handle = x.begin_access_readonly();
+            auto y_handle = y.begin_access();
+            for (std::size_t elNo = 0, num = topo_->numLocalElements(); elNo < num; ++elNo) {
+                auto x_0 = x_handle.subtensor(slice{}, elNo);
+                auto y_0 = y_handle.subtensor(slice{}, elNo);
+                lop_->wave_mass(elNo, x_0, y_0);
+            }
+            y.end_access(y_handle);
+            x.end_access_readonly(x_handle);
+        } else {
+            throw std::runtime_error("The local operator does not provide a wave mass matrix.");
+        }
+    }
+
+    void set_wave_shift(double mass_shift, double damping_shift) override {
+        if constexpr (std::experimental::is_detected_v<wave_mass_t, LocalOperator>) {
+            lop_->setup_wave_mass(topo_->numLocalElements());
+        } else if (mass_shift != 0.0 || damping_shift != 0.0) {
+            throw std::runtime_error("The local operator does not provide a wave mass matrix.");
+        }
+        if (mass_shift != 0.0 || damping_shift != 0.0) {
+            require_full_degree();
+        }
+        mass_shift_ = mass_shift;
+        damping_shift_ = damping_shift;
+    }
 
     void project(typename base::volume_functional_t x, BlockVector& y) override {
         auto y_handle = y.begin_access();
@@ -254,11 +383,23 @@ public:
             for (std::size_t elNo = 0, num = topo_->numLocalElements(); elNo < num; ++elNo) {
                 auto y_block = y_handle.subtensor(slice{}, elNo);
                 lop_->project(elNo, x, y_block);
+                if (auto P = element_degree_.empty() ? nullptr : projector(elNo)) {
+                    std::copy(y_block.data(), y_block.data() + block_size(),
+                              restrict_buf_.data());
+                    project_block(*P, restrict_buf_.data(), y_block.data());
+                }
             }
         }
         y.end_access(y_handle);
     }
 
+    auto near_null_space() -> std::vector<typename base::volume_functional_t> override {
+        if constexpr (std::experimental::is_detected_v<near_null_space_t, LocalOperator>) {
+            return lop_->near_null_space();
+        }
+        return {};
+    }
+
     double local_cfl_time_step() const override {
         double dt = std::numeric_limits<double>::max();
         if constexpr (std::experimental::is_detected_v<cfl_time_step_t, LocalOperator>) {
@@ -279,6 +420,61 @@ public:
         return flops;
     }
 
+    constexpr static bool has_error_indicator() {
+        return std::experimental::is_detected_v<error_indicator_volume_t, LocalOperator> ||
+               std::experimental::is_detected_v<error_indicator_skeleton_t, LocalOperator> ||
+               std::experimental::is_detected_v<error_indicator_boundary_t, LocalOperator>;
+    }
+
+    /**
+     * @brief Squared a-posteriori error indicator of every local element.
+     *
+     * The local operator returns squared volume, skeleton, and boundary residuals.
+     * The contribution of an interior facet is split equally between both adjacent elements.
+     *
+     * @param x Discrete solution
+     *
+     * @return eta^2 per local element (all zero if the local operator has no indicator)
+     */
+    std::vector<double> error_indicator(BlockVector const& x) {
+        auto eta2 = std::vector<double>(topo_->numLocalElements(), 0.0);
+        auto block_view = LocalGhostCompositeView(x, ghost_);
+
+        scatter_.begin_scatter(x, ghost_);
+        if constexpr (std::experimental::is_detected_v<error_indicator_volume_t, LocalOperator>) {
+            for (std::size_t elNo = 0; elNo < topo_->numLocalElements(); ++elNo) {
+                scratch_.reset();
+                eta2[elNo] += lop_->error_indicator_volume(elNo, block_view.get_block(elNo),
+                                                           scratch_);
+            }
+        }
+        scatter_.wait_scatter();
+
+        if constexpr (std::experimental::is_detected_v<error_indicator_skeleton_t,
+                                                       LocalOperator> ||
+                      std::experimental::is_detected_v<error_indicator_boundary_t,
+                                                       LocalOperator>) {
+            for (std::size_t fctNo = 0; fctNo < topo_->numLocalFacets(); ++fctNo) {
+                scratch_.reset();
+                auto const& info = topo_->info(fctNo);
+                if (info.up[0] != info.up[1]) {
+                    double eta2_f = lop_->error_indicator_skeleton(
+                        fctNo, info, block_view.get_block(info.up[0]),
+                        block_view.get_block(info.up[1]), scratch_);
+                    for (int side = 0; side < 2; ++side) {
+                        if (info.inside[side]) {
+                            eta2[info.up[side]] += 0.5 * eta2_f;
+                        }
+                    }
+                } else if (info.inside[0]) {
+                    eta2[info.up[0]] += lop_->error_indicator_boundary(
+                        fctNo, info, block_view.get_block(info.up[0]), scratch_);
+                }
+            }
+        }
+        return eta2;
+    }
+
     template <typename Iterator>
     auto solution(BlockVector const& vector, Iterator first, Iterator last) const {
         auto num_elements = std::distance(first, last);
@@ -345,6 +541,40 @@ public:
         return params(range->begin(), range->end());
     }
 
+    /**
+     * @brief Restricts the discrete solution of every element to polynomials of lower degree.
+     *
+     * The block size is unchanged. With the orthogonal projector P onto the coefficients of the
+     * restricted space, assemble() and apply() yield P A P + (I - P) and rhs() yields P b,
+     * hence the solution is the Galerkin solution in the restricted space.
+     * Only the elliptic operator is restricted; wave_rhs() and implicit wave solves throw.
+     *
+     * @param degree Polynomial degree of every element of topo(), i.e. including ghosts; degrees
+     * at or above the degree of the local operator are not restricted
+     */
+    void set_element_degree(std::vector<unsigned> degree) {
+        if constexpr (std::experimental::is_detected_v<degree_projector_t, LocalOperator>) {
+            if (degree.size() != topo_->numElements()) {
+                throw std::runtime_error("Element degree required for every local and ghost "
+                                         "element.");
+            }
+            if (exterior_) {
+                throw std::runtime_error(
+                    "Element degrees are not supported with exterior boundaries.");
+            }
+            auto bs = lop_->block_size();
+            auto nbf = bs / LocalOperator::NumQuantities;
+            projectors_.clear();
+            for (unsigned p = 0; binom(p + LocalOperator::Dim, LocalOperator::Dim) < nbf; ++p) {
+                projectors_.emplace_back(lop_->degree_projector(p));
+            }
+            restrict_buf_.resize((NumFacets + 2) * bs);
+            element_degree_ = std::move(degree);
+        } else {
+            throw std::runtime_error("The local operator does not support element degrees.");
+        }
+    }
+
     void set_force(typename base::volume_functional_t fun) override {
         lop_->set_force(std::move(fun));
     }
@@ -360,7 +590,8 @@ private:
         std::size_t, mneme::span<SideInfo>, Vector<double const> const&,
         std::array<Vector<double const>, NumFacets> const&, Vector<double>&) const;
 
-    void apply_(BlockVector const& x, BlockVector& y, apply_fun_ptr apply_fun) {
+    void apply_(BlockVector const& x, BlockVector& y, apply_fun_ptr apply_fun,
+                std::function<void()> const& wait = {}) {
         auto y_handle = y.begin_access();
 
         auto copy_first = topo_->numInteriorElements();
@@ -376,7 +607,34 @@ private:
             for (std::size_t d = 0; d < NumFacets; ++d) {
                 x_n[d] = block_view.get_block(info[d].lid);
             }
+            if (element_degree_.empty()) {
+                ((lop_.get())->*apply_fun)(elNo, info, x_0, x_n, y_0);
+                return;
+            }
+            // y_0 = P A P x + (I - P) x_0
+            auto restrict_input = [&](std::size_t no, decltype(x_0)& x, std::size_t slot) {
+                if (auto P = projector(no)) {
+                    double* buf = restrict_buf_.data() + slot * x.size();
+                    project_block(*P, x.data(), buf);
+                    x = decltype(x_0)(buf, x.size());
+                }
+            };
+            auto x_0_full = x_0;
+            restrict_input(elNo, x_0, 0);
+            for (std::size_t d = 0; d < NumFacets; ++d) {
+                restrict_input(info[d].lid, x_n[d], d + 1);
+            }
             ((lop_.get())->*apply_fun)(elNo, info, x_0, x_n, y_0);
+            if (auto P = projector(elNo)) {
+                double* r = restrict_buf_.data() + (NumFacets + 1) * y_0.size();
+                for (std::size_t i = 0; i < y_0.size(); ++i) {
+                    r[i] = y_0(i) - x_0_full(i);
+                }
+                project_block(*P, r, y_0.data());
+                for (std::size_t i = 0; i < y_0.size(); ++i) {
+                    y_0(i) += x_0_full(i);
+                }
+            }
         };
 
         scatter_.begin_scatter(x, ghost_);
@@ -387,6 +645,9 @@ private:
         }
 
         scatter_.wait_scatter();
+        if (wait) {
+            wait();
+        }
 
         for (std::size_t elNo = copy_first; elNo < ghost_first; ++elNo) {
             lop_apply(elNo);
@@ -395,11 +656,215 @@ private:
         y.end_access(y_handle);
     }
 
+    /**
+     * @brief Projector of element elNo or nullptr if the element is not restricted
+     */
+    Matrix<double> const* projector(std::size_t elNo) const {
+        auto degree = element_degree_[elNo];
+        return degree < projectors_.size() ? &projectors_[degree] : nullptr;
+    }
+
+    /**
+     * @brief Computes y = P x for every quantity of the block x
+     */
+    void project_block(Matrix<double> const& P, double const* x, double* y) const {
+        auto nbf = P.shape(0);
+        auto nq = lop_->block_size() / nbf;
+        auto X = Eigen::Map<Eigen::MatrixXd const>(x, nbf, nq);
+        auto Y = Eigen::Map<Eigen::MatrixXd>(y, nbf, nq);
+        Y.noalias() = EigenMap(P) * X;
+    }
+
+    /**
+     * @brief Adds P_i A P_j to the block (i, j) of the matrix
+     */
+    void add_block(BlockMatrix& matrix, std::size_t i, std::size_t j, Matrix<double>& A) {
+        auto P_i = element_degree_.empty() ? nullptr : projector(i);
+        auto P_j = element_degree_.empty() ? nullptr : projector(j);
+        if (P_i || P_j) {
+            auto nbf = P_i ? P_i->shape(0) : P_j->shape(0);
+            auto nq = lop_->block_size() / nbf;
+            auto A_map = EigenMap(A);
+            for (std::size_t qj = 0; qj < nq; ++qj) {
+                for (std::size_t qi = 0; qi < nq; ++qi) {
+                    auto A_ij = A_map.block(qi * nbf, qj * nbf, nbf, nbf);
+                    if (P_i) {
+                        A_ij = EigenMap(*P_i) * A_ij;
+                    }
+                    if (P_j) {
+                        A_ij = A_ij * EigenMap(*P_j);
+                    }
+                }
+            }
+        }
+        matrix.add_block(i, j, A);
+    }
+
+    /**
+     * @brief Sets A to the identity minus P for every quantity
+     */
+    void complement_block(Matrix<double> const& P, Matrix<double>& A) const {
+        auto nbf = P.shape(0);
+        auto nq = lop_->block_size() / nbf;
+        A.set_zero();
+        auto A_map = EigenMap(A);
+        for (std::size_t q = 0; q < nq; ++q) {
+            A_map.block(q * nbf, q * nbf, nbf, nbf) = -EigenMap(P);
+        }
+        A_map.diagonal().array() += 1.0;
+    }
+
+    void require_full_degree() const {
+        if (!element_degree_.empty()) {
+            throw std::runtime_error(
+                "Element degrees are only supported by the static and quasi-dynamic solvers.");
+        }
+    }
+
+    /**
+     * @brief Adds M (mass_shift x - damping_shift M^{-1} C x) to y, where M^{-1} C x is
+     * obtained from wave_damping.
+     */
+    void apply_wave_shift(BlockVector const& x, BlockVector& y) {
+        if constexpr (std::experimental::is_detected_v<wave_mass_t, LocalOperator>) {
+            auto bs = lop_->block_size();
+            auto z_size = LinearAllocator<double>::allocation_size(bs, lop_->alignment());
+            auto z_scratch = Scratch<double>(2 * z_size, lop_->alignment());
+
+            auto x_handle = x.begin_access_readonly();
+            auto y_handle = y.begin_access();
+            for (std::size_t elNo = 0, num = topo_->numLocalElements(); elNo < num; ++elNo) {
+                z_scratch.reset();
+                double* z_raw = z_scratch.allocate(bs);
+                auto z = Vector<double>(z_raw, bs);
+                auto Mz = Vector<double>(z_scratch.allocate(bs), bs);
+                auto x_0 = x_handle.subtensor(slice{}, elNo);
+                z.set_zero();
+                if constexpr (std::experimental::is_detected_v<wave_damping_t, LocalOperator>) {
+                    if (damping_shift_ != 0.0) {
+                        lop_->wave_damping(elNo, topo_->neighbours(elNo), x_0, z);
+                    }
+                }
+                for (std::size_t i = 0; i < bs; ++i) {
+                    z(i) = mass_shift_ * x_0(i) - damping_shift_ * z(i);
+                }
+                lop_->wave_mass(elNo, Vector<double const>(z_raw, bs), Mz);
+                auto y_0 = y_handle.subtensor(slice{}, elNo);
+                for (std::size_t i = 0; i < bs; ++i) {
+                    y_0(i) += Mz(i);
+                }
+            }
+            y.end_access(y_handle);
+            x.end_access_readonly(x_handle);
+        }
+    }
+
+    void setup_exterior() {
+        for (std::size_t fctNo = 0; fctNo < topo_->numLocalFacets(); ++fctNo) {
+            auto const& info = topo_->info(fctNo);
+            if (info.bc == BC::Exterior && info.up[0] == info.up[1] && info.inside[0]) {
+                exterior_facets_.emplace_back(fctNo);
+            }
+        }
+        int has_exterior = !exterior_facets_.empty();
+        MPI_Allreduce(MPI_IN_PLACE, &has_exterior, 1, MPI_INT, MPI_MAX, topo_->comm());
+        if (!has_exterior) {
+            return;
+        }
+
+        if constexpr (std::experimental::is_detected_v<exterior_trace_t, LocalOperator>) {
+            std::size_t nq = lop_->facetQuadratureRule().size();
+            std::size_t num_points = nq * exterior_facets_.size();
+            std::vector<std::array<double, LocalOperator::Dim>> points(num_points);
+            std::vector<std::array<double, LocalOperator::Dim>> normals(num_points);
+            std::vector<double> weights(num_points);
+            for (std::size_t k = 0; k < exterior_facets_.size(); ++k) {
+                lop_->boundary_quadrature(exterior_facets_[k], &points[k * nq],
+                                          &normals[k * nq], &weights[k * nq]);
+            }
+            exterior_ = std::make_unique<ExteriorCoupling<LocalOperator::Dim>>(
+                points, normals, weights, lop_->exterior_free_surface(), topo_->comm());
+            exterior_u_.resize(num_points);
+            exterior_t_.resize(num_points);
+        } else {
+            throw std::runtime_error(
+                "Exterior boundary conditions are not supported by the local operator.");
+        }
+    }
+
+    void apply_exterior(BlockVector const& x, BlockVector& y) {
+        if constexpr (std::experimental::is_detected_v<exterior_trace_t, LocalOperator>) {
+            std::size_t nq = lop_->facetQuadratureRule().size();
+            auto x_handle = x.begin_access_readonly();
+            for (std::size_t k = 0; k < exterior_facets_.size(); ++k) {
+                auto const& info = topo_->info(exterior_facets_[k]);
+                auto x_0 = x_handle.subtensor(slice{}, info.up[0]);
+                lop_->exterior_trace(exterior_facets_[k], info, x_0, &exterior_u_[k * nq]);
+            }
+            x.end_access_readonly(x_handle);
+
+            exterior_->apply(exterior_u_.data(), exterior_t_.data());
+
+            auto y_handle = y.begin_access();
+            for (std::size_t k = 0; k < exterior_facets_.size(); ++k) {
+                auto const& info = topo_->info(exterior_facets_[k]);
+                auto y_0 = y_handle.subtensor(slice{}, info.up[0]);
+                lop_->exterior_flux(exterior_facets_[k], info, &exterior_t_[k * nq], y_0);
+            }
+            y.end_access(y_handle);
+        }
+    }
+
+    /**
+     * @brief Element block of the exterior coupling of the k-th exterior facet.
+     *
+     * Only the coupling within the facet is kept, such that the assembled matrix stays
+     * block-sparse; it is therefore suitable as preconditioner only.
+     */
+    void assemble_exterior(std::size_t k, Matrix<double>& A00) {
+        if constexpr (std::experimental::is_detected_v<exterior_trace_t, LocalOperator>) {
+            std::size_t nq = lop_->facetQuadratureRule().size();
+            auto bs = lop_->block_size();
+            auto fctNo = exterior_facets_[k];
+            auto const& info = topo_->info(fctNo);
+            std::vector<double> e(bs, 0.0);
+            std::vector<double> u_q(nq);
+            std::vector<double> t_q(nq);
+            A00.set_zero();
+            for (std::size_t j = 0; j < bs; ++j) {
+                e[j] = 1.0;
+                lop_->exterior_trace(fctNo, info, Vector<double const>(e.data(), bs), u_q.data());
+                e[j] = 0.0;
+                for (std::size_t p = 0; p < nq; ++p) {
+                    t_q[p] = 0.0;
+                    for (std::size_t q = 0; q < nq; ++q) {
+                        t_q[p] += exterior_->local_entry(k * nq + p, k * nq + q) * u_q[q];
+                    }
+                }
+                auto A_j = A00.subtensor(slice{}, j);
+                lop_->exterior_flux(fctNo, info, t_q.data(), A_j);
+            }
+        }
+    }
+
     std::shared_ptr<DGOperatorTopo> topo_;
     std::shared_ptr<LocalOperator> lop_;
     Scratch<double> scratch_;
     Scatter scatter_;
     SparseBlockVector<double> ghost_;
+
+    std::vector<std::size_t> exterior_facets_;
+    std::unique_ptr<ExteriorCoupling<LocalOperator::Dim>> exterior_ = nullptr;
+    std::vector<double> exterior_u_;
+    std::vector<double> exterior_t_;
+
+    double mass_shift_ = 0.0;
+    double damping_shift_ = 0.0;
+
+    std::vector<unsigned> element_degree_;
+    // Projector of every restricted degree
+    std::vector<Managed<Matrix<double>>> projectors_;
+    std::vector<double> restrict_buf_;
 };
 
 } // namespace tndm
@@ -0,0 +1,56 @@
+#include "ExteriorCoupling.h"
+
+#include <numeric>
+
+namespace tndm {
+
+template <std::size_t D>
+ExteriorCoupling<D>::ExteriorCoupling(std::vector<point_t> const& points,
+                                      std::vector<point_t> const& normals,
+                                      std::vector<double> const& weights,
+                                      std::optional<FreeSurfacePlane<D>> const& free_surface,
+                                      MPI_Comm comm)
+    : comm_(comm) {
+    int rank, procs;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &procs);
+
+    int num_local = points.size();
+    counts_.resize(procs);
+    displs_.resize(procs);
+    MPI_Allgather(&num_local, 1, MPI_INT, counts_.data(), 1, MPI_INT, comm_);
+    std::exclusive_scan(counts_.begin(), counts_.end(), displs_.begin(), 0);
+    offset_ = displs_[rank];
+    std::size_t num_total = displs_.back() + counts_.back();
+
+    auto counts_D = counts_;
+    auto displs_D = displs_;
+    for (int p = 0; p < procs; ++p) {
+        counts_D[p] *= D;
+        displs_D[p] *= D;
+    }
+    std::vector<point_t> all_points(num_total);
+    std::vector<point_t> all_normals(num_total);
+    std::vector<double> all_weights(num_total);
+    MPI_Allgatherv(points.data(), num_local * D, MPI_DOUBLE, all_points.data(), counts_D.data(),
+                   displs_D.data(), MPI_DOUBLE, comm_);
+    MPI_Allgatherv(normals.data(), num_local * D, MPI_DOUBLE, all_normals.data(),
+                   counts_D.data(), displs_D.data(), MPI_DOUBLE, comm_);
+    MPI_Allgatherv(weights.data(), num_local, MPI_DOUBLE, all_weights.data(), counts_.data(),
+                   displs_.data(), MPI_DOUBLE, comm_);
+
+    auto dtn = LaplaceExteriorDtN<D>(all_points, all_normals, all_weights, free_surface);
+    rows_ = dtn.matrix().middleRows(offset_, num_local);
+    u_all_.resize(num_total);
+}
+
+template <std::size_t D> void ExteriorCoupling<D>::apply(double const* u, double* t) {
+    MPI_Allgatherv(u, num_local_points(), MPI_DOUBLE, u_all_.data(), counts_.data(),
+                   displs_.data(), MPI_DOUBLE, comm_);
+    Eigen::Map<Eigen::VectorXd>(t, num_local_points()).noalias() = rows_ * u_all_;
+}
+
+template class ExteriorCoupling<2u>;
+template class ExteriorCoupling<3u>;
+
+} // namespace tndm
@@ -0,0 +1,65 @@
+#ifndef EXTERIORCOUPLING_20261018_H
+#define EXTERIORCOUPLING_20261018_H
+
+#include "form/ExteriorDtN.h"
+
+#include <Eigen/Core>
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Distributed Dirichlet-to-Neumann map of the homogeneous exterior domain.
+ *
+ * Every rank contributes the quadrature points of its exterior boundary facets. The dense
+ * boundary element matrix is set up once for all points and every rank keeps the rows of
+ * its own points.
+ */
+template <std::size_t D> class ExteriorCoupling {
+public:
+    using point_t = std::array<double, D>;
+
+    /**
+     * @param points Local quadrature points on the exterior boundary
+     * @param normals Unit normals pointing into the exterior
+     * @param weights Quadrature weights times surface element
+     * @param free_surface Optional free surface bounding the exterior
+     * @param comm Communicator
+     */
+    ExteriorCoupling(std::vector<point_t> const& points, std::vector<point_t> const& normals,
+                     std::vector<double> const& weights,
+                     std::optional<FreeSurfacePlane<D>> const& free_surface, MPI_Comm comm);
+
+    std::size_t num_local_points() const { return rows_.rows(); }
+    std::size_t num_points() const { return rows_.cols(); }
+
+    /**
+     * @brief Computes the normal derivative t at the local points (collective).
+     *
+     * @param u Solution at the local points
+     * @param t Normal derivative at the local points
+     */
+    void apply(double const* u, double* t);
+
+    /**
+     * @brief Entry of the Dirichlet-to-Neumann map coupling local points i and j.
+     */
+    double local_entry(std::size_t i, std::size_t j) const { return rows_(i, offset_ + j); }
+
+private:
+    MPI_Comm comm_;
+    std::size_t offset_;
+    std::vector<int> counts_;
+    std::vector<int> displs_;
+    Eigen::MatrixXd rows_;
+    Eigen::VectorXd u_all_;
+};
+
+} // namespace tndm
+
+#endif // EXTERIORCOUPLING_20261018_H
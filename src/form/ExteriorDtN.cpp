@@ -0,0 +1,111 @@
+#include "ExteriorDtN.h"
+#include "geometry/Vector.h"
+
+#include <Eigen/LU>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace tndm {
+
+namespace {
+
+template <std::size_t D> constexpr double surface_of_unit_sphere() {
+    if constexpr (D == 2u) {
+        return 2.0 * M_PI;
+    } else {
+        return 4.0 * M_PI;
+    }
+}
+
+/**
+ * @brief Fundamental solution of -Δ
+ */
+template <std::size_t D> double green(double r) {
+    if constexpr (D == 2u) {
+        return -std::log(r) / (2.0 * M_PI);
+    } else {
+        return 1.0 / (4.0 * M_PI * r);
+    }
+}
+
+/**
+ * @brief Integral of the fundamental solution over a flat panel of measure w centred at x.
+ */
+template <std::size_t D> double green_self(double w) {
+    if constexpr (D == 2u) {
+        return -w * (std::log(w / 2.0) - 1.0) / (2.0 * M_PI);
+    } else {
+        return std::sqrt(w / M_PI) / 2.0;
+    }
+}
+
+/**
+ * @brief Normal derivative of the fundamental solution with respect to y
+ */
+template <std::size_t D>
+double green_dn(std::array<double, D> const& x, std::array<double, D> const& y,
+                std::array<double, D> const& n_y) {
+    auto r = y - x;
+    double dist = norm(r);
+    return -dot(r, n_y) / (surface_of_unit_sphere<D>() * std::pow(dist, D));
+}
+
+} // namespace
+
+template <std::size_t D>
+LaplaceExteriorDtN<D>::LaplaceExteriorDtN(std::vector<point_t> const& points,
+                                          std::vector<point_t> const& normals,
+                                          std::vector<double> const& weights,
+                                          std::optional<FreeSurfacePlane<D>> const& free_surface) {
+    std::size_t n = points.size();
+    if (normals.size() != n || weights.size() != n) {
+        throw std::runtime_error("Number of points, normals, and weights must match");
+    }
+
+    auto reflect = [&free_surface](point_t const& x, double offset) {
+        auto const& p = free_surface->normal;
+        return x - (2.0 * (dot(p, x) - offset)) * p;
+    };
+
+    // Boundary integral equation V t = (K - I/2) u + u_inf
+    std::size_t m = D == 2u ? n + 1 : n;
+    Eigen::MatrixXd M = Eigen::MatrixXd::Zero(m, m);
+    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(m, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            if (i == j) {
+                M(i, j) = green_self<D>(weights[j]);
+            } else {
+                M(i, j) = green<D>(norm(points[j] - points[i])) * weights[j];
+                B(i, j) = green_dn<D>(points[i], points[j], normals[j]) * weights[j];
+            }
+            if (free_surface) {
+                auto y_image = reflect(points[j], free_surface->offset);
+                auto n_image = reflect(normals[j], 0.0);
+                M(i, j) += green<D>(norm(y_image - points[i])) * weights[j];
+                B(i, j) += green_dn<D>(points[i], y_image, n_image) * weights[j];
+            }
+        }
+    }
+    // Singularity subtraction: the double layer potential of a constant is -1/2 on Γ, as Γ
+    // together with its mirror image is closed, hence (K - I/2) 1 = -1.
+    for (std::size_t i = 0; i < n; ++i) {
+        B(i, i) -= 1.0 + B.row(i).sum();
+    }
+    if constexpr (D == 2u) {
+        // Unknown u_inf and zero net flux
+        for (std::size_t i = 0; i < n; ++i) {
+            M(i, n) = -1.0;
+            M(n, i) = weights[i];
+        }
+    }
+
+    Eigen::MatrixXd X = M.partialPivLu().solve(B);
+    S_ = X.topRows(n);
+}
+
+template class LaplaceExteriorDtN<2u>;
+template class LaplaceExteriorDtN<3u>;
+
+} // namespace tndm
@@ -0,0 +1,62 @@
+#ifndef EXTERIORDTN_20261018_H
+#define EXTERIORDTN_20261018_H
+
+#include <Eigen/Core>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Plane {x : normal . x = offset} bounding the exterior half-space.
+ */
+template <std::size_t D> struct FreeSurfacePlane {
+    std::array<double, D> normal;
+    double offset;
+};
+
+/**
+ * @brief Dirichlet-to-Neumann map of the homogeneous Laplace problem outside of a domain.
+ *
+ * The exterior solution is represented with a boundary integral equation, which is discretized
+ * with a Nyström method on the collocation points of the truncation boundary Γ.
+ * Every point x_j represents a flat panel of measure w_j.
+ * The Dirichlet-to-Neumann map S satisfies t = S u, where u is the solution on Γ and t = ∂u/∂n
+ * is the normal derivative in direction of the normal n pointing into the exterior.
+ *
+ * The exterior may be a half-space bounded by a traction-free surface, which is accounted for
+ * with the method of images.
+ * In 2D, the exterior solution is required to be bounded, that is, u tends to a constant and
+ * the net flux through Γ vanishes.
+ * In 3D, u tends to zero.
+ */
+template <std::size_t D> class LaplaceExteriorDtN {
+public:
+    using point_t = std::array<double, D>;
+
+    /**
+     * @param points Collocation points on Γ
+     * @param normals Unit normals pointing into the exterior
+     * @param weights Surface measure of every point
+     * @param free_surface Optional free surface bounding the exterior
+     */
+    LaplaceExteriorDtN(std::vector<point_t> const& points, std::vector<point_t> const& normals,
+                       std::vector<double> const& weights,
+                       std::optional<FreeSurfacePlane<D>> const& free_surface = std::nullopt);
+
+    std::size_t size() const { return S_.rows(); }
+    /**
+     * @brief Dense Dirichlet-to-Neumann matrix of shape size() x size()
+     */
+    Eigen::MatrixXd const& matrix() const { return S_; }
+
+private:
+    Eigen::MatrixXd S_;
+};
+
+} // namespace tndm
+
+#endif // EXTERIORDTN_20261018_H
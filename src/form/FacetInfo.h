@@ -2,6 +2,7 @@
 #define FACETINFO_20200910_H
 
 #include "form/BC.h"
+#include "util/LocalIndex.h"
 
 #include <array>
 #include <cstddef>
@@ -9,18 +10,18 @@
 namespace tndm {
 
 struct SideInfo {
-    std::size_t fctNo;
+    local_index_t fctNo;
     int side;
-    std::size_t lid;
-    std::size_t localNo;
+    local_index_t lid;
+    local_index_t localNo;
     BC bc;
 };
 
 struct FacetInfo {
     std::array<bool, 2> inside;
-    std::array<std::size_t, 2> up;
+    std::array<local_index_t, 2> up;
     std::array<std::size_t, 2> g_up;
-    std::array<std::size_t, 2> localNo;
+    std::array<local_index_t, 2> localNo;
     BC bc;
 };
 
@@ -0,0 +1,429 @@
+#include "FunctionSnapshot.h"
+#include "basis/Functions.h"
+#include "basis/WarpAndBlend.h"
+#include "form/RefElement.h"
+#include "geometry/SimplexDistance.h"
+#include "geometry/Vector.h"
+#include "parallel/MPITraits.h"
+#include "tensor/EigenMap.h"
+#include "tensor/Managed.h"
+#include "util/Combinatorics.h"
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace tndm {
+
+namespace {
+
+template <typename T> void write_binary(std::ostream& out, T const* data, std::size_t n) {
+    out.write(reinterpret_cast<char const*>(data), n * sizeof(T));
+}
+void write_size(std::ostream& out, std::size_t value) {
+    uint64_t v = value;
+    write_binary(out, &v, 1);
+}
+
+template <typename T> void read_binary(std::istream& in, T* data, std::size_t n) {
+    in.read(reinterpret_cast<char*>(data), n * sizeof(T));
+    if (!in) {
+        throw std::runtime_error("Unexpected end of function snapshot");
+    }
+}
+std::size_t read_size(std::istream& in) {
+    uint64_t v;
+    read_binary(in, &v, 1);
+    return v;
+}
+
+constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+} // namespace
+
+template <std::size_t D, std::size_t DE>
+FunctionSnapshot<D, DE>::FunctionSnapshot(FiniteElementFunction<DE> const& function,
+                                          std::vector<vertices_t> vertices)
+    : degree_(function.refElement().degree()), vertices_(std::move(vertices)) {
+    if (vertices_.size() != function.numElements()) {
+        throw std::logic_error("FunctionSnapshot: Number of elements and vertices differ");
+    }
+    std::size_t Q = function.numQuantities();
+    names_.reserve(Q);
+    for (std::size_t q = 0; q < Q; ++q) {
+        names_.emplace_back(function.name(q));
+    }
+
+    // Modal coefficients c = V^{-1} u, where u are the function values at the nodes
+    auto nodal = NodalRefElement<DE>(degree_, WarpAndBlendFactory<DE>());
+    std::size_t nbf = nodal.numBasisFunctions();
+    auto E = function.evaluationMatrix(nodal.refNodes());
+    auto u = Managed<Matrix<double>>(function.mapResultInfo(nbf));
+    coeffs_.resize(nbf * Q * function.numElements());
+    for (std::size_t elNo = 0; elNo < function.numElements(); ++elNo) {
+        function.map(elNo, E, u);
+        Eigen::Map<Eigen::MatrixXd>(&coeffs_[elNo * nbf * Q], nbf, Q) =
+            nodal.vandermondeInv() * EigenMap(u);
+    }
+    setup();
+}
+
+template <std::size_t D, std::size_t DE>
+FunctionSnapshot<D, DE>::FunctionSnapshot(unsigned degree, std::vector<std::string> names,
+                                          std::vector<vertices_t> vertices,
+                                          std::vector<double> coeffs)
+    : degree_(degree), names_(std::move(names)), vertices_(std::move(vertices)),
+      coeffs_(std::move(coeffs)) {
+    setup();
+    if (coeffs_.size() != numBasisFunctions() * numQuantities() * numElements()) {
+        throw std::runtime_error("FunctionSnapshot: Inconsistent number of coefficients");
+    }
+}
+
+template <std::size_t D, std::size_t DE>
+auto FunctionSnapshot<D, DE>::gather(FiniteElementFunction<DE> const& function,
+                                     std::vector<vertices_t> const& vertices, MPI_Comm comm,
+                                     int root) -> FunctionSnapshot {
+    int rank, procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &procs);
+
+    auto local = FunctionSnapshot(function, vertices);
+
+    // Counts and displacements are in elements, such that only the number of elements is
+    // limited by the int counts of MPI_Gatherv
+    uint64_t num_total = local.numElements();
+    MPI_Allreduce(MPI_IN_PLACE, &num_total, 1, MPI_UINT64_T, MPI_SUM, comm);
+    if (num_total > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("FunctionSnapshot: Too many elements to gather");
+    }
+
+    int num_local = local.numElements();
+    auto num_elements = std::vector<int>(rank == root ? procs : 0);
+    MPI_Gather(&num_local, 1, MPI_INT, num_elements.data(), 1, MPI_INT, root, comm);
+    auto displs = std::vector<int>(num_elements.size() + 1, 0);
+    for (std::size_t p = 0; p < num_elements.size(); ++p) {
+        displs[p + 1] = displs[p] + num_elements[p];
+    }
+
+    auto const gatherv = [&](double const* data, std::size_t per_element) {
+        auto element_t = mpi_array_type<double>(per_element);
+        auto result = std::vector<double>(static_cast<std::size_t>(displs.back()) * per_element);
+        MPI_Gatherv(data, num_local, element_t.get(), result.data(), num_elements.data(),
+                    displs.data(), element_t.get(), root, comm);
+        return result;
+    };
+
+    constexpr std::size_t vertex_size = (DE + 1u) * D;
+    auto vertex_data =
+        gatherv(reinterpret_cast<double const*>(local.vertices_.data()), vertex_size);
+    auto coeffs =
+        gatherv(local.coeffs_.data(), local.numBasisFunctions() * local.numQuantities());
+    if (rank != root) {
+        return FunctionSnapshot();
+    }
+
+    auto all_vertices = std::vector<vertices_t>(vertex_data.size() / vertex_size);
+    std::copy(vertex_data.begin(), vertex_data.end(),
+              reinterpret_cast<double*>(all_vertices.data()));
+    return FunctionSnapshot(local.degree_, local.names_, std::move(all_vertices),
+                            std::move(coeffs));
+}
+
+template <std::size_t D, std::size_t DE>
+void FunctionSnapshot<D, DE>::write(std::ostream& out) const {
+    write_size(out, D);
+    write_size(out, DE);
+    write_size(out, degree_);
+    write_size(out, numQuantities());
+    write_size(out, numElements());
+    for (auto const& name : names_) {
+        write_size(out, name.size());
+        write_binary(out, name.data(), name.size());
+    }
+    write_binary(out, reinterpret_cast<double const*>(vertices_.data()),
+                 numElements() * (DE + 1u) * D);
+    write_binary(out, coeffs_.data(), coeffs_.size());
+}
+
+template <std::size_t D, std::size_t DE>
+auto FunctionSnapshot<D, DE>::read(std::istream& in) -> FunctionSnapshot {
+    std::size_t dim = read_size(in);
+    std::size_t element_dim = read_size(in);
+    if (dim != D || element_dim != DE) {
+        throw std::runtime_error("FunctionSnapshot: Dimension mismatch");
+    }
+    unsigned degree = read_size(in);
+    std::size_t Q = read_size(in);
+    std::size_t num_elements = read_size(in);
+    auto names = std::vector<std::string>(Q);
+    for (auto& name : names) {
+        name.resize(read_size(in));
+        read_binary(in, name.data(), name.size());
+    }
+    auto vertices = std::vector<vertices_t>(num_elements);
+    read_binary(in, reinterpret_cast<double*>(vertices.data()), num_elements * (DE + 1u) * D);
+    auto coeffs = std::vector<double>(binom(degree + DE, DE) * Q * num_elements);
+    read_binary(in, coeffs.data(), coeffs.size());
+    return FunctionSnapshot(degree, std::move(names), std::move(vertices), std::move(coeffs));
+}
+
+template <std::size_t D, std::size_t DE> void FunctionSnapshot<D, DE>::setup() {
+    basis_.clear();
+    for (auto const& j : AllIntegerSums<DE>(degree_)) {
+        basis_.emplace_back(j);
+    }
+
+    std::size_t num_elements = numElements();
+    P_.resize(num_elements);
+    bbox_.resize(num_elements);
+    if (num_elements == 0) {
+        return;
+    }
+
+    double h_mean = 0.0;
+    for (std::size_t elNo = 0; elNo < num_elements; ++elNo) {
+        auto const& v = vertices_[elNo];
+        Eigen::Matrix<double, D, DE> J;
+        for (std::size_t k = 0; k < DE; ++k) {
+            for (std::size_t d = 0; d < D; ++d) {
+                J(d, k) = v[k + 1][d] - v[0][d];
+            }
+        }
+        Eigen::Matrix<double, DE, D> P = (J.transpose() * J).inverse() * J.transpose();
+        for (std::size_t k = 0; k < DE; ++k) {
+            for (std::size_t d = 0; d < D; ++d) {
+                P_[elNo][k][d] = P(k, d);
+            }
+        }
+
+        double diam = 0.0;
+        for (std::size_t i = 0; i < DE + 1u; ++i) {
+            for (std::size_t j = i + 1; j < DE + 1u; ++j) {
+                diam = std::max(diam, norm(v[i] - v[j]));
+            }
+        }
+        h_mean += diam;
+
+        // Enlarged bounding box such that nearby points that miss a curved boundary still find
+        // the element in their grid cell
+        auto& [lo, hi] = bbox_[elNo];
+        lo = hi = v[0];
+        for (auto const& x : v) {
+            for (std::size_t d = 0; d < D; ++d) {
+                lo[d] = std::min(lo[d], x[d]);
+                hi[d] = std::max(hi[d], x[d]);
+            }
+        }
+        for (std::size_t d = 0; d < D; ++d) {
+            lo[d] -= 0.25 * diam;
+            hi[d] += 0.25 * diam;
+        }
+    }
+    h_mean /= num_elements;
+
+    point_t grid_hi;
+    grid_lo_ = bbox_[0][0];
+    grid_hi = bbox_[0][1];
+    for (auto const& [lo, hi] : bbox_) {
+        for (std::size_t d = 0; d < D; ++d) {
+            grid_lo_[d] = std::min(grid_lo_[d], lo[d]);
+            grid_hi[d] = std::max(grid_hi[d], hi[d]);
+        }
+    }
+
+    // About one element per cell; facets in D dimensions may only fill a small fraction of the
+    // cells, hence we limit the number of cells
+    double h = h_mean;
+    std::size_t max_cells = 4 * num_elements + 1;
+    std::size_t num_cells;
+    do {
+        num_cells = 1;
+        for (std::size_t d = 0; d < D; ++d) {
+            grid_n_[d] = std::max(1.0, std::ceil((grid_hi[d] - grid_lo_[d]) / h));
+            num_cells *= grid_n_[d];
+        }
+        h *= 2.0;
+    } while (num_cells > max_cells);
+    for (std::size_t d = 0; d < D; ++d) {
+        grid_h_[d] = (grid_hi[d] - grid_lo_[d]) / grid_n_[d];
+        if (grid_h_[d] <= 0.0) {
+            grid_h_[d] = 1.0;
+        }
+    }
+
+    cell_offsets_.assign(num_cells + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (std::size_t elNo = 0; elNo < num_elements; ++elNo) {
+            for_each_cell(bbox_[elNo][0], bbox_[elNo][1], [&](std::size_t c) {
+                if (pass == 0) {
+                    ++cell_offsets_[c + 1];
+                } else {
+                    cell_elements_[cell_offsets_[c]++] = elNo;
+                }
+            });
+        }
+        if (pass == 0) {
+            for (std::size_t c = 0; c < num_cells; ++c) {
+                cell_offsets_[c + 1] += cell_offsets_[c];
+            }
+            cell_elements_.resize(cell_offsets_.back());
+        } else {
+            // Offsets have been shifted by one cell during insertion
+            for (std::size_t c = num_cells; c > 0; --c) {
+                cell_offsets_[c] = cell_offsets_[c - 1];
+            }
+            cell_offsets_[0] = 0;
+        }
+    }
+    eps_ = 1e-10 * h_mean;
+}
+
+template <std::size_t D, std::size_t DE>
+std::size_t FunctionSnapshot<D, DE>::cell_coord(double x, std::size_t d) const {
+    double i = std::floor((x - grid_lo_[d]) / grid_h_[d]);
+    return std::min(static_cast<double>(grid_n_[d] - 1), std::max(0.0, i));
+}
+
+template <std::size_t D, std::size_t DE>
+template <typename Func>
+void FunctionSnapshot<D, DE>::for_each_cell(point_t const& lo, point_t const& hi,
+                                            Func&& fun) const {
+    std::array<std::size_t, D> i_lo, i_hi, i;
+    for (std::size_t d = 0; d < D; ++d) {
+        i_lo[d] = cell_coord(lo[d], d);
+        i_hi[d] = cell_coord(hi[d], d);
+    }
+    i = i_lo;
+    while (true) {
+        std::size_t c = 0;
+        for (std::size_t d = D; d-- > 0;) {
+            c = c * grid_n_[d] + i[d];
+        }
+        fun(c);
+        std::size_t d = 0;
+        for (; d < D; ++d) {
+            if (++i[d] <= i_hi[d]) {
+                break;
+            }
+            i[d] = i_lo[d];
+        }
+        if (d == D) {
+            break;
+        }
+    }
+}
+
+template <std::size_t D, std::size_t DE>
+auto FunctionSnapshot<D, DE>::locate(point_t const& x) const
+    -> std::pair<std::size_t, std::array<double, DE>> {
+    if (numElements() == 0) {
+        throw std::runtime_error("FunctionSnapshot: Cannot evaluate empty snapshot");
+    }
+
+    std::size_t best = npos;
+    double best_dist = std::numeric_limits<double>::max();
+    std::array<double, DE> best_xi = {};
+
+    // Elements that contain the (projected) point
+    for_each_cell(x, x, [&](std::size_t c) {
+        for (std::size_t i = cell_offsets_[c]; i < cell_offsets_[c + 1]; ++i) {
+            std::size_t elNo = cell_elements_[i];
+            auto const& v = vertices_[elNo];
+            auto const dx = x - v[0];
+            std::array<double, DE> xi;
+            double bary0 = 1.0;
+            bool inside = true;
+            for (std::size_t k = 0; k < DE; ++k) {
+                xi[k] = dot(P_[elNo][k], dx);
+                bary0 -= xi[k];
+                inside = inside && xi[k] >= -1e-10;
+            }
+            if (!inside || bary0 < -1e-10) {
+                continue;
+            }
+            auto y = v[0];
+            for (std::size_t k = 0; k < DE; ++k) {
+                y = y + xi[k] * (v[k + 1] - v[0]);
+            }
+            double dist = norm(y - x);
+            if (dist < best_dist) {
+                best = elNo;
+                best_dist = dist;
+                best_xi = xi;
+            }
+        }
+    });
+    if (best != npos && best_dist <= eps_) {
+        return {best, best_xi};
+    }
+
+    // Closest point of all elements within radius R, where R is increased until we find one
+    double R = best != npos ? best_dist : *std::max_element(grid_h_.begin(), grid_h_.end());
+    while (true) {
+        point_t lo, hi;
+        bool covers_grid = true;
+        for (std::size_t d = 0; d < D; ++d) {
+            lo[d] = x[d] - R;
+            hi[d] = x[d] + R;
+            covers_grid = covers_grid && lo[d] <= grid_lo_[d] &&
+                          hi[d] >= grid_lo_[d] + grid_n_[d] * grid_h_[d];
+        }
+        for_each_cell(lo, hi, [&](std::size_t c) {
+            for (std::size_t i = cell_offsets_[c]; i < cell_offsets_[c + 1]; ++i) {
+                std::size_t elNo = cell_elements_[i];
+                auto const& [blo, bhi] = bbox_[elNo];
+                double lb2 = 0.0;
+                for (std::size_t d = 0; d < D; ++d) {
+                    double e = std::max({0.0, blo[d] - x[d], x[d] - bhi[d]});
+                    lb2 += e * e;
+                }
+                if (std::sqrt(lb2) >= best_dist) {
+                    continue;
+                }
+                auto r = SimplexDistance<D, DE + 1u>(vertices_[elNo]).closest(x);
+                if (r.dist < best_dist) {
+                    best = elNo;
+                    best_dist = r.dist;
+                    for (std::size_t k = 0; k < DE; ++k) {
+                        best_xi[k] = r.bary[k + 1];
+                    }
+                }
+            }
+        });
+        if (best_dist <= R || covers_grid) {
+            break;
+        }
+        R *= 2.0;
+    }
+    return {best, best_xi};
+}
+
+template <std::size_t D, std::size_t DE>
+void FunctionSnapshot<D, DE>::evaluate(point_t const& x, double* result) const {
+    auto [elNo, xi] = locate(x);
+    std::size_t nbf = numBasisFunctions();
+    std::size_t Q = numQuantities();
+    double const* c = &coeffs_[elNo * nbf * Q];
+    std::fill(result, result + Q, 0.0);
+    for (std::size_t bf = 0; bf < nbf; ++bf) {
+        double phi = DubinerP<DE>(basis_[bf], xi);
+        for (std::size_t q = 0; q < Q; ++q) {
+            result[q] += phi * c[bf + q * nbf];
+        }
+    }
+}
+
+template class FunctionSnapshot<2u, 1u>;
+template class FunctionSnapshot<2u, 2u>;
+template class FunctionSnapshot<3u, 2u>;
+template class FunctionSnapshot<3u, 3u>;
+
+} // namespace tndm
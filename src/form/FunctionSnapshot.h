@@ -0,0 +1,101 @@
+#ifndef FUNCTIONSNAPSHOT_20261018_H
+#define FUNCTIONSNAPSHOT_20261018_H
+
+#include "form/FiniteElementFunction.h"
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Finite element function that can be evaluated independently of mesh and partition.
+ *
+ * The snapshot stores for every element the vertices of its affine approximation and the
+ * coefficients of the function in the modal basis of degree degree(). A snapshot may therefore
+ * be evaluated at arbitrary points of another discretisation, e.g. to transfer a solution from a
+ * coarse mesh with low polynomial degree to a fine mesh with high polynomial degree.
+ *
+ * Points are located with a uniform bucket grid. Points that do not lie inside any element
+ * (e.g. due to curved boundaries) are evaluated at the closest point of the closest element.
+ *
+ * @tparam D Space dimension
+ * @tparam DE Element dimension (D for volume functions, D - 1 for functions on facets)
+ */
+template <std::size_t D, std::size_t DE> class FunctionSnapshot {
+public:
+    using point_t = std::array<double, D>;
+    using vertices_t = std::array<point_t, DE + 1u>;
+
+    FunctionSnapshot() {}
+    /**
+     * @brief Snapshot of the local part of function
+     *
+     * @param function Finite element function (nodal or modal)
+     * @param vertices Physical vertex coordinates of every element of function
+     */
+    FunctionSnapshot(FiniteElementFunction<DE> const& function,
+                     std::vector<vertices_t> vertices);
+
+    /**
+     * @brief Collects the function of all ranks on root; the result is empty on other ranks
+     */
+    static auto gather(FiniteElementFunction<DE> const& function,
+                       std::vector<vertices_t> const& vertices, MPI_Comm comm, int root = 0)
+        -> FunctionSnapshot;
+
+    void write(std::ostream& out) const;
+    static auto read(std::istream& in) -> FunctionSnapshot;
+
+    unsigned degree() const { return degree_; }
+    std::size_t numBasisFunctions() const { return basis_.size(); }
+    std::size_t numQuantities() const { return names_.size(); }
+    std::size_t numElements() const { return vertices_.size(); }
+    std::string const& name(std::size_t q) const { return names_[q]; }
+
+    /**
+     * @brief Evaluates all quantities at x
+     *
+     * @param x Evaluation point
+     * @param result Array of size numQuantities()
+     */
+    void evaluate(point_t const& x, double* result) const;
+
+private:
+    FunctionSnapshot(unsigned degree, std::vector<std::string> names,
+                     std::vector<vertices_t> vertices, std::vector<double> coeffs);
+
+    void setup();
+    auto locate(point_t const& x) const -> std::pair<std::size_t, std::array<double, DE>>;
+    std::size_t cell_coord(double x, std::size_t d) const;
+    template <typename Func>
+    void for_each_cell(point_t const& lo, point_t const& hi, Func&& fun) const;
+
+    unsigned degree_ = 0;
+    std::vector<std::string> names_;
+    std::vector<vertices_t> vertices_;
+    std::vector<double> coeffs_; ///< Shape (numBasisFunctions, numQuantities, numElements)
+
+    std::vector<std::array<unsigned, DE>> basis_;
+
+    /// Affine map inverse xi = P (x - v0) (least-squares inverse if DE < D)
+    std::vector<std::array<point_t, DE>> P_;
+    std::vector<std::array<point_t, 2>> bbox_;
+
+    point_t grid_lo_ = {};
+    std::array<double, D> grid_h_ = {};
+    std::array<std::size_t, D> grid_n_ = {};
+    std::vector<std::size_t> cell_offsets_;
+    std::vector<std::size_t> cell_elements_;
+    double eps_ = 0.0;
+};
+
+} // namespace tndm
+
+#endif // FUNCTIONSNAPSHOT_20261018_H
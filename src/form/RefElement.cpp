@@ -11,6 +11,7 @@
 
 #include <Eigen/Core>
 #include <Eigen/LU>
+#include <Eigen/QR>
 
 #include <cassert>
 #include <cstddef>
@@ -45,6 +46,19 @@ template <std::size_t D> Managed<Matrix<double>> ModalRefElement<D>::inverseMass
     return Minv;
 }
 
+template <std::size_t D>
+Managed<Matrix<double>> ModalRefElement<D>::degreeProjector(unsigned degree) const {
+    // The basis is hierarchical, i.e. the first modes span the polynomials of lower degree
+    std::ptrdiff_t nbf = this->numBasisFunctions();
+    std::ptrdiff_t num_kept = degree < this->degree() ? binom(degree + D, D) : nbf;
+    Managed<Matrix<double>> P({nbf, nbf}, this->alignment());
+    P.set_zero();
+    for (std::ptrdiff_t i = 0; i < num_kept; ++i) {
+        P(i, i) = 1.0;
+    }
+    return P;
+}
+
 template <std::size_t D>
 Managed<Matrix<double>>
 ModalRefElement<D>::evaluateBasisAt(std::vector<std::array<double, D>> const& points,
@@ -113,6 +127,23 @@ template <std::size_t D> Managed<Matrix<double>> NodalRefElement<D>::inverseMass
     return Minv;
 }
 
+template <std::size_t D>
+Managed<Matrix<double>> NodalRefElement<D>::degreeProjector(unsigned degree) const {
+    std::ptrdiff_t nbf = this->numBasisFunctions();
+    Managed<Matrix<double>> P({nbf, nbf}, this->alignment());
+    if (degree >= this->degree()) {
+        EigenMap(P) = Eigen::MatrixXd::Identity(nbf, nbf);
+        return P;
+    }
+    // The leading columns of the Vandermonde matrix are the nodal values of the modes of lower
+    // degree; P = Q Q^T with an orthonormal basis Q of their span
+    std::ptrdiff_t num_kept = binom(degree + D, D);
+    Eigen::HouseholderQR<Eigen::MatrixXd> qr(vandermonde_.leftCols(num_kept));
+    Eigen::MatrixXd Q = qr.householderQ() * Eigen::MatrixXd::Identity(nbf, num_kept);
+    EigenMap(P) = Q * Q.transpose();
+    return P;
+}
+
 template <std::size_t D>
 Managed<Matrix<double>>
 NodalRefElement<D>::evaluateBasisAt(std::vector<std::array<double, D>> const& points,
@@ -45,6 +45,17 @@ public:
     virtual Managed<Matrix<double>> massMatrix() const = 0;
     virtual Managed<Matrix<double>> inverseMassMatrix() const = 0;
 
+    /**
+     * @brief Orthogonal projector onto the coefficients of polynomials of lower degree
+     *
+     * @param degree Maximum polynomial degree of the subspace
+     *
+     * @return Symmetric matrix P with shape (numberOfBasisFunctions, numberOfBasisFunctions)
+     * such that P u are the coefficients of the best approximation of u in the subspace w.r.t.
+     * the Euclidean norm of the coefficients; identity if degree >= degree()
+     */
+    virtual Managed<Matrix<double>> degreeProjector(unsigned degree) const = 0;
+
     /**
      * @brief Evaluate basis functions at points
      *
@@ -101,6 +112,7 @@ public:
 
     Managed<Matrix<double>> massMatrix() const override;
     Managed<Matrix<double>> inverseMassMatrix() const override;
+    Managed<Matrix<double>> degreeProjector(unsigned degree) const override;
 
     Managed<Matrix<double>>
     evaluateBasisAt(std::vector<std::array<double, D>> const& points,
@@ -124,6 +136,7 @@ public:
 
     Managed<Matrix<double>> massMatrix() const override;
     Managed<Matrix<double>> inverseMassMatrix() const override;
+    Managed<Matrix<double>> degreeProjector(unsigned degree) const override;
 
     Managed<Matrix<double>>
     evaluateBasisAt(std::vector<std::array<double, D>> const& points,
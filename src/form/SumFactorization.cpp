@@ -0,0 +1,533 @@
+#include "SumFactorization.h"
+#include "basis/Functions.h"
+#include "quadrules/GaussJacobi.h"
+#include "quadrules/TensorProductRule.h"
+#include "util/Combinatorics.h"
+#include "util/Enumerate.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tndm {
+
+namespace {
+
+std::vector<double> collapsedPoints(std::size_t n, unsigned alpha) {
+    auto gj = GaussJacobi(n, alpha, 0);
+    gj.changeInterval(0.0, 1.0);
+    return gj.points();
+}
+
+/**
+ * @brief Evaluates (1-x)^e P_j^{(alpha,0)}(2x-1) and its derivative.
+ */
+void collapsedFactor(unsigned e, unsigned j, unsigned alpha, double x, double& f, double& df) {
+    double p = JacobiP(j, alpha, 0, 2.0 * x - 1.0);
+    double dp = 2.0 * JacobiPDerivative(j, alpha, 0, 2.0 * x - 1.0);
+    double s = std::pow(1.0 - x, e);
+    f = s * p;
+    df = s * dp;
+    if (e > 0) {
+        df -= e * std::pow(1.0 - x, e - 1) * p;
+    }
+}
+
+} // namespace
+
+template <std::size_t D>
+SimplexQuadratureRule<D> SumFactorization<D>::rule(unsigned minQuadOrder) {
+    auto tp = TensorProductRule<D>::get(minQuadOrder);
+    for (auto& pt : tp.points()) {
+        std::reverse(pt.begin(), pt.end());
+    }
+    return tp;
+}
+
+template <std::size_t D>
+SumFactorization<D>::SumFactorization(unsigned degree, unsigned minQuadOrder)
+    : N_(degree), n_(TensorProductRule<D>::pointsPerDim(minQuadOrder)),
+      numBF_(binom(degree + D, D)), numQ_(TensorProductRule<D>::size(minQuadOrder)) {
+    std::size_t Np1 = N_ + 1;
+    a_ = collapsedPoints(n_, 0);
+    b_ = collapsedPoints(n_, 1);
+    if constexpr (D == 3u) {
+        c_ = collapsedPoints(n_, 2);
+    }
+
+    A_.resize(Np1 * n_);
+    dA_.resize(Np1 * n_);
+    for (unsigned i = 0; i <= N_; ++i) {
+        for (std::size_t k = 0; k < n_; ++k) {
+            A_[a_index(i, k)] = JacobiP(i, 0, 0, 2.0 * a_[k] - 1.0);
+            dA_[a_index(i, k)] = 2.0 * JacobiPDerivative(i, 0, 0, 2.0 * a_[k] - 1.0);
+        }
+    }
+
+    B_.resize(Np1 * Np1 * n_);
+    dB_.resize(Np1 * Np1 * n_);
+    for (unsigned i = 0; i <= N_; ++i) {
+        for (unsigned j = 0; i + j <= N_; ++j) {
+            for (std::size_t l = 0; l < n_; ++l) {
+                collapsedFactor(i, j, 2 * i + 1, b_[l], B_[b_index(i, j, l)],
+                                dB_[b_index(i, j, l)]);
+            }
+        }
+    }
+
+    if constexpr (D == 3u) {
+        C_.resize(Np1 * Np1 * n_);
+        dC_.resize(Np1 * Np1 * n_);
+        for (unsigned s = 0; s <= N_; ++s) {
+            for (unsigned k = 0; s + k <= N_; ++k) {
+                for (std::size_t m = 0; m < n_; ++m) {
+                    collapsedFactor(s, k, 2 * s + 2, c_[m], C_[b_index(s, k, m)],
+                                    dC_[b_index(s, k, m)]);
+                }
+            }
+        }
+    }
+
+    bf_.resize(D == 3u ? Np1 * Np1 * Np1 : Np1 * Np1);
+    for (auto&& [bf, j] : enumerate(AllIntegerSums<D>(N_))) {
+        std::size_t idx = j[0] * Np1 + j[1];
+        if constexpr (D == 3u) {
+            idx = idx * Np1 + j[2];
+        }
+        bf_[idx] = bf;
+    }
+
+    auto transpose = [this, Np1](std::vector<double> const& X) {
+        std::vector<double> Xt(X.size());
+        if (X.empty()) {
+            return Xt;
+        }
+        for (std::size_t i = 0; i < Np1; ++i) {
+            for (std::size_t j = 0; j < Np1; ++j) {
+                for (std::size_t l = 0; l < n_; ++l) {
+                    Xt[bt_index(i, l, j)] = X[b_index(i, j, l)];
+                }
+            }
+        }
+        return Xt;
+    };
+    At_.resize(Np1 * n_);
+    dAt_.resize(Np1 * n_);
+    for (std::size_t i = 0; i < Np1; ++i) {
+        for (std::size_t k = 0; k < n_; ++k) {
+            At_[k * Np1 + i] = A_[a_index(i, k)];
+            dAt_[k * Np1 + i] = dA_[a_index(i, k)];
+        }
+    }
+    Bt_ = transpose(B_);
+    dBt_ = transpose(dB_);
+    Ct_ = transpose(C_);
+    dCt_ = transpose(dC_);
+
+    scratchSize_ = scratch_size(N_, n_);
+}
+
+template <std::size_t D>
+void SumFactorization<D>::evaluate(double const* coeffs, double* values, double* scratch) const {
+    std::size_t const n = n_;
+    std::size_t const Np1 = N_ + 1;
+    if constexpr (D == 2u) {
+        double* w = scratch;
+        std::fill(w, w + Np1 * n, 0.0);
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                double c = coeffs[bf_index(i, j)];
+                double const* B = &B_[b_index(i, j, 0)];
+                for (std::size_t l = 0; l < n; ++l) {
+                    w[i * n + l] += B[l] * c;
+                }
+            }
+        }
+        std::fill(values, values + numQ_, 0.0);
+        for (std::size_t l = 0; l < n; ++l) {
+            for (unsigned i = 0; i <= N_; ++i) {
+                double v = w[i * n + l];
+                double const* A = &A_[a_index(i, 0)];
+                for (std::size_t k = 0; k < n; ++k) {
+                    values[k + n * l] += A[k] * v;
+                }
+            }
+        }
+    } else {
+        double* w1 = scratch;
+        double* w2 = w1 + Np1 * Np1 * n;
+        std::fill(w1, w2 + Np1 * n * n, 0.0);
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                for (unsigned k = 0; i + j + k <= N_; ++k) {
+                    double c = coeffs[bf_index(i, j, k)];
+                    double const* C = &C_[b_index(i + j, k, 0)];
+                    for (std::size_t m = 0; m < n; ++m) {
+                        w1[(i * Np1 + j) * n + m] += C[m] * c;
+                    }
+                }
+            }
+        }
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                double const* B = &B_[b_index(i, j, 0)];
+                for (std::size_t m = 0; m < n; ++m) {
+                    double v = w1[(i * Np1 + j) * n + m];
+                    for (std::size_t l = 0; l < n; ++l) {
+                        w2[(i * n + m) * n + l] += B[l] * v;
+                    }
+                }
+            }
+        }
+        std::fill(values, values + numQ_, 0.0);
+        for (std::size_t m = 0; m < n; ++m) {
+            for (std::size_t l = 0; l < n; ++l) {
+                double* u = values + n * (l + n * m);
+                for (unsigned i = 0; i <= N_; ++i) {
+                    double v = w2[(i * n + m) * n + l];
+                    double const* A = &A_[a_index(i, 0)];
+                    for (std::size_t k = 0; k < n; ++k) {
+                        u[k] += A[k] * v;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <std::size_t D>
+void SumFactorization<D>::evaluate_gradient(double const* coeffs, double* grad,
+                                            double* scratch) const {
+    std::size_t const n = n_;
+    std::size_t const Np1 = N_ + 1;
+    if constexpr (D == 2u) {
+        double* w = scratch;
+        double* wb = w + Np1 * n;
+        double* ua = wb + Np1 * n;
+        double* ub = ua + n * n;
+        std::fill(w, ub + n * n, 0.0);
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                double c = coeffs[bf_index(i, j)];
+                double const* B = &B_[b_index(i, j, 0)];
+                double const* dB = &dB_[b_index(i, j, 0)];
+                for (std::size_t l = 0; l < n; ++l) {
+                    w[i * n + l] += B[l] * c;
+                    wb[i * n + l] += dB[l] * c;
+                }
+            }
+        }
+        for (std::size_t l = 0; l < n; ++l) {
+            for (unsigned i = 0; i <= N_; ++i) {
+                double v = w[i * n + l];
+                double vb = wb[i * n + l];
+                double const* A = &A_[a_index(i, 0)];
+                double const* dA = &dA_[a_index(i, 0)];
+                for (std::size_t k = 0; k < n; ++k) {
+                    ua[k + n * l] += dA[k] * v;
+                    ub[k + n * l] += A[k] * vb;
+                }
+            }
+        }
+        for (std::size_t l = 0; l < n; ++l) {
+            double beta = 1.0 / (1.0 - b_[l]);
+            for (std::size_t k = 0; k < n; ++k) {
+                std::size_t q = k + n * l;
+                grad[D * q] = beta * ua[q];
+                grad[D * q + 1] = a_[k] * beta * ua[q] + ub[q];
+            }
+        }
+    } else {
+        double* w1 = scratch;
+        double* w1c = w1 + Np1 * Np1 * n;
+        double* w2 = w1c + Np1 * Np1 * n;
+        double* w2b = w2 + Np1 * n * n;
+        double* w2c = w2b + Np1 * n * n;
+        double* ua = w2c + Np1 * n * n;
+        double* ub = ua + numQ_;
+        double* uc = ub + numQ_;
+        std::fill(w1, uc + numQ_, 0.0);
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                for (unsigned k = 0; i + j + k <= N_; ++k) {
+                    double c = coeffs[bf_index(i, j, k)];
+                    double const* C = &C_[b_index(i + j, k, 0)];
+                    double const* dC = &dC_[b_index(i + j, k, 0)];
+                    for (std::size_t m = 0; m < n; ++m) {
+                        w1[(i * Np1 + j) * n + m] += C[m] * c;
+                        w1c[(i * Np1 + j) * n + m] += dC[m] * c;
+                    }
+                }
+            }
+        }
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                double const* B = &B_[b_index(i, j, 0)];
+                double const* dB = &dB_[b_index(i, j, 0)];
+                for (std::size_t m = 0; m < n; ++m) {
+                    double v = w1[(i * Np1 + j) * n + m];
+                    double vc = w1c[(i * Np1 + j) * n + m];
+                    std::size_t offset = (i * n + m) * n;
+                    for (std::size_t l = 0; l < n; ++l) {
+                        w2[offset + l] += B[l] * v;
+                        w2b[offset + l] += dB[l] * v;
+                        w2c[offset + l] += B[l] * vc;
+                    }
+                }
+            }
+        }
+        for (std::size_t m = 0; m < n; ++m) {
+            for (std::size_t l = 0; l < n; ++l) {
+                std::size_t q0 = n * (l + n * m);
+                for (unsigned i = 0; i <= N_; ++i) {
+                    std::size_t idx = (i * n + m) * n + l;
+                    double v = w2[idx];
+                    double vb = w2b[idx];
+                    double vc = w2c[idx];
+                    double const* A = &A_[a_index(i, 0)];
+                    double const* dA = &dA_[a_index(i, 0)];
+                    for (std::size_t k = 0; k < n; ++k) {
+                        ua[q0 + k] += dA[k] * v;
+                        ub[q0 + k] += A[k] * vb;
+                        uc[q0 + k] += A[k] * vc;
+                    }
+                }
+            }
+        }
+        for (std::size_t m = 0; m < n; ++m) {
+            double gamma = 1.0 / (1.0 - c_[m]);
+            for (std::size_t l = 0; l < n; ++l) {
+                double beta = gamma / (1.0 - b_[l]);
+                for (std::size_t k = 0; k < n; ++k) {
+                    std::size_t q = k + n * (l + n * m);
+                    double* g = grad + D * q;
+                    g[0] = beta * ua[q];
+                    g[1] = a_[k] * beta * ua[q] + gamma * ub[q];
+                    g[2] = a_[k] * beta * ua[q] + b_[l] * gamma * ub[q] + uc[q];
+                }
+            }
+        }
+    }
+}
+
+template <std::size_t D>
+void SumFactorization<D>::integrate(double const* values, double* coeffs, double* scratch) const {
+    std::size_t const n = n_;
+    std::size_t const Np1 = N_ + 1;
+    if constexpr (D == 2u) {
+        double* t = scratch;
+        double* r = t + Np1 * n;
+        std::fill(t, r + Np1 * Np1, 0.0);
+        for (std::size_t l = 0; l < n; ++l) {
+            for (std::size_t k = 0; k < n; ++k) {
+                double f = values[k + n * l];
+                double const* At = &At_[k * Np1];
+                for (unsigned i = 0; i <= N_; ++i) {
+                    t[l * Np1 + i] += At[i] * f;
+                }
+            }
+        }
+        for (std::size_t l = 0; l < n; ++l) {
+            for (unsigned i = 0; i <= N_; ++i) {
+                double v = t[l * Np1 + i];
+                double const* Bt = &Bt_[bt_index(i, l, 0)];
+                for (unsigned j = 0; i + j <= N_; ++j) {
+                    r[i * Np1 + j] += Bt[j] * v;
+                }
+            }
+        }
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                coeffs[bf_index(i, j)] = r[i * Np1 + j];
+            }
+        }
+    } else {
+        double* t = scratch;
+        double* s = t + Np1 * n * n;
+        double* r = s + Np1 * Np1 * n;
+        std::fill(t, r + Np1 * Np1 * Np1, 0.0);
+        for (std::size_t m = 0; m < n; ++m) {
+            for (std::size_t l = 0; l < n; ++l) {
+                double* tml = t + (m * n + l) * Np1;
+                for (std::size_t k = 0; k < n; ++k) {
+                    double f = values[k + n * (l + n * m)];
+                    double const* At = &At_[k * Np1];
+                    for (unsigned i = 0; i <= N_; ++i) {
+                        tml[i] += At[i] * f;
+                    }
+                }
+            }
+        }
+        for (std::size_t m = 0; m < n; ++m) {
+            for (std::size_t l = 0; l < n; ++l) {
+                for (unsigned i = 0; i <= N_; ++i) {
+                    double v = t[(m * n + l) * Np1 + i];
+                    double const* Bt = &Bt_[bt_index(i, l, 0)];
+                    double* smi = s + (m * Np1 + i) * Np1;
+                    for (unsigned j = 0; i + j <= N_; ++j) {
+                        smi[j] += Bt[j] * v;
+                    }
+                }
+            }
+        }
+        for (std::size_t m = 0; m < n; ++m) {
+            for (unsigned i = 0; i <= N_; ++i) {
+                for (unsigned j = 0; i + j <= N_; ++j) {
+                    double v = s[(m * Np1 + i) * Np1 + j];
+                    double const* Ct = &Ct_[bt_index(i + j, m, 0)];
+                    double* rij = r + (i * Np1 + j) * Np1;
+                    for (unsigned k = 0; i + j + k <= N_; ++k) {
+                        rij[k] += Ct[k] * v;
+                    }
+                }
+            }
+        }
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                for (unsigned k = 0; i + j + k <= N_; ++k) {
+                    coeffs[bf_index(i, j, k)] = r[(i * Np1 + j) * Np1 + k];
+                }
+            }
+        }
+    }
+}
+
+template <std::size_t D>
+void SumFactorization<D>::integrate_gradient(double* grad, double* coeffs, double* scratch) const {
+    std::size_t const n = n_;
+    std::size_t const Np1 = N_ + 1;
+    // Transpose of the chain rule in evaluate_gradient; afterwards grad(e,q) holds the
+    // derivative with respect to the e-th collapsed coordinate.
+    if constexpr (D == 2u) {
+        for (std::size_t l = 0; l < n; ++l) {
+            double beta = 1.0 / (1.0 - b_[l]);
+            for (std::size_t k = 0; k < n; ++k) {
+                double* g = grad + D * (k + n * l);
+                g[0] = beta * (g[0] + a_[k] * g[1]);
+            }
+        }
+        double* ta = scratch;
+        double* tb = ta + Np1 * n;
+        double* r = tb + Np1 * n;
+        std::fill(ta, r + Np1 * Np1, 0.0);
+        for (std::size_t l = 0; l < n; ++l) {
+            for (std::size_t k = 0; k < n; ++k) {
+                double const* g = grad + D * (k + n * l);
+                double const* At = &At_[k * Np1];
+                double const* dAt = &dAt_[k * Np1];
+                for (unsigned i = 0; i <= N_; ++i) {
+                    ta[l * Np1 + i] += dAt[i] * g[0];
+                    tb[l * Np1 + i] += At[i] * g[1];
+                }
+            }
+        }
+        for (std::size_t l = 0; l < n; ++l) {
+            for (unsigned i = 0; i <= N_; ++i) {
+                double va = ta[l * Np1 + i];
+                double vb = tb[l * Np1 + i];
+                double const* Bt = &Bt_[bt_index(i, l, 0)];
+                double const* dBt = &dBt_[bt_index(i, l, 0)];
+                for (unsigned j = 0; i + j <= N_; ++j) {
+                    r[i * Np1 + j] += Bt[j] * va + dBt[j] * vb;
+                }
+            }
+        }
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                coeffs[bf_index(i, j)] = r[i * Np1 + j];
+            }
+        }
+    } else {
+        for (std::size_t m = 0; m < n; ++m) {
+            double gamma = 1.0 / (1.0 - c_[m]);
+            for (std::size_t l = 0; l < n; ++l) {
+                double beta = gamma / (1.0 - b_[l]);
+                for (std::size_t k = 0; k < n; ++k) {
+                    double* g = grad + D * (k + n * (l + n * m));
+                    g[0] = beta * (g[0] + a_[k] * (g[1] + g[2]));
+                    g[1] = gamma * (g[1] + b_[l] * g[2]);
+                }
+            }
+        }
+        double* ta = scratch;
+        double* tb = ta + Np1 * n * n;
+        double* tc = tb + Np1 * n * n;
+        double* s = tc + Np1 * n * n;
+        double* sc = s + Np1 * Np1 * n;
+        double* r = sc + Np1 * Np1 * n;
+        std::fill(ta, r + Np1 * Np1 * Np1, 0.0);
+        for (std::size_t m = 0; m < n; ++m) {
+            for (std::size_t l = 0; l < n; ++l) {
+                std::size_t offset = (m * n + l) * Np1;
+                for (std::size_t k = 0; k < n; ++k) {
+                    double const* g = grad + D * (k + n * (l + n * m));
+                    double const* At = &At_[k * Np1];
+                    double const* dAt = &dAt_[k * Np1];
+                    for (unsigned i = 0; i <= N_; ++i) {
+                        ta[offset + i] += dAt[i] * g[0];
+                        tb[offset + i] += At[i] * g[1];
+                        tc[offset + i] += At[i] * g[2];
+                    }
+                }
+            }
+        }
+        for (std::size_t m = 0; m < n; ++m) {
+            for (std::size_t l = 0; l < n; ++l) {
+                for (unsigned i = 0; i <= N_; ++i) {
+                    std::size_t idx = (m * n + l) * Np1 + i;
+                    double va = ta[idx];
+                    double vb = tb[idx];
+                    double vc = tc[idx];
+                    double const* Bt = &Bt_[bt_index(i, l, 0)];
+                    double const* dBt = &dBt_[bt_index(i, l, 0)];
+                    std::size_t offset = (m * Np1 + i) * Np1;
+                    for (unsigned j = 0; i + j <= N_; ++j) {
+                        s[offset + j] += Bt[j] * va + dBt[j] * vb;
+                        sc[offset + j] += Bt[j] * vc;
+                    }
+                }
+            }
+        }
+        for (std::size_t m = 0; m < n; ++m) {
+            for (unsigned i = 0; i <= N_; ++i) {
+                for (unsigned j = 0; i + j <= N_; ++j) {
+                    double v = s[(m * Np1 + i) * Np1 + j];
+                    double vc = sc[(m * Np1 + i) * Np1 + j];
+                    double const* Ct = &Ct_[bt_index(i + j, m, 0)];
+                    double const* dCt = &dCt_[bt_index(i + j, m, 0)];
+                    double* rij = r + (i * Np1 + j) * Np1;
+                    for (unsigned k = 0; i + j + k <= N_; ++k) {
+                        rij[k] += Ct[k] * v + dCt[k] * vc;
+                    }
+                }
+            }
+        }
+        for (unsigned i = 0; i <= N_; ++i) {
+            for (unsigned j = 0; i + j <= N_; ++j) {
+                for (unsigned k = 0; i + j + k <= N_; ++k) {
+                    coeffs[bf_index(i, j, k)] = r[(i * Np1 + j) * Np1 + k];
+                }
+            }
+        }
+    }
+}
+template <std::size_t D> std::size_t SumFactorization<D>::flops_gradient() const {
+    std::size_t n = n_;
+    std::size_t Np1 = N_ + 1;
+    std::size_t numIJ = binom(N_ + 2, 2);
+    if constexpr (D == 2u) {
+        std::size_t eval = 2 * 2 * numIJ * n + 2 * 2 * Np1 * n * n + 4 * n * n;
+        std::size_t integ = 3 * n * n + 2 * 2 * Np1 * n * n + 2 * 2 * numIJ * n;
+        return eval + integ;
+    } else {
+        std::size_t eval = 2 * 2 * numBF_ * n + 2 * 3 * numIJ * n * n + 2 * 3 * Np1 * n * n * n +
+                           9 * n * n * n;
+        std::size_t integ = 8 * n * n * n + 2 * 3 * Np1 * n * n * n + 2 * 3 * numIJ * n * n +
+                            2 * 2 * numBF_ * n;
+        return eval + integ;
+    }
+}
+
+template class SumFactorization<2u>;
+template class SumFactorization<3u>;
+
+} // namespace tndm
@@ -0,0 +1,116 @@
+#ifndef SUMFACTORIZATION_20261018_H
+#define SUMFACTORIZATION_20261018_H
+
+#include "quadrules/SimplexQuadratureRule.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Sum-factorised evaluation of the modal (Dubiner) basis of ModalRefElement.
+ *
+ * In the collapsed coordinates (a,b) (2D) or (a,b,c) (3D) the Dubiner basis factorises as
+ *
+ * phi_ij(a,b) = A_i(a) B_ij(b), phi_ijk(a,b,c) = A_i(a) B_ij(b) C_{i+j,k}(c).
+ *
+ * On the collapsed tensor-product rule returned by rule() the basis and its gradient are
+ * evaluated and integrated with one-dimensional contractions only, which costs O(N^{D+1})
+ * per element instead of O(N^{2D}) for the dense reference matrices.
+ *
+ * Quadrature point q = k + n * (l + n * m) has collapsed coordinates (a_k, b_l, c_m).
+ * Coefficients are ordered as in ModalRefElement.
+ *
+ * @tparam D Simplex dimension (2 or 3)
+ */
+template <std::size_t D> class SumFactorization {
+public:
+    static_assert(D == 2u || D == 3u);
+
+    /**
+     * @brief Collapsed tensor-product rule on the reference simplex.
+     *
+     * Same points and weights as TensorProductRule but the collapse is towards the last
+     * coordinate, as in the Dubiner basis.
+     */
+    static SimplexQuadratureRule<D> rule(unsigned minQuadOrder);
+
+    /**
+     * @param degree Maximum polynomial degree
+     * @param minQuadOrder Minimum order of rule()
+     */
+    SumFactorization(unsigned degree, unsigned minQuadOrder);
+
+    unsigned degree() const { return N_; }
+    std::size_t numBasisFunctions() const { return numBF_; }
+    std::size_t pointsPerDim() const { return n_; }
+    std::size_t numQuadPoints() const { return numQ_; }
+    /**
+     * @brief Size of scratch memory (number of doubles) required by the operations.
+     */
+    std::size_t scratch_size() const { return scratchSize_; }
+    /**
+     * @brief Scratch size for degree and n points per dimension (e.g. for stack buffers).
+     */
+    static constexpr std::size_t scratch_size(unsigned degree, std::size_t n) {
+        std::size_t Np1 = degree + 1;
+        if constexpr (D == 2u) {
+            return 2 * Np1 * n + std::max(2 * n * n, Np1 * Np1);
+        } else {
+            return 3 * Np1 * n * n + 2 * Np1 * Np1 * n + std::max(3 * n * n * n, Np1 * Np1 * Np1);
+        }
+    }
+
+    /**
+     * @brief values(q) = sum_k phi_k(q) coeffs(k)
+     */
+    void evaluate(double const* coeffs, double* values, double* scratch) const;
+    /**
+     * @brief grad(e,q) = sum_k dphi_k/dxi_e(q) coeffs(k), e fastest
+     */
+    void evaluate_gradient(double const* coeffs, double* grad, double* scratch) const;
+    /**
+     * @brief coeffs(k) = sum_q phi_k(q) values(q)
+     */
+    void integrate(double const* values, double* coeffs, double* scratch) const;
+    /**
+     * @brief coeffs(k) = sum_q sum_e dphi_k/dxi_e(q) grad(e,q), e fastest
+     *
+     * The input is overwritten.
+     */
+    void integrate_gradient(double* grad, double* coeffs, double* scratch) const;
+
+    /**
+     * @brief Number of floating point operations of evaluate_gradient + integrate_gradient.
+     */
+    std::size_t flops_gradient() const;
+
+private:
+    std::size_t a_index(std::size_t i, std::size_t k) const { return i * n_ + k; }
+    std::size_t b_index(std::size_t i, std::size_t j, std::size_t l) const {
+        return (i * (N_ + 1) + j) * n_ + l;
+    }
+    std::size_t bt_index(std::size_t i, std::size_t l, std::size_t j) const {
+        return (i * n_ + l) * (N_ + 1) + j;
+    }
+    std::size_t bf_index(std::size_t i, std::size_t j, std::size_t k = 0) const {
+        return bf_[(i * (N_ + 1) + j) * (D == 3u ? N_ + 1 : 1) + k];
+    }
+
+    unsigned N_;
+    std::size_t n_;
+    std::size_t numBF_;
+    std::size_t numQ_;
+    std::size_t scratchSize_;
+    std::vector<double> a_, b_, c_;
+    std::vector<double> A_, dA_, At_, dAt_;
+    std::vector<double> B_, dB_, Bt_, dBt_;
+    std::vector<double> C_, dC_, Ct_, dCt_;
+    std::vector<std::size_t> bf_;
+};
+
+} // namespace tndm
+
+#endif // SUMFACTORIZATION_20261018_H
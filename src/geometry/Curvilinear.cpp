@@ -6,6 +6,7 @@
 #include "mesh/LocalSimplexMesh.h"
 #include "mesh/MeshData.h"
 #include "tensor/EigenMap.h"
+#include "tensor/FixedTensor.h"
 #include "tensor/Managed.h"
 #include "tensor/Reshape.h"
 #include "util/Math.h"
@@ -195,10 +196,9 @@ template <std::size_t D>
 void Curvilinear<D>::jacobianInv(Tensor<double, 3u> const& jacobian,
                                  Tensor<double, 3u>& result) const {
     for (std::ptrdiff_t i = 0; i < result.shape(2); ++i) {
-        auto jAtP = jacobian.subtensor(slice{}, slice{}, i);
-        auto resAtP = result.subtensor(slice{}, slice{}, i);
-        EigenMap<Matrix<double>, D, D>(resAtP) =
-            EigenMap<const Matrix<double>, D, D>(jAtP).inverse();
+        auto jAtP = fixed_subtensor<D, D>(jacobian, i);
+        auto resAtP = fixed_subtensor<D, D>(result, i);
+        EigenMap(resAtP) = EigenMap(jAtP).inverse();
     }
 }
 
@@ -211,8 +211,8 @@ template <std::size_t D>
 void Curvilinear<D>::detJ(std::size_t eleNo, Tensor<double, 3u> const& jacobian,
                           Tensor<double, 1u>& result) const {
     for (std::ptrdiff_t i = 0; i < result.shape(0); ++i) {
-        auto jAtP = jacobian.subtensor(slice{}, slice{}, i);
-        result(i) = EigenMap<const Matrix<double>, D, D>(jAtP).determinant();
+        auto jAtP = fixed_subtensor<D, D>(jacobian, i);
+        result(i) = EigenMap(jAtP).determinant();
     }
 }
 
@@ -220,8 +220,8 @@ template <std::size_t D>
 void Curvilinear<D>::absDetJ(std::size_t eleNo, Tensor<double, 3u> const& jacobian,
                              Tensor<double, 1u>& result) const {
     for (std::ptrdiff_t i = 0; i < result.shape(0); ++i) {
-        auto jAtP = jacobian.subtensor(slice{}, slice{}, i);
-        result(i) = std::fabs(EigenMap<const Matrix<double>, D, D>(jAtP).determinant());
+        auto jAtP = fixed_subtensor<D, D>(jacobian, i);
+        result(i) = std::fabs(EigenMap(jAtP).determinant());
     }
 }
 
@@ -236,18 +236,16 @@ void Curvilinear<D>::normal(std::size_t faceNo, Tensor<double, 1u> const& detJ,
     assert(faceNo < D + 1u);
     // n_{iq} = |J|_q J^{-T}_{ijq} N_j
     for (std::ptrdiff_t i = 0; i < detJ.shape(0); ++i) {
-        auto jInvAtP = jInv.subtensor(slice{}, slice{}, i);
-        auto res = result.subtensor(slice{}, i);
-        EigenMap<Vector<double>, D>(res) =
-            std::fabs(detJ(i)) * EigenMap<const Matrix<double>, D, D>(jInvAtP).transpose() *
-            refNormals[faceNo];
+        auto jInvAtP = fixed_subtensor<D, D>(jInv, i);
+        auto res = fixed_subtensor<D>(result, i);
+        EigenMap(res) = std::fabs(detJ(i)) * EigenMap(jInvAtP).transpose() * refNormals[faceNo];
     }
 }
 
 template <std::size_t D> void Curvilinear<D>::normalize(Tensor<double, 2u>& normal) const {
     for (std::ptrdiff_t i = 0; i < normal.shape(1); ++i) {
-        auto n = normal.subtensor(slice{}, i);
-        EigenMap<Vector<double>, D>(n).normalize();
+        auto n = fixed_subtensor<D>(normal, i);
+        EigenMap(n).normalize();
     }
 }
 
@@ -264,26 +262,25 @@ void Curvilinear<D>::facetBasis(std::array<double, D> const& up, Matrix<double>
     constexpr double colinear_tol = 10000.0 * std::numeric_limits<double>::epsilon();
 
     for (std::ptrdiff_t i = 0; i < result.shape(2); ++i) {
-        auto n_in = normal.subtensor(slice{}, i);
-        auto n_in_eigen = EigenMap<Vector<double>, D>(n_in);
-        auto n = result.subtensor(slice{}, 0, i);
-        auto n_eigen = EigenMap<Vector<double>, D>(n);
-        n_eigen = n_in_eigen.normalized();
+        auto n_in = fixed_subtensor<D>(normal, i);
+        auto n = fixed_subtensor<D>(result, 0, i);
+        auto n_eigen = EigenMap(n);
+        n_eigen = EigenMap(n_in).normalized();
 
         if constexpr (D == 2u) {
             double s = sgn(up[0] * n(1) - up[1] * n(0));
             if (std::fabs(s) < colinear_tol) {
                 throw std::logic_error("Up vector and normal are almost colinear.");
             }
-            auto d = result.subtensor(slice{}, 1, i);
+            auto d = fixed_subtensor<D>(result, 1, i);
             d(0) = -s * n(1);
             d(1) = s * n(0);
         } else if constexpr (D == 3u) {
             auto u = Eigen::Vector3d(up.data());
-            auto d = result.subtensor(slice{}, 1, i);
-            auto d_eigen = EigenMap<Vector<double>, D>(d);
-            auto s = result.subtensor(slice{}, 2, i);
-            auto s_eigen = EigenMap<Vector<double>, D>(s);
+            auto d = fixed_subtensor<D>(result, 1, i);
+            auto d_eigen = EigenMap(d);
+            auto s = fixed_subtensor<D>(result, 2, i);
+            auto s_eigen = EigenMap(s);
             s_eigen = u.cross(n_eigen).normalized();
             if (s_eigen.norm() < colinear_tol) {
                 throw std::logic_error("Up vector and normal are almost colinear.");
@@ -304,24 +301,23 @@ void Curvilinear<D>::facetBasisFromPlexTangents(std::size_t faceNo,
     auto& f = f2v[faceNo];
     auto refTangent = refVertices[f[1]] - refVertices[f[0]];
     for (std::ptrdiff_t i = 0; i < result.shape(2); ++i) {
-        auto n = normal.subtensor(slice{}, i);
-        auto n_eigen = EigenMap<Vector<double>, D>(n);
-        auto n_res = result.subtensor(slice{}, 0, i);
-        auto n_res_eigen = EigenMap<Vector<double>, D>(n_res);
-        n_res_eigen = n_eigen.normalized();
+        auto n = fixed_subtensor<D>(normal, i);
+        auto n_res = fixed_subtensor<D>(result, 0, i);
+        auto n_res_eigen = EigenMap(n_res);
+        n_res_eigen = EigenMap(n).normalized();
 
         if constexpr (D >= 2u) {
-            auto jAtP = jacobian.subtensor(slice{}, slice{}, i);
-            auto t1_res = result.subtensor(slice{}, 1, i);
-            auto t1_res_eigen = EigenMap<Vector<double>, D>(t1_res);
+            auto jAtP = fixed_subtensor<D, D>(jacobian, i);
+            auto t1_res = fixed_subtensor<D>(result, 1, i);
+            auto t1_res_eigen = EigenMap(t1_res);
             // first tangent = J * refTangent
-            t1_res_eigen = EigenMap<const Matrix<double>, D, D>(jAtP) *
-                           Eigen::Map<Eigen::Matrix<double, D, 1>>(refTangent.data());
+            t1_res_eigen =
+                EigenMap(jAtP) * Eigen::Map<Eigen::Matrix<double, D, 1>>(refTangent.data());
             t1_res_eigen.normalize();
 
             if constexpr (D == 3u) {
-                auto t2_res = result.subtensor(slice{}, 2, i);
-                auto t2_res_eigen = EigenMap<Vector<double>, D>(t2_res);
+                auto t2_res = fixed_subtensor<D>(result, 2, i);
+                auto t2_res_eigen = EigenMap(t2_res);
                 t2_res_eigen = n_res_eigen.cross(t1_res_eigen);
                 t2_res_eigen.normalize();
             }
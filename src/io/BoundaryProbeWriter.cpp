@@ -79,7 +79,7 @@ template <std::size_t D>
 void BoundaryProbeWriter<D>::write(double time,
                                    mneme::span<FiniteElementFunction<D - 1>> functions) const {
     for (auto const& probe : probes_) {
-        if (time <= 0.0) {
+        if (first_write_) {
             out_->open(probe.file_name, false);
             write_header(probe, functions);
         } else {
@@ -98,6 +98,7 @@ void BoundaryProbeWriter<D>::write(double time,
         *out_ << endrow;
         out_->close();
     }
+    first_write_ = false;
 }
 
 template class BoundaryProbeWriter<2u>;
@@ -48,6 +48,8 @@ private:
     std::unique_ptr<TableWriter> out_;
     std::vector<std::size_t> bndNos_;
     std::vector<ProbeMeta> probes_;
+    /// Truncate files and write header in the first write (may be later than time 0)
+    mutable bool first_write_ = true;
 };
 
 } // namespace tndm
@@ -156,7 +156,6 @@ bool GMSHParser::parseElements() {
 
     constexpr std::size_t MaxElementType = sizeof(NumNodes) / sizeof(std::size_t);
     constexpr std::size_t MaxNodes = *std::max_element(NumNodes, NumNodes + MaxElementType);
-    long tag = -1;
     std::array<long, MaxNodes> nodes;
 
     builder->setNumElements(numElements);
@@ -181,6 +180,8 @@ bool GMSHParser::parseElements() {
             return logErrorAnnotated<bool>("Expected number of tags");
         }
         long numTags = lexer.getInteger();
+        long tag = -1;
+        long elementaryTag = -1;
         for (long i = 0; i < numTags; ++i) {
             getNextToken();
             if (curTok != GMSHToken::integer) {
@@ -188,6 +189,8 @@ bool GMSHParser::parseElements() {
             }
             if (i == 0) {
                 tag = lexer.getInteger();
+            } else if (i == 1) {
+                elementaryTag = lexer.getInteger();
             }
         }
 
@@ -202,7 +205,7 @@ bool GMSHParser::parseElements() {
             nodes[i] = lexer.getInteger() - 1;
         }
 
-        builder->addElement(type, tag, nodes.data(), NumNodes[type - 1]);
+        builder->addTaggedElement(type, tag, elementaryTag, nodes.data(), NumNodes[type - 1]);
     }
     getNextToken();
     if (curTok != GMSHToken::end_elements) {
@@ -22,6 +22,17 @@ public:
     virtual void setVertex(long id, std::array<double, 3> const& x) = 0;
     virtual void setNumElements(std::size_t numElements) = 0;
     virtual void addElement(long type, long tag, long* node, std::size_t numNodes) = 0;
+    /**
+     * @brief Called by GMSHParser for every element.
+     *
+     * The first tag of the element is the physical tag, the second tag the elementary tag
+     * (-1 if the element has fewer tags).
+     * The default drops the elementary tag and calls addElement with the physical tag.
+     */
+    virtual void addTaggedElement(long type, long physicalTag, long, long* node,
+                                  std::size_t numNodes) {
+        addElement(type, physicalTag, node, numNodes);
+    }
 };
 
 class GMSHParser {
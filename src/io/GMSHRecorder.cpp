@@ -0,0 +1,73 @@
+#include "GMSHRecorder.h"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace tndm {
+
+void GMSHRecorder::setNumVertices(std::size_t numVertices) {
+    if (next_) {
+        next_->setNumVertices(numVertices);
+    }
+    vertices.resize(numVertices);
+}
+
+void GMSHRecorder::setVertex(long id, std::array<double, 3> const& x) {
+    if (next_) {
+        next_->setVertex(id, x);
+    }
+    vertices[id] = x;
+}
+
+void GMSHRecorder::setNumElements(std::size_t numElements) {
+    if (next_) {
+        next_->setNumElements(numElements);
+    }
+    records.reserve(numElements);
+}
+
+void GMSHRecorder::addElement(long type, long tag, long* node, std::size_t numNodes) {
+    addTaggedElement(type, tag, -1, node, numNodes);
+}
+
+void GMSHRecorder::addTaggedElement(long type, long physicalTag, long elementaryTag, long* node,
+                                    std::size_t numNodes) {
+    if (next_) {
+        next_->addTaggedElement(type, physicalTag, elementaryTag, node, numNodes);
+    }
+    records.push_back({type, physicalTag, elementaryTag, std::vector<long>(node, node + numNodes)});
+}
+
+void GMSHRecorder::write(std::string const& fileName) const {
+    std::ofstream out(fileName);
+    if (!out) {
+        throw std::runtime_error("Could not open " + fileName);
+    }
+    out << "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n";
+    out << "$Nodes\n" << vertices.size() << '\n' << std::setprecision(17);
+    for (std::size_t vNo = 0; vNo < vertices.size(); ++vNo) {
+        auto const& x = vertices[vNo];
+        out << vNo + 1 << ' ' << x[0] << ' ' << x[1] << ' ' << x[2] << '\n';
+    }
+    out << "$EndNodes\n";
+    out << "$Elements\n" << records.size() << '\n';
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        auto const& r = records[i];
+        out << i + 1 << ' ' << r.type;
+        if (r.elementaryTag >= 0) {
+            out << " 2 " << r.physicalTag << ' ' << r.elementaryTag;
+        } else if (r.physicalTag >= 0) {
+            out << " 1 " << r.physicalTag;
+        } else {
+            out << " 0";
+        }
+        for (auto n : r.nodes) {
+            out << ' ' << n + 1;
+        }
+        out << '\n';
+    }
+    out << "$EndElements\n";
+}
+
+} // namespace tndm
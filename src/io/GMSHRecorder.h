@@ -0,0 +1,52 @@
+#ifndef GMSHRECORDER_20261018_H
+#define GMSHRECORDER_20261018_H
+
+#include "io/GMSHParser.h"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Keeps a copy of the raw GMSH data and optionally forwards it to another builder.
+ *
+ * The copy may be modified (e.g. vertices moved) and written back in MSH 2.2 format.
+ */
+class GMSHRecorder : public GMSHMeshBuilder {
+public:
+    struct Record {
+        long type;
+        long physicalTag;
+        long elementaryTag;
+        std::vector<long> nodes;
+    };
+
+    GMSHRecorder(GMSHMeshBuilder* next = nullptr) : next_(next) {}
+
+    void setNumVertices(std::size_t numVertices) override;
+    void setVertex(long id, std::array<double, 3> const& x) override;
+    void setNumElements(std::size_t numElements) override;
+    void addElement(long type, long tag, long* node, std::size_t numNodes) override;
+    void addTaggedElement(long type, long physicalTag, long elementaryTag, long* node,
+                          std::size_t numNodes) override;
+
+    /**
+     * @brief Writes vertices and records in MSH 2.2 ASCII format.
+     *
+     * Negative tags are not written.
+     */
+    void write(std::string const& fileName) const;
+
+    std::vector<std::array<double, 3>> vertices;
+    std::vector<Record> records;
+
+private:
+    GMSHMeshBuilder* next_;
+};
+
+} // namespace tndm
+
+#endif // GMSHRECORDER_20261018_H
@@ -90,6 +90,12 @@ void GlobalSimplexMeshBuilder<D>::addElement(long type, long tag, long* node,
         case static_cast<long>(BC::Natural):
             bc = BC::Natural;
             break;
+        case static_cast<long>(BC::Absorbing):
+            bc = BC::Absorbing;
+            break;
+        case static_cast<long>(BC::Exterior):
+            bc = BC::Exterior;
+            break;
         default:
             ++unknownBC;
             break;
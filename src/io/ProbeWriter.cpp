@@ -77,7 +77,7 @@ void ProbeWriter<D>::write_header(ProbeMeta const& p,
 template <std::size_t D>
 void ProbeWriter<D>::write(double time, mneme::span<FiniteElementFunction<D>> functions) const {
     for (auto const& probe : probes_) {
-        if (time <= 0.0) {
+        if (first_write_) {
             out_->open(probe.file_name, false);
             write_header(probe, functions);
         } else {
@@ -96,6 +96,7 @@ void ProbeWriter<D>::write(double time, mneme::span<FiniteElementFunction<D>> fu
         *out_ << endrow;
         out_->close();
     }
+    first_write_ = false;
 }
 
 template class ProbeWriter<2u>;
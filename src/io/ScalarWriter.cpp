@@ -15,9 +15,10 @@ void ScalarWriter::write_header() const {
 }
 
 void ScalarWriter::write(double time, mneme::span<double> scalars) const {
-    if (time <= 0.0) {
+    if (first_write_) {
         out_->open(file_name_, false);
         write_header();
+        first_write_ = false;
     } else {
         out_->open(file_name_, true);
     }
@@ -30,6 +30,8 @@ private:
     std::string file_name_;
     std::unique_ptr<TableWriter> out_;
     std::vector<std::string> variable_names_;
+    /// Truncate file and write header in the first write (may be later than time 0)
+    mutable bool first_write_ = true;
 };
 
 } // namespace tndm
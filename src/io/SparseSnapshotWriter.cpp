@@ -0,0 +1,102 @@
+#include "SparseSnapshotWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace tndm {
+
+SparseSnapshotWriter::SparseSnapshotWriter(std::string const& file_name,
+                                           std::vector<std::string> const& names,
+                                           std::vector<uint64_t> const& ids,
+                                           std::size_t num_points, std::size_t point_dim,
+                                           std::vector<double> const& coords,
+                                           std::vector<Criterion> criteria,
+                                           std::size_t keyframe_interval)
+    : out_(file_name, std::ios::binary | std::ios::trunc), num_blocks_(ids.size()),
+      num_points_(num_points), num_quantities_(names.size()), criteria_(std::move(criteria)),
+      keyframe_interval_(std::max(std::size_t(1), keyframe_interval)),
+      last_(num_blocks_ * num_points_ * num_quantities_), active_(num_blocks_) {
+    if (!out_) {
+        throw std::runtime_error("Could not open " + file_name);
+    }
+    if (coords.size() != num_blocks_ * num_points_ * point_dim) {
+        throw std::runtime_error("Coordinate array of " + file_name + " has wrong size");
+    }
+    for (auto const& c : criteria_) {
+        if (c.quantity >= num_quantities_) {
+            throw std::runtime_error("Activity criterion refers to unknown quantity");
+        }
+    }
+
+    char const magic[8] = {'T', 'N', 'D', 'M', 'S', 'F', 'O', '\0'};
+    put(magic, 8);
+    uint32_t header32[] = {Version, static_cast<uint32_t>(point_dim)};
+    put(header32, 2);
+    uint64_t header64[] = {num_blocks_, num_points_, num_quantities_};
+    put(header64, 3);
+    for (auto const& name : names) {
+        uint32_t len = name.size();
+        put(&len, 1);
+        put(name.data(), len);
+    }
+    put(ids.data(), ids.size());
+    put(coords.data(), coords.size());
+    out_.flush();
+}
+
+template <typename T> void SparseSnapshotWriter::put(T const* data, std::size_t count) {
+    std::size_t bytes = count * sizeof(T);
+    out_.write(reinterpret_cast<char const*>(data), bytes);
+    bytes_written_ += bytes;
+}
+
+bool SparseSnapshotWriter::is_active(std::size_t block, Tensor<double, 3u> const& values) const {
+    double const* last = &last_[block * num_points_ * num_quantities_];
+    for (auto const& c : criteria_) {
+        for (std::size_t i = 0; i < num_points_; ++i) {
+            double delta = values(i, c.quantity, block) - last[i + c.quantity * num_points_];
+            if (std::fabs(delta) > c.threshold) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::size_t SparseSnapshotWriter::write(double time, Tensor<double, 3u> const& values) {
+    if (values.shape(0) != num_points_ || values.shape(1) != num_quantities_ ||
+        values.shape(2) != num_blocks_) {
+        throw std::runtime_error("Snapshot shape does not match header");
+    }
+
+    uint8_t keyframe = num_snapshots_ % keyframe_interval_ == 0;
+    active_.clear();
+    for (std::size_t b = 0; b < num_blocks_; ++b) {
+        if (keyframe || is_active(b, values)) {
+            active_.emplace_back(b);
+        }
+    }
+
+    uint64_t count = active_.size();
+    put(&time, 1);
+    put(&keyframe, 1);
+    put(&count, 1);
+    put(active_.data(), active_.size());
+    std::size_t block_size = num_points_ * num_quantities_;
+    for (auto const& b : active_) {
+        double const* block = &values(0, 0, b);
+        put(block, block_size);
+        std::copy(block, block + block_size, &last_[b * block_size]);
+    }
+    out_.flush();
+    if (!out_) {
+        throw std::runtime_error("Could not write sparse snapshot");
+    }
+
+    ++num_snapshots_;
+    return count;
+}
+
+} // namespace tndm
@@ -0,0 +1,87 @@
+#ifndef SPARSESNAPSHOTWRITER_20261018_H
+#define SPARSESNAPSHOTWRITER_20261018_H
+
+#include "tensor/Tensor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Writes a time series of blocked point data, where each snapshot only contains the
+ * blocks that changed noticeably since they were written the last time.
+ *
+ * A block (e.g. a fault facet) consists of num_points x num_quantities values.
+ * A block is active if for any criterion max_i |v(i, q) - v_last(i, q)| > threshold, where
+ * v_last are the values of the block in the file.
+ * Every keyframe_interval-th snapshot (and the first) is a keyframe containing all blocks.
+ *
+ * Binary layout (native endianness):
+ *  - Header: "TNDMSFO\0", uint32 version, uint32 point_dim, uint64 num_blocks,
+ *    uint64 num_points, uint64 num_quantities, names (uint32 length + characters),
+ *    uint64 block ids[num_blocks], double coords[num_blocks][num_points][point_dim]
+ *  - Snapshots: double time, uint8 keyframe, uint64 count, uint64 block indices[count],
+ *    double values[count][num_quantities][num_points]
+ */
+class SparseSnapshotWriter {
+public:
+    constexpr static uint32_t Version = 1;
+
+    struct Criterion {
+        std::size_t quantity;
+        double threshold;
+    };
+
+    /**
+     * @param file_name Output file
+     * @param names Quantity names
+     * @param ids Global identifier of every block
+     * @param num_points Number of points per block
+     * @param point_dim Dimension of coordinates
+     * @param coords Coordinates with layout [num_blocks][num_points][point_dim]
+     * @param criteria Activity criteria
+     * @param keyframe_interval Every keyframe_interval-th snapshot contains all blocks
+     */
+    SparseSnapshotWriter(std::string const& file_name, std::vector<std::string> const& names,
+                         std::vector<uint64_t> const& ids, std::size_t num_points,
+                         std::size_t point_dim, std::vector<double> const& coords,
+                         std::vector<Criterion> criteria, std::size_t keyframe_interval);
+
+    /**
+     * @brief Appends a snapshot.
+     *
+     * @param time Simulation time
+     * @param values Tensor of shape num_points x num_quantities x num_blocks
+     *
+     * @return Number of blocks written
+     */
+    std::size_t write(double time, Tensor<double, 3u> const& values);
+
+    inline std::size_t num_blocks() const { return num_blocks_; }
+    inline std::size_t num_snapshots() const { return num_snapshots_; }
+    inline uint64_t bytes_written() const { return bytes_written_; }
+
+private:
+    template <typename T> void put(T const* data, std::size_t count);
+    bool is_active(std::size_t block, Tensor<double, 3u> const& values) const;
+
+    std::ofstream out_;
+    std::size_t num_blocks_;
+    std::size_t num_points_;
+    std::size_t num_quantities_;
+    std::vector<Criterion> criteria_;
+    std::size_t keyframe_interval_;
+
+    std::vector<double> last_;
+    std::vector<uint64_t> active_;
+    std::size_t num_snapshots_ = 0;
+    uint64_t bytes_written_ = 0;
+};
+
+} // namespace tndm
+
+#endif // SPARSESNAPSHOTWRITER_20261018_H
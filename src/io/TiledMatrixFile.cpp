@@ -0,0 +1,203 @@
+#include "TiledMatrixFile.h"
+
+#include <Eigen/Core>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utility>
+
+namespace tndm {
+
+namespace {
+[[noreturn]] void throw_errno(std::string const& what, std::string const& file_name) {
+    throw std::runtime_error(what + " " + file_name + ": " + std::strerror(errno));
+}
+} // namespace
+
+TiledMatrixFile::TiledMatrixFile(std::string file_name, std::size_t rows, std::size_t cols,
+                                 std::size_t tile_cols)
+    : file_name_(std::move(file_name)), rows_(rows), cols_(cols),
+      tile_cols_(std::max(std::size_t(1), std::min(tile_cols, cols))) {
+    num_tiles_ = (cols_ + tile_cols_ - 1) / tile_cols_;
+
+    fd_ = open(file_name_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd_ < 0) {
+        throw_errno("Could not open", file_name_);
+    }
+    if (ftruncate(fd_, bytes()) != 0) {
+        throw_errno("Could not allocate", file_name_);
+    }
+    for (auto& buffer : buffers_) {
+        buffer.resize(rows_ * tile_cols_);
+    }
+}
+
+TiledMatrixFile::~TiledMatrixFile() {
+    for (auto& p : pending_) {
+        if (p.valid()) {
+            try {
+                p.get();
+            } catch (...) {
+            }
+        }
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        unlink(file_name_.c_str());
+    }
+}
+
+void TiledMatrixFile::write_column(std::size_t j, double const* values) {
+    for (std::size_t buf = 0; buf < pending_.size(); ++buf) {
+        wait(buf);
+    }
+    first_tile_prefetched_ = false;
+    resident_ = false;
+
+    auto const* data = reinterpret_cast<char const*>(values);
+    std::size_t size = rows_ * sizeof(double);
+    off_t offset = j * size;
+    while (size > 0) {
+        ssize_t written = pwrite(fd_, data, size, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("Could not write to", file_name_);
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+void TiledMatrixFile::read_columns(std::size_t begin, std::size_t ncols, double* buffer) const {
+    auto* data = reinterpret_cast<char*>(buffer);
+    std::size_t size = rows_ * ncols * sizeof(double);
+    off_t offset = begin * rows_ * sizeof(double);
+    while (size > 0) {
+        ssize_t nread = pread(fd_, data, size, offset);
+        if (nread < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("Could not read from", file_name_);
+        }
+        if (nread == 0) {
+            throw std::runtime_error("Unexpected end of file in " + file_name_);
+        }
+        data += nread;
+        size -= nread;
+        offset += nread;
+    }
+}
+
+void TiledMatrixFile::read_tile(std::size_t tile, double* buffer) const {
+    read_columns(tile_begin(tile), tile_end(tile) - tile_begin(tile), buffer);
+}
+
+void TiledMatrixFile::prefetch(std::size_t tile, std::size_t buf) {
+    double* buffer = buffers_[buf].data();
+    bytes_read_ += rows_ * (tile_end(tile) - tile_begin(tile)) * sizeof(double);
+    pending_[buf] =
+        std::async(std::launch::async, [this, tile, buffer]() { read_tile(tile, buffer); });
+}
+
+void TiledMatrixFile::wait(std::size_t buf) {
+    if (pending_[buf].valid()) {
+        pending_[buf].get();
+    }
+}
+
+void TiledMatrixFile::mult(double const* x, double* y) {
+    using Eigen::Map;
+    using Eigen::MatrixXd;
+    using Eigen::VectorXd;
+
+    auto y_map = Map<VectorXd>(y, rows_);
+    y_map.setZero();
+
+    auto mult_tile = [&](std::size_t tile, std::size_t buf) {
+        std::size_t begin = tile_begin(tile);
+        std::size_t ncols = tile_end(tile) - begin;
+        auto A = Map<MatrixXd const>(buffers_[buf].data(), rows_, ncols);
+        auto x_map = Map<VectorXd const>(x + begin, ncols);
+        y_map.noalias() += A * x_map;
+    };
+
+    if (num_tiles_ == 0) {
+        return;
+    }
+
+    // Everything fits into one buffer, hence we keep it in memory
+    if (num_tiles_ == 1) {
+        if (!resident_) {
+            prefetch(0, 0);
+            wait(0);
+            resident_ = true;
+        }
+        mult_tile(0, 0);
+        return;
+    }
+
+    if (!first_tile_prefetched_) {
+        prefetch(0, 0);
+    }
+    for (std::size_t tile = 0; tile < num_tiles_; ++tile) {
+        std::size_t buf = tile % 2;
+        wait(buf);
+        if (tile + 1 < num_tiles_) {
+            prefetch(tile + 1, (tile + 1) % 2);
+        }
+        mult_tile(tile, buf);
+    }
+    prefetch(0, 0);
+    first_tile_prefetched_ = true;
+}
+
+void TiledMatrixFile::mult_add_columns(std::size_t n, std::size_t const* cols, double const* x,
+                                       double* y) {
+    using Eigen::Map;
+    using Eigen::MatrixXd;
+    using Eigen::VectorXd;
+
+    if (n == 0) {
+        return;
+    }
+    auto y_map = Map<VectorXd>(y, rows_);
+
+    if (num_tiles_ == 1) {
+        if (!resident_) {
+            prefetch(0, 0);
+            wait(0);
+            resident_ = true;
+        }
+        auto A = Map<MatrixXd const>(buffers_[0].data(), rows_, cols_);
+        for (std::size_t k = 0; k < n; ++k) {
+            y_map.noalias() += A.col(cols[k]) * x[k];
+        }
+        return;
+    }
+
+    // The first panel might be in flight in buffer 0, therefore we only use buffer 1
+    wait(1);
+    double* buffer = buffers_[1].data();
+    for (std::size_t k = 0; k < n;) {
+        std::size_t run = 1;
+        while (k + run < n && run < tile_cols_ && cols[k + run] == cols[k] + run) {
+            ++run;
+        }
+        read_columns(cols[k], run, buffer);
+        bytes_read_ += rows_ * run * sizeof(double);
+        auto A = Map<MatrixXd const>(buffer, rows_, run);
+        auto x_map = Map<VectorXd const>(x + k, run);
+        y_map.noalias() += A * x_map;
+        k += run;
+    }
+}
+
+} // namespace tndm
@@ -0,0 +1,108 @@
+#ifndef TILEDMATRIXFILE_20261018_H
+#define TILEDMATRIXFILE_20261018_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Dense rows x cols matrix kept in a binary file instead of main memory.
+ *
+ * The matrix is stored column-major and split into panels of tile_cols columns, such that
+ * a panel is one contiguous chunk of the file.
+ * Matrix-vector products stream the panels through two buffers; the read of the next panel
+ * is issued asynchronously while the current panel is multiplied.
+ * After a product the first panel is prefetched such that reading overlaps with whatever the
+ * caller does until the next product.
+ *
+ * The file is removed when the object is destroyed.
+ */
+class TiledMatrixFile {
+public:
+    TiledMatrixFile(std::string file_name, std::size_t rows, std::size_t cols,
+                    std::size_t tile_cols);
+    ~TiledMatrixFile();
+
+    TiledMatrixFile(TiledMatrixFile const&) = delete;
+    TiledMatrixFile& operator=(TiledMatrixFile const&) = delete;
+
+    /**
+     * @brief Writes column j.
+     *
+     * @param j Column index
+     * @param values Array of length rows()
+     */
+    void write_column(std::size_t j, double const* values);
+
+    /**
+     * @brief Computes y = A x.
+     *
+     * @param x Array of length cols()
+     * @param y Array of length rows()
+     */
+    void mult(double const* x, double* y);
+
+    /**
+     * @brief Computes y += sum_k A(:, cols[k]) x[k].
+     *
+     * Only the requested columns are read from storage; runs of consecutive columns are read
+     * at once.
+     *
+     * @param n Number of columns
+     * @param cols Ascending column indices of length n
+     * @param x Array of length n
+     * @param y Array of length rows()
+     */
+    void mult_add_columns(std::size_t n, std::size_t const* cols, double const* x, double* y);
+
+    inline std::size_t rows() const { return rows_; }
+    inline std::size_t cols() const { return cols_; }
+    inline std::size_t num_tiles() const { return num_tiles_; }
+    inline std::string const& file_name() const { return file_name_; }
+
+    /**
+     * @brief Size of the matrix in bytes.
+     */
+    inline uint64_t bytes() const { return rows_ * cols_ * sizeof(double); }
+    /**
+     * @brief Total number of bytes requested from storage so far.
+     *
+     * Asynchronous reads are counted when they are issued. A single resident panel is only
+     * counted once.
+     */
+    inline uint64_t bytes_read() const { return bytes_read_; }
+
+private:
+    inline std::size_t tile_begin(std::size_t tile) const { return tile * tile_cols_; }
+    inline std::size_t tile_end(std::size_t tile) const {
+        return std::min(cols_, (tile + 1) * tile_cols_);
+    }
+
+    void read_columns(std::size_t begin, std::size_t ncols, double* buffer) const;
+    void read_tile(std::size_t tile, double* buffer) const;
+    void prefetch(std::size_t tile, std::size_t buf);
+    void wait(std::size_t buf);
+
+    std::string file_name_;
+    int fd_ = -1;
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t tile_cols_;
+    std::size_t num_tiles_;
+
+    std::array<std::vector<double>, 2> buffers_;
+    std::array<std::future<void>, 2> pending_;
+    uint64_t bytes_read_ = 0;
+    bool first_tile_prefetched_ = false;
+    bool resident_ = false;
+};
+
+} // namespace tndm
+
+#endif // TILEDMATRIXFILE_20261018_H
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <utility>
 
 namespace tndm {
@@ -51,6 +52,87 @@ std::array<GenMesh<3>::simplex_t, 5> GenMesh<3>::tessellate(std::array<uint64_t,
     return result;
 }
 
+template <std::size_t D>
+auto GenMesh<D>::faultExtents(std::array<std::vector<double>, D> const& points,
+                              std::array<bc_fun_t, D> const& BCs)
+    -> std::array<std::vector<interval_t>, D> {
+    std::array<std::vector<interval_t>, D> extents;
+    for (std::size_t d = 0; d < D; ++d) {
+        std::array<std::size_t, D - 1u> other;
+        std::array<std::size_t, D - 1u> numRegions;
+        std::size_t numRegionsTotal = 1;
+        for (std::size_t i = 0, j = 0; i < D; ++i) {
+            if (i != d) {
+                other[j] = i;
+                numRegions[j] = points[i].size() - 1u;
+                numRegionsTotal *= numRegions[j++];
+            }
+        }
+        for (std::size_t plane = 0; plane < points[d].size(); ++plane) {
+            for (std::size_t r = 0; r < numRegionsTotal; ++r) {
+                std::array<std::size_t, D - 1u> region;
+                for (std::size_t j = 0, rr = r; j < D - 1u; ++j) {
+                    region[j] = rr % numRegions[j];
+                    rr /= numRegions[j];
+                }
+                if (BCs[d](plane, region) != BC::Fault) {
+                    continue;
+                }
+                extents[d].emplace_back(points[d][plane], points[d][plane]);
+                for (std::size_t j = 0; j < D - 1u; ++j) {
+                    auto const& p = points[other[j]];
+                    extents[other[j]].emplace_back(p[region[j]], p[region[j] + 1]);
+                }
+            }
+        }
+    }
+    return extents;
+}
+
+template <std::size_t D>
+std::vector<double> GenMesh<D>::gradedPoints(double a, double b,
+                                             std::vector<interval_t> const& refined,
+                                             double h_min, double h_max, double growth) {
+    assert(b > a && h_min > 0.0 && h_max >= h_min && growth >= 1.0);
+    auto const h = [&](double x) {
+        double dist = std::numeric_limits<double>::max();
+        for (auto const& [lo, hi] : refined) {
+            dist = std::min(dist, std::max({0.0, lo - x, x - hi}));
+        }
+        if (refined.empty()) {
+            return h_max;
+        }
+        return std::min(h_max, h_min + (growth - 1.0) * dist);
+    };
+
+    // Number of elements up to x is given by int_a^x 1/h(y) dy; integrated with the
+    // trapezoidal rule on a grid much finer than h_min
+    std::size_t num_samples = std::max(16.0, std::ceil(16.0 * (b - a) / h_min));
+    double dx = (b - a) / num_samples;
+    auto count = std::vector<double>(num_samples + 1);
+    count[0] = 0.0;
+    for (std::size_t i = 1; i <= num_samples; ++i) {
+        double x0 = a + (i - 1) * dx;
+        count[i] = count[i - 1] + 0.5 * dx * (1.0 / h(x0) + 1.0 / h(x0 + dx));
+    }
+    std::size_t n = std::max(1l, std::lround(count.back()));
+
+    // Invert count with linear interpolation
+    auto x = std::vector<double>(n + 1);
+    x[0] = a;
+    std::size_t i = 1;
+    for (std::size_t k = 1; k < n; ++k) {
+        double target = k * count.back() / n;
+        while (count[i] < target) {
+            ++i;
+        }
+        double theta = (target - count[i - 1]) / (count[i] - count[i - 1]);
+        x[k] = a + (i - 1 + theta) * dx;
+    }
+    x[n] = b;
+    return x;
+}
+
 template <std::size_t D>
 std::unique_ptr<typename GenMesh<D>::mesh_t> GenMesh<D>::uniformMesh() const {
     int rank, size;
@@ -73,10 +155,7 @@ std::unique_ptr<typename GenMesh<D>::mesh_t> GenMesh<D>::uniformMesh() const {
     auto vertex_pos = [&](std::array<uint64_t, D> const& v) {
         vertex_t vert;
         for (std::size_t d = 0; d < D; ++d) {
-            std::size_t region = findRegion(d, v);
-            double h = (points_[d][region + 1] - points_[d][region]) /
-                       (regions_[d][region + 1] - regions_[d][region]);
-            vert[d] = points_[d][region] + static_cast<double>(v[d] - regions_[d][region]) * h;
+            vert[d] = coords_[d][v[d]];
         }
         return vert;
     };
@@ -157,9 +157,84 @@ public:
     }
 
     /**
-     * @brief Uniform SimplexMesh generation in D dimensions.
+     * @brief Generate cuboidal mesh with corner points, graded towards faults.
      *
-     * @param transform Function that maps from the unit square or cube to another domain.
+     * As the constructor above, but the grid is refined towards the faults, i.e. the planes and
+     * regions with BC::Fault. The grid spacing in direction d is
+     *
+     * h_d(x) = min(h[d], h_fault + (growth - 1) * dist(x, F_d)),
+     *
+     * where F_d is the extent of the faults in direction d (see faultExtents), such that
+     * neighbouring intervals differ by about the factor growth.
+     * Elements on a fault therefore have size h_fault in every direction. As the grid is a
+     * tensor product, the refinement normal to a fault continues along the whole plane outside
+     * of the fault region, whereas the tangential refinement is limited to the fault region.
+     * The corner points are kept as grid points.
+     *
+     * @param points mesh corner points per dimension (provide at least 2 points per dimension)
+     * @param h maximum resolution away from faults
+     * @param BCs boundary condition at mesh corner point
+     * @param h_fault resolution on faults
+     * @param growth ratio of adjacent interval lengths (>= 1)
+     * @param comm MPI communicator
+     */
+    GenMesh(std::array<std::vector<double>, D> const& points, std::array<double, D> const& h,
+            std::array<bc_fun_t, D> BCs, double h_fault, double growth,
+            MPI_Comm comm = MPI_COMM_WORLD)
+        : points_(points), bcs_(BCs), comm_(comm) {
+        auto const faults = faultExtents(points_, bcs_);
+        for (std::size_t d = 0; d < D; ++d) {
+            assert(points_[d].size() >= 2);
+            N[d] = 0;
+            regions_[d].resize(points_[d].size());
+            regions_[d][0] = 0;
+            coords_[d] = std::vector<double>{points_[d][0]};
+            for (std::size_t p = 0; p < points_[d].size() - 1u; ++p) {
+                auto x = gradedPoints(points_[d][p], points_[d][p + 1], faults[d], h_fault, h[d],
+                                      growth);
+                coords_[d].insert(coords_[d].end(), x.begin() + 1, x.end());
+                N[d] += x.size() - 1u;
+                regions_[d][p + 1] = N[d];
+            }
+        }
+        init();
+    }
+
+    using interval_t = std::pair<double, double>;
+
+    /**
+     * @brief Extents of the faults per dimension.
+     *
+     * The fault plane x_d = points[d][plane] in the region r contributes the interval
+     * [points[d][plane], points[d][plane]] in direction d and the interval
+     * [points[i][r_i], points[i][r_i + 1]] in every other direction i.
+     *
+     * @param points mesh corner points per dimension
+     * @param BCs boundary condition at mesh corner point
+     *
+     * @return Closed intervals per dimension
+     */
+    static std::array<std::vector<interval_t>, D>
+    faultExtents(std::array<std::vector<double>, D> const& points,
+                 std::array<bc_fun_t, D> const& BCs);
+
+    /**
+     * @brief Grid points in the interval [a, b] for the spacing
+     * h(x) = min(h_max, h_min + (growth - 1) * dist(x, refined)).
+     *
+     * @param refined Intervals with spacing h_min
+     *
+     * @return Grid points including a and b
+     */
+    static std::vector<double> gradedPoints(double a, double b,
+                                            std::vector<interval_t> const& refined, double h_min,
+                                            double h_max, double growth);
+
+    /**
+     * @brief SimplexMesh generation in D dimensions.
+     *
+     * The mesh is uniform within each region unless the mesh is graded.
+     * Every rank only generates its own share of vertices and elements.
      *
      * @return Mesh of D-simplices and boundary mesh of (D-1)-simplices
      */
@@ -172,6 +247,18 @@ private:
         // vertices live on grid with size (N_1+1) x ... x (N_d+1)
         for (std::size_t d = 0; d < D; ++d) {
             Np1[d] = N[d] + 1;
+            if (coords_[d].empty()) {
+                coords_[d].resize(Np1[d]);
+                coords_[d][0] = points_[d][0];
+                for (std::size_t region = 0; region < regions_[d].size() - 1u; ++region) {
+                    double h = (points_[d][region + 1] - points_[d][region]) /
+                               (regions_[d][region + 1] - regions_[d][region]);
+                    for (uint64_t v = regions_[d][region] + 1; v <= regions_[d][region + 1]; ++v) {
+                        coords_[d][v] = points_[d][region] +
+                                        static_cast<double>(v - regions_[d][region]) * h;
+                    }
+                }
+            }
         }
     }
 
@@ -190,6 +277,7 @@ private:
     MPI_Comm comm_;
     std::array<uint64_t, D> Np1;
     std::array<std::vector<uint64_t>, D> regions_;
+    std::array<std::vector<double>, D> coords_;
 };
 
 } // namespace tndm
@@ -28,6 +28,13 @@ template <std::size_t D> void GlobalSimplexMesh<D>::repartitionByHash() {
     isPartitionedByHash = true;
 }
 
+template <std::size_t D> void GlobalSimplexMesh<D>::moveToRank(int newRank) {
+    auto partition = std::vector<idx_t>(numElements(), newRank);
+
+    doPartition(partition);
+    isPartitionedByHash = false;
+}
+
 template <std::size_t D>
 void GlobalSimplexMesh<D>::doPartition(std::vector<idx_t> const& partition) {
     int procs, rank;
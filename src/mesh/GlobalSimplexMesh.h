@@ -117,6 +117,16 @@ public:
      */
     void repartitionByHash();
 
+    /**
+     * @brief Moves all local elements to another rank.
+     *
+     * Used to permute partitions among ranks after repartition(), e.g. with RankPlacement.
+     * The mapping from rank to newRank must be a permutation.
+     *
+     * @param newRank Rank which shall own the local elements
+     */
+    void moveToRank(int newRank);
+
     /**
      * @brief Local mesh construction with ghost entities.
      *
@@ -3,6 +3,7 @@
 
 #include "MeshData.h"
 #include "Simplex.h"
+#include "util/LocalIndex.h"
 #include "util/Range.h"
 
 #include "mneme/displacements.hpp"
@@ -22,7 +23,7 @@ namespace tndm {
 
 template <std::size_t D> class LocalFaces {
 public:
-    using g2l_t = std::unordered_map<Simplex<D>, std::size_t, SimplexHash<D>>;
+    using g2l_t = std::unordered_map<Simplex<D>, local_index_t, SimplexHash<D>>;
     using l2cg_t = std::vector<std::size_t>;
 
     LocalFaces() : localSize_(0) {}
@@ -110,7 +111,7 @@ private:
 
     void makeG2LMap() {
         g2l_.clear();
-        std::size_t local = 0;
+        local_index_t local = 0;
         for (auto& f : faces_) {
             g2l_[f] = local++;
         }
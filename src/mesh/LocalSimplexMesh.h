@@ -4,6 +4,7 @@
 #include "LocalFaces.h"
 #include "MeshData.h"
 #include "Simplex.h"
+#include "util/LocalIndex.h"
 #include "util/Utility.h"
 
 #include <array>
@@ -46,7 +47,7 @@ public:
 
     template <std::size_t Dto, std::size_t Dfrom> auto downward(Simplex<Dfrom> const& face) const {
         auto down = face.template downward<Dto>();
-        std::array<std::size_t, down.size()> lids;
+        std::array<local_index_t, down.size()> lids;
         auto it = lids.begin();
         auto& map = faces<Dto>().g2l();
         for (auto& d : down) {
@@ -66,7 +67,7 @@ public:
     }
 
 private:
-    using upward_map_t = std::vector<std::vector<std::size_t>>;
+    using upward_map_t = std::vector<std::vector<local_index_t>>;
 
     template <std::size_t DD> void makeUpwardMap() {
         auto& map = upwardMaps[DD];
@@ -75,7 +76,7 @@ private:
         auto& g2lUp = faces<DD + 1>().g2l();
         auto& g2lDown = faces<DD>().g2l();
         for (auto& f : faces<DD + 1>()) {
-            std::size_t uLid = g2lUp.at(f);
+            local_index_t uLid = g2lUp.at(f);
             for (auto& d : f.downward()) {
                 map[g2lDown.at(d)].push_back(uLid);
             }
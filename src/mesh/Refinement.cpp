@@ -0,0 +1,364 @@
+#include "Refinement.h"
+#include "mesh/MeshData.h"
+#include "parallel/CommPattern.h"
+#include "parallel/MPITraits.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace tndm {
+
+template <std::size_t D>
+BisectionRefinement<D>::BisectionRefinement(std::vector<vertex_t> vertices,
+                                            std::vector<simplex_t> elements,
+                                            std::vector<facet_t> facets, std::vector<BC> bcs)
+    : vertices_(std::move(vertices)), elements_(std::move(elements)), facets_(std::move(facets)),
+      bcs_(std::move(bcs)) {
+    if (facets_.size() != bcs_.size()) {
+        throw std::runtime_error("Number of boundary facets and boundary conditions differ.");
+    }
+    elementAlive_.resize(elements_.size(), true);
+    facetAlive_.resize(facets_.size(), true);
+    compact();
+}
+
+template <std::size_t D>
+void BisectionRefinement<D>::refine(std::vector<std::size_t> const& marked) {
+    for (auto elNo : marked) {
+        assert(elNo < elementAlive_.size());
+        // The element might already have been bisected as part of a neighbour's refinement
+        if (elementAlive_[elNo]) {
+            refineElement(elNo);
+        }
+    }
+    compact();
+}
+
+template <std::size_t D> void BisectionRefinement<D>::refineAll() {
+    auto all = std::vector<std::size_t>(numElements());
+    std::iota(all.begin(), all.end(), std::size_t(0));
+    refine(all);
+}
+
+template <std::size_t D> double BisectionRefinement<D>::length2(edge_t const& edge) const {
+    auto const& a = vertices_[edge[0]];
+    auto const& b = vertices_[edge[1]];
+    double l2 = 0.0;
+    for (std::size_t d = 0; d < D; ++d) {
+        l2 += (b[d] - a[d]) * (b[d] - a[d]);
+    }
+    return l2;
+}
+
+template <std::size_t D>
+bool BisectionRefinement<D>::isLonger(edge_t const& a, edge_t const& b) const {
+    auto la = length2(a);
+    auto lb = length2(b);
+    return la > lb || (la == lb && a < b);
+}
+
+template <std::size_t D>
+auto BisectionRefinement<D>::longestEdge(std::size_t elNo) const -> edge_t {
+    auto es = edges(elements_[elNo]);
+    return *std::max_element(es.begin(), es.end(), [this](edge_t const& a, edge_t const& b) {
+        return isLonger(b, a);
+    });
+}
+
+template <std::size_t D> void BisectionRefinement<D>::refineElement(std::size_t elNo) {
+    while (elementAlive_[elNo]) {
+        auto edge = longestEdge(elNo);
+        auto neighbours = edge2elems_.at(edge);
+        bool compatible = true;
+        for (auto nbNo : neighbours) {
+            if (nbNo != elNo && longestEdge(nbNo) != edge) {
+                // The neighbour's longest edge is strictly longer, hence the recursion terminates
+                refineElement(nbNo);
+                compatible = false;
+                break;
+            }
+        }
+        if (compatible) {
+            bisect(edge);
+        }
+    }
+}
+
+template <std::size_t D> void BisectionRefinement<D>::bisect(edge_t const& edge) {
+    auto const& a = vertices_[edge[0]];
+    auto const& b = vertices_[edge[1]];
+    vertex_t midpoint;
+    for (std::size_t d = 0; d < D; ++d) {
+        midpoint[d] = 0.5 * (a[d] + b[d]);
+    }
+    uint64_t m = vertices_.size();
+    vertices_.emplace_back(midpoint);
+
+    auto elems = edge2elems_.at(edge);
+    for (auto elNo : elems) {
+        auto elem = elements_[elNo];
+        removeElement(elNo);
+        addElement(replace(elem, edge[0], m));
+        addElement(replace(elem, edge[1], m));
+    }
+
+    auto it = edge2facets_.find(edge);
+    if (it != edge2facets_.end()) {
+        auto fcts = it->second;
+        for (auto fctNo : fcts) {
+            auto fct = facets_[fctNo];
+            auto bc = bcs_[fctNo];
+            removeFacet(fctNo);
+            addFacet(replace(fct, edge[0], m), bc);
+            addFacet(replace(fct, edge[1], m), bc);
+        }
+    }
+    assert(edge2elems_.find(edge) == edge2elems_.end());
+    assert(edge2facets_.find(edge) == edge2facets_.end());
+}
+
+template <std::size_t D> void BisectionRefinement<D>::addElement(simplex_t const& elem) {
+    std::size_t elNo = elements_.size();
+    elements_.emplace_back(elem);
+    elementAlive_.emplace_back(true);
+    for (auto const& e : edges(elem)) {
+        edge2elems_[e].emplace_back(elNo);
+    }
+}
+
+template <std::size_t D> void BisectionRefinement<D>::removeElement(std::size_t elNo) {
+    elementAlive_[elNo] = false;
+    for (auto const& e : edges(elements_[elNo])) {
+        auto it = edge2elems_.find(e);
+        assert(it != edge2elems_.end());
+        auto& list = it->second;
+        list.erase(std::remove(list.begin(), list.end(), elNo), list.end());
+        if (list.empty()) {
+            edge2elems_.erase(it);
+        }
+    }
+}
+
+template <std::size_t D> void BisectionRefinement<D>::addFacet(facet_t const& fct, BC bc) {
+    std::size_t fctNo = facets_.size();
+    facets_.emplace_back(fct);
+    bcs_.emplace_back(bc);
+    facetAlive_.emplace_back(true);
+    for (auto const& e : edges(fct)) {
+        edge2facets_[e].emplace_back(fctNo);
+    }
+}
+
+template <std::size_t D> void BisectionRefinement<D>::removeFacet(std::size_t fctNo) {
+    facetAlive_[fctNo] = false;
+    for (auto const& e : edges(facets_[fctNo])) {
+        auto it = edge2facets_.find(e);
+        assert(it != edge2facets_.end());
+        auto& list = it->second;
+        list.erase(std::remove(list.begin(), list.end(), fctNo), list.end());
+        if (list.empty()) {
+            edge2facets_.erase(it);
+        }
+    }
+}
+
+template <std::size_t D> void BisectionRefinement<D>::compact() {
+    auto elements = std::move(elements_);
+    auto facets = std::move(facets_);
+    auto bcs = std::move(bcs_);
+    auto elementAlive = std::move(elementAlive_);
+    auto facetAlive = std::move(facetAlive_);
+    elements_.clear();
+    facets_.clear();
+    bcs_.clear();
+    elementAlive_.clear();
+    facetAlive_.clear();
+    edge2elems_.clear();
+    edge2facets_.clear();
+
+    for (std::size_t elNo = 0; elNo < elements.size(); ++elNo) {
+        if (elementAlive[elNo]) {
+            addElement(elements[elNo]);
+        }
+    }
+    for (std::size_t fctNo = 0; fctNo < facets.size(); ++fctNo) {
+        if (facetAlive[fctNo]) {
+            addFacet(facets[fctNo], bcs[fctNo]);
+        }
+    }
+}
+
+std::vector<std::size_t> doerflerMarking(std::vector<double> const& eta2, double theta) {
+    if (theta <= 0.0 || theta > 1.0) {
+        throw std::runtime_error("Bulk parameter theta must lie in (0, 1].");
+    }
+    auto order = std::vector<std::size_t>(eta2.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&eta2](std::size_t a, std::size_t b) { return eta2[a] > eta2[b]; });
+
+    double total = std::accumulate(eta2.begin(), eta2.end(), 0.0);
+    std::vector<std::size_t> marked;
+    double sum = 0.0;
+    for (auto elNo : order) {
+        if (sum >= theta * total) {
+            break;
+        }
+        sum += eta2[elNo];
+        marked.emplace_back(elNo);
+    }
+    return marked;
+}
+
+namespace {
+template <std::size_t D>
+std::unique_ptr<GlobalSimplexMesh<D>> refineGathered(LocalSimplexMesh<D> const& mesh,
+                                                     std::vector<double> const& eta2, bool uniform,
+                                                     double theta, MPI_Comm comm) {
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    if (dynamic_cast<ElementData const*>(mesh.elements().data())) {
+        throw std::runtime_error("Refinement of high-order meshes is not supported.");
+    }
+    auto vertexData = dynamic_cast<VertexData<D> const*>(mesh.vertices().data());
+    if (!vertexData) {
+        throw std::runtime_error("Refinement requires vertex data.");
+    }
+    auto boundaryData = dynamic_cast<BoundaryData const*>(mesh.facets().data());
+
+    std::size_t numLocalElements = mesh.elements().localSize();
+    if (!uniform && eta2.size() != numLocalElements) {
+        throw std::runtime_error("Need one error indicator per local element.");
+    }
+
+    std::vector<uint64_t> elemVerts;
+    std::vector<double> elemCoords;
+    elemVerts.reserve((D + 1) * numLocalElements);
+    elemCoords.reserve(D * (D + 1) * numLocalElements);
+    auto const& vertices = vertexData->getVertices();
+    for (std::size_t elNo = 0; elNo < numLocalElements; ++elNo) {
+        auto const& elem = mesh.elements()[elNo];
+        auto vlids = mesh.template downward<0, D>(elNo);
+        for (std::size_t i = 0; i < D + 1; ++i) {
+            elemVerts.emplace_back(elem[i]);
+            for (std::size_t d = 0; d < D; ++d) {
+                elemCoords.emplace_back(vertices[vlids[i]][d]);
+            }
+        }
+    }
+
+    std::vector<uint64_t> fctVerts;
+    std::vector<int> fctBCs;
+    if (boundaryData) {
+        auto const& bcs = boundaryData->getBoundaryConditions();
+        for (std::size_t fctNo = 0; fctNo < mesh.facets().localSize(); ++fctNo) {
+            if (bcs[fctNo] != BC::None) {
+                auto const& fct = mesh.facets()[fctNo];
+                fctVerts.insert(fctVerts.end(), fct.begin(), fct.end());
+                fctBCs.emplace_back(static_cast<int>(bcs[fctNo]));
+            }
+        }
+    }
+
+    auto allElemVerts = GatherV(elemVerts.size(), 0, comm).exchange(elemVerts.data());
+    auto allElemCoords = GatherV(elemCoords.size(), 0, comm).exchange(elemCoords.data());
+    auto allEta2 = GatherV(eta2.size(), 0, comm).exchange(eta2.data());
+    auto allFctVerts = GatherV(fctVerts.size(), 0, comm).exchange(fctVerts.data());
+    auto allFctBCs = GatherV(fctBCs.size(), 0, comm).exchange(fctBCs.data());
+
+    std::vector<std::array<double, D>> newVertices;
+    std::vector<Simplex<D>> newElements;
+    std::vector<Simplex<D - 1u>> newFacets;
+    std::vector<BC> newBCs;
+    if (rank == 0) {
+        // Contiguous vertex ids, ordered by the old global id
+        std::map<uint64_t, std::array<double, D>> gid2coords;
+        for (std::size_t i = 0; i < allElemVerts.size(); ++i) {
+            auto& x = gid2coords[allElemVerts[i]];
+            std::copy(&allElemCoords[D * i], &allElemCoords[D * i] + D, x.begin());
+        }
+        std::map<uint64_t, uint64_t> gid2vid;
+        std::vector<std::array<double, D>> verts;
+        verts.reserve(gid2coords.size());
+        for (auto const& [gid, x] : gid2coords) {
+            gid2vid[gid] = verts.size();
+            verts.emplace_back(x);
+        }
+
+        std::size_t numElements = allElemVerts.size() / (D + 1);
+        std::vector<Simplex<D>> elems(numElements);
+        for (std::size_t elNo = 0; elNo < numElements; ++elNo) {
+            std::array<uint64_t, D + 1> plex;
+            for (std::size_t i = 0; i < D + 1; ++i) {
+                plex[i] = gid2vid.at(allElemVerts[(D + 1) * elNo + i]);
+            }
+            elems[elNo] = Simplex<D>(plex);
+        }
+
+        std::vector<Simplex<D - 1u>> fcts(allFctBCs.size());
+        std::vector<BC> bcs(allFctBCs.size());
+        for (std::size_t fctNo = 0; fctNo < fcts.size(); ++fctNo) {
+            std::array<uint64_t, D> plex;
+            for (std::size_t i = 0; i < D; ++i) {
+                plex[i] = gid2vid.at(allFctVerts[D * fctNo + i]);
+            }
+            fcts[fctNo] = Simplex<D - 1u>(plex);
+            bcs[fctNo] = static_cast<BC>(allFctBCs[fctNo]);
+        }
+
+        auto refinement = BisectionRefinement<D>(std::move(verts), std::move(elems),
+                                                 std::move(fcts), std::move(bcs));
+        if (uniform) {
+            refinement.refineAll();
+        } else {
+            refinement.refine(doerflerMarking(allEta2, theta));
+        }
+        newVertices = refinement.vertices();
+        newElements = refinement.elements();
+        newFacets = refinement.facets();
+        newBCs = refinement.bcs();
+    }
+
+    auto vertexDataOut = std::make_unique<VertexData<D>>(std::move(newVertices));
+    auto refined = std::make_unique<GlobalSimplexMesh<D>>(
+        std::move(newElements), std::move(vertexDataOut), nullptr, comm);
+    auto boundaryDataOut = std::make_unique<BoundaryData>(std::move(newBCs));
+    auto boundaryMesh = std::make_unique<GlobalSimplexMesh<D - 1u>>(
+        std::move(newFacets), nullptr, std::move(boundaryDataOut), comm);
+    refined->setBoundaryMesh(std::move(boundaryMesh));
+    return refined;
+}
+
+} // namespace
+
+template <std::size_t D>
+std::unique_ptr<GlobalSimplexMesh<D>> refineLocalMesh(LocalSimplexMesh<D> const& mesh,
+                                                      std::vector<double> const& eta2,
+                                                      double theta, MPI_Comm comm) {
+    return refineGathered(mesh, eta2, false, theta, comm);
+}
+
+template <std::size_t D>
+std::unique_ptr<GlobalSimplexMesh<D>> refineLocalMeshUniformly(LocalSimplexMesh<D> const& mesh,
+                                                               MPI_Comm comm) {
+    return refineGathered(mesh, {}, true, 1.0, comm);
+}
+
+template class BisectionRefinement<2ul>;
+template class BisectionRefinement<3ul>;
+template std::unique_ptr<GlobalSimplexMesh<2ul>>
+refineLocalMesh(LocalSimplexMesh<2ul> const& mesh, std::vector<double> const& eta2, double theta,
+                MPI_Comm comm);
+template std::unique_ptr<GlobalSimplexMesh<3ul>>
+refineLocalMesh(LocalSimplexMesh<3ul> const& mesh, std::vector<double> const& eta2, double theta,
+                MPI_Comm comm);
+template std::unique_ptr<GlobalSimplexMesh<2ul>>
+refineLocalMeshUniformly(LocalSimplexMesh<2ul> const& mesh, MPI_Comm comm);
+template std::unique_ptr<GlobalSimplexMesh<3ul>>
+refineLocalMeshUniformly(LocalSimplexMesh<3ul> const& mesh, MPI_Comm comm);
+
+} // namespace tndm
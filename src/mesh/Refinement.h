@@ -0,0 +1,150 @@
+#ifndef REFINEMENT_20261018_H
+#define REFINEMENT_20261018_H
+
+#include "form/BC.h"
+#include "mesh/GlobalSimplexMesh.h"
+#include "mesh/LocalSimplexMesh.h"
+#include "mesh/Simplex.h"
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Conforming longest-edge bisection of a simplex mesh (Rivara).
+ *
+ * An element is refined by bisecting its longest edge, and every element sharing that edge is
+ * bisected as well. If a neighbour's longest edge is a different one, then the neighbour is
+ * refined first (longest-edge propagation path), such that no hanging nodes are created.
+ * Ties between edges of equal length are broken by the vertex ids, hence the result is
+ * deterministic. Boundary facets containing a bisected edge are split and keep their BC.
+ *
+ * The class works on a serial (i.e. fully gathered) mesh.
+ *
+ * @tparam D simplex dimension
+ */
+template <std::size_t D> class BisectionRefinement {
+public:
+    using vertex_t = std::array<double, D>;
+    using simplex_t = Simplex<D>;
+    using facet_t = Simplex<D - 1u>;
+
+    /**
+     * @param vertices Vertex coordinates; the vertex id is the position in the vector
+     * @param elements D-simplices
+     * @param facets Boundary facets
+     * @param bcs Boundary condition for every boundary facet
+     */
+    BisectionRefinement(std::vector<vertex_t> vertices, std::vector<simplex_t> elements,
+                        std::vector<facet_t> facets = {}, std::vector<BC> bcs = {});
+
+    /**
+     * @brief Bisects every marked element (at least) once.
+     *
+     * @param marked Indices into elements(); elements() is renumbered afterwards
+     */
+    void refine(std::vector<std::size_t> const& marked);
+    /**
+     * @brief Bisects every element once.
+     */
+    void refineAll();
+
+    auto const& vertices() const { return vertices_; }
+    auto const& elements() const { return elements_; }
+    auto const& facets() const { return facets_; }
+    auto const& bcs() const { return bcs_; }
+    std::size_t numElements() const { return elements_.size(); }
+
+private:
+    using edge_t = std::array<uint64_t, 2>;
+    using edge_map_t = std::map<edge_t, std::vector<std::size_t>>;
+
+    template <std::size_t DD> static auto edges(Simplex<DD> const& plex) {
+        std::array<edge_t, (DD + 1) * DD / 2> result;
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < DD + 1; ++i) {
+            for (std::size_t j = i + 1; j < DD + 1; ++j) {
+                result[k++] = {plex[i], plex[j]};
+            }
+        }
+        return result;
+    }
+    template <std::size_t DD> static Simplex<DD> replace(Simplex<DD> plex, uint64_t from,
+                                                         uint64_t to) {
+        std::array<uint64_t, DD + 1> verts = plex;
+        for (auto& v : verts) {
+            if (v == from) {
+                v = to;
+            }
+        }
+        return Simplex<DD>(verts);
+    }
+
+    double length2(edge_t const& edge) const;
+    bool isLonger(edge_t const& a, edge_t const& b) const;
+    edge_t longestEdge(std::size_t elNo) const;
+
+    void refineElement(std::size_t elNo);
+    void bisect(edge_t const& edge);
+    void addElement(simplex_t const& elem);
+    void removeElement(std::size_t elNo);
+    void addFacet(facet_t const& fct, BC bc);
+    void removeFacet(std::size_t fctNo);
+    void compact();
+
+    std::vector<vertex_t> vertices_;
+    std::vector<simplex_t> elements_;
+    std::vector<facet_t> facets_;
+    std::vector<BC> bcs_;
+    std::vector<bool> elementAlive_;
+    std::vector<bool> facetAlive_;
+    edge_map_t edge2elems_;
+    edge_map_t edge2facets_;
+};
+
+/**
+ * @brief Dörfler (bulk) marking.
+ *
+ * Returns the smallest set of elements with largest indicators such that
+ * sum_{marked} eta2 >= theta sum_{all} eta2.
+ *
+ * @param eta2 Squared error indicator per element
+ * @param theta Bulk parameter in (0, 1]
+ */
+std::vector<std::size_t> doerflerMarking(std::vector<double> const& eta2, double theta);
+
+/**
+ * @brief Refines a distributed mesh adaptively.
+ *
+ * Owned elements, their vertices, and the tagged boundary facets are gathered on rank 0,
+ * the elements selected by doerflerMarking are refined with BisectionRefinement, and the result
+ * is returned as global mesh that lives on rank 0.
+ * The caller is expected to redistribute the mesh (e.g. repartitionByHash() + repartition()).
+ *
+ * @param mesh Local mesh (must not carry high-order element data)
+ * @param eta2 Squared error indicator per local element
+ * @param theta Bulk parameter for doerflerMarking
+ * @param comm MPI communicator
+ */
+template <std::size_t D>
+std::unique_ptr<GlobalSimplexMesh<D>> refineLocalMesh(LocalSimplexMesh<D> const& mesh,
+                                                      std::vector<double> const& eta2,
+                                                      double theta, MPI_Comm comm);
+
+/**
+ * @brief Same as refineLocalMesh but every element is bisected once.
+ */
+template <std::size_t D>
+std::unique_ptr<GlobalSimplexMesh<D>> refineLocalMeshUniformly(LocalSimplexMesh<D> const& mesh,
+                                                               MPI_Comm comm);
+
+} // namespace tndm
+
+#endif // REFINEMENT_20261018_H
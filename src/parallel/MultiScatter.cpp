@@ -0,0 +1,132 @@
+#include "MultiScatter.h"
+#include "tensor/Tensor.h"
+
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+namespace tndm {
+
+std::size_t MultiScatter::add_field(std::shared_ptr<ScatterPlan> plan, std::size_t block_size) {
+    if (comm_ == MPI_COMM_NULL) {
+        comm_ = plan->comm();
+    } else {
+        // Congruent communicators share the rank numbering, hence comm_ may be used for both
+        int result;
+        MPI_Comm_compare(comm_, plan->comm(), &result);
+        if (result != MPI_IDENT && result != MPI_CONGRUENT) {
+            throw std::runtime_error("MultiScatter: scatter plans must share the communicator.");
+        }
+    }
+    if (!pending_.empty()) {
+        throw std::logic_error("MultiScatter: cannot add field during an exchange.");
+    }
+    fields_.emplace_back(Field{std::move(plan), block_size});
+    setup();
+    return fields_.size() - 1;
+}
+
+void MultiScatter::setup() {
+    auto const make_messages = [this](auto get_blocks, std::vector<Message>& messages,
+                                      std::vector<Segment>& segments) {
+        auto rank_segments = std::map<int, std::vector<Segment>>{};
+        for (std::size_t f = 0; f < fields_.size(); ++f) {
+            for (auto const& block : get_blocks(*fields_[f].plan)) {
+                rank_segments[block.source_or_dest].emplace_back(
+                    Segment{f, block.offset, static_cast<std::size_t>(block.count), 0});
+            }
+        }
+
+        messages.clear();
+        segments.clear();
+        std::size_t offset = 0;
+        for (auto& [rank, segs] : rank_segments) {
+            auto message = Message{rank, offset, 0};
+            for (auto& seg : segs) {
+                seg.buffer_offset = offset + message.size;
+                message.size += seg.count * fields_[seg.field].block_size;
+                segments.emplace_back(seg);
+            }
+            offset += message.size;
+            messages.emplace_back(message);
+        }
+        return offset;
+    };
+
+    auto const send_blocks = [](ScatterPlan const& plan) -> auto const& {
+        return plan.send_blocks();
+    };
+    auto const recv_blocks = [](ScatterPlan const& plan) -> auto const& {
+        return plan.recv_blocks();
+    };
+    auto send_size = make_messages(send_blocks, send_, send_segments_);
+    auto recv_size = make_messages(recv_blocks, recv_, recv_segments_);
+    send_buffer_.resize(send_size);
+    recv_buffer_.resize(recv_size);
+    requests_.resize(send_.size() + recv_.size(), MPI_REQUEST_NULL);
+}
+
+void MultiScatter::begin_scatter(field_t const* fields, std::size_t num_fields) {
+    if (num_fields != fields_.size()) {
+        throw std::logic_error("MultiScatter: number of fields does not match registration.");
+    }
+
+    std::size_t requestNo = 0;
+    for (auto const& message : recv_) {
+        MPI_Irecv(&recv_buffer_[message.offset], message.size, MPI_DOUBLE, message.rank, Tag,
+                  comm_, &requests_[requestNo++]);
+    }
+
+    pending_.resize(num_fields);
+    for (std::size_t f = 0; f < num_fields; ++f) {
+        auto const& [x, y] = fields[f];
+        assert(x->block_size() == fields_[f].block_size);
+        assert(y->block_size() == fields_[f].block_size);
+        pending_[f] = y;
+    }
+
+    auto x_handles = std::vector<Matrix<double const>>{};
+    x_handles.reserve(num_fields);
+    for (std::size_t f = 0; f < num_fields; ++f) {
+        x_handles.emplace_back(fields[f].first->begin_access_readonly());
+    }
+    for (auto const& seg : send_segments_) {
+        auto const& indices = fields_[seg.field].plan->send_indices();
+        std::size_t bs = fields_[seg.field].block_size;
+        for (std::size_t i = 0; i < seg.count; ++i) {
+            auto block = x_handles[seg.field].subtensor(slice{}, indices[seg.index_offset + i]);
+            memcpy(&send_buffer_[seg.buffer_offset + i * bs], block.data(), bs * sizeof(double));
+        }
+    }
+    for (std::size_t f = 0; f < num_fields; ++f) {
+        fields[f].first->end_access_readonly(x_handles[f]);
+    }
+
+    for (auto const& message : send_) {
+        MPI_Isend(&send_buffer_[message.offset], message.size, MPI_DOUBLE, message.rank, Tag,
+                  comm_, &requests_[requestNo++]);
+    }
+    assert(requestNo == requests_.size());
+}
+
+void MultiScatter::test_scatter() {
+    int flag;
+    MPI_Testall(requests_.size(), requests_.data(), &flag, MPI_STATUSES_IGNORE);
+}
+
+void MultiScatter::wait_scatter() {
+    MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+    if (pending_.empty()) {
+        return;
+    }
+    for (auto const& seg : recv_segments_) {
+        std::size_t bs = fields_[seg.field].block_size;
+        double* y = pending_[seg.field]->data();
+        memcpy(&y[seg.index_offset * bs], &recv_buffer_[seg.buffer_offset],
+               seg.count * bs * sizeof(double));
+    }
+    pending_.clear();
+}
+
+} // namespace tndm
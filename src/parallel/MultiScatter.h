@@ -0,0 +1,121 @@
+#ifndef MULTISCATTER_20261018_H
+#define MULTISCATTER_20261018_H
+
+#include "interface/BlockVector.h"
+#include "parallel/ScatterPlan.h"
+#include "parallel/SparseBlockVector.h"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Ghost exchange of several fields in a single round.
+ *
+ * Every field has its own ScatterPlan and block size. The data of all fields that goes to the
+ * same neighbour rank is packed into a single message, such that one exchange costs one message
+ * per neighbour instead of one message per neighbour and field.
+ *
+ * Usage:
+ *
+ * auto scatter = MultiScatter();
+ * auto a = scatter.add_field(planA, bsA);
+ * auto b = scatter.add_field(planB, bsB);
+ * auto ghostA = scatter.recv_prototype(a);
+ * auto ghostB = scatter.recv_prototype(b);
+ * scatter.begin_scatter({{&xA, &ghostA}, {&xB, &ghostB}});
+ * scatter.wait_scatter();
+ *
+ * All plans must live on the same (or a congruent) communicator.
+ */
+class MultiScatter {
+public:
+    using field_t = std::pair<BlockVector const*, SparseBlockVector<double>*>;
+
+    /**
+     * @brief Registers a field.
+     *
+     * @param plan Scatter plan of the field
+     * @param block_size Number of values per index
+     *
+     * @return Field id; fields are passed to begin_scatter in the order of registration
+     */
+    std::size_t add_field(std::shared_ptr<ScatterPlan> plan, std::size_t block_size);
+
+    std::size_t num_fields() const { return fields_.size(); }
+    /**
+     * @brief Number of messages per exchange sent by this rank.
+     */
+    std::size_t num_send_messages() const { return send_.size(); }
+
+    auto recv_prototype(std::size_t field,
+                        std::size_t alignment = SparseBlockVector<double>::DefaultAlignment) const {
+        auto const& f = fields_[field];
+        return SparseBlockVector<double>(f.plan->recv_indices(), f.block_size, alignment);
+    }
+
+    /**
+     * @brief Packs and sends the owned data of all fields.
+     *
+     * @param fields One (x, ghost) pair per registered field in order of registration
+     */
+    void begin_scatter(std::initializer_list<field_t> fields) {
+        begin_scatter(fields.begin(), fields.size());
+    }
+    void begin_scatter(std::vector<field_t> const& fields) {
+        begin_scatter(fields.data(), fields.size());
+    }
+    void test_scatter();
+    /**
+     * @brief Waits for all messages and unpacks the ghost data.
+     */
+    void wait_scatter();
+
+private:
+    constexpr static int Tag = 1;
+
+    struct Field {
+        std::shared_ptr<ScatterPlan> plan;
+        std::size_t block_size;
+    };
+
+    /// Contiguous range of a field in a neighbour message (all sizes in doubles)
+    struct Segment {
+        std::size_t field;
+        std::size_t index_offset; ///< Offset in send_indices / recv_indices of the plan
+        std::size_t count;        ///< Number of indices
+        std::size_t buffer_offset;
+    };
+
+    struct Message {
+        int rank;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    void begin_scatter(field_t const* fields, std::size_t num_fields);
+    void setup();
+
+    MPI_Comm comm_ = MPI_COMM_NULL;
+    std::vector<Field> fields_;
+
+    std::vector<Message> send_;
+    std::vector<Message> recv_;
+    std::vector<Segment> send_segments_;
+    std::vector<Segment> recv_segments_;
+    std::vector<double> send_buffer_;
+    std::vector<double> recv_buffer_;
+
+    std::vector<MPI_Request> requests_;
+    std::vector<SparseBlockVector<double>*> pending_;
+};
+
+} // namespace tndm
+
+#endif // MULTISCATTER_20261018_H
@@ -12,6 +12,9 @@ std::size_t Profile::add(std::string name) {
     watches_.emplace_back(Stopwatch());
     times_.emplace_back(0.0);
     flops_.emplace_back(0ull);
+    bytes_.emplace_back(0ull);
+    counts_.emplace_back(PerfCounters::values_t{});
+    counts_begin_.emplace_back(PerfCounters::values_t{});
     return regions_.size() - 1;
 }
 
@@ -39,26 +42,78 @@ void Profile::print(std::ostream& out, MPI_Comm comm) const {
         1 + std::max_element(regions_.begin(), regions_.end(), [](auto const& x, auto const& y) {
                 return x.size() < y.size();
             })->size();
-    auto tp = TablePrinter(my_out, {w_1st_col, 10},
-                           {"Region", "t_min", "t_median", "t_mean", "t_max", "TFLOP", "GFLOP/s"});
+    auto tp = TablePrinter(
+        my_out, {w_1st_col, 10},
+        {"Region", "t_min", "t_median", "t_mean", "t_max", "TFLOP", "GFLOP/s", "GB/s"});
 
-    auto print_summary = [&tp, &comm](std::string const& name, double time, uint64_t flops) {
+    auto print_summary = [&tp, &comm](std::string const& name, double time, uint64_t flops,
+                                      uint64_t bytes) {
         auto s = Summary(time, comm);
-        uint64_t global_flops;
+        uint64_t global_flops, global_bytes;
         MPI_Reduce(&flops, &global_flops, 1, MPI_UINT64_T, MPI_SUM, 0, comm);
+        MPI_Reduce(&bytes, &global_bytes, 1, MPI_UINT64_T, MPI_SUM, 0, comm);
         tp << name << s.min << s.median << s.mean << s.max << global_flops * 1e-12
-           << global_flops / s.max * 1e-9;
+           << global_flops / s.max * 1e-9 << global_bytes / s.max * 1e-9;
     };
 
     double total_time = 0.0;
     uint64_t total_flops = 0;
+    uint64_t total_bytes = 0;
     for (std::size_t region = 0, num = size(); region < num; ++region) {
-        print_summary(regions_[region], times_[region], flops_[region]);
+        print_summary(regions_[region], times_[region], flops_[region], bytes_[region]);
         total_time += times_[region];
         total_flops += flops_[region];
+        total_bytes += bytes_[region];
     }
     tp.separator();
-    print_summary("Total", total_time, total_flops);
+    print_summary("Total", total_time, total_flops, total_bytes);
+
+    print_counters(my_out, comm, w_1st_col);
+}
+
+void Profile::print_counters(std::ostream* out, MPI_Comm comm, int w_1st_col) const {
+    int has_counters = PerfCounters::instance() != nullptr ? 1 : 0;
+    int has_fp = has_counters && PerfCounters::instance()->available(PerfCounters::FPOps);
+    MPI_Allreduce(MPI_IN_PLACE, &has_counters, 1, MPI_INT, MPI_MIN, comm);
+    MPI_Allreduce(MPI_IN_PLACE, &has_fp, 1, MPI_INT, MPI_MIN, comm);
+    if (!has_counters) {
+        return;
+    }
+
+    *out << std::endl;
+    auto tp = TablePrinter(out, {w_1st_col, 10},
+                           {"Region", "IPC_min", "IPC_mean", "IPC_max", "LLC miss", "GB/s LLC",
+                            has_fp ? "FLOP/B hw" : "FLOP/B"});
+
+    auto print_summary = [&tp, &comm, &has_fp](std::string const& name, double time,
+                                               uint64_t flops, PerfCounters::values_t const& c) {
+        double ipc = c[PerfCounters::Cycles] > 0
+                         ? static_cast<double>(c[PerfCounters::Instructions]) /
+                               c[PerfCounters::Cycles]
+                         : 0.0;
+        auto s = Summary(ipc, comm);
+        auto t = Summary(time, comm);
+        uint64_t local[2] = {c[PerfCounters::LLCMisses], has_fp ? c[PerfCounters::FPOps] : flops};
+        uint64_t global[2];
+        MPI_Reduce(local, global, 2, MPI_UINT64_T, MPI_SUM, 0, comm);
+        double traffic = static_cast<double>(global[0]) * PerfCounters::CacheLineSize;
+        tp << name << s.min << s.mean << s.max << static_cast<double>(global[0])
+           << traffic / t.max * 1e-9 << (traffic > 0.0 ? global[1] / traffic : 0.0);
+    };
+
+    double total_time = 0.0;
+    uint64_t total_flops = 0;
+    PerfCounters::values_t total_counts{};
+    for (std::size_t region = 0, num = size(); region < num; ++region) {
+        print_summary(regions_[region], times_[region], flops_[region], counts_[region]);
+        total_time += times_[region];
+        total_flops += flops_[region];
+        for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+            total_counts[e] += counts_[region][e];
+        }
+    }
+    tp.separator();
+    print_summary("Total", total_time, total_flops, total_counts);
 }
 
 } // namespace tndm
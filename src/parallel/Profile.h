@@ -2,6 +2,7 @@
 #define PROFILE_20210916_H
 
 #include "parallel/Summary.h"
+#include "util/PerfCounters.h"
 #include "util/Stopwatch.h"
 
 #include <cstdint>
@@ -20,24 +21,48 @@ public:
     inline std::string_view get(std::size_t region) const { return regions_[region]; }
     inline std::size_t size() const { return regions_.size(); }
 
-    inline void begin(std::size_t region) { watches_[region].start(); }
-    inline void end(std::size_t region, uint64_t flops = 0) {
+    inline void begin(std::size_t region) {
+        if (auto counters = PerfCounters::instance(); counters) {
+            counters->read(counts_begin_[region]);
+        }
+        watches_[region].start();
+    }
+    inline void end(std::size_t region, uint64_t flops = 0, uint64_t bytes = 0) {
         double time = watches_[region].stop();
         times_[region] += time;
         flops_[region] += flops;
+        bytes_[region] += bytes;
+        if (auto counters = PerfCounters::instance(); counters) {
+            PerfCounters::values_t now;
+            counters->read(now);
+            for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+                counts_[region][e] += now[e] - counts_begin_[region][e];
+            }
+        }
     }
 
     inline Summary summary(std::size_t region, MPI_Comm comm) const {
         return Summary(times_[region], comm);
     }
 
+    /**
+     * @brief Prints timings and, if PerfCounters are enabled, derived hardware metrics.
+     *
+     * IPC is summarised over ranks; the arithmetic intensity relates floating point operations
+     * (FP counter if available, otherwise the flops passed to end()) to LLC miss traffic.
+     */
     void print(std::ostream& out, MPI_Comm comm) const;
 
 private:
+    void print_counters(std::ostream* out, MPI_Comm comm, int w_1st_col) const;
+
     std::vector<Stopwatch> watches_;
     std::vector<std::string> regions_;
     std::vector<double> times_;
     std::vector<uint64_t> flops_;
+    std::vector<uint64_t> bytes_;
+    std::vector<PerfCounters::values_t> counts_;
+    std::vector<PerfCounters::values_t> counts_begin_;
 };
 
 } // namespace tndm
@@ -0,0 +1,194 @@
+#include "RankPlacement.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <utility>
+
+namespace tndm {
+
+RankPlacement::RankPlacement(MPI_Comm comm) : comm_(comm) {
+    int rank, procs;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &procs);
+
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(comm_, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    int leader = rank;
+    MPI_Bcast(&leader, 1, MPI_INT, 0, node_comm);
+    MPI_Comm_free(&node_comm);
+
+    node_of_rank_.resize(procs);
+    MPI_Allgather(&leader, 1, MPI_INT, node_of_rank_.data(), 1, MPI_INT, comm_);
+
+    // Number nodes consecutively
+    std::unordered_map<int, int> node_no;
+    for (auto& node : node_of_rank_) {
+        int next = node_no.size();
+        node = node_no.emplace(node, next).first->second;
+    }
+    num_nodes_ = node_no.size();
+}
+
+int RankPlacement::place(ScatterPlan const& plan) {
+    int rank, procs;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &procs);
+
+    auto edge_dest = std::vector<int>{};
+    auto edge_weight = std::vector<uint64_t>{};
+    edge_dest.reserve(plan.send_blocks().size());
+    edge_weight.reserve(plan.send_blocks().size());
+    for (auto const& block : plan.send_blocks()) {
+        edge_dest.emplace_back(block.source_or_dest);
+        edge_weight.emplace_back(block.count);
+    }
+
+    int num_edges = edge_dest.size();
+    auto counts = std::vector<int>(rank == 0 ? procs : 0);
+    MPI_Gather(&num_edges, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm_);
+    auto displs = std::vector<int>(counts.size() + 1, 0);
+    std::partial_sum(counts.begin(), counts.end(), displs.begin() + 1);
+    auto all_dest = std::vector<int>(displs.back());
+    auto all_weight = std::vector<uint64_t>(displs.back());
+    MPI_Gatherv(edge_dest.data(), num_edges, MPI_INT, all_dest.data(), counts.data(),
+                displs.data(), MPI_INT, 0, comm_);
+    MPI_Gatherv(edge_weight.data(), num_edges, MPI_UINT64_T, all_weight.data(), counts.data(),
+                displs.data(), MPI_UINT64_T, 0, comm_);
+
+    auto rank_of_part = std::vector<int>{};
+    if (rank == 0) {
+        auto graph = graph_t(procs);
+        for (int p = 0; p < procs; ++p) {
+            for (int e = displs[p]; e < displs[p + 1]; ++e) {
+                int q = all_dest[e];
+                uint64_t w = all_weight[e];
+                graph[p][q] += w;
+                graph[q][p] += w;
+            }
+        }
+
+        auto identity = std::vector<int>(procs);
+        std::iota(identity.begin(), identity.end(), 0);
+        before_ = volume(graph, node_of_rank_, identity);
+
+        rank_of_part = greedy(graph, node_of_rank_);
+        after_ = volume(graph, node_of_rank_, rank_of_part);
+        if (after_.off_node >= before_.off_node) {
+            rank_of_part = std::move(identity);
+            after_ = before_;
+        }
+    }
+
+    int new_rank;
+    MPI_Scatter(rank_of_part.data(), 1, MPI_INT, &new_rank, 1, MPI_INT, 0, comm_);
+
+    uint64_t volumes[4] = {before_.on_node, before_.off_node, after_.on_node, after_.off_node};
+    MPI_Bcast(volumes, 4, MPI_UINT64_T, 0, comm_);
+    before_ = Volume{volumes[0], volumes[1]};
+    after_ = Volume{volumes[2], volumes[3]};
+
+    int moved = new_rank != rank;
+    int any_moved;
+    MPI_Allreduce(&moved, &any_moved, 1, MPI_INT, MPI_LOR, comm_);
+    changed_ = any_moved != 0;
+
+    return new_rank;
+}
+
+void RankPlacement::print(std::ostream& out) const {
+    int rank;
+    MPI_Comm_rank(comm_, &rank);
+    if (rank != 0) {
+        return;
+    }
+    auto const print_volume = [&out](Volume const& v) {
+        auto total = v.on_node + v.off_node;
+        out << v.on_node << " on-node, " << v.off_node << " off-node ("
+            << (total > 0 ? 100.0 * v.off_node / total : 0.0) << "% off-node)";
+    };
+    out << "Ghost exchange volume on " << num_nodes_ << " node(s) [elements]: ";
+    print_volume(before_);
+    out << std::endl;
+    if (changed_) {
+        out << "Ghost exchange volume after rank placement [elements]: ";
+        print_volume(after_);
+        out << std::endl;
+    }
+}
+
+std::vector<int> RankPlacement::greedy(graph_t const& graph,
+                                       std::vector<int> const& node_of_rank) {
+    int procs = node_of_rank.size();
+    int num_nodes = procs > 0 ? *std::max_element(node_of_rank.begin(), node_of_rank.end()) + 1 : 0;
+    auto ranks_on_node = std::vector<std::vector<int>>(num_nodes);
+    for (int r = 0; r < procs; ++r) {
+        ranks_on_node[node_of_rank[r]].emplace_back(r);
+    }
+
+    // Unplaced partitions with positive gain ordered by decreasing gain and increasing index.
+    // Together with a cursor to the unplaced partition with smallest index the assignment
+    // costs O((procs + edges) log procs) instead of a linear search per partition.
+    auto by_gain = [](std::pair<uint64_t, int> const& a, std::pair<uint64_t, int> const& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    auto candidates = std::set<std::pair<uint64_t, int>, decltype(by_gain)>(by_gain);
+
+    auto rank_of_part = std::vector<int>(procs, -1);
+    auto gain = std::vector<uint64_t>(procs, 0);
+    auto touched = std::vector<int>{};
+    int first_unplaced = 0;
+    for (auto const& ranks : ranks_on_node) {
+        for (int p : touched) {
+            gain[p] = 0;
+        }
+        touched.clear();
+        candidates.clear();
+        for (int r : ranks) {
+            // Take the unplaced partition which communicates most with the node.
+            // If there is none, the unplaced partition with the smallest index starts the node.
+            while (first_unplaced < procs && rank_of_part[first_unplaced] >= 0) {
+                ++first_unplaced;
+            }
+            int best = first_unplaced;
+            if (!candidates.empty()) {
+                best = candidates.begin()->second;
+                candidates.erase(candidates.begin());
+            }
+            rank_of_part[best] = r;
+            for (auto const& [q, w] : graph[best]) {
+                if (rank_of_part[q] >= 0 || w == 0) {
+                    continue;
+                }
+                if (gain[q] > 0) {
+                    candidates.erase({gain[q], q});
+                } else {
+                    touched.emplace_back(q);
+                }
+                gain[q] += w;
+                candidates.emplace(gain[q], q);
+            }
+        }
+    }
+    return rank_of_part;
+}
+
+auto RankPlacement::volume(graph_t const& graph, std::vector<int> const& node_of_rank,
+                           std::vector<int> const& rank_of_part) -> Volume {
+    Volume v;
+    for (int p = 0, num = graph.size(); p < num; ++p) {
+        for (auto const& [q, w] : graph[p]) {
+            if (q <= p) {
+                continue;
+            }
+            if (node_of_rank[rank_of_part[p]] == node_of_rank[rank_of_part[q]]) {
+                v.on_node += w;
+            } else {
+                v.off_node += w;
+            }
+        }
+    }
+    return v;
+}
+
+} // namespace tndm
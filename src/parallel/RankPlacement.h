@@ -0,0 +1,86 @@
+#ifndef RANKPLACEMENT_20261018_H
+#define RANKPLACEMENT_20261018_H
+
+#include "parallel/ScatterPlan.h"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace tndm {
+
+/**
+ * @brief Maps partitions to ranks such that heavy ghost exchange stays on a node.
+ *
+ * Ranks sharing memory (MPI_COMM_TYPE_SHARED) are considered to be on the same node.
+ * The communication graph between partitions is built from the volumes of a ScatterPlan;
+ * the partitions are then assigned to nodes greedily, where each node is filled with the
+ * partitions that have the strongest connection to the partitions already placed on the node.
+ */
+class RankPlacement {
+public:
+    using graph_t = std::vector<std::unordered_map<int, uint64_t>>;
+
+    struct Volume {
+        uint64_t on_node = 0;
+        uint64_t off_node = 0;
+    };
+
+    RankPlacement(MPI_Comm comm = MPI_COMM_WORLD);
+
+    /**
+     * @brief Computes the new rank of the partition currently owned by this rank.
+     *
+     * Collective.
+     *
+     * @param plan Ghost exchange pattern of the current partitioning
+     *
+     * @return Rank the local partition shall be moved to
+     */
+    int place(ScatterPlan const& plan);
+
+    /**
+     * @brief True if the last call to place() changed the mapping.
+     */
+    inline bool changed() const { return changed_; }
+    inline Volume const& volume_before() const { return before_; }
+    inline Volume const& volume_after() const { return after_; }
+    inline int num_nodes() const { return num_nodes_; }
+
+    /**
+     * @brief Prints on-node and off-node exchange volume (only on rank 0).
+     */
+    void print(std::ostream& out) const;
+
+    /**
+     * @brief Greedy assignment of partitions to ranks.
+     *
+     * @param graph Symmetric communication graph; graph[p][q] is the volume between p and q
+     * @param node_of_rank Node index for every rank
+     *
+     * @return Rank of every partition
+     */
+    static std::vector<int> greedy(graph_t const& graph, std::vector<int> const& node_of_rank);
+
+    /**
+     * @brief Exchange volume for a given mapping of partitions to ranks.
+     */
+    static Volume volume(graph_t const& graph, std::vector<int> const& node_of_rank,
+                         std::vector<int> const& rank_of_part);
+
+private:
+    MPI_Comm comm_;
+    std::vector<int> node_of_rank_;
+    int num_nodes_ = 1;
+    bool changed_ = false;
+    Volume before_;
+    Volume after_;
+};
+
+} // namespace tndm
+
+#endif // RANKPLACEMENT_20261018_H
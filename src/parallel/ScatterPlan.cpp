@@ -2,15 +2,14 @@
 
 namespace tndm {
 
-void ScatterPlan::setup(std::unordered_map<int, std::vector<std::size_t>> const& send_map,
-                        std::unordered_map<int, std::vector<std::size_t>> const& recv_map) {
+void ScatterPlan::setup(index_map_t const& send_map, index_map_t const& recv_map) {
     const auto make_indices = [](auto const& map) {
         std::size_t size = 0;
         for (auto& [key, value] : map) {
             size += value.size();
         }
 
-        auto indices = std::vector<std::size_t>{};
+        auto indices = std::vector<local_index_t>{};
         indices.reserve(size);
         for (auto& [key, value] : map) {
             for (auto&& v : value) {
@@ -2,6 +2,7 @@
 #define SCATTERPLAN_20210325_H
 
 #include "mesh/LocalFaces.h"
+#include "util/LocalIndex.h"
 
 #include <mpi.h>
 
@@ -14,6 +15,7 @@ namespace tndm {
 class ScatterPlan {
 public:
     using byte_t = unsigned char;
+    using index_map_t = std::unordered_map<int, std::vector<local_index_t>>;
 
     struct CommBlock {
         std::size_t offset;
@@ -26,9 +28,9 @@ public:
         int rank;
         MPI_Comm_rank(comm_, &rank);
 
-        std::unordered_map<int, std::vector<std::size_t>> send_map;
-        std::unordered_map<int, std::vector<std::size_t>> recv_map;
-        for (std::size_t f = 0; f < faces.size(); ++f) {
+        index_map_t send_map;
+        index_map_t recv_map;
+        for (local_index_t f = 0; f < faces.size(); ++f) {
             auto owner = faces.owner(f);
             if (owner == rank) {
                 for (auto&& shRk : faces.getSharedRanks(f)) {
@@ -42,27 +44,25 @@ public:
         setup(send_map, recv_map);
     }
 
-    ScatterPlan(std::unordered_map<int, std::vector<std::size_t>> const& send_map,
-                std::unordered_map<int, std::vector<std::size_t>> const& recv_map,
+    ScatterPlan(index_map_t const& send_map, index_map_t const& recv_map,
                 MPI_Comm comm = MPI_COMM_WORLD)
         : comm_(comm) {
         setup(send_map, recv_map);
     }
 
     MPI_Comm comm() const { return comm_; }
-    std::vector<std::size_t> const& send_indices() const { return send_indices_; }
-    std::vector<std::size_t> const& recv_indices() const { return recv_indices_; }
+    std::vector<local_index_t> const& send_indices() const { return send_indices_; }
+    std::vector<local_index_t> const& recv_indices() const { return recv_indices_; }
     std::vector<CommBlock> const& send_blocks() const { return send_blocks_; }
     std::vector<CommBlock> const& recv_blocks() const { return recv_blocks_; }
 
 private:
-    void setup(std::unordered_map<int, std::vector<std::size_t>> const& send_map,
-               std::unordered_map<int, std::vector<std::size_t>> const& recv_map);
+    void setup(index_map_t const& send_map, index_map_t const& recv_map);
 
     MPI_Comm comm_;
 
-    std::vector<std::size_t> send_indices_;
-    std::vector<std::size_t> recv_indices_;
+    std::vector<local_index_t> send_indices_;
+    std::vector<local_index_t> recv_indices_;
     std::vector<CommBlock> send_blocks_;
     std::vector<CommBlock> recv_blocks_;
 };
@@ -2,6 +2,7 @@
 #define SPARSEBLOCKVECTOR_20210325_H
 
 #include "tensor/Tensor.h"
+#include "util/LocalIndex.h"
 
 #include <algorithm>
 #include <limits>
@@ -18,16 +19,16 @@ template <typename T> class SparseBlockVector {
 public:
     static constexpr std::size_t DefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
 
-    SparseBlockVector(std::vector<std::size_t> local_to_global, std::size_t block_size = 1,
+    SparseBlockVector(std::vector<local_index_t> const& local_to_global, std::size_t block_size = 1,
                       std::size_t alignment = DefaultAlignment)
         : block_size_(block_size) {
         mem_ = make_storage(local_to_global.size() * block_size_, alignment);
 
         auto max_idx = std::max_element(local_to_global.begin(), local_to_global.end());
         if (max_idx != local_to_global.end()) {
-            global_to_local_.resize(*max_idx + 1, std::numeric_limits<std::size_t>::max());
+            global_to_local_.resize(*max_idx + 1, std::numeric_limits<local_index_t>::max());
         }
-        std::size_t local = 0;
+        local_index_t local = 0;
         for (auto&& i : local_to_global) {
             global_to_local_[i] = local++;
         }
@@ -38,7 +39,7 @@ public:
 
     bool has_block(std::size_t idx) const {
         return idx < global_to_local_.size() &&
-               global_to_local_[idx] != std::numeric_limits<std::size_t>::max();
+               global_to_local_[idx] != std::numeric_limits<local_index_t>::max();
     }
 
     auto get_block(std::size_t idx) {
@@ -64,7 +65,7 @@ private:
 
     std::unique_ptr<T[], Deleter> mem_;
     std::size_t block_size_;
-    std::vector<std::size_t> global_to_local_;
+    std::vector<local_index_t> global_to_local_;
 };
 
 } // namespace tndm
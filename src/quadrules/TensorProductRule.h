@@ -9,14 +9,14 @@ namespace tndm {
 
 template <std::size_t D> class TensorProductRule {
 public:
-    static unsigned pointsPerDim(unsigned minQuadOrder) {
+    static constexpr unsigned pointsPerDim(unsigned minQuadOrder) {
         return (1 + minQuadOrder / 2); // n = ceil((minQuadOrder+1)/2)
     }
 
     /**
      * @brief Returns size of rule with at least minQuadOrder.
      */
-    static std::size_t size(unsigned minQuadOrder) {
+    static constexpr std::size_t size(unsigned minQuadOrder) {
         auto n = pointsPerDim(minQuadOrder);
         std::size_t s = 1u;
         for (std::size_t d = 0; d < D; ++d) {
@@ -1,6 +1,7 @@
 #ifndef EIGENMAP_20200609_H
 #define EIGENMAP_20200609_H
 
+#include "FixedTensor.h"
 #include "Tensor.h"
 #include "TensorBase.h"
 #include "util/Utility.h"
@@ -43,12 +44,26 @@ template <typename Matrix, int Rows, int Cols> struct EigenMapFactory<Matrix, Ro
     }
 };
 
+template <typename RealT, std::size_t... Extents>
+auto FixedEigenMap(FixedTensor<RealT, Extents...> const& tensor) {
+    static_assert(sizeof...(Extents) <= 2u, "EigenMap requires a vector or a matrix");
+    constexpr auto shape = FixedTensor<RealT, Extents...>::shape();
+    constexpr int Rows = shape[0];
+    constexpr int Cols = sizeof...(Extents) == 2u ? shape.back() : 1;
+    using matrix_t = copy_const<RealT, Eigen::Matrix<std::remove_const_t<RealT>, Rows, Cols>>;
+    return Eigen::Map<matrix_t>(tensor.data());
+}
+
 } // namespace detail
 
 template <typename Tensor, int Rows = Eigen::Dynamic, int Cols = Eigen::Dynamic>
 auto EigenMap(Tensor& tensor) {
-    detail::EigenMapFactory<Tensor, Rows, Cols, detail::traits<Tensor>::Dim> factory;
-    return factory(tensor);
+    if constexpr (detail::is_fixed_tensor_v<Tensor>) {
+        return detail::FixedEigenMap(tensor);
+    } else {
+        detail::EigenMapFactory<Tensor, Rows, Cols, detail::traits<Tensor>::Dim> factory;
+        return factory(tensor);
+    }
 }
 
 } // namespace tndm
@@ -0,0 +1,184 @@
+#ifndef FIXEDTENSOR_20261018_H
+#define FIXEDTENSOR_20261018_H
+
+#include "Managed.h"
+#include "Tensor.h"
+#include "TensorBase.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace tndm {
+
+/**
+ * @brief Packed tensor view whose shape is known at compile time.
+ *
+ * Memory layout is the same as for a packed Tensor (first index fastest), but shape and stride
+ * are constants, such that loops over a FixedTensor can be fully unrolled by the compiler.
+ * The view is a single pointer and is therefore cheap to create inside pointwise loops.
+ *
+ * @tparam RealT Floating point type (may be const)
+ * @tparam Extents Shape of the tensor
+ */
+template <typename RealT, std::size_t... Extents> class FixedTensor {
+public:
+    using index_t = std::ptrdiff_t;
+    using real_t = RealT;
+    static constexpr std::size_t Dim = sizeof...(Extents);
+    using multi_index_t = std::array<index_t, Dim>;
+    static_assert(Dim > 0, "FixedTensor must have at least one dimension");
+
+    constexpr FixedTensor() : data_(nullptr) {}
+    constexpr explicit FixedTensor(real_t* memory) : data_(memory) {}
+
+    /**
+     * @brief View on a packed Tensor with matching shape.
+     */
+    template <typename OtherRealT, std::enable_if_t<std::is_convertible_v<OtherRealT*, real_t*>,
+                                                    int> = 0>
+    FixedTensor(Tensor<OtherRealT, Dim, true>& tensor) : data_(tensor.data()) {
+        assert(tensor.shape() == shape());
+    }
+    template <typename OtherRealT,
+              std::enable_if_t<std::is_convertible_v<OtherRealT const*, real_t*>, int> = 0>
+    FixedTensor(Tensor<OtherRealT, Dim, true> const& tensor) : data_(tensor.data()) {
+        assert(tensor.shape() == shape());
+    }
+
+    template <typename OtherRealT, std::enable_if_t<std::is_convertible_v<OtherRealT*, real_t*>,
+                                                    int> = 0>
+    constexpr FixedTensor(FixedTensor<OtherRealT, Extents...> const& other)
+        : data_(other.data()) {}
+
+    static constexpr multi_index_t shape() { return {static_cast<index_t>(Extents)...}; }
+    static constexpr index_t shape(index_t pos) { return shape()[pos]; }
+    static constexpr multi_index_t stride() {
+        multi_index_t s{};
+        index_t st = 1;
+        for (std::size_t d = 0; d < Dim; ++d) {
+            s[d] = st;
+            st *= shape(d);
+        }
+        return s;
+    }
+    static constexpr index_t stride(index_t pos) { return stride()[pos]; }
+    static constexpr index_t size() { return (static_cast<index_t>(Extents) * ...); }
+
+    template <typename... Entry> constexpr real_t& operator()(Entry... entry) const {
+        static_assert(sizeof...(Entry) == Dim);
+        return data_[address(std::make_index_sequence<Dim>{}, entry...)];
+    }
+
+    real_t* data() const { return data_; }
+
+    /**
+     * @brief Runtime-shaped view on the same memory, e.g. to pass to functions taking a Tensor.
+     */
+    auto tensor() const { return Tensor<real_t, Dim>(data_, shape()); }
+    /**
+     * @brief Shape information for Tensor/Managed constructors and make_scratch_tensor.
+     */
+    static auto info() { return TensorBase<Tensor<std::remove_const_t<real_t>, Dim>>(shape()); }
+
+    void set_zero() const { set_constant(0.0); }
+    void set_constant(real_t c) const { std::fill(data_, data_ + size(), c); }
+    template <typename OtherRealT>
+    void copy_values(FixedTensor<OtherRealT, Extents...> const& other) const {
+        std::copy(other.data(), other.data() + size(), data_);
+    }
+
+protected:
+    template <std::size_t... Is, typename... Entry>
+    static constexpr index_t address(std::index_sequence<Is...>, Entry... entry) {
+        assert(((entry >= 0 && entry < shape(Is)) && ...));
+        return ((static_cast<index_t>(entry) * stride(Is)) + ...);
+    }
+
+    real_t* data_;
+};
+
+namespace detail {
+template <typename RealT, std::size_t... Extents> struct traits<FixedTensor<RealT, Extents...>> {
+    using real_t = RealT;
+    static constexpr std::size_t Dim = sizeof...(Extents);
+    static constexpr bool Packed = true;
+};
+template <typename RealT, std::size_t... Extents>
+struct traits<const FixedTensor<RealT, Extents...>> : traits<FixedTensor<RealT, Extents...>> {};
+
+template <typename RealT, std::size_t... Extents>
+std::true_type is_fixed_tensor_impl(FixedTensor<RealT, Extents...> const*);
+std::false_type is_fixed_tensor_impl(...);
+template <typename T>
+constexpr bool is_fixed_tensor_v = decltype(is_fixed_tensor_impl(std::declval<T*>()))::value;
+} // namespace detail
+
+/**
+ * @brief Returns a FixedTensor view on the leading dimensions of a packed tensor.
+ *
+ * E.g. for a Jacobian with shape (D, D, numPoints), fixed_subtensor<D, D>(J, q) is equivalent
+ * to J.subtensor(slice{}, slice{}, q) but has compile-time shape and stride.
+ *
+ * @param tensor Packed tensor whose leading shape equals Extents
+ * @param trailing Indices of the remaining dimensions
+ */
+template <std::size_t... Extents, typename TensorType, typename... Trailing>
+auto fixed_subtensor(TensorType&& tensor, Trailing... trailing) {
+    using traits = detail::traits<std::remove_cv_t<std::remove_reference_t<TensorType>>>;
+    static_assert(traits::Packed, "Leading dimensions of fixed subtensor must be packed.");
+    static_assert(sizeof...(Extents) + sizeof...(Trailing) == traits::Dim);
+    using real_t = std::remove_pointer_t<decltype(tensor.data())>;
+    using fixed_t = FixedTensor<real_t, Extents...>;
+    using index_t = typename fixed_t::index_t;
+    for (std::size_t d = 0; d < sizeof...(Extents); ++d) {
+        assert(tensor.shape(d) == fixed_t::shape(d));
+    }
+    std::array<index_t, sizeof...(Trailing)> t{static_cast<index_t>(trailing)...};
+    index_t addr = 0;
+    for (std::size_t d = 0; d < sizeof...(Trailing); ++d) {
+        assert(t[d] >= 0 && t[d] < tensor.shape(sizeof...(Extents) + d));
+        addr += t[d] * tensor.stride(sizeof...(Extents) + d);
+    }
+    return fixed_t(tensor.data() + addr);
+}
+
+/**
+ * @brief Fixed-shape tensor with inline (stack) storage.
+ */
+template <typename RealT, std::size_t... Extents>
+class Managed<FixedTensor<RealT, Extents...>> : public FixedTensor<RealT, Extents...> {
+public:
+    using Base = FixedTensor<RealT, Extents...>;
+    using typename Base::real_t;
+
+    Managed() : Base(storage_.data()) {}
+    Managed(Managed const& other) : Base(storage_.data()), storage_(other.storage_) {}
+    Managed& operator=(Managed const& other) {
+        storage_ = other.storage_;
+        return *this;
+    }
+    Managed(Managed&& other) : Managed(static_cast<Managed const&>(other)) {}
+    Managed& operator=(Managed&& other) { return *this = static_cast<Managed const&>(other); }
+
+    Base view() const { return *this; }
+
+private:
+    std::array<std::remove_const_t<real_t>, Base::size()> storage_;
+};
+
+namespace detail {
+template <typename RealT, std::size_t... Extents>
+struct traits<Managed<FixedTensor<RealT, Extents...>>> : traits<FixedTensor<RealT, Extents...>> {};
+} // namespace detail
+
+template <typename real_t, std::size_t N> using FixedVector = FixedTensor<real_t, N>;
+template <typename real_t, std::size_t M, std::size_t N>
+using FixedMatrix = FixedTensor<real_t, M, N>;
+
+} // namespace tndm
+
+#endif // FIXEDTENSOR_20261018_H
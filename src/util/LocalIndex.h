@@ -0,0 +1,26 @@
+#ifndef LOCALINDEX_20261018_H
+#define LOCALINDEX_20261018_H
+
+#include <cstdint>
+
+namespace tndm {
+
+/**
+ * @brief Integer type for rank-local indices (connectivity, neighbour lists, scatter indices).
+ *
+ * A partition never holds more than 2^32 entities, hence 32 bit suffice and halve the
+ * memory traffic of index arrays compared to std::size_t.
+ * Global ids remain 64 bit. In particular, Simplex<D> stays 64 bit: it stores global vertex ids,
+ * which identify faces across ranks (e.g. as keys of LocalFaces::g2l) and exceed 2^32 for
+ * large meshes.
+ * Configure with -DLOCAL_INDEX_64=ON to use 64 bit local indices.
+ */
+#ifdef TANDEM_LOCAL_INDEX_64
+using local_index_t = uint64_t;
+#else
+using local_index_t = uint32_t;
+#endif
+
+} // namespace tndm
+
+#endif // LOCALINDEX_20261018_H
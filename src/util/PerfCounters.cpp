@@ -0,0 +1,87 @@
+#include "PerfCounters.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tndm {
+
+std::unique_ptr<PerfCounters> PerfCounters::instance_ = nullptr;
+
+#ifdef __linux__
+namespace {
+int open_event(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    // Child threads created later are counted; threads that already run are not
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    return fd;
+}
+} // namespace
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+    fds_[Cycles] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds_[Instructions] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds_[LLCMisses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    char const* fp_event = std::getenv("TANDEM_PERF_FP_EVENT");
+    if (fp_event) {
+        fds_[FPOps] = open_event(PERF_TYPE_RAW, std::strtoull(fp_event, nullptr, 16));
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (auto fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounters::read(values_t& values) const {
+    for (int e = 0; e < NumEvents; ++e) {
+        values[e] = 0;
+        uint64_t buf[3];
+        if (fds_[e] >= 0 && ::read(fds_[e], buf, sizeof(buf)) == sizeof(buf) && buf[2] > 0) {
+            values[e] = buf[1] == buf[2]
+                            ? buf[0]
+                            : static_cast<uint64_t>(static_cast<double>(buf[0]) * buf[1] / buf[2]);
+        }
+    }
+}
+#else
+PerfCounters::PerfCounters() { fds_.fill(-1); }
+PerfCounters::~PerfCounters() {}
+void PerfCounters::read(values_t& values) const { values.fill(0); }
+#endif
+
+bool PerfCounters::enable() {
+    if (!instance_) {
+        instance_ = std::make_unique<PerfCounters>();
+    }
+    return instance_->available();
+}
+
+PerfCounters const* PerfCounters::instance() {
+    return instance_ && instance_->available() ? instance_.get() : nullptr;
+}
+
+} // namespace tndm
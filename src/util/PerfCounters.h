@@ -0,0 +1,64 @@
+#ifndef PERFCOUNTERS_20261018_H
+#define PERFCOUNTERS_20261018_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace tndm {
+
+/**
+ * @brief Hardware performance counters read via Linux perf_event_open.
+ *
+ * Counts cycles, instructions, and last level cache misses of the calling thread and of
+ * threads created after construction (user space only).
+ * There is no portable floating point event; a raw event config (e.g. FP_ARITH_INST_RETIRED
+ * on Intel) may be given in the environment variable TANDEM_PERF_FP_EVENT as hex number.
+ *
+ * Events which cannot be opened (other OS, perf_event_paranoid, no PMU in VMs) are reported
+ * as unavailable and read as zero.
+ */
+class PerfCounters {
+public:
+    enum Event : int { Cycles = 0, Instructions, LLCMisses, FPOps, NumEvents };
+    using values_t = std::array<uint64_t, NumEvents>;
+
+    constexpr static uint64_t CacheLineSize = 64;
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(PerfCounters const&) = delete;
+    PerfCounters& operator=(PerfCounters const&) = delete;
+
+    /**
+     * @brief True if cycles and instructions are counted.
+     */
+    inline bool available() const { return available(Cycles) && available(Instructions); }
+    inline bool available(Event event) const { return fds_[event] >= 0; }
+
+    /**
+     * @brief Reads the current counter values (scaled if the PMU is multiplexed).
+     */
+    void read(values_t& values) const;
+
+    /**
+     * @brief Opens the process-wide counters used by Profile.
+     *
+     * @return True if counters are available
+     */
+    static bool enable();
+    /**
+     * @brief Process-wide counters; nullptr unless enable() succeeded.
+     */
+    static PerfCounters const* instance();
+
+private:
+    std::array<int, NumEvents> fds_;
+
+    static std::unique_ptr<PerfCounters> instance_;
+};
+
+} // namespace tndm
+
+#endif // PERFCOUNTERS_20261018_H
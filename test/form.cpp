@@ -1,17 +1,27 @@
 #include "basis/Nodal.h"
 #include "basis/WarpAndBlend.h"
+#include "form/ExteriorDtN.h"
+#include "form/FiniteElementFunction.h"
+#include "form/FunctionSnapshot.h"
 #include "form/RefElement.h"
+#include "form/SumFactorization.h"
 #include "quadrules/AutoRule.h"
 #include "quadrules/SimplexQuadratureRule.h"
+#include "quadrules/TensorProductRule.h"
 #include "tensor/EigenMap.h"
 #include "tensor/Managed.h"
 #include "tensor/Tensor.h"
+#include "util/Combinatorics.h"
 
 #include "doctest.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <memory>
+#include <sstream>
+#include <type_traits>
 #include <vector>
 
 using namespace tndm;
@@ -88,3 +98,187 @@ TEST_CASE("Projection") {
         CHECK(F_Q(q) == doctest::Approx(F_Q_test(q)));
     }
 }
+
+TEST_CASE_TEMPLATE("Degree projector", D, std::integral_constant<std::size_t, 2u>,
+                   std::integral_constant<std::size_t, 3u>) {
+    constexpr unsigned N = 4;
+    auto modal = ModalRefElement<D::value>(N);
+    auto nodal = NodalRefElement<D::value>(N, WarpAndBlendFactory<D::value>());
+    std::size_t nbf = modal.numBasisFunctions();
+
+    for (unsigned p = 0; p <= N + 1; ++p) {
+        auto num_kept = static_cast<double>(binom(std::min(p, N) + D::value, D::value));
+        using space_t = RefElement<D::value> const*;
+        for (space_t space : {space_t(&modal), space_t(&nodal)}) {
+            auto P = space->degreeProjector(p);
+            auto P_map = EigenMap(P);
+            CHECK((P_map - P_map.transpose()).norm() < 1.0e-12);
+            CHECK((P_map * P_map - P_map).norm() < 1.0e-12);
+            CHECK(P_map.trace() == doctest::Approx(num_kept));
+        }
+
+        // Nodal values of x^p are kept, those of x^(p+1) are not
+        auto P = nodal.degreeProjector(p);
+        for (unsigned k : {p, p + 1}) {
+            auto u = Eigen::VectorXd(nbf);
+            for (std::size_t i = 0; i < nbf; ++i) {
+                u(i) = std::pow(nodal.refNodes()[i][0], k);
+            }
+            double err = (EigenMap(P) * u - u).norm();
+            if (k <= p || k > N) {
+                CHECK(err < 1.0e-12);
+            } else {
+                CHECK(err > 1.0e-6);
+            }
+        }
+    }
+}
+
+TEST_CASE("Function snapshot") {
+    constexpr unsigned degree = 2;
+    const auto test_fun = [](std::array<double, 2> const& x) {
+        return x[0] * x[0] - x[0] * x[1] + 3.0 * x[1] + 1.0;
+    };
+
+    // Unit square split into two triangles
+    auto vertices = std::vector<FunctionSnapshot<2u, 2u>::vertices_t>{
+        {{{0.0, 0.0}, {1.0, 0.0}, {0.0, 1.0}}}, {{{1.0, 1.0}, {0.0, 1.0}, {1.0, 0.0}}}};
+    auto space = NodalRefElement<2u>(degree, WarpAndBlendFactory<2u>());
+    auto function = FiniteElementFunction<2u>(space.clone(), 1, vertices.size());
+    for (std::size_t elNo = 0; elNo < vertices.size(); ++elNo) {
+        auto const& v = vertices[elNo];
+        for (std::size_t node = 0; node < space.numBasisFunctions(); ++node) {
+            auto const& xi = space.refNodes()[node];
+            std::array<double, 2> x;
+            for (std::size_t d = 0; d < 2; ++d) {
+                x[d] = v[0][d] + xi[0] * (v[1][d] - v[0][d]) + xi[1] * (v[2][d] - v[0][d]);
+            }
+            function.values()(node, 0, elNo) = test_fun(x);
+        }
+    }
+
+    auto snapshot = FunctionSnapshot<2u, 2u>(function, vertices);
+    std::stringstream stream;
+    snapshot.write(stream);
+    auto copy = FunctionSnapshot<2u, 2u>::read(stream);
+    REQUIRE(copy.numElements() == 2);
+    REQUIRE(copy.numQuantities() == 1);
+
+    double result;
+    for (auto const& x : std::vector<std::array<double, 2>>{
+             {0.1, 0.2}, {0.9, 0.8}, {0.5, 0.5}, {0.0, 1.0}, {0.75, 0.1}}) {
+        copy.evaluate(x, &result);
+        CHECK(result == doctest::Approx(test_fun(x)));
+    }
+
+    // Points outside are evaluated at the closest point
+    copy.evaluate({1.5, 0.5}, &result);
+    CHECK(result == doctest::Approx(test_fun({1.0, 0.5})));
+    copy.evaluate({-3.0, -2.0}, &result);
+    CHECK(result == doctest::Approx(test_fun({0.0, 0.0})));
+}
+
+TEST_CASE("Exterior Dirichlet-to-Neumann map") {
+    // u = x / r^2 is harmonic outside the unit circle, bounded, and satisfies du/dy = 0 on y = 0
+    auto test_dtn = [](LaplaceExteriorDtN<2u> const& dtn, std::vector<std::array<double, 2>> x) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            double t = 0.0;
+            double t_const = 0.0;
+            for (std::size_t j = 0; j < x.size(); ++j) {
+                t += dtn.matrix()(i, j) * x[j][0];
+                t_const += dtn.matrix()(i, j);
+            }
+            CHECK(t == doctest::Approx(-x[i][0]).epsilon(0.01));
+            CHECK(t_const == doctest::Approx(0.0));
+        }
+    };
+
+    SUBCASE("Full space") {
+        constexpr std::size_t n = 128;
+        std::vector<std::array<double, 2>> x(n);
+        std::vector<double> w(n, 2.0 * M_PI / n);
+        for (std::size_t i = 0; i < n; ++i) {
+            double phi = 2.0 * M_PI * (i + 0.5) / n;
+            x[i] = {std::cos(phi), std::sin(phi)};
+        }
+        auto dtn = LaplaceExteriorDtN<2u>(x, x, w);
+        REQUIRE(dtn.size() == n);
+        test_dtn(dtn, x);
+    }
+
+    SUBCASE("Half space") {
+        constexpr std::size_t n = 64;
+        std::vector<std::array<double, 2>> x(n);
+        std::vector<double> w(n, M_PI / n);
+        for (std::size_t i = 0; i < n; ++i) {
+            double phi = -M_PI * (i + 0.5) / n;
+            x[i] = {std::cos(phi), std::sin(phi)};
+        }
+        auto dtn = LaplaceExteriorDtN<2u>(x, x, w, FreeSurfacePlane<2u>{{0.0, 1.0}, 0.0});
+        test_dtn(dtn, x);
+    }
+}
+
+TEST_CASE_TEMPLATE("Sum factorization", D, std::integral_constant<std::size_t, 2u>,
+                   std::integral_constant<std::size_t, 3u>) {
+    for (unsigned N = 0; N <= 5; ++N) {
+        auto sf = SumFactorization<D::value>(N, 2 * N + 1);
+        auto rule = SumFactorization<D::value>::rule(2 * N + 1);
+        REQUIRE(rule.size() == sf.numQuadPoints());
+        CHECK(sf.scratch_size() ==
+              SumFactorization<D::value>::scratch_size(
+                  N, TensorProductRule<D::value>::pointsPerDim(2 * N + 1)));
+
+        auto refElement = ModalRefElement<D::value>(N);
+        auto E = refElement.evaluateBasisAt(rule.points());
+        auto Dxi = refElement.evaluateGradientAt(rule.points());
+        REQUIRE(E.shape(0) == sf.numBasisFunctions());
+
+        std::vector<double> scratch(sf.scratch_size());
+        std::vector<double> coeffs(sf.numBasisFunctions());
+        for (std::size_t k = 0; k < coeffs.size(); ++k) {
+            coeffs[k] = std::sin(1.0 + k);
+        }
+        std::vector<double> values(rule.size());
+        std::vector<double> grad(D::value * rule.size());
+        sf.evaluate(coeffs.data(), values.data(), scratch.data());
+        sf.evaluate_gradient(coeffs.data(), grad.data(), scratch.data());
+        for (std::size_t q = 0; q < rule.size(); ++q) {
+            double value = 0.0;
+            for (std::size_t k = 0; k < coeffs.size(); ++k) {
+                value += E(k, q) * coeffs[k];
+            }
+            CHECK(values[q] == doctest::Approx(value));
+            for (std::size_t e = 0; e < D::value; ++e) {
+                double g = 0.0;
+                for (std::size_t k = 0; k < coeffs.size(); ++k) {
+                    g += Dxi(k, e, q) * coeffs[k];
+                }
+                CHECK(grad[e + D::value * q] == doctest::Approx(g));
+            }
+        }
+
+        for (std::size_t q = 0; q < rule.size(); ++q) {
+            values[q] = std::cos(1.0 + q);
+            for (std::size_t e = 0; e < D::value; ++e) {
+                grad[e + D::value * q] = std::cos(1.0 + q + e);
+            }
+        }
+        std::vector<double> result(coeffs.size());
+        std::vector<double> result_grad(coeffs.size());
+        sf.integrate(values.data(), result.data(), scratch.data());
+        sf.integrate_gradient(grad.data(), result_grad.data(), scratch.data());
+        for (std::size_t k = 0; k < coeffs.size(); ++k) {
+            double r = 0.0;
+            double r_grad = 0.0;
+            for (std::size_t q = 0; q < rule.size(); ++q) {
+                r += E(k, q) * std::cos(1.0 + q);
+                for (std::size_t e = 0; e < D::value; ++e) {
+                    r_grad += Dxi(k, e, q) * std::cos(1.0 + q + e);
+                }
+            }
+            CHECK(result[k] == doctest::Approx(r));
+            CHECK(result_grad[k] == doctest::Approx(r_grad));
+        }
+    }
+}
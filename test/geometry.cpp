@@ -238,3 +238,64 @@ TEST_CASE("Point locator") {
         }
     }
 }
+
+TEST_CASE("Graded mesh") {
+    constexpr std::size_t D = 2;
+
+    SUBCASE("Uniform without faults") {
+        auto x = GenMesh<D>::gradedPoints(0.0, 1.0, {}, 0.1, 0.25, 1.2);
+        REQUIRE(x.size() == 5);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            CHECK(x[i] == doctest::Approx(0.25 * i));
+        }
+    }
+
+    SUBCASE("Graded towards fault") {
+        auto x = GenMesh<D>::gradedPoints(-10.0, 10.0, {{0.0, 0.0}}, 0.01, 1.0, 1.1);
+        CHECK(x.front() == -10.0);
+        CHECK(x.back() == 10.0);
+        auto h_min = 1.0;
+        auto h_max = 0.0;
+        for (std::size_t i = 1; i < x.size(); ++i) {
+            double h = x[i] - x[i - 1];
+            REQUIRE(h > 0.0);
+            h_min = std::min(h_min, h);
+            h_max = std::max(h_max, h);
+            if (i > 1) {
+                double ratio = h / (x[i - 1] - x[i - 2]);
+                CHECK(ratio < 1.15);
+                CHECK(ratio > 1.0 / 1.15);
+            }
+        }
+        CHECK(h_min < 0.012);
+        CHECK(h_max > 0.95);
+        CHECK(x.size() < 100);
+    }
+
+    SUBCASE("Refined along fault region") {
+        auto x = GenMesh<D>::gradedPoints(0.0, 1.0, {{0.25, 0.5}}, 0.01, 0.1, 1.1);
+        for (std::size_t i = 1; i < x.size(); ++i) {
+            double h = x[i] - x[i - 1];
+            if (x[i - 1] >= 0.25 && x[i] <= 0.5) {
+                CHECK(h < 0.0105);
+            }
+            if (x[i - 1] >= 0.75) {
+                CHECK(h > 0.03);
+            }
+        }
+    }
+
+    SUBCASE("Fault extents") {
+        auto points = std::array<std::vector<double>, D>{{{0.0, 1.0, 2.0}, {-2.0, -1.0, 0.0}}};
+        auto BCs = std::array<GenMesh<D>::bc_fun_t, D>{};
+        BCs[0] = [](std::size_t plane, std::array<std::size_t, D - 1u> const& region) {
+            return plane == 1 && region[0] == 1 ? BC::Fault : BC::Dirichlet;
+        };
+        BCs[1] = [](std::size_t, std::array<std::size_t, D - 1u> const&) { return BC::Natural; };
+        auto extents = GenMesh<D>::faultExtents(points, BCs);
+        REQUIRE(extents[0].size() == 1);
+        CHECK(extents[0][0] == std::make_pair(1.0, 1.0));
+        REQUIRE(extents[1].size() == 1);
+        CHECK(extents[1][0] == std::make_pair(-1.0, 0.0));
+    }
+}
@@ -1,11 +1,20 @@
 #include "io/GMSHLexer.h"
 #include "io/GMSHParser.h"
+#include "io/GMSHRecorder.h"
+#include "io/SparseSnapshotWriter.h"
+#include "io/TiledMatrixFile.h"
+#include "tensor/Managed.h"
 
 #include "doctest.h"
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
 #include <string_view>
+#include <vector>
 
 using namespace tndm;
 
@@ -49,8 +58,8 @@ public:
     }
 };
 
-TEST_CASE("GMSH") {
-    char msh[] = R"MSH($MeshFormat
+namespace {
+char gmsh_test_mesh[] = R"MSH($MeshFormat
 2.2 0 8
 $EndMeshFormat
 $Nodes
@@ -84,11 +93,139 @@ $NodeData
 6 0.4
 $EndNodeData
 )MSH";
+} // namespace
 
+TEST_CASE("GMSH") {
     MyTestBuilder builder;
     GMSHParser parser(&builder);
-    bool ok = parser.parse(msh, sizeof(msh));
+    bool ok = parser.parse(gmsh_test_mesh, sizeof(gmsh_test_mesh));
     if (!ok) {
         std::cout << parser.getErrorMessage();
     }
 }
+
+TEST_CASE("GMSH round trip") {
+    MyTestBuilder builder;
+    GMSHRecorder rec(&builder);
+    GMSHParser parser(&rec);
+    REQUIRE(parser.parse(gmsh_test_mesh, sizeof(gmsh_test_mesh)));
+    REQUIRE(rec.records.size() == 2);
+    CHECK(rec.records[0].physicalTag == 99);
+    CHECK(rec.records[0].elementaryTag == 2);
+    CHECK(rec.records[1].physicalTag == 97);
+    CHECK(rec.records[1].elementaryTag == -1);
+
+    rec.vertices[2][0] = 1.0 / 3.0;
+    auto file_name = (std::filesystem::temp_directory_path() / "tandem_test_round.msh").string();
+    rec.write(file_name);
+    GMSHRecorder rec2;
+    GMSHParser parser2(&rec2);
+    bool ok = parser2.parseFile(file_name);
+    if (!ok) {
+        std::cout << parser2.getErrorMessage();
+    }
+    REQUIRE(ok);
+    std::filesystem::remove(file_name);
+
+    CHECK(rec2.vertices == rec.vertices);
+    REQUIRE(rec2.records.size() == rec.records.size());
+    for (std::size_t i = 0; i < rec.records.size(); ++i) {
+        CHECK(rec2.records[i].type == rec.records[i].type);
+        CHECK(rec2.records[i].physicalTag == rec.records[i].physicalTag);
+        CHECK(rec2.records[i].elementaryTag == rec.records[i].elementaryTag);
+        CHECK(rec2.records[i].nodes == rec.records[i].nodes);
+    }
+}
+
+TEST_CASE("Tiled matrix file") {
+    constexpr std::size_t rows = 7;
+    constexpr std::size_t cols = 11;
+    auto A = [](std::size_t i, std::size_t j) { return 1.0 + i + 0.5 * j * j; };
+    auto x = std::vector<double>(cols);
+    for (std::size_t j = 0; j < cols; ++j) {
+        x[j] = 1.0 / (1.0 + j);
+    }
+    auto y_ref = std::vector<double>(rows, 0.0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            y_ref[i] += A(i, j) * x[j];
+        }
+    }
+
+    auto file_name = (std::filesystem::temp_directory_path() / "tandem_test_tiled.bin").string();
+    for (std::size_t tile_cols : {1, 3, 11, 64}) {
+        auto tmf = TiledMatrixFile(file_name, rows, cols, tile_cols);
+        auto column = std::vector<double>(rows);
+        for (std::size_t j = 0; j < cols; ++j) {
+            for (std::size_t i = 0; i < rows; ++i) {
+                column[i] = A(i, j);
+            }
+            tmf.write_column(j, column.data());
+        }
+        auto y = std::vector<double>(rows);
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            tmf.mult(x.data(), y.data());
+            for (std::size_t i = 0; i < rows; ++i) {
+                CHECK(y[i] == doctest::Approx(y_ref[i]));
+            }
+        }
+        uint64_t bytes_column = rows * sizeof(double);
+        uint64_t bytes_first_tile = std::min(tile_cols, cols) * bytes_column;
+        if (tmf.num_tiles() == 1) {
+            CHECK(tmf.bytes_read() == tmf.bytes());
+        } else {
+            CHECK(tmf.bytes_read() == 3 * tmf.bytes() + bytes_first_tile);
+        }
+
+        auto subset = std::vector<std::size_t>{0, 1, 2, 5, 9, 10};
+        auto x_subset = std::vector<double>(subset.size());
+        auto y_subset = y_ref;
+        for (std::size_t k = 0; k < subset.size(); ++k) {
+            x_subset[k] = -2.0 * k;
+            for (std::size_t i = 0; i < rows; ++i) {
+                y_subset[i] += A(i, subset[k]) * x_subset[k];
+            }
+        }
+        tmf.mult_add_columns(subset.size(), subset.data(), x_subset.data(), y.data());
+        for (std::size_t i = 0; i < rows; ++i) {
+            CHECK(y[i] == doctest::Approx(y_subset[i]));
+        }
+        if (tmf.num_tiles() > 1) {
+            CHECK(tmf.bytes_read() ==
+                  3 * tmf.bytes() + bytes_first_tile + subset.size() * bytes_column);
+        }
+    }
+    CHECK(!std::filesystem::exists(file_name));
+}
+
+TEST_CASE("Sparse snapshot writer") {
+    constexpr std::size_t points = 3;
+    constexpr std::size_t blocks = 4;
+    auto ids = std::vector<uint64_t>{10, 11, 12, 13};
+    auto coords = std::vector<double>(blocks * points * 2, 0.0);
+    auto file_name = (std::filesystem::temp_directory_path() / "tandem_test_sparse.sfo").string();
+    auto writer = SparseSnapshotWriter(file_name, {"state", "slip-rate0"}, ids, points, 2, coords,
+                                       {{0, 0.1}, {1, 1e-3}}, 3);
+
+    auto values = Managed<Tensor<double, 3u>>(points, 2, blocks);
+    values.set_zero();
+    CHECK(writer.write(0.0, values) == blocks);
+    CHECK(writer.write(1.0, values) == 0);
+
+    values(1, 0, 2) = 0.05;
+    CHECK(writer.write(2.0, values) == 0);
+    values(2, 1, 0) = 0.01;
+    values(1, 0, 2) = 0.15;
+    CHECK(writer.write(3.0, values) == blocks);
+    values(0, 0, 3) = 0.2;
+    CHECK(writer.write(4.0, values) == 1);
+
+    auto header_bytes = 8 + 2 * 4 + 3 * 8 + (4 + 5) + (4 + 10) + blocks * 8 + coords.size() * 8;
+    auto snapshot_bytes = [&](std::size_t count) {
+        return 8 + 1 + 8 + count * 8 + count * 2 * points * 8;
+    };
+    CHECK(writer.bytes_written() == header_bytes + 2 * snapshot_bytes(blocks) +
+                                        2 * snapshot_bytes(0) + snapshot_bytes(1));
+    CHECK(std::filesystem::file_size(file_name) == writer.bytes_written());
+    std::filesystem::remove(file_name);
+}
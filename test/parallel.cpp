@@ -1,10 +1,64 @@
+#include "basis/WarpAndBlend.h"
 #include "doctest.h"
+#include "form/FiniteElementFunction.h"
+#include "form/FunctionSnapshot.h"
+#include "form/RefElement.h"
+#include "interface/BlockVector.h"
+#include "parallel/MultiScatter.h"
+#include "parallel/RankPlacement.h"
+#include "parallel/ScatterPlan.h"
 #include "parallel/SortedDistribution.h"
+#include "parallel/SparseBlockVector.h"
+#include "util/LocalIndex.h"
+
+#include <mpi.h>
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 
+using tndm::BlockVector;
+using tndm::FiniteElementFunction;
+using tndm::FunctionSnapshot;
+using tndm::Matrix;
+using tndm::MultiScatter;
+using tndm::NodalRefElement;
+using tndm::RankPlacement;
+using tndm::ScatterPlan;
+using tndm::local_index_t;
 using tndm::SortedDistributionToRank;
+using tndm::SparseBlockVector;
+using tndm::Vector;
+using tndm::WarpAndBlendFactory;
+
+namespace {
+class SimpleBlockVector : public BlockVector {
+public:
+    SimpleBlockVector(std::size_t bs, std::size_t num) : bs_(bs), data_(bs * num) {}
+    std::size_t block_size() const override { return bs_; }
+    void begin_assembly() override {}
+    void add_block(std::size_t, Vector<double> const&) override {}
+    void add_block(std::size_t, Vector<const double> const&) override {}
+    void insert_block(std::size_t, Vector<double> const&) override {}
+    void insert_block(std::size_t, Vector<const double> const&) override {}
+    void end_assembly() override {}
+    void set_zero() override { std::fill(data_.begin(), data_.end(), 0.0); }
+    Matrix<double> begin_access() override {
+        return Matrix<double>(data_.data(), bs_, data_.size() / bs_);
+    }
+    void end_access(Matrix<double>&) override {}
+    Matrix<const double> begin_access_readonly() const override {
+        return Matrix<const double>(data_.data(), bs_, data_.size() / bs_);
+    }
+    void end_access_readonly(Matrix<const double>&) const override {}
+
+    std::vector<double>& data() { return data_; }
+
+private:
+    std::size_t bs_;
+    std::vector<double> data_;
+};
+} // namespace
 
 TEST_CASE("parallel") {
     SUBCASE("SortedDistributionToRank") {
@@ -16,4 +70,116 @@ TEST_CASE("parallel") {
         CHECK(p2r(14) == 2);
         CHECK(p2r(0) == 0);
     }
+
+    SUBCASE("RankPlacement") {
+        // Round-robin placement of 4 ranks on 2 nodes
+        auto node_of_rank = std::vector<int>{0, 1, 0, 1};
+        auto graph = RankPlacement::graph_t(4);
+        auto add_edge = [&graph](int p, int q, uint64_t w) {
+            graph[p][q] += w;
+            graph[q][p] += w;
+        };
+        add_edge(0, 1, 100);
+        add_edge(1, 2, 1);
+        add_edge(2, 3, 100);
+
+        auto before = RankPlacement::volume(graph, node_of_rank, {0, 1, 2, 3});
+        CHECK(before.on_node == 0);
+        CHECK(before.off_node == 201);
+
+        auto rank_of_part = RankPlacement::greedy(graph, node_of_rank);
+        CHECK(rank_of_part == std::vector<int>{0, 2, 1, 3});
+        auto after = RankPlacement::volume(graph, node_of_rank, rank_of_part);
+        CHECK(after.on_node == 200);
+        CHECK(after.off_node == 1);
+    }
+
+    SUBCASE("SparseBlockVector") {
+        auto indices = std::vector<local_index_t>{7, 3, 5};
+        auto v = SparseBlockVector<double>(indices, 2);
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            v.data()[2 * i] = i;
+            v.data()[2 * i + 1] = -1.0 * i;
+        }
+        CHECK(v.has_block(3));
+        CHECK(v.has_block(5));
+        CHECK(v.has_block(7));
+        CHECK(!v.has_block(4));
+        CHECK(!v.has_block(8));
+        CHECK(v.get_block(3)(0) == 1.0);
+        CHECK(v.get_block(5)(1) == -2.0);
+        CHECK(v.get_block(7)(0) == 0.0);
+    }
+
+    SUBCASE("MultiScatter") {
+        // Two fields exchanged with the own rank, i.e. one message per exchange
+        auto planA = std::make_shared<ScatterPlan>(ScatterPlan::index_map_t{{0, {1, 3}}},
+                                                   ScatterPlan::index_map_t{{0, {5, 6}}},
+                                                   MPI_COMM_SELF);
+        auto planB = std::make_shared<ScatterPlan>(ScatterPlan::index_map_t{{0, {0}}},
+                                                   ScatterPlan::index_map_t{{0, {2}}},
+                                                   MPI_COMM_SELF);
+        auto scatter = MultiScatter();
+        auto a = scatter.add_field(planA, 2);
+        auto b = scatter.add_field(planB, 3);
+        CHECK(scatter.num_fields() == 2);
+        CHECK(scatter.num_send_messages() == 1);
+
+        auto xA = SimpleBlockVector(2, 4);
+        auto xB = SimpleBlockVector(3, 2);
+        for (std::size_t i = 0; i < xA.data().size(); ++i) {
+            xA.data()[i] = i;
+        }
+        for (std::size_t i = 0; i < xB.data().size(); ++i) {
+            xB.data()[i] = -1.0 * i;
+        }
+        auto ghostA = scatter.recv_prototype(a);
+        auto ghostB = scatter.recv_prototype(b);
+        scatter.begin_scatter({{&xA, &ghostA}, {&xB, &ghostB}});
+        scatter.wait_scatter();
+
+        CHECK(ghostA.get_block(5)(0) == 2.0);
+        CHECK(ghostA.get_block(5)(1) == 3.0);
+        CHECK(ghostA.get_block(6)(0) == 6.0);
+        CHECK(ghostA.get_block(6)(1) == 7.0);
+        for (std::size_t i = 0; i < 3; ++i) {
+            CHECK(ghostB.get_block(2)(i) == -1.0 * i);
+        }
+    }
+}
+
+TEST_CASE("Function snapshot gather") {
+    int rank, procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &procs);
+
+    // Rank r owns r + 1 triangles in the strip [r, r + 1] x [0, r + 1] where the function is r;
+    // the last rank owns no triangles
+    int const empty_rank = procs > 1 ? procs - 1 : -1;
+    auto vertices = std::vector<FunctionSnapshot<2u, 2u>::vertices_t>{};
+    for (int i = 0; i <= rank && rank != empty_rank; ++i) {
+        vertices.push_back({{{1.0 * rank, 1.0 * i},
+                             {rank + 1.0, 1.0 * i},
+                             {1.0 * rank, i + 1.0}}});
+    }
+    auto space = NodalRefElement<2u>(1, WarpAndBlendFactory<2u>());
+    auto function = FiniteElementFunction<2u>(space.clone(), 1, vertices.size());
+    for (std::size_t elNo = 0; elNo < vertices.size(); ++elNo) {
+        for (std::size_t node = 0; node < space.numBasisFunctions(); ++node) {
+            function.values()(node, 0, elNo) = rank;
+        }
+    }
+
+    auto snapshot = FunctionSnapshot<2u, 2u>::gather(function, vertices, MPI_COMM_WORLD, 0);
+    if (rank == 0) {
+        int const owners = procs > 1 ? procs - 1 : 1;
+        REQUIRE(snapshot.numElements() == static_cast<std::size_t>(owners * (owners + 1) / 2));
+        for (int p = 0; p < owners; ++p) {
+            double result;
+            snapshot.evaluate({p + 0.2, p + 0.2}, &result);
+            CHECK(result == doctest::Approx(p));
+        }
+    } else {
+        CHECK(snapshot.numElements() == 0);
+    }
 }
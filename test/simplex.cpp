@@ -1,8 +1,17 @@
+#include "form/BC.h"
+#include "mesh/Refinement.h"
 #include "mesh/Simplex.h"
 #include "doctest.h"
 
 #include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <vector>
 
+using tndm::BC;
+using tndm::BisectionRefinement;
 using tndm::Simplex;
 
 TEST_CASE("Simplex") {
@@ -63,3 +72,100 @@ TEST_CASE("Simplex") {
         }
     }
 }
+
+template <std::size_t D> void check_conforming(BisectionRefinement<D> const& refinement) {
+    auto const& verts = refinement.vertices();
+    double volume = 0.0;
+    std::map<Simplex<D - 1u>, int> facetCount;
+    for (auto const& elem : refinement.elements()) {
+        double J[D][D];
+        for (std::size_t i = 0; i < D; ++i) {
+            for (std::size_t j = 0; j < D; ++j) {
+                J[i][j] = verts[elem[j + 1]][i] - verts[elem[0]][i];
+            }
+        }
+        double det = D == 2u ? J[0][0] * J[1][1] - J[0][1] * J[1][0]
+                             : J[0][0] * (J[1][1] * J[2][2] - J[1][2] * J[2][1]) -
+                                   J[0][1] * (J[1][0] * J[2][2] - J[1][2] * J[2][0]) +
+                                   J[0][2] * (J[1][0] * J[2][1] - J[1][1] * J[2][0]);
+        CHECK(std::fabs(det) > 0.0);
+        volume += std::fabs(det) / (D == 2u ? 2.0 : 6.0);
+        for (auto const& fct : elem.downward()) {
+            ++facetCount[fct];
+        }
+    }
+    CHECK(volume == doctest::Approx(1.0));
+
+    // Without hanging nodes, facets with a single neighbour are exactly the boundary facets
+    std::set<Simplex<D - 1u>> boundary;
+    for (auto const& [fct, count] : facetCount) {
+        CHECK(count <= 2);
+        if (count == 1) {
+            boundary.insert(fct);
+        }
+    }
+    auto const& fcts = refinement.facets();
+    CHECK(std::set<Simplex<D - 1u>>(fcts.begin(), fcts.end()) == boundary);
+}
+
+TEST_CASE("Bisection refinement") {
+    SUBCASE("2D") {
+        auto refinement = BisectionRefinement<2u>(
+            {{0.0, 0.0}, {1.0, 0.0}, {0.0, 1.0}, {1.0, 1.0}}, {{0, 1, 2}, {1, 2, 3}},
+            {{0, 1}, {0, 2}, {1, 3}, {2, 3}},
+            {BC::Dirichlet, BC::Dirichlet, BC::Natural, BC::Natural});
+        for (int step = 0; step < 6; ++step) {
+            refinement.refine({0});
+            check_conforming(refinement);
+        }
+        CHECK(refinement.numElements() > 6);
+        auto numElements = refinement.numElements();
+        refinement.refineAll();
+        check_conforming(refinement);
+        CHECK(refinement.numElements() >= 2 * numElements);
+
+        int numDirichlet = 0;
+        for (auto bc : refinement.bcs()) {
+            numDirichlet += bc == BC::Dirichlet ? 1 : 0;
+        }
+        CHECK(numDirichlet > 2);
+        CHECK(numDirichlet < static_cast<int>(refinement.bcs().size()));
+    }
+
+    SUBCASE("3D") {
+        std::vector<std::array<double, 3>> verts;
+        for (int i = 0; i < 8; ++i) {
+            verts.push_back({double(i & 1), double((i >> 1) & 1), double((i >> 2) & 1)});
+        }
+        std::vector<Simplex<3>> elems = {
+            {0, 1, 2, 4}, {1, 2, 3, 7}, {2, 4, 6, 7}, {1, 4, 5, 7}, {1, 2, 4, 7}};
+        std::map<Simplex<2>, int> count;
+        for (auto const& elem : elems) {
+            for (auto const& fct : elem.downward()) {
+                ++count[fct];
+            }
+        }
+        std::vector<Simplex<2>> fcts;
+        for (auto const& [fct, c] : count) {
+            if (c == 1) {
+                fcts.push_back(fct);
+            }
+        }
+        auto bcs = std::vector<BC>(fcts.size(), BC::Dirichlet);
+        auto refinement = BisectionRefinement<3u>(verts, elems, fcts, bcs);
+        check_conforming(refinement);
+        for (int step = 0; step < 6; ++step) {
+            refinement.refine({0, 1});
+            check_conforming(refinement);
+        }
+        refinement.refineAll();
+        check_conforming(refinement);
+    }
+
+    SUBCASE("Doerfler marking") {
+        auto marked = tndm::doerflerMarking({1.0, 8.0, 0.5, 4.0}, 0.8);
+        CHECK(marked == std::vector<std::size_t>{1, 3});
+        CHECK(tndm::doerflerMarking({1.0, 1.0}, 1.0).size() == 2);
+        CHECK(tndm::doerflerMarking({0.0, 0.0}, 0.5).empty());
+    }
+}
@@ -1,10 +1,15 @@
 #include "tensor/Tensor.h"
 #include "doctest.h"
+#include "tensor/EigenMap.h"
+#include "tensor/FixedTensor.h"
 #include "tensor/Managed.h"
 #include "tensor/TensorBase.h"
 
+#include <Eigen/LU>
+
 #include <cstddef>
 #include <numeric>
+#include <type_traits>
 
 using namespace tndm;
 
@@ -95,3 +100,64 @@ TEST_CASE("Subtensor") {
         }
     }
 }
+
+TEST_CASE("Fixed tensor") {
+    auto tensor = Managed<Tensor<double, 4u>>(3, 2, 5, 4);
+    std::iota(tensor.data(), tensor.data() + tensor.size(), 0);
+    auto const& ctensor = tensor;
+
+    SUBCASE("Fixed subtensor matches subtensor") {
+        auto fixed = fixed_subtensor<3, 2>(tensor, 4, 1);
+        auto sub = tensor.subtensor(slice{}, slice{}, 4, 1);
+        static_assert(decltype(fixed)::size() == 6);
+        CHECK(fixed.data() == sub.data());
+        for (std::ptrdiff_t i = 0; i < fixed.shape(0); ++i) {
+            for (std::ptrdiff_t j = 0; j < fixed.shape(1); ++j) {
+                CHECK(fixed(i, j) == sub(i, j));
+            }
+        }
+        auto fixed_vec = fixed_subtensor<3>(ctensor, 1, 2, 3);
+        static_assert(std::is_same_v<decltype(fixed_vec)::real_t, double const>);
+        for (std::ptrdiff_t i = 0; i < fixed_vec.shape(0); ++i) {
+            CHECK(fixed_vec(i) == tensor(i, 1, 2, 3));
+        }
+    }
+
+    SUBCASE("Conversion to and from Tensor") {
+        auto sub = tensor.subtensor(slice{}, slice{}, 2, 3);
+        auto fixed = FixedMatrix<double, 3, 2>(sub);
+        CHECK(fixed.data() == sub.data());
+        auto back = fixed.tensor();
+        CHECK(back.shape() == sub.shape());
+        CHECK(back.stride() == sub.stride());
+        auto managed = Managed<Matrix<double>>(fixed.info());
+        CHECK(managed.size() == fixed.size());
+    }
+
+    SUBCASE("Managed storage") {
+        auto a = Managed<FixedMatrix<double, 3, 2>>();
+        a.copy_values(fixed_subtensor<3, 2>(ctensor, 0, 0));
+        auto b = a;
+        CHECK(b.data() != a.data());
+        a.set_zero();
+        for (std::ptrdiff_t i = 0; i < b.size(); ++i) {
+            CHECK(a.data()[i] == 0.0);
+            CHECK(b.data()[i] == tensor.data()[i]);
+        }
+    }
+
+    SUBCASE("Eigen map") {
+        auto J = Managed<FixedMatrix<double, 2, 2>>();
+        J(0, 0) = 2.0;
+        J(1, 0) = 1.0;
+        J(0, 1) = 0.0;
+        J(1, 1) = 4.0;
+        auto map = EigenMap(J);
+        static_assert(decltype(map)::RowsAtCompileTime == 2);
+        static_assert(decltype(map)::ColsAtCompileTime == 2);
+        CHECK(map.determinant() == doctest::Approx(8.0));
+        auto v = fixed_subtensor<2>(J.view(), 1);
+        static_assert(decltype(EigenMap(v))::SizeAtCompileTime == 2);
+        CHECK(EigenMap(v).norm() == doctest::Approx(4.0));
+    }
+}
@@ -4,6 +4,7 @@
 #include "util/Algorithm.h"
 #include "util/Combinatorics.h"
 #include "util/LinearAllocator.h"
+#include "util/PerfCounters.h"
 #include "util/Zero.h"
 
 #include <array>
@@ -259,3 +260,25 @@ TEST_CASE("Algorithm") {
         CHECK(tensor(1, 2, 1) == 2);
     }
 }
+
+TEST_CASE("PerfCounters") {
+    PerfCounters counters;
+    PerfCounters::values_t before, after;
+    counters.read(before);
+    volatile double x = 0.0;
+    for (int i = 0; i < 100000; ++i) {
+        x = x + 1.0;
+    }
+    counters.read(after);
+    for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+        auto event = static_cast<PerfCounters::Event>(e);
+        if (!counters.available(event)) {
+            CHECK(before[e] == 0);
+            CHECK(after[e] == 0);
+        }
+    }
+    if (counters.available()) {
+        CHECK(after[PerfCounters::Instructions] > before[PerfCounters::Instructions]);
+        CHECK(after[PerfCounters::Cycles] > before[PerfCounters::Cycles]);
+    }
+}
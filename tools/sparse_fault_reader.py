@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+# Reads the sparse fault output of tandem ([fault_output] with sparse = true) and
+# reconstructs full snapshots.
+#
+# Usage as module:
+#   from sparse_fault_reader import SparseFaultOutput
+#   out = SparseFaultOutput('output/fault')
+#   for time, values in out.snapshots():
+#       ...  # values[name] has shape (num_facets, num_points)
+#
+# Usage as script (writes one CSV file per snapshot):
+#   sparse_fault_reader.py output/fault --csv output/fault-full
+
+import argparse
+import glob
+import struct
+
+import numpy as np
+
+MAGIC = b'TNDMSFO\0'
+VERSION = 1
+
+
+class SparseSnapshotFile:
+
+    def __init__(self, file_name):
+        self.f = open(file_name, 'rb')
+        if self.f.read(8) != MAGIC:
+            raise ValueError('{} is not a sparse fault output file'.format(file_name))
+        version, self.point_dim = struct.unpack('=II', self.f.read(8))
+        if version != VERSION:
+            raise ValueError('{} has unsupported version {}'.format(file_name, version))
+        self.num_blocks, self.num_points, self.num_quantities = struct.unpack(
+            '=QQQ', self.f.read(24))
+        self.names = []
+        for q in range(self.num_quantities):
+            length, = struct.unpack('=I', self.f.read(4))
+            self.names.append(self.f.read(length).decode())
+        self.ids = np.fromfile(self.f, dtype=np.uint64, count=self.num_blocks)
+        self.coords = np.fromfile(self.f, dtype=np.float64,
+                                  count=self.num_blocks * self.num_points *
+                                  self.point_dim).reshape(
+                                      (self.num_blocks, self.num_points, self.point_dim))
+
+    def records(self):
+        """Yields (time, keyframe, block indices, values[count, num_quantities, num_points])."""
+        block_size = self.num_quantities * self.num_points
+        while True:
+            head = self.f.read(17)
+            if len(head) < 17:
+                return
+            time, keyframe, count = struct.unpack('=dBQ', head)
+            blocks = np.fromfile(self.f, dtype=np.uint64, count=count)
+            values = np.fromfile(self.f, dtype=np.float64, count=count * block_size)
+            if len(blocks) < count or len(values) < count * block_size:
+                return  # truncated record of a running or aborted simulation
+            yield time, bool(keyframe), blocks, values.reshape(
+                (count, self.num_quantities, self.num_points))
+
+
+class SparseFaultOutput:
+
+    def __init__(self, prefix):
+        file_names = sorted(glob.glob(prefix + '_*.sfo'))
+        if not file_names:
+            raise FileNotFoundError('No sparse fault output found for prefix ' + prefix)
+        self.files = [SparseSnapshotFile(f) for f in file_names]
+        first = self.files[0]
+        self.names = first.names
+        self.num_points = first.num_points
+        for f in self.files:
+            if f.names != self.names or f.num_points != self.num_points:
+                raise ValueError('Inconsistent sparse fault output for prefix ' + prefix)
+
+        # Facets may be present on several ranks; the first occurence is used
+        self.ids = np.unique(np.concatenate([f.ids for f in self.files]))
+        pos = {gid: i for i, gid in enumerate(self.ids)}
+        self.maps = []
+        self.coords = np.zeros((len(self.ids), self.num_points, first.point_dim))
+        seen = np.zeros(len(self.ids), dtype=bool)
+        for f in self.files:
+            out = np.array([pos[gid] for gid in f.ids], dtype=np.int64)
+            mine = ~seen[out]
+            self.coords[out[mine]] = f.coords[mine]
+            seen[out[mine]] = True
+            self.maps.append((out, mine))
+
+    def snapshots(self):
+        """Yields (time, dict name -> array of shape (num_facets, num_points))."""
+        state = np.zeros((len(self.ids), len(self.names), self.num_points))
+        for records in zip(*[f.records() for f in self.files]):
+            time = records[0][0]
+            for (out, mine), (t, keyframe, blocks, values) in zip(self.maps, records):
+                if t != time:
+                    raise ValueError('Ranks disagree on output times')
+                sel = mine[blocks]
+                state[out[blocks[sel]]] = values[sel]
+            yield time, {name: state[:, q, :].copy() for q, name in enumerate(self.names)}
+
+
+def write_csv(output, csv_prefix):
+    coords = output.coords.reshape((-1, output.coords.shape[2]))
+    header = ','.join(['x', 'y', 'z'][:coords.shape[1]] + output.names)
+    for step, (time, values) in enumerate(output.snapshots()):
+        table = np.column_stack([coords] + [values[n].reshape(-1) for n in output.names])
+        np.savetxt('{}_{}.csv'.format(csv_prefix, step), table, delimiter=',', header=header,
+                   comments='# time = {}\n'.format(time))
+
+
+if __name__ == '__main__':
+    cmdLineParser = argparse.ArgumentParser()
+    cmdLineParser.add_argument('prefix', help='prefix of [fault_output]')
+    cmdLineParser.add_argument('--csv', type=str, help='write full snapshots to CSV files')
+    cmdLineArgs = cmdLineParser.parse_args()
+
+    output = SparseFaultOutput(cmdLineArgs.prefix)
+    if cmdLineArgs.csv:
+        write_csv(output, cmdLineArgs.csv)
+    else:
+        print('{} facets, {} points per facet, quantities: {}'.format(
+            len(output.ids), output.num_points, ', '.join(output.names)))
+        for time, values in output.snapshots():
+            print(time)